@@ -2,14 +2,27 @@ import struct
 import random
 import enum
 import socket
+import collections
 
-CURRENT_REQUEST_VERSION = 1
-MAX_REQUEST_DATA_SIZE = 32
-MAX_PACKET_SIZE = 48
+CURRENT_REQUEST_VERSION = 2
+MAX_REQUEST_DATA_SIZE = 1024
+MAX_PACKET_SIZE = 1040
 
 class RequestType(enum.IntEnum):
     ReadMemory = 1,
-    WriteMemory = 2
+    WriteMemory = 2,
+    ReadMemoryBatch = 3,
+    WriteMemoryBatch = 4,
+    ScanMemory = 5,
+    WatchMemory = 6
+
+class ScanCompare(enum.IntEnum):
+    Equal = 0,
+    NotEqual = 1,
+    Less = 2,
+    LessOrEqual = 3,
+    Greater = 4,
+    GreaterOrEqual = 5
 
 CITRA_PORT = 45987
 
@@ -17,6 +30,8 @@ class Citra:
     def __init__(self, address="127.0.0.1", port=CITRA_PORT):
         self.socket = socket.socket(socket.AF_INET, socket.SOCK_DGRAM)
         self.address = address
+        self.watch_id = None
+        self.watch_updates = collections.deque()
 
     def is_connected(self):
         return self.socket is not None
@@ -34,6 +49,20 @@ class Citra:
             return raw_reply[4*4:]
         return None
 
+    def _is_watch_update(self, raw_reply):
+        if self.watch_id is None or len(raw_reply) < 4*4:
+            return False
+        _, reply_id, reply_type, _ = struct.unpack("IIII", raw_reply[:4*4])
+        return reply_id == self.watch_id and reply_type == RequestType.WatchMemory
+
+    def _receive_reply(self, expected_id, expected_type):
+        # Watch updates arrive on the same socket as replies, keep them for wait_for_watch_changes
+        while True:
+            raw_reply = self.socket.recv(MAX_PACKET_SIZE)
+            if not self._is_watch_update(raw_reply):
+                return self._read_and_validate_header(raw_reply, expected_id, expected_type)
+            self.watch_updates.append(raw_reply)
+
     def read_memory(self, read_address, read_size):
         """
         >>> c.read_memory(0x100000, 4)
@@ -47,8 +76,7 @@ class Citra:
             request += request_data
             self.socket.sendto(request, (self.address, CITRA_PORT))
 
-            raw_reply = self.socket.recv(MAX_PACKET_SIZE)
-            reply_data = self._read_and_validate_header(raw_reply, request_id, RequestType.ReadMemory)
+            reply_data = self._receive_reply(request_id, RequestType.ReadMemory)
 
             if reply_data:
                 result += reply_data
@@ -79,8 +107,7 @@ class Citra:
             request += request_data
             self.socket.sendto(request, (self.address, CITRA_PORT))
 
-            raw_reply = self.socket.recv(MAX_PACKET_SIZE)
-            reply_data = self._read_and_validate_header(raw_reply, request_id, RequestType.WriteMemory)
+            reply_data = self._receive_reply(request_id, RequestType.WriteMemory)
 
             if None != reply_data:
                 write_address += temp_write_size
@@ -90,6 +117,128 @@ class Citra:
                 return False
         return True
 
+    def _request(self, request_type, request_data):
+        request, request_id = self._generate_header(request_type, len(request_data))
+        self.socket.sendto(request + request_data, (self.address, CITRA_PORT))
+        return self._receive_reply(request_id, request_type)
+
+    def read_memory_batch(self, ranges):
+        """
+        Reads several (address, size) ranges, as many per request as fit in a reply.
+
+        >>> c.read_memory_batch([(0x100000, 4), (0x100000, 2)])
+        [b'\\x07\\x00\\x00\\xeb', b'\\x07\\x00']
+        """
+        result = []
+        while ranges:
+            count = 0
+            total_size = 0
+            while (count < len(ranges) and count < MAX_REQUEST_DATA_SIZE // 8 and
+                   total_size + ranges[count][1] <= MAX_REQUEST_DATA_SIZE):
+                total_size += ranges[count][1]
+                count += 1
+            if count == 0:
+                return None
+            request_data = b"".join(struct.pack("II", address, size) for address, size in ranges[:count])
+            reply_data = self._request(RequestType.ReadMemoryBatch, request_data)
+            if reply_data is None or len(reply_data) != total_size:
+                return None
+            for _, size in ranges[:count]:
+                result.append(reply_data[:size])
+                reply_data = reply_data[size:]
+            ranges = ranges[count:]
+        return result
+
+    def write_memory_batch(self, writes):
+        """
+        Writes several (address, contents) pairs, as many per request as fit.
+
+        >>> c.write_memory_batch([(0x100000, b"\\xff\\xff"), (0x100002, b"\\xff\\xff")])
+        True
+        >>> c.read_memory(0x100000, 4)
+        b'\\xff\\xff\\xff\\xff'
+        >>> c.write_memory_batch([(0x100000, b"\\x07\\x00"), (0x100002, b"\\x00\\xeb")])
+        True
+        """
+        while writes:
+            request_data = b""
+            count = 0
+            for address, contents in writes:
+                record = struct.pack("II", address, len(contents)) + contents
+                if len(request_data) + len(record) > MAX_REQUEST_DATA_SIZE:
+                    break
+                request_data += record
+                count += 1
+            if count == 0:
+                return False
+            if self._request(RequestType.WriteMemoryBatch, request_data) is None:
+                return False
+            writes = writes[count:]
+        return True
+
+    def scan_memory(self, address, size, value, value_size=4, compare=ScanCompare.Equal):
+        """
+        Returns the addresses in [address, address + size) holding a value that compares to the
+        given one. Values are compared unsigned and have to be aligned to value_size.
+
+        >>> c.scan_memory(0x100000, 4, 0xeb000007)
+        [1048576]
+        """
+        matches = []
+        end = (address + size) & 0xFFFFFFFF
+        while True:
+            request_data = struct.pack("IIIII", address, size, compare, value_size, value)
+            reply_data = self._request(RequestType.ScanMemory, request_data)
+            if not reply_data:
+                return None
+            next_address = struct.unpack("I", reply_data[:4])[0]
+            matches += [match for (match,) in struct.iter_unpack("I", reply_data[4:])]
+            if next_address == end:
+                return matches
+            size -= (next_address - address) & 0xFFFFFFFF
+            address = next_address
+
+    def watch_memory(self, ranges):
+        """
+        Replaces the watch list with the given (address, size) ranges and returns their contents.
+        Once per frame, Citra sends the ranges that changed, see wait_for_watch_changes. An empty
+        list stops the updates.
+        """
+        request_data = b"".join(struct.pack("II", address, size) for address, size in ranges)
+        request, request_id = self._generate_header(RequestType.WatchMemory, len(request_data))
+        self.socket.sendto(request + request_data, (self.address, CITRA_PORT))
+        reply_data = self._receive_reply(request_id, RequestType.WatchMemory)
+        if reply_data is None:
+            return None
+        # Updates still queued belong to the previous watch list
+        self.watch_id = request_id if ranges else None
+        self.watch_updates.clear()
+        result = []
+        for _, size in ranges:
+            result.append(reply_data[:size])
+            reply_data = reply_data[size:]
+        return result
+
+    def wait_for_watch_changes(self):
+        """
+        Waits for the next update of the watch list and returns it as (address, contents) pairs.
+        """
+        while True:
+            if self.watch_updates:
+                raw_reply = self.watch_updates.popleft()
+            else:
+                raw_reply = self.socket.recv(MAX_PACKET_SIZE)
+            reply_data = self._read_and_validate_header(raw_reply, self.watch_id,
+                                                        RequestType.WatchMemory)
+            if reply_data is not None:
+                break
+        changes = []
+        while reply_data:
+            address, size = struct.unpack("II", reply_data[:8])
+            changes.append((address, reply_data[8:8 + size]))
+            reply_data = reply_data[8 + size:]
+        return changes
+
 if "__main__" == __name__:
     import doctest
     doctest.testmod(extraglobs={'c': Citra()})
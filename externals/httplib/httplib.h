@@ -301,15 +301,30 @@ public:
 
     bool send(Request& req, Response& res);
 
+    // Keeps the connection open between requests, until the server closes it.
+    void set_keep_alive(bool on);
+
+    // Whether the last request was sent over a connection kept alive from an earlier one.
+    bool reused_connection() const;
+
 protected:
     bool process_request(Stream& strm, Request& req, Response& res, bool& connection_close);
 
+    virtual bool process_keep_alive_socket(Request& req, Response& res, bool& connection_close);
+    virtual void close_keep_alive_socket();
+
     const std::string host_;
     const int         port_;
     size_t            timeout_sec_;
     const std::string host_and_port_;
 
+    bool              keep_alive_;
+    socket_t          keep_alive_sock_;
+    bool              reused_connection_;
+
 private:
+    bool send_keep_alive(Request& req, Response& res);
+
     socket_t create_client_socket() const;
     bool read_response_line(Stream& strm, Response& res);
     void write_request(Stream& strm, Request& req);
@@ -364,11 +379,16 @@ public:
 
     virtual bool add_client_cert_ASN1(std::vector<unsigned char> cert, std::vector<unsigned char> key);
 
+protected:
+    virtual bool process_keep_alive_socket(Request& req, Response& res, bool& connection_close);
+    virtual void close_keep_alive_socket();
+
 private:
     virtual bool read_and_close_socket(socket_t sock, Request& req, Response& res);
 
     SSL_CTX* ctx_;
     std::mutex ctx_mutex_;
+    SSL* keep_alive_ssl_;
 };
 #endif
 
@@ -592,6 +612,11 @@ socket_t create_socket(const char* host, int port, Fn fn, int socket_flags = 0)
         int yes = 1;
         setsockopt(sock, SOL_SOCKET, SO_REUSEADDR, (char*)&yes, sizeof(yes));
 
+#ifdef SO_NOSIGPIPE
+        // Writing to a connection closed by the peer must fail instead of raising SIGPIPE
+        setsockopt(sock, SOL_SOCKET, SO_NOSIGPIPE, (char*)&yes, sizeof(yes));
+#endif
+
         // bind or connect
         if (fn(sock, *rp)) {
             freeaddrinfo(result);
@@ -616,6 +641,42 @@ inline void set_nonblocking(socket_t sock, bool nonblocking)
 #endif
 }
 
+// Blocks SIGPIPE on the calling thread while alive, and discards the SIGPIPE raised meanwhile.
+// This covers writes which can't pass MSG_NOSIGNAL, such as those made by OpenSSL, on platforms
+// without SO_NOSIGPIPE.
+class scoped_sigpipe_block {
+public:
+#if !defined(_WIN32) && !defined(SO_NOSIGPIPE)
+    scoped_sigpipe_block()
+    {
+        sigemptyset(&sigpipe_);
+        sigaddset(&sigpipe_, SIGPIPE);
+        sigset_t pending;
+        sigpending(&pending);
+        was_pending_ = sigismember(&pending, SIGPIPE) == 1;
+        pthread_sigmask(SIG_BLOCK, &sigpipe_, &old_mask_);
+    }
+
+    ~scoped_sigpipe_block()
+    {
+        if (!was_pending_) {
+            sigset_t pending;
+            sigpending(&pending);
+            if (sigismember(&pending, SIGPIPE) == 1) {
+                int sig;
+                sigwait(&sigpipe_, &sig);
+            }
+        }
+        pthread_sigmask(SIG_SETMASK, &old_mask_, nullptr);
+    }
+
+private:
+    sigset_t sigpipe_;
+    sigset_t old_mask_;
+    bool was_pending_;
+#endif
+};
+
 inline bool is_connection_error()
 {
 #ifdef _WIN32
@@ -1426,7 +1487,12 @@ inline int SocketStream::read(char* ptr, size_t size)
 
 inline int SocketStream::write(const char* ptr, size_t size)
 {
+#ifdef MSG_NOSIGNAL
+    // Writing to a connection closed by the peer must fail instead of raising SIGPIPE
+    return send(sock_, ptr, size, MSG_NOSIGNAL);
+#else
     return send(sock_, ptr, size, 0);
+#endif
 }
 
 inline int SocketStream::write(const char* ptr)
@@ -1882,11 +1948,28 @@ inline Client::Client(
         , port_(port)
         , timeout_sec_(timeout_sec)
         , host_and_port_(host_ + ":" + std::to_string(port_))
+        , keep_alive_(false)
+        , keep_alive_sock_(INVALID_SOCKET)
+        , reused_connection_(false)
 {
 }
 
 inline Client::~Client()
 {
+    Client::close_keep_alive_socket();
+}
+
+inline void Client::set_keep_alive(bool on)
+{
+    keep_alive_ = on;
+    if (!on) {
+        close_keep_alive_socket();
+    }
+}
+
+inline bool Client::reused_connection() const
+{
+    return reused_connection_;
 }
 
 inline bool Client::is_valid() const
@@ -1942,6 +2025,12 @@ inline bool Client::send(Request& req, Response& res)
         return false;
     }
 
+    if (keep_alive_) {
+        return send_keep_alive(req, res);
+    }
+
+    reused_connection_ = false;
+
     auto sock = create_client_socket();
     if (sock == INVALID_SOCKET) {
         return false;
@@ -1950,6 +2039,51 @@ inline bool Client::send(Request& req, Response& res)
     return read_and_close_socket(sock, req, res);
 }
 
+inline bool Client::send_keep_alive(Request& req, Response& res)
+{
+    // An idle connection becomes readable once the server has closed it
+    if (keep_alive_sock_ != INVALID_SOCKET && detail::select_read(keep_alive_sock_, 0, 0) != 0) {
+        close_keep_alive_socket();
+    }
+
+    reused_connection_ = keep_alive_sock_ != INVALID_SOCKET;
+    if (!reused_connection_) {
+        keep_alive_sock_ = create_client_socket();
+        if (keep_alive_sock_ == INVALID_SOCKET) {
+            return false;
+        }
+    }
+
+    auto connection_close = false;
+    auto ret = process_keep_alive_socket(req, res, connection_close);
+    if (!ret || connection_close) {
+        close_keep_alive_socket();
+    }
+
+    // The server may have dropped the connection just as the request was sent, in which case
+    // nothing was received and the request is retried once over a new connection
+    if (!ret && reused_connection_ && res.status == -1) {
+        res = Response();
+        return send_keep_alive(req, res);
+    }
+
+    return ret;
+}
+
+inline bool Client::process_keep_alive_socket(Request& req, Response& res, bool& connection_close)
+{
+    SocketStream strm(keep_alive_sock_);
+    return process_request(strm, req, res, connection_close);
+}
+
+inline void Client::close_keep_alive_socket()
+{
+    if (keep_alive_sock_ != INVALID_SOCKET) {
+        detail::close_socket(keep_alive_sock_);
+        keep_alive_sock_ = INVALID_SOCKET;
+    }
+}
+
 inline void Client::write_request(Stream& strm, Request& req)
 {
     auto path = detail::encode_url(req.path);
@@ -1970,10 +2104,7 @@ inline void Client::write_request(Stream& strm, Request& req)
         req.set_header("User-Agent", "cpp-httplib/0.2");
     }
 
-    // TODO: Support KeepAlive connection
-    // if (!req.has_header("Connection")) {
-    req.set_header("Connection", "close");
-    // }
+    req.set_header("Connection", keep_alive_ ? "keep-alive" : "close");
 
     if (!req.body.empty()) {
         if (!req.has_header("Content-Type")) {
@@ -2333,12 +2464,14 @@ inline bool SSLServer::read_and_close_socket(socket_t sock)
 // SSL HTTP client implementation
 inline SSLClient::SSLClient(const char* host, int port, size_t timeout_sec)
         : Client(host, port, timeout_sec)
+        , keep_alive_ssl_(nullptr)
 {
     ctx_ = SSL_CTX_new(SSLv23_client_method());
 }
 
 inline SSLClient::~SSLClient()
 {
+    SSLClient::close_keep_alive_socket();
     if (ctx_) {
         SSL_CTX_free(ctx_);
     }
@@ -2370,6 +2503,7 @@ inline bool SSLClient::add_client_cert_ASN1(std::vector<unsigned char> cert, std
 
 inline bool SSLClient::read_and_close_socket(socket_t sock, Request& req, Response& res)
 {
+    detail::scoped_sigpipe_block sigpipe_block;
     return is_valid() && detail::read_and_close_socket_ssl(
             sock, 0,
             ctx_, ctx_mutex_,
@@ -2381,6 +2515,52 @@ inline bool SSLClient::read_and_close_socket(socket_t sock, Request& req, Respon
                 return process_request(strm, req, res, connection_close);
             });
 }
+
+inline bool SSLClient::process_keep_alive_socket(Request& req, Response& res, bool& connection_close)
+{
+    if (!is_valid()) {
+        return false;
+    }
+
+    detail::scoped_sigpipe_block sigpipe_block;
+    if (!keep_alive_ssl_) {
+        {
+            std::lock_guard<std::mutex> guard(ctx_mutex_);
+            keep_alive_ssl_ = SSL_new(ctx_);
+            if (!keep_alive_ssl_) {
+                return false;
+            }
+        }
+
+        auto bio = BIO_new_socket(keep_alive_sock_, BIO_NOCLOSE);
+        SSL_set_bio(keep_alive_ssl_, bio, bio);
+        SSL_set_tlsext_host_name(keep_alive_ssl_, host_.c_str());
+
+        if (SSL_connect(keep_alive_ssl_) != 1) {
+            return false;
+        }
+    }
+
+    SSLSocketStream strm(keep_alive_sock_, keep_alive_ssl_);
+    return process_request(strm, req, res, connection_close);
+}
+
+inline void SSLClient::close_keep_alive_socket()
+{
+    if (keep_alive_ssl_) {
+        // Don't notify a server which has already closed the connection, or sent something
+        // unexpected
+        if (detail::select_read(keep_alive_sock_, 0, 0) == 0) {
+            detail::scoped_sigpipe_block sigpipe_block;
+            SSL_shutdown(keep_alive_ssl_);
+        }
+
+        std::lock_guard<std::mutex> guard(ctx_mutex_);
+        SSL_free(keep_alive_ssl_);
+        keep_alive_ssl_ = nullptr;
+    }
+    Client::close_keep_alive_socket();
+}
 #endif
 
 } // namespace httplib
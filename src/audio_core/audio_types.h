@@ -6,7 +6,7 @@
 
 #include <array>
 #include <cstddef>
-#include <deque>
+#include "common/assert.h"
 #include "common/common_types.h"
 
 namespace AudioCore {
@@ -23,8 +23,77 @@ using StereoFrame16 = std::array<std::array<s16, 2>, samples_per_frame>;
 /// The DSP is quadraphonic internally.
 using QuadFrame32 = std::array<std::array<s32, 4>, samples_per_frame>;
 
-/// A variable length buffer of signed PCM16 stereo samples.
-using StereoBuffer16 = std::deque<std::array<s16, 2>>;
+/**
+ * A fixed-capacity FIFO of signed PCM16 stereo samples backed by contiguous storage. Samples are
+ * appended at the back by the decoders and consumed from the front by the interpolator. Storage
+ * is only rewound once the buffer has been drained, so reads and writes never wrap and no memory
+ * is allocated after construction.
+ *
+ * Two slots are always reserved in front of the read position so that the interpolator can place
+ * its history samples directly before the unread input.
+ */
+class StereoBuffer16 {
+public:
+    using Sample = std::array<s16, 2>;
+
+    /// Number of history slots kept in front of the read position.
+    static constexpr std::size_t history_size = 2;
+    /// Maximum number of samples the buffer can hold.
+    static constexpr std::size_t capacity = 4096;
+
+    bool Empty() const {
+        return read_pos == write_pos;
+    }
+
+    /// Number of unread samples.
+    std::size_t Size() const {
+        return write_pos - read_pos;
+    }
+
+    /// Number of samples that can still be appended without rewinding.
+    std::size_t FreeSpace() const {
+        return storage.size() - write_pos;
+    }
+
+    /// Pointer to the first unread sample. Data()[-2] and Data()[-1] are always valid.
+    Sample* Data() {
+        return storage.data() + read_pos;
+    }
+    const Sample* Data() const {
+        return storage.data() + read_pos;
+    }
+
+    const Sample& operator[](std::size_t i) const {
+        return storage[read_pos + i];
+    }
+
+    /// Discards all unread samples and rewinds the storage.
+    void Clear() {
+        read_pos = write_pos = history_size;
+    }
+
+    /// Marks count samples as consumed.
+    void Pop(std::size_t count) {
+        DEBUG_ASSERT(count <= Size());
+        read_pos += count;
+    }
+
+    /**
+     * Appends count samples to the back of the buffer.
+     * @return Pointer to the first appended sample, which the caller must fill in.
+     */
+    Sample* Append(std::size_t count) {
+        ASSERT_MSG(count <= FreeSpace(), "StereoBuffer16 overflow: {} > {}", count, FreeSpace());
+        Sample* const ret = storage.data() + write_pos;
+        write_pos += count;
+        return ret;
+    }
+
+private:
+    std::array<Sample, history_size + capacity> storage{};
+    std::size_t read_pos = history_size;
+    std::size_t write_pos = history_size;
+};
 
 constexpr std::size_t num_dsp_pipe = 8;
 enum class DspPipe {
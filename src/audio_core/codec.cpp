@@ -13,21 +13,32 @@
 
 namespace AudioCore::Codec {
 
-StereoBuffer16 DecodeADPCM(const u8* const data, const std::size_t sample_count,
-                           const std::array<s16, 16>& adpcm_coeff, ADPCMState& state) {
+// GC-ADPCM frames are 8 bytes long containing 14 samples each.
+constexpr std::size_t ADPCM_FRAME_LEN = 8;
+constexpr std::size_t ADPCM_SAMPLES_PER_FRAME = 14;
+
+std::size_t ADPCMDataSize(const std::size_t sample_count) {
+    const std::size_t num_frames =
+        (sample_count + (ADPCM_SAMPLES_PER_FRAME - 1)) / ADPCM_SAMPLES_PER_FRAME; // Round up.
+    return num_frames * ADPCM_FRAME_LEN;
+}
+
+std::size_t ADPCMDecodedSize(const std::size_t sample_count) {
+    return sample_count % 2 == 0 ? sample_count : sample_count + 1; // Ensure multiple of two.
+}
+
+void DecodeADPCM(const u8* const data, const std::size_t sample_count,
+                 const std::array<s16, 16>& adpcm_coeff, ADPCMState& state,
+                 StereoBuffer16::Sample* const ret) {
     // GC-ADPCM with scale factor and variable coefficients.
     // Frames are 8 bytes long containing 14 samples each.
     // Samples are 4 bits (one nibble) long.
 
-    constexpr std::size_t FRAME_LEN = 8;
-    constexpr std::size_t SAMPLES_PER_FRAME = 14;
+    constexpr std::size_t FRAME_LEN = ADPCM_FRAME_LEN;
+    constexpr std::size_t SAMPLES_PER_FRAME = ADPCM_SAMPLES_PER_FRAME;
     constexpr std::array<int, 16> SIGNED_NIBBLES = {
         {0, 1, 2, 3, 4, 5, 6, 7, -8, -7, -6, -5, -4, -3, -2, -1}};
 
-    const std::size_t ret_size =
-        sample_count % 2 == 0 ? sample_count : sample_count + 1; // Ensure multiple of two.
-    StereoBuffer16 ret(ret_size);
-
     int yn1 = state.yn1, yn2 = state.yn2;
 
     const std::size_t NUM_FRAMES =
@@ -74,20 +85,22 @@ StereoBuffer16 DecodeADPCM(const u8* const data, const std::size_t sample_count,
 
     state.yn1 = static_cast<s16>(yn1);
     state.yn2 = static_cast<s16>(yn2);
+}
 
-    return ret;
+void DecodeADPCM(const u8* const data, const std::size_t sample_count,
+                 const std::array<s16, 16>& adpcm_coeff, ADPCMState& state, StereoBuffer16& out) {
+    DecodeADPCM(data, sample_count, adpcm_coeff, state,
+                out.Append(ADPCMDecodedSize(sample_count)));
 }
 
-StereoBuffer16 DecodePCM8(const unsigned num_channels, const u8* const data,
-                          const std::size_t sample_count) {
+void DecodePCM8(const unsigned num_channels, const u8* const data, const std::size_t sample_count,
+                StereoBuffer16::Sample* const ret) {
     ASSERT(num_channels == 1 || num_channels == 2);
 
     const auto decode_sample = [](u8 sample) {
         return static_cast<s16>(static_cast<u16>(sample) << 8);
     };
 
-    StereoBuffer16 ret(sample_count);
-
     if (num_channels == 1) {
         for (std::size_t i = 0; i < sample_count; i++) {
             ret[i].fill(decode_sample(data[i]));
@@ -98,16 +111,17 @@ StereoBuffer16 DecodePCM8(const unsigned num_channels, const u8* const data,
             ret[i][1] = decode_sample(data[i * 2 + 1]);
         }
     }
+}
 
-    return ret;
+void DecodePCM8(const unsigned num_channels, const u8* const data, const std::size_t sample_count,
+                StereoBuffer16& out) {
+    DecodePCM8(num_channels, data, sample_count, out.Append(sample_count));
 }
 
-StereoBuffer16 DecodePCM16(const unsigned num_channels, const u8* const data,
-                           const std::size_t sample_count) {
+void DecodePCM16(const unsigned num_channels, const u8* const data, const std::size_t sample_count,
+                 StereoBuffer16::Sample* const ret) {
     ASSERT(num_channels == 1 || num_channels == 2);
 
-    StereoBuffer16 ret(sample_count);
-
     if (num_channels == 1) {
         for (std::size_t i = 0; i < sample_count; i++) {
             s16 sample;
@@ -115,11 +129,13 @@ StereoBuffer16 DecodePCM16(const unsigned num_channels, const u8* const data,
             ret[i].fill(sample);
         }
     } else {
-        for (std::size_t i = 0; i < sample_count; ++i) {
-            std::memcpy(&ret[i], data + i * sizeof(s16) * 2, 2 * sizeof(s16));
-        }
+        // Interleaved stereo PCM16 already matches the layout of the output buffer.
+        std::memcpy(ret, data, sample_count * 2 * sizeof(s16));
     }
+}
 
-    return ret;
+void DecodePCM16(const unsigned num_channels, const u8* const data, const std::size_t sample_count,
+                 StereoBuffer16& out) {
+    DecodePCM16(num_channels, data, sample_count, out.Append(sample_count));
 }
 } // namespace AudioCore::Codec
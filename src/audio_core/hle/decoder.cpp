@@ -2,17 +2,61 @@
 // Licensed under GPLv2 or any later version
 // Refer to the license.txt file included.
 
+#include <cstring>
 #include "audio_core/hle/decoder.h"
+#include "common/assert.h"
+#include "common/microprofile.h"
 
 namespace AudioCore::HLE {
 
+/// Returns a pointer to [address, address + size) in FCRAM, or nullptr if it's out of bounds
+static u8* GetFCRAMRange(Memory::MemorySystem& memory, u32 address, std::size_t size) {
+    if (address < Memory::FCRAM_PADDR ||
+        address + static_cast<u64>(size) > Memory::FCRAM_PADDR + Memory::FCRAM_SIZE) {
+        return nullptr;
+    }
+    return memory.GetFCRAMPointer(address - Memory::FCRAM_PADDR);
+}
+
+bool ReadDecoderInput(Memory::MemorySystem& memory, const BinaryRequest& request,
+                      DecoderBuffers& buffers) {
+    const u8* data = GetFCRAMRange(memory, request.src_addr, request.size);
+    if (data == nullptr) {
+        LOG_ERROR(Audio_DSP, "Got out of bounds src_addr {:08x}", request.src_addr);
+        buffers.input.clear();
+        return false;
+    }
+    buffers.input.assign(data, data + request.size);
+    return true;
+}
+
+bool WriteDecoderOutput(Memory::MemorySystem& memory, const BinaryRequest& request,
+                        const DecoderBuffers& buffers) {
+    const std::array<u32, 2> dst_addrs{request.dst_addr_ch0, request.dst_addr_ch1};
+    for (std::size_t channel = 0; channel < buffers.output.size(); ++channel) {
+        const std::vector<u8>& samples = buffers.output[channel];
+        if (samples.empty()) {
+            continue;
+        }
+        u8* data = GetFCRAMRange(memory, dst_addrs[channel], samples.size());
+        if (data == nullptr) {
+            LOG_ERROR(Audio_DSP, "Got out of bounds dst_addr_ch{} {:08x}", channel,
+                      dst_addrs[channel]);
+            return false;
+        }
+        std::memcpy(data, samples.data(), samples.size());
+    }
+    return true;
+}
+
 DecoderBase::~DecoderBase(){};
 
 NullDecoder::NullDecoder() = default;
 
 NullDecoder::~NullDecoder() = default;
 
-std::optional<BinaryResponse> NullDecoder::ProcessRequest(const BinaryRequest& request) {
+std::optional<BinaryResponse> NullDecoder::ProcessRequest(const BinaryRequest& request,
+                                                          DecoderBuffers& buffers) {
     BinaryResponse response;
     switch (request.cmd) {
     case DecoderCommand::Init:
@@ -32,4 +76,96 @@ std::optional<BinaryResponse> NullDecoder::ProcessRequest(const BinaryRequest& r
         return {};
     }
 };
+
+AsyncDecoder::AsyncDecoder(Memory::MemorySystem& memory, Factory factory)
+    : memory(memory), worker(&AsyncDecoder::WorkerLoop, this, std::move(factory)) {}
+
+AsyncDecoder::~AsyncDecoder() {
+    {
+        std::lock_guard lock{mutex};
+        stop = true;
+    }
+    request_cv.notify_one();
+    worker.join();
+}
+
+void AsyncDecoder::Submit(const BinaryRequest& request) {
+    Job job{request, {}, std::nullopt};
+    if (request.cmd == DecoderCommand::Decode) {
+        // The application may reuse the source buffer as soon as the request is made
+        ReadDecoderInput(memory, request, job.buffers);
+    }
+    {
+        std::lock_guard lock{mutex};
+        requests.push_back(std::move(job));
+        in_flight++;
+    }
+    request_cv.notify_one();
+}
+
+MICROPROFILE_DEFINE(Audio_DecodeWait, "Audio", "Wait for decoder", MP_RGB(160, 160, 100));
+
+void AsyncDecoder::Collect(std::vector<std::optional<BinaryResponse>>& responses) {
+    std::vector<Job> jobs;
+    {
+        std::unique_lock lock{mutex};
+        if (in_flight != 0) {
+            MICROPROFILE_SCOPE(Audio_DecodeWait);
+            done_cv.wait(lock, [this] { return in_flight == 0; });
+        }
+        jobs.swap(completed);
+    }
+
+    for (Job& job : jobs) {
+        if (job.response && !WriteDecoderOutput(memory, job.request, job.buffers)) {
+            job.response.reset();
+        }
+        responses.push_back(job.response);
+    }
+}
+
+std::optional<BinaryResponse> AsyncDecoder::ProcessRequest(const BinaryRequest& request) {
+    std::vector<std::optional<BinaryResponse>> responses;
+    Submit(request);
+    Collect(responses);
+    ASSERT_MSG(responses.size() == 1, "Synchronous request issued while requests are pending");
+    return responses.back();
+}
+
+MICROPROFILE_DEFINE(Audio_Decode, "Audio", "Decode", MP_RGB(200, 200, 100));
+
+void AsyncDecoder::WorkerLoop(Factory factory) {
+    MicroProfileOnThreadCreate("AudioDecoder");
+
+    std::unique_ptr<DecoderBase> decoder = factory();
+
+    std::unique_lock lock{mutex};
+    while (true) {
+        request_cv.wait(lock, [this] { return stop || !requests.empty(); });
+        if (stop) {
+            break;
+        }
+
+        Job job = std::move(requests.front());
+        requests.pop_front();
+        lock.unlock();
+
+        {
+            MICROPROFILE_SCOPE(Audio_Decode);
+            job.response = decoder->ProcessRequest(job.request, job.buffers);
+        }
+
+        lock.lock();
+        completed.push_back(std::move(job));
+        in_flight--;
+        if (in_flight == 0) {
+            done_cv.notify_all();
+        }
+    }
+    lock.unlock();
+
+    decoder.reset();
+    MicroProfileOnThreadExit();
+}
+
 } // namespace AudioCore::HLE
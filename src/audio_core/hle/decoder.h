@@ -4,8 +4,14 @@
 
 #pragma once
 
+#include <array>
+#include <condition_variable>
+#include <deque>
+#include <functional>
 #include <memory>
+#include <mutex>
 #include <optional>
+#include <thread>
 #include <vector>
 #include "common/common_types.h"
 #include "common/swap.h"
@@ -52,17 +58,101 @@ struct BinaryResponse {
 };
 static_assert(sizeof(BinaryResponse) == 32, "Unexpected struct size for BinaryResponse");
 
+/**
+ * The guest memory a request reads and writes, staged in host buffers. Decoders only ever see
+ * these buffers, never FCRAM, so they can run on any thread.
+ */
+struct DecoderBuffers {
+    /// Contents of [src_addr, src_addr + size) at the time the request was made
+    std::vector<u8> input;
+    /// PCM16 samples to be written to dst_addr_ch0 and dst_addr_ch1
+    std::array<std::vector<u8>, 2> output;
+};
+
+/**
+ * Copies the input of a Decode request out of FCRAM.
+ * @return false if the input is out of FCRAM bounds, in which case buffers.input is left empty
+ */
+bool ReadDecoderInput(Memory::MemorySystem& memory, const BinaryRequest& request,
+                      DecoderBuffers& buffers);
+
+/**
+ * Copies the decoded output of a request into FCRAM.
+ * @return false if a channel is out of FCRAM bounds, in which case it and later ones aren't written
+ */
+bool WriteDecoderOutput(Memory::MemorySystem& memory, const BinaryRequest& request,
+                        const DecoderBuffers& buffers);
+
 class DecoderBase {
 public:
     virtual ~DecoderBase();
-    virtual std::optional<BinaryResponse> ProcessRequest(const BinaryRequest& request) = 0;
+    virtual std::optional<BinaryResponse> ProcessRequest(const BinaryRequest& request,
+                                                         DecoderBuffers& buffers) = 0;
 };
 
 class NullDecoder final : public DecoderBase {
 public:
     NullDecoder();
     ~NullDecoder() override;
-    std::optional<BinaryResponse> ProcessRequest(const BinaryRequest& request) override;
+    std::optional<BinaryResponse> ProcessRequest(const BinaryRequest& request,
+                                                 DecoderBuffers& buffers) override;
+};
+
+/**
+ * Runs a decoder on a dedicated worker thread so that decoding doesn't stall the emulation
+ * thread. Requests are processed one at a time in submission order, and responses are handed back
+ * in the same order by Collect. Since the caller decides when to collect, the point at which
+ * responses become visible to the application doesn't depend on how long decoding takes.
+ *
+ * The worker never accesses guest memory: Submit copies the input out of FCRAM, and Collect
+ * copies the decoded output into FCRAM, both on the calling thread.
+ *
+ * The decoder is created, used and destroyed on the worker thread only, as some backends (Media
+ * Foundation) hold per-thread state.
+ */
+class AsyncDecoder final {
+public:
+    using Factory = std::function<std::unique_ptr<DecoderBase>()>;
+
+    AsyncDecoder(Memory::MemorySystem& memory, Factory factory);
+    ~AsyncDecoder();
+
+    /// Queues a request for the worker thread.
+    void Submit(const BinaryRequest& request);
+
+    /**
+     * Waits for every submitted request to complete.
+     * @param responses Responses of the completed requests, in submission order, are appended to
+     *                  this. Requests which failed produce std::nullopt.
+     */
+    void Collect(std::vector<std::optional<BinaryResponse>>& responses);
+
+    /**
+     * Processes a request and waits for its response. Requests still pending on the worker
+     * thread must have been collected beforehand.
+     */
+    std::optional<BinaryResponse> ProcessRequest(const BinaryRequest& request);
+
+private:
+    struct Job {
+        BinaryRequest request;
+        DecoderBuffers buffers;
+        std::optional<BinaryResponse> response;
+    };
+
+    void WorkerLoop(Factory factory);
+
+    Memory::MemorySystem& memory;
+
+    std::mutex mutex;
+    std::condition_variable request_cv;
+    std::condition_variable done_cv;
+    std::deque<Job> requests;
+    std::vector<Job> completed;
+    std::size_t in_flight = 0;
+    bool stop = false;
+
+    std::thread worker;
 };
 
 } // namespace AudioCore::HLE
@@ -9,16 +9,17 @@ namespace AudioCore::HLE {
 
 class FFMPEGDecoder::Impl {
 public:
-    explicit Impl(Memory::MemorySystem& memory);
+    Impl();
     ~Impl();
-    std::optional<BinaryResponse> ProcessRequest(const BinaryRequest& request);
+    std::optional<BinaryResponse> ProcessRequest(const BinaryRequest& request,
+                                                 DecoderBuffers& buffers);
 
 private:
     std::optional<BinaryResponse> Initalize(const BinaryRequest& request);
 
     void Clear();
 
-    std::optional<BinaryResponse> Decode(const BinaryRequest& request);
+    std::optional<BinaryResponse> Decode(const BinaryRequest& request, DecoderBuffers& buffers);
 
     struct AVPacketDeleter {
         void operator()(AVPacket* packet) const {
@@ -47,8 +48,6 @@ private:
     bool initalized = false;
     bool have_ffmpeg_dl;
 
-    Memory::MemorySystem& memory;
-
     AVCodec* codec;
     std::unique_ptr<AVCodecContext, AVCodecContextDeleter> av_context;
     std::unique_ptr<AVCodecParserContext, AVCodecParserContextDeleter> parser;
@@ -56,13 +55,14 @@ private:
     std::unique_ptr<AVFrame, AVFrameDeleter> decoded_frame;
 };
 
-FFMPEGDecoder::Impl::Impl(Memory::MemorySystem& memory) : memory(memory) {
+FFMPEGDecoder::Impl::Impl() {
     have_ffmpeg_dl = InitFFmpegDL();
 }
 
 FFMPEGDecoder::Impl::~Impl() = default;
 
-std::optional<BinaryResponse> FFMPEGDecoder::Impl::ProcessRequest(const BinaryRequest& request) {
+std::optional<BinaryResponse> FFMPEGDecoder::Impl::ProcessRequest(const BinaryRequest& request,
+                                                                  DecoderBuffers& buffers) {
     if (request.codec != DecoderCodec::AAC) {
         LOG_ERROR(Audio_DSP, "Got wrong codec {}", static_cast<u16>(request.codec));
         return {};
@@ -73,7 +73,7 @@ std::optional<BinaryResponse> FFMPEGDecoder::Impl::ProcessRequest(const BinaryRe
         return Initalize(request);
     }
     case DecoderCommand::Decode: {
-        return Decode(request);
+        return Decode(request, buffers);
     }
     case DecoderCommand::Unknown: {
         BinaryResponse response;
@@ -140,7 +140,8 @@ void FFMPEGDecoder::Impl::Clear() {
     av_packet.reset();
 }
 
-std::optional<BinaryResponse> FFMPEGDecoder::Impl::Decode(const BinaryRequest& request) {
+std::optional<BinaryResponse> FFMPEGDecoder::Impl::Decode(const BinaryRequest& request,
+                                                          DecoderBuffers& buffers) {
     BinaryResponse response;
     response.codec = request.codec;
     response.cmd = request.cmd;
@@ -154,12 +155,11 @@ std::optional<BinaryResponse> FFMPEGDecoder::Impl::Decode(const BinaryRequest& r
         return response;
     }
 
-    if (request.src_addr < Memory::FCRAM_PADDR ||
-        request.src_addr + request.size > Memory::FCRAM_PADDR + Memory::FCRAM_SIZE) {
-        LOG_ERROR(Audio_DSP, "Got out of bounds src_addr {:08x}", request.src_addr);
+    if (buffers.input.size() != request.size) {
+        // The source was out of FCRAM bounds, ReadDecoderInput has logged it
         return {};
     }
-    u8* data = memory.GetFCRAMPointer(request.src_addr - Memory::FCRAM_PADDR);
+    const u8* data = buffers.input.data();
 
     std::array<std::vector<u8>, 2> out_streams;
 
@@ -229,36 +229,17 @@ std::optional<BinaryResponse> FFMPEGDecoder::Impl::Decode(const BinaryRequest& r
         }
     }
 
-    if (out_streams[0].size() != 0) {
-        if (request.dst_addr_ch0 < Memory::FCRAM_PADDR ||
-            request.dst_addr_ch0 + out_streams[0].size() >
-                Memory::FCRAM_PADDR + Memory::FCRAM_SIZE) {
-            LOG_ERROR(Audio_DSP, "Got out of bounds dst_addr_ch0 {:08x}", request.dst_addr_ch0);
-            return {};
-        }
-        std::memcpy(memory.GetFCRAMPointer(request.dst_addr_ch0 - Memory::FCRAM_PADDR),
-                    out_streams[0].data(), out_streams[0].size());
-    }
-
-    if (out_streams[1].size() != 0) {
-        if (request.dst_addr_ch1 < Memory::FCRAM_PADDR ||
-            request.dst_addr_ch1 + out_streams[1].size() >
-                Memory::FCRAM_PADDR + Memory::FCRAM_SIZE) {
-            LOG_ERROR(Audio_DSP, "Got out of bounds dst_addr_ch1 {:08x}", request.dst_addr_ch1);
-            return {};
-        }
-        std::memcpy(memory.GetFCRAMPointer(request.dst_addr_ch1 - Memory::FCRAM_PADDR),
-                    out_streams[1].data(), out_streams[1].size());
-    }
+    buffers.output = std::move(out_streams);
     return response;
 }
 
-FFMPEGDecoder::FFMPEGDecoder(Memory::MemorySystem& memory) : impl(std::make_unique<Impl>(memory)) {}
+FFMPEGDecoder::FFMPEGDecoder() : impl(std::make_unique<Impl>()) {}
 
 FFMPEGDecoder::~FFMPEGDecoder() = default;
 
-std::optional<BinaryResponse> FFMPEGDecoder::ProcessRequest(const BinaryRequest& request) {
-    return impl->ProcessRequest(request);
+std::optional<BinaryResponse> FFMPEGDecoder::ProcessRequest(const BinaryRequest& request,
+                                                            DecoderBuffers& buffers) {
+    return impl->ProcessRequest(request, buffers);
 }
 
 } // namespace AudioCore::HLE
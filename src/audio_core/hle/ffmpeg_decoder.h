@@ -10,9 +10,10 @@ namespace AudioCore::HLE {
 
 class FFMPEGDecoder final : public DecoderBase {
 public:
-    explicit FFMPEGDecoder(Memory::MemorySystem& memory);
+    FFMPEGDecoder();
     ~FFMPEGDecoder() override;
-    std::optional<BinaryResponse> ProcessRequest(const BinaryRequest& request) override;
+    std::optional<BinaryResponse> ProcessRequest(const BinaryRequest& request,
+                                                 DecoderBuffers& buffers) override;
 
 private:
     class Impl;
@@ -5,6 +5,10 @@
 #include <algorithm>
 #include <array>
 #include <cstddef>
+#include <cstring>
+#ifdef ARCHITECTURE_x86_64
+#include <emmintrin.h>
+#endif
 #include "audio_core/hle/common.h"
 #include "audio_core/hle/filter.h"
 #include "audio_core/hle/shared_memory.h"
@@ -39,14 +43,32 @@ void SourceFilters::ProcessFrame(StereoFrame16& frame) {
         return;
 
     if (simple_filter_enabled) {
-        FilterFrame(frame, simple_filter);
+        simple_filter.ProcessFrame(frame);
     }
 
     if (biquad_filter_enabled) {
-        FilterFrame(frame, biquad_filter);
+        biquad_filter.ProcessFrame(frame);
     }
 }
 
+#ifdef ARCHITECTURE_x86_64
+static __m128i LoadSample(const std::array<s16, 2>& sample) {
+    s32 raw;
+    std::memcpy(&raw, sample.data(), sizeof(raw));
+    return _mm_cvtsi32_si128(raw);
+}
+
+static void StoreSample(std::array<s16, 2>& sample, __m128i value) {
+    const s32 raw = _mm_cvtsi128_si32(value);
+    std::memcpy(sample.data(), &raw, sizeof(raw));
+}
+
+/// The SSE2 paths multiply with pmaddwd, which requires every coefficient to fit in an s16.
+static bool FitsInS16(s32 value) {
+    return value >= -32768 && value <= 32767;
+}
+#endif
+
 // SimpleFilter
 
 void SourceFilters::SimpleFilter::Reset() {
@@ -75,6 +97,27 @@ std::array<s16, 2> SourceFilters::SimpleFilter::ProcessSample(const std::array<s
     return y0;
 }
 
+void SourceFilters::SimpleFilter::ProcessFrame(StereoFrame16& frame) {
+#ifdef ARCHITECTURE_x86_64
+    if (FitsInS16(a1) && FitsInS16(b0)) {
+        // Both channels are filtered in parallel; each pmaddwd lane computes b0 * x0 + a1 * y1.
+        const s16 b0_16 = static_cast<s16>(b0);
+        const s16 a1_16 = static_cast<s16>(a1);
+        const __m128i coeffs = _mm_setr_epi16(b0_16, a1_16, b0_16, a1_16, 0, 0, 0, 0);
+        __m128i y = LoadSample(y1);
+        for (auto& sample : frame) {
+            const __m128i acc = _mm_madd_epi16(_mm_unpacklo_epi16(LoadSample(sample), y), coeffs);
+            const __m128i shifted = _mm_srai_epi32(acc, 15);
+            y = _mm_packs_epi32(shifted, shifted);
+            StoreSample(sample, y);
+        }
+        StoreSample(y1, y);
+        return;
+    }
+#endif
+    FilterFrame(frame, *this);
+}
+
 // BiquadFilter
 
 void SourceFilters::BiquadFilter::Reset() {
@@ -112,4 +155,49 @@ std::array<s16, 2> SourceFilters::BiquadFilter::ProcessSample(const std::array<s
     return y0;
 }
 
+void SourceFilters::BiquadFilter::ProcessFrame(StereoFrame16& frame) {
+#ifdef ARCHITECTURE_x86_64
+    if (FitsInS16(a1) && FitsInS16(a2) && FitsInS16(b0) && FitsInS16(b1) && FitsInS16(b2)) {
+        // Both channels are filtered in parallel. The five products per channel are split as
+        // {b0 * x0 + b1 * x1, b2 * x2 + a1 * y1} and {a2 * y2} across two pmaddwd operations.
+        const s16 b0_16 = static_cast<s16>(b0);
+        const s16 b1_16 = static_cast<s16>(b1);
+        const s16 b2_16 = static_cast<s16>(b2);
+        const s16 a1_16 = static_cast<s16>(a1);
+        const s16 a2_16 = static_cast<s16>(a2);
+        const __m128i coeffs_lo =
+            _mm_setr_epi16(b0_16, b1_16, b0_16, b1_16, b2_16, a1_16, b2_16, a1_16);
+        const __m128i coeffs_hi = _mm_setr_epi16(a2_16, 0, a2_16, 0, 0, 0, 0, 0);
+        const __m128i zero = _mm_setzero_si128();
+
+        __m128i vx1 = LoadSample(x1);
+        __m128i vx2 = LoadSample(x2);
+        __m128i vy1 = LoadSample(y1);
+        __m128i vy2 = LoadSample(y2);
+        for (auto& sample : frame) {
+            const __m128i vx0 = LoadSample(sample);
+            const __m128i terms = _mm_unpacklo_epi64(_mm_unpacklo_epi16(vx0, vx1),
+                                                     _mm_unpacklo_epi16(vx2, vy1));
+            const __m128i partial = _mm_madd_epi16(terms, coeffs_lo);
+            __m128i acc = _mm_add_epi32(partial, _mm_srli_si128(partial, 8));
+            acc = _mm_add_epi32(acc, _mm_madd_epi16(_mm_unpacklo_epi16(vy2, zero), coeffs_hi));
+            const __m128i shifted = _mm_srai_epi32(acc, 14);
+            const __m128i vy0 = _mm_packs_epi32(shifted, shifted);
+            StoreSample(sample, vy0);
+
+            vx2 = vx1;
+            vx1 = vx0;
+            vy2 = vy1;
+            vy1 = vy0;
+        }
+        StoreSample(x1, vx1);
+        StoreSample(x2, vx2);
+        StoreSample(y1, vy1);
+        StoreSample(y2, vy2);
+        return;
+    }
+#endif
+    FilterFrame(frame, *this);
+}
+
 } // namespace AudioCore::HLE
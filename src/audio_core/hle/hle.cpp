@@ -12,6 +12,7 @@
 #include "audio_core/hle/decoder.h"
 #include "audio_core/hle/hle.h"
 #include "audio_core/hle/mixers.h"
+#include "audio_core/hle/sample_cache.h"
 #include "audio_core/hle/shared_memory.h"
 #include "audio_core/hle/source.h"
 #include "audio_core/sink.h"
@@ -21,6 +22,7 @@
 #include "common/logging/log.h"
 #include "core/core.h"
 #include "core/core_timing.h"
+#include "core/movie.h"
 
 using InterruptType = Service::DSP::DSP_DSP::InterruptType;
 using Service::DSP::DSP_DSP;
@@ -31,7 +33,7 @@ static constexpr u64 audio_frame_ticks = 1310252ull; ///< Units: ARM11 cycles
 
 struct DspHle::Impl final {
 public:
-    explicit Impl(DspHle& parent, Memory::MemorySystem& memory);
+    explicit Impl(DspHle& parent, Memory::MemorySystem& memory, Core::Timing& timing);
     ~Impl();
 
     DspState GetDspState() const;
@@ -49,6 +51,8 @@ public:
 private:
     void ResetPipes();
     void WriteU16(DspPipe pipe_number, u16 value);
+    void WriteBinaryResponse(const HLE::BinaryResponse& response);
+    void CollectDecoderResponses();
     void AudioPipeWriteStructAddresses();
 
     std::size_t CurrentRegionIndex() const;
@@ -71,42 +75,48 @@ private:
         HLE::Source(20), HLE::Source(21), HLE::Source(22), HLE::Source(23),
     }};
     HLE::Mixers mixers;
+    HLE::SampleCache sample_cache;
 
     DspHle& parent;
+    Core::Timing& core_timing;
     Core::TimingEventType* tick_event;
 
-    std::unique_ptr<HLE::DecoderBase> decoder;
+    std::unique_ptr<HLE::AsyncDecoder> decoder;
+    std::vector<std::optional<HLE::BinaryResponse>> decoder_responses;
 
     std::weak_ptr<DSP_DSP> dsp_dsp;
 };
 
-DspHle::Impl::Impl(DspHle& parent_, Memory::MemorySystem& memory) : parent(parent_) {
+DspHle::Impl::Impl(DspHle& parent_, Memory::MemorySystem& memory, Core::Timing& timing)
+    : parent(parent_), core_timing(timing) {
     dsp_memory.raw_memory.fill(0);
 
     for (auto& source : sources) {
         source.SetMemory(memory);
+        source.SetSampleCache(&sample_cache);
     }
 
+    decoder = std::make_unique<HLE::AsyncDecoder>(
+        memory, []() -> std::unique_ptr<HLE::DecoderBase> {
 #ifdef HAVE_MF
-    decoder = std::make_unique<HLE::WMFDecoder>(memory);
+            return std::make_unique<HLE::WMFDecoder>();
 #elif HAVE_FFMPEG
-    decoder = std::make_unique<HLE::FFMPEGDecoder>(memory);
+            return std::make_unique<HLE::FFMPEGDecoder>();
 #else
-    LOG_WARNING(Audio_DSP, "No decoder found, this could lead to missing audio");
-    decoder = std::make_unique<HLE::NullDecoder>();
+            LOG_WARNING(Audio_DSP, "No decoder found, this could lead to missing audio");
+            return std::make_unique<HLE::NullDecoder>();
 #endif // HAVE_MF
+        });
 
-    Core::Timing& timing = Core::System::GetInstance().CoreTiming();
     tick_event =
-        timing.RegisterEvent("AudioCore::DspHle::tick_event", [this](u64, s64 cycles_late) {
+        core_timing.RegisterEvent("AudioCore::DspHle::tick_event", [this](u64, s64 cycles_late) {
             this->AudioTickCallback(cycles_late);
         });
-    timing.ScheduleEvent(audio_frame_ticks, tick_event);
+    core_timing.ScheduleEvent(audio_frame_ticks, tick_event);
 }
 
 DspHle::Impl::~Impl() {
-    Core::Timing& timing = Core::System::GetInstance().CoreTiming();
-    timing.UnscheduleEvent(tick_event, 0);
+    core_timing.UnscheduleEvent(tick_event, 0);
 }
 
 DspState DspHle::Impl::GetDspState() const {
@@ -233,7 +243,6 @@ void DspHle::Impl::PipeWrite(DspPipe pipe_number, const std::vector<u8>& buffer)
         return;
     }
     case DspPipe::Binary: {
-        // TODO(B3N30): Make this async, and signal the interrupt
         HLE::BinaryRequest request;
         if (sizeof(request) != buffer.size()) {
             LOG_CRITICAL(Audio_DSP, "got binary pipe with wrong size {}", buffer.size());
@@ -246,11 +255,19 @@ void DspHle::Impl::PipeWrite(DspPipe pipe_number, const std::vector<u8>& buffer)
             UNIMPLEMENTED();
             return;
         }
-        std::optional<HLE::BinaryResponse> response = decoder->ProcessRequest(request);
-        if (response) {
-            const HLE::BinaryResponse& value = *response;
-            pipe_data[static_cast<u32>(pipe_number)].resize(sizeof(value));
-            std::memcpy(pipe_data[static_cast<u32>(pipe_number)].data(), &value, sizeof(value));
+
+        // Requests are decoded on the decoder thread and their responses published at the next
+        // audio frame. Movies are decoded synchronously, so that responses become visible at
+        // exactly the same point they did when the movie was recorded.
+        const Core::Movie& movie = Core::Movie::GetInstance();
+        if (movie.IsRecordingInput() || movie.IsPlayingInput()) {
+            CollectDecoderResponses();
+            std::optional<HLE::BinaryResponse> response = decoder->ProcessRequest(request);
+            if (response) {
+                WriteBinaryResponse(*response);
+            }
+        } else {
+            decoder->Submit(request);
         }
         break;
     }
@@ -271,6 +288,10 @@ void DspHle::Impl::SetServiceToInterrupt(std::weak_ptr<DSP_DSP> dsp) {
 }
 
 void DspHle::Impl::ResetPipes() {
+    // Responses to requests made before the reset are dropped.
+    decoder->Collect(decoder_responses);
+    decoder_responses.clear();
+
     for (auto& data : pipe_data) {
         data.clear();
     }
@@ -286,6 +307,24 @@ void DspHle::Impl::WriteU16(DspPipe pipe_number, u16 value) {
     data.emplace_back(value >> 8);
 }
 
+void DspHle::Impl::WriteBinaryResponse(const HLE::BinaryResponse& response) {
+    // Several responses can be collected at once, the application reads them back in order
+    std::vector<u8>& data = pipe_data[static_cast<std::size_t>(DspPipe::Binary)];
+    const std::size_t offset = data.size();
+    data.resize(offset + sizeof(response));
+    std::memcpy(data.data() + offset, &response, sizeof(response));
+}
+
+void DspHle::Impl::CollectDecoderResponses() {
+    decoder->Collect(decoder_responses);
+    for (const auto& response : decoder_responses) {
+        if (response) {
+            WriteBinaryResponse(*response);
+        }
+    }
+    decoder_responses.clear();
+}
+
 void DspHle::Impl::AudioPipeWriteStructAddresses() {
     // These struct addresses are DSP dram addresses.
     // See also: DSP_DSP::ConvertProcessAddressFromDspDram
@@ -390,6 +429,8 @@ bool DspHle::Impl::Tick() {
 }
 
 void DspHle::Impl::AudioTickCallback(s64 cycles_late) {
+    CollectDecoderResponses();
+
     if (Tick()) {
         // TODO(merry): Signal all the other interrupts as appropriate.
         if (auto service = dsp_dsp.lock()) {
@@ -400,11 +441,11 @@ void DspHle::Impl::AudioTickCallback(s64 cycles_late) {
     }
 
     // Reschedule recurrent event
-    Core::Timing& timing = Core::System::GetInstance().CoreTiming();
-    timing.ScheduleEvent(audio_frame_ticks - cycles_late, tick_event);
+    core_timing.ScheduleEvent(audio_frame_ticks - cycles_late, tick_event);
 }
 
-DspHle::DspHle(Memory::MemorySystem& memory) : impl(std::make_unique<Impl>(*this, memory)) {}
+DspHle::DspHle(Memory::MemorySystem& memory, Core::Timing& timing)
+    : impl(std::make_unique<Impl>(*this, memory, timing)) {}
 DspHle::~DspHle() = default;
 
 u16 DspHle::RecvData(u32 register_number) {
@@ -4,6 +4,9 @@
 
 #include <algorithm>
 #include <cstddef>
+#ifdef ARCHITECTURE_x86_64
+#include <emmintrin.h>
+#endif
 #include "audio_core/hle/mixers.h"
 #include "common/assert.h"
 #include "common/logging/log.h"
@@ -94,9 +97,66 @@ static std::array<s16, 2> AddAndClampToS16(const std::array<s16, 2>& a,
             ClampToS16(static_cast<s32>(a[1]) + static_cast<s32>(b[1]))};
 }
 
+#ifdef ARCHITECTURE_x86_64
+/**
+ * Downmixes four quadraphonic samples at a time and mixes them into the stereo accumulator.
+ * The samples are transposed so each channel occupies its own register, which keeps the float
+ * additions in the same order as the scalar path and the results bit-identical to it.
+ */
+static void DownmixSSE2(float gain, bool mono, const QuadFrame32& samples,
+                        StereoFrame16& accumulator) {
+    static_assert(samples_per_frame % 4 == 0);
+
+    const auto load = [&samples](std::size_t i) {
+        return _mm_cvtepi32_ps(_mm_loadu_si128(reinterpret_cast<const __m128i*>(&samples[i])));
+    };
+
+    const __m128 gains = _mm_set1_ps(gain);
+    for (std::size_t i = 0; i < samples_per_frame; i += 4) {
+        __m128 c0 = load(i);
+        __m128 c1 = load(i + 1);
+        __m128 c2 = load(i + 2);
+        __m128 c3 = load(i + 3);
+        _MM_TRANSPOSE4_PS(c0, c1, c2, c3);
+        c0 = _mm_mul_ps(gains, c0);
+        c1 = _mm_mul_ps(gains, c1);
+        c2 = _mm_mul_ps(gains, c2);
+        c3 = _mm_mul_ps(gains, c3);
+
+        // Saturating packs and adds perform the clamping to s16.
+        __m128i mixed;
+        if (mono) {
+            const __m128 sum = _mm_add_ps(_mm_add_ps(_mm_add_ps(c0, c1), c2), c3);
+            const __m128i value = _mm_cvttps_epi32(_mm_div_ps(sum, _mm_set1_ps(2.0f)));
+            const __m128i packed = _mm_packs_epi32(value, value);
+            mixed = _mm_unpacklo_epi16(packed, packed);
+        } else {
+            const __m128i left = _mm_cvttps_epi32(_mm_add_ps(c0, c2));
+            const __m128i right = _mm_cvttps_epi32(_mm_add_ps(c1, c3));
+            mixed = _mm_unpacklo_epi16(_mm_packs_epi32(left, left), _mm_packs_epi32(right, right));
+        }
+
+        __m128i* const out = reinterpret_cast<__m128i*>(&accumulator[i]);
+        _mm_storeu_si128(out, _mm_adds_epi16(_mm_loadu_si128(out), mixed));
+    }
+}
+#endif
+
 void Mixers::DownmixAndMixIntoCurrentFrame(float gain, const QuadFrame32& samples) {
     // TODO(merry): Limiter. (Currently we're performing final mixing assuming a disabled limiter.)
 
+#ifdef ARCHITECTURE_x86_64
+    switch (state.output_format) {
+    case OutputFormat::Mono:
+        DownmixSSE2(gain, true, samples, current_frame);
+        return;
+    case OutputFormat::Surround:
+    case OutputFormat::Stereo:
+        DownmixSSE2(gain, false, samples, current_frame);
+        return;
+    }
+#endif
+
     switch (state.output_format) {
     case OutputFormat::Mono:
         std::transform(
@@ -0,0 +1,119 @@
+// Copyright 2020 Citra Emulator Project
+// Licensed under GPLv2 or any later version
+// Refer to the license.txt file included.
+
+#include <utility>
+#include "audio_core/hle/sample_cache.h"
+#include "common/logging/log.h"
+
+namespace AudioCore::HLE {
+
+SampleCache::SampleCache(std::size_t capacity) : capacity(capacity) {}
+
+SampleCache::~SampleCache() {
+    const u64 lookups = stats.hits + stats.misses;
+    if (lookups != 0) {
+        LOG_INFO(Audio_DSP,
+                 "Sample cache: {} hits, {} misses ({:.1f}% hit rate), {} evictions, {} KiB held",
+                 stats.hits, stats.misses, 100.0 * stats.hits / lookups, stats.evictions,
+                 stats.bytes / 1024);
+    }
+}
+
+SampleCache::Key SampleCache::MakeKey(const u8* data, PAddr physical_address, u32 length,
+                                      Format format, unsigned num_channels,
+                                      const std::array<s16, 16>& adpcm_coeffs,
+                                      const Codec::ADPCMState& adpcm_state) {
+    std::size_t data_size = 0;
+    switch (format) {
+    case Format::PCM8:
+        data_size = length * num_channels;
+        break;
+    case Format::PCM16:
+        data_size = length * num_channels * sizeof(s16);
+        break;
+    case Format::ADPCM:
+        data_size = Codec::ADPCMDataSize(length);
+        break;
+    }
+
+    Key key;
+    key.state.content_hash = Common::ComputeHash64(data, data_size);
+    key.state.physical_address = physical_address;
+    key.state.length = length;
+    key.state.format = format;
+    key.state.num_channels = static_cast<u16>(num_channels);
+    if (format == Format::ADPCM) {
+        key.state.adpcm_coeffs = adpcm_coeffs;
+        key.state.adpcm_state = adpcm_state;
+    }
+    return key;
+}
+
+bool SampleCache::IsCacheable(u32 length, Format format) const {
+    // PCM16 decodes with a plain copy, which costs no more than hashing the buffer would.
+    // Long buffers are usually streamed music that would only push sound effects out.
+    return (format == Format::PCM8 || format == Format::ADPCM) &&
+           length * sizeof(StereoBuffer16::Sample) <= capacity / 8;
+}
+
+std::shared_ptr<const SampleCache::Entry> SampleCache::Lookup(const Key& key) {
+    const auto iter = entries.find(key);
+    if (iter == entries.end()) {
+        stats.misses++;
+        return nullptr;
+    }
+
+    stats.hits++;
+    lru.splice(lru.begin(), lru, iter->second);
+    return iter->second->second;
+}
+
+std::shared_ptr<const SampleCache::Entry> SampleCache::Insert(const Key& key, Entry entry) {
+    const std::size_t bytes = EntryBytes(entry);
+    auto shared_entry = std::make_shared<const Entry>(std::move(entry));
+    if (bytes > capacity) {
+        return shared_entry;
+    }
+
+    const auto iter = entries.find(key);
+    if (iter != entries.end()) {
+        stats.bytes -= EntryBytes(*iter->second->second);
+        lru.erase(iter->second);
+        entries.erase(iter);
+    }
+
+    EvictTo(capacity - bytes);
+
+    lru.emplace_front(key, shared_entry);
+    entries.emplace(key, lru.begin());
+    stats.bytes += bytes;
+    stats.entries = entries.size();
+    return shared_entry;
+}
+
+void SampleCache::Clear() {
+    lru.clear();
+    entries.clear();
+    stats.bytes = 0;
+    stats.entries = 0;
+}
+
+std::size_t SampleCache::EntryBytes(const Entry& entry) {
+    return entry.samples.size() * sizeof(StereoBuffer16::Sample);
+}
+
+void SampleCache::EvictTo(std::size_t target_bytes) {
+    while (stats.bytes > target_bytes && !lru.empty()) {
+        const auto& [key, entry] = lru.back();
+        LOG_TRACE(Audio_DSP, "Evicting {} decoded samples from {:#010x}", entry->samples.size(),
+                  key.state.physical_address);
+        stats.bytes -= EntryBytes(*entry);
+        stats.evictions++;
+        entries.erase(key);
+        lru.pop_back();
+    }
+    stats.entries = entries.size();
+}
+
+} // namespace AudioCore::HLE
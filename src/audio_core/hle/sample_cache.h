@@ -0,0 +1,113 @@
+// Copyright 2020 Citra Emulator Project
+// Licensed under GPLv2 or any later version
+// Refer to the license.txt file included.
+
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <list>
+#include <memory>
+#include <unordered_map>
+#include <vector>
+#include "audio_core/audio_types.h"
+#include "audio_core/codec.h"
+#include "audio_core/hle/shared_memory.h"
+#include "common/common_types.h"
+#include "common/hash.h"
+
+namespace AudioCore::HLE {
+
+/**
+ * Cache of decoded source buffers, shared by all Sources.
+ *
+ * Applications replay the same sound effects constantly. Entries are keyed by everything the
+ * decoded output depends on, including a hash of the encoded data, so a buffer that has been
+ * rewritten by the application simply misses. Least recently used entries are evicted once the
+ * decoded size exceeds the capacity.
+ */
+class SampleCache final {
+public:
+    using Format = SourceConfiguration::Configuration::Format;
+
+    /// Default capacity in bytes of decoded samples.
+    static constexpr std::size_t default_capacity = 16 * 1024 * 1024;
+
+    struct KeyData {
+        u64 content_hash;
+        PAddr physical_address;
+        u32 length;
+        std::array<s16, 16> adpcm_coeffs; ///< Zero unless format is ADPCM
+        Codec::ADPCMState adpcm_state;    ///< Zero unless format is ADPCM
+        Format format;
+        u16 num_channels;
+    };
+    using Key = Common::HashableStruct<KeyData>;
+
+    struct Entry {
+        std::vector<StereoBuffer16::Sample> samples;
+        /// ADPCM decoder state after decoding the whole buffer.
+        Codec::ADPCMState adpcm_state;
+    };
+
+    struct Stats {
+        u64 hits = 0;
+        u64 misses = 0;
+        u64 evictions = 0;
+        /// Decoded bytes currently held by the cache.
+        std::size_t bytes = 0;
+        std::size_t entries = 0;
+    };
+
+    explicit SampleCache(std::size_t capacity = default_capacity);
+    ~SampleCache();
+
+    /**
+     * Builds the key for a buffer.
+     * @param data Pointer to the encoded data in guest memory
+     * @param physical_address Physical address of the buffer
+     * @param length Length of the buffer in samples
+     * @param format Encoding of the buffer
+     * @param num_channels Number of channels in the buffer
+     * @param adpcm_coeffs ADPCM coefficients used to decode the buffer
+     * @param adpcm_state ADPCM state at the start of the buffer
+     */
+    static Key MakeKey(const u8* data, PAddr physical_address, u32 length, Format format,
+                       unsigned num_channels, const std::array<s16, 16>& adpcm_coeffs,
+                       const Codec::ADPCMState& adpcm_state);
+
+    /// Returns whether a buffer of this length and format is worth caching.
+    bool IsCacheable(u32 length, Format format) const;
+
+    /// Looks up a decoded buffer, returning nullptr and counting a miss if it is not cached.
+    std::shared_ptr<const Entry> Lookup(const Key& key);
+
+    /// Inserts a decoded buffer, evicting old entries as needed. Returns the inserted entry.
+    std::shared_ptr<const Entry> Insert(const Key& key, Entry entry);
+
+    /// Drops all entries. Entries still held by callers stay valid.
+    void Clear();
+
+    const Stats& GetStats() const {
+        return stats;
+    }
+
+private:
+    struct KeyHash {
+        std::size_t operator()(const Key& key) const {
+            return key.Hash();
+        }
+    };
+
+    using LruList = std::list<std::pair<Key, std::shared_ptr<const Entry>>>;
+
+    static std::size_t EntryBytes(const Entry& entry);
+    void EvictTo(std::size_t target_bytes);
+
+    std::size_t capacity;
+    LruList lru; ///< Most recently used first
+    std::unordered_map<Key, LruList::iterator, KeyHash> entries;
+    Stats stats;
+};
+
+} // namespace AudioCore::HLE
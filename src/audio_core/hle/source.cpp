@@ -4,6 +4,10 @@
 
 #include <algorithm>
 #include <array>
+#include <cstring>
+#ifdef ARCHITECTURE_x86_64
+#include <emmintrin.h>
+#endif
 #include "audio_core/codec.h"
 #include "audio_core/hle/common.h"
 #include "audio_core/hle/source.h"
@@ -30,6 +34,23 @@ void Source::MixInto(QuadFrame32& dest, std::size_t intermediate_mix_id) const {
         return;
 
     const std::array<float, 4>& gains = state.gain.at(intermediate_mix_id);
+
+#ifdef ARCHITECTURE_x86_64
+    // Each stereo sample is widened to {L, R, L, R} and scaled by all four gains at once.
+    // Truncating conversion matches static_cast<s32>.
+    const __m128 gain = _mm_loadu_ps(gains.data());
+    for (std::size_t samplei = 0; samplei < samples_per_frame; samplei++) {
+        s32 raw;
+        std::memcpy(&raw, &current_frame[samplei], sizeof(raw));
+        __m128i sample = _mm_cvtsi32_si128(raw);
+        sample = _mm_srai_epi32(_mm_unpacklo_epi16(sample, sample), 16);
+        sample = _mm_shuffle_epi32(sample, _MM_SHUFFLE(1, 0, 1, 0));
+
+        const __m128i scaled = _mm_cvttps_epi32(_mm_mul_ps(gain, _mm_cvtepi32_ps(sample)));
+        __m128i* const out = reinterpret_cast<__m128i*>(dest[samplei].data());
+        _mm_storeu_si128(out, _mm_add_epi32(_mm_loadu_si128(out), scaled));
+    }
+#else
     for (std::size_t samplei = 0; samplei < samples_per_frame; samplei++) {
         // Conversion from stereo (current_frame) to quadraphonic (dest) occurs here.
         dest[samplei][0] += static_cast<s32>(gains[0] * current_frame[samplei][0]);
@@ -37,6 +58,7 @@ void Source::MixInto(QuadFrame32& dest, std::size_t intermediate_mix_id) const {
         dest[samplei][2] += static_cast<s32>(gains[2] * current_frame[samplei][0]);
         dest[samplei][3] += static_cast<s32>(gains[3] * current_frame[samplei][1]);
     }
+#endif
 }
 
 void Source::Reset() {
@@ -48,6 +70,10 @@ void Source::SetMemory(Memory::MemorySystem& memory) {
     memory_system = &memory;
 }
 
+void Source::SetSampleCache(SampleCache* cache) {
+    sample_cache = cache;
+}
+
 void Source::ParseConfig(SourceConfiguration::Configuration& config,
                          const s16_le (&adpcm_coeffs)[16]) {
     if (!config.dirty_raw) {
@@ -232,7 +258,7 @@ void Source::ParseConfig(SourceConfiguration::Configuration& config,
 void Source::GenerateFrame() {
     current_frame.fill({});
 
-    if (state.current_buffer.empty() && !DequeueBuffer()) {
+    if (state.current_buffer.Empty() && !RefillBuffer() && !DequeueBuffer()) {
         state.enabled = false;
         state.buffer_update = true;
         state.current_buffer_id = 0;
@@ -243,7 +269,7 @@ void Source::GenerateFrame() {
 
     state.current_sample_number = state.next_sample_number;
     while (frame_position < current_frame.size()) {
-        if (state.current_buffer.empty() && !DequeueBuffer()) {
+        if (state.current_buffer.Empty() && !RefillBuffer() && !DequeueBuffer()) {
             break;
         }
 
@@ -273,7 +299,7 @@ void Source::GenerateFrame() {
 }
 
 bool Source::DequeueBuffer() {
-    ASSERT_MSG(state.current_buffer.empty(),
+    ASSERT_MSG(state.current_buffer.Empty() && state.current_decoded == state.current_length,
                "Shouldn't dequeue; we still have data in current_buffer");
 
     if (state.input_queue.empty())
@@ -291,28 +317,26 @@ bool Source::DequeueBuffer() {
     // firmware.
     const u8* const memory = memory_system->GetPhysicalPointer(buf.physical_address & 0xFFFFFFFC);
     if (memory) {
-        const unsigned num_channels = buf.mono_or_stereo == MonoOrStereo::Stereo ? 2 : 1;
-        switch (buf.format) {
-        case Format::PCM8:
-            state.current_buffer = Codec::DecodePCM8(num_channels, memory, buf.length);
-            break;
-        case Format::PCM16:
-            state.current_buffer = Codec::DecodePCM16(num_channels, memory, buf.length);
-            break;
-        case Format::ADPCM:
-            DEBUG_ASSERT(num_channels == 1);
-            state.current_buffer =
-                Codec::DecodeADPCM(memory, buf.length, state.adpcm_coeffs, state.adpcm_state);
-            break;
-        default:
-            UNIMPLEMENTED();
-            break;
+        state.current_data = memory;
+        state.current_length = buf.length;
+        state.current_decoded = 0;
+        state.current_num_channels = buf.mono_or_stereo == MonoOrStereo::Stereo ? 2 : 1;
+        state.current_format = buf.format;
+        state.current_adpcm_coeffs = state.adpcm_coeffs;
+        state.current_cached = nullptr;
+        DEBUG_ASSERT(buf.format != Format::ADPCM || state.current_num_channels == 1);
+        if (sample_cache && sample_cache->IsCacheable(buf.length, buf.format)) {
+            LoadCachedBuffer(buf.physical_address);
         }
+        RefillBuffer();
     } else {
         LOG_WARNING(Audio_DSP,
                     "source_id={} buffer_id={} length={}: Invalid physical address {:#010x}",
                     source_id, buf.buffer_id, buf.length, buf.physical_address);
-        state.current_buffer.clear();
+        state.current_data = nullptr;
+        state.current_cached = nullptr;
+        state.current_length = state.current_decoded = 0;
+        state.current_buffer.Clear();
         return true;
     }
 
@@ -327,11 +351,96 @@ bool Source::DequeueBuffer() {
         state.input_queue.push(buf);
     }
 
-    LOG_TRACE(Audio_DSP, "source_id={} buffer_id={} from_queue={} current_buffer.size()={}",
-              source_id, buf.buffer_id, buf.from_queue, state.current_buffer.size());
+    LOG_TRACE(Audio_DSP, "source_id={} buffer_id={} from_queue={} length={}", source_id,
+              buf.buffer_id, buf.from_queue, buf.length);
+    return true;
+}
+
+bool Source::RefillBuffer() {
+    // ADPCM frames contain 14 samples. Chunks stay frame aligned and leave room for the extra
+    // sample DecodeADPCM emits for an odd sample count.
+    constexpr std::size_t ADPCM_SAMPLES_PER_FRAME = 14;
+    constexpr std::size_t CHUNK_SIZE =
+        (StereoBuffer16::capacity - 1) / ADPCM_SAMPLES_PER_FRAME * ADPCM_SAMPLES_PER_FRAME;
+
+    if (state.current_decoded >= state.current_length)
+        return false;
+
+    if (state.current_cached) {
+        const std::size_t count = std::min<std::size_t>(
+            state.current_length - state.current_decoded, StereoBuffer16::capacity);
+        state.current_buffer.Clear();
+        std::memcpy(state.current_buffer.Append(count),
+                    state.current_cached->samples.data() + state.current_decoded,
+                    count * sizeof(StereoBuffer16::Sample));
+        state.current_decoded += static_cast<u32>(count);
+        return true;
+    }
+
+    const std::size_t offset = state.current_decoded;
+    const std::size_t count =
+        std::min<std::size_t>(state.current_length - state.current_decoded, CHUNK_SIZE);
+    const unsigned num_channels = state.current_num_channels;
+
+    state.current_buffer.Clear();
+    switch (state.current_format) {
+    case Format::PCM8:
+        Codec::DecodePCM8(num_channels, state.current_data + offset * num_channels, count,
+                          state.current_buffer);
+        break;
+    case Format::PCM16:
+        Codec::DecodePCM16(num_channels, state.current_data + offset * num_channels * sizeof(s16),
+                           count, state.current_buffer);
+        break;
+    case Format::ADPCM:
+        Codec::DecodeADPCM(state.current_data + Codec::ADPCMDataSize(offset), count,
+                           state.current_adpcm_coeffs, state.adpcm_state, state.current_buffer);
+        break;
+    default:
+        UNIMPLEMENTED();
+        break;
+    }
+    state.current_decoded += static_cast<u32>(count);
+
     return true;
 }
 
+void Source::LoadCachedBuffer(PAddr physical_address) {
+    const SampleCache::Key key = SampleCache::MakeKey(
+        state.current_data, physical_address, state.current_length, state.current_format,
+        state.current_num_channels, state.current_adpcm_coeffs, state.adpcm_state);
+
+    std::shared_ptr<const SampleCache::Entry> entry = sample_cache->Lookup(key);
+    if (!entry) {
+        SampleCache::Entry decoded;
+        decoded.adpcm_state = state.adpcm_state;
+        switch (state.current_format) {
+        case Format::PCM8:
+            decoded.samples.resize(state.current_length);
+            Codec::DecodePCM8(state.current_num_channels, state.current_data, state.current_length,
+                              decoded.samples.data());
+            break;
+        case Format::ADPCM:
+            decoded.samples.resize(Codec::ADPCMDecodedSize(state.current_length));
+            Codec::DecodeADPCM(state.current_data, state.current_length,
+                               state.current_adpcm_coeffs, decoded.adpcm_state,
+                               decoded.samples.data());
+            break;
+        default:
+            UNREACHABLE();
+            break;
+        }
+        entry = sample_cache->Insert(key, std::move(decoded));
+    }
+
+    // The whole buffer has been decoded, so the decoder state is already that of its end.
+    // current_length now counts decoded samples, including the padding sample ADPCM adds to odd
+    // lengths.
+    state.adpcm_state = entry->adpcm_state;
+    state.current_length = static_cast<u32>(entry->samples.size());
+    state.current_cached = std::move(entry);
+}
+
 SourceStatus::Status Source::GetCurrentStatus() {
     SourceStatus::Status ret;
 
@@ -5,12 +5,14 @@
 #pragma once
 
 #include <array>
+#include <memory>
 #include <vector>
 #include <queue>
 #include "audio_core/audio_types.h"
 #include "audio_core/codec.h"
 #include "audio_core/hle/common.h"
 #include "audio_core/hle/filter.h"
+#include "audio_core/hle/sample_cache.h"
 #include "audio_core/interpolate.h"
 #include "common/common_types.h"
 
@@ -41,6 +43,9 @@ public:
     /// Sets the memory system to read data from
     void SetMemory(Memory::MemorySystem& memory);
 
+    /// Sets the cache to look decoded buffers up in. Buffers are always decoded if not set.
+    void SetSampleCache(SampleCache* cache);
+
     /**
      * This is called once every audio frame. This performs per-source processing every frame.
      * @param config The new configuration we've got for this Source from the application.
@@ -63,6 +68,7 @@ public:
 private:
     const std::size_t source_id;
     Memory::MemorySystem* memory_system;
+    SampleCache* sample_cache = nullptr;
     StereoFrame16 current_frame;
 
     using Format = SourceConfiguration::Configuration::Format;
@@ -115,7 +121,18 @@ private:
 
         u32 current_sample_number = 0;
         u32 next_sample_number = 0;
-        AudioInterp::StereoBuffer16 current_buffer;
+
+        /// Guest memory of the buffer being played. It is decoded into current_buffer one chunk
+        /// at a time, or copied from current_cached if the buffer was found in the sample cache.
+        const u8* current_data = nullptr;
+        std::shared_ptr<const SampleCache::Entry> current_cached;
+        u32 current_length = 0;
+        u32 current_decoded = 0;
+        unsigned current_num_channels = 1;
+        Format current_format = Format::ADPCM;
+        std::array<s16, 16> current_adpcm_coeffs = {};
+
+        StereoBuffer16 current_buffer;
 
         // buffer_id state
 
@@ -148,6 +165,12 @@ private:
     /// INTERNAL: Dequeues a buffer and does preprocessing on it (decoding, resampling). Puts it
     /// into current_buffer.
     bool DequeueBuffer();
+    /// INTERNAL: Decodes the next chunk of the buffer being played into current_buffer. Returns
+    /// false if the buffer has been fully decoded.
+    bool RefillBuffer();
+    /// INTERNAL: Looks the buffer being played up in the sample cache, decoding and inserting it
+    /// on a miss.
+    void LoadCachedBuffer(PAddr physical_address);
     /// INTERNAL: Generates a SourceStatus::Status based on our internal state.
     SourceStatus::Status GetCurrentStatus();
 };
@@ -9,28 +9,27 @@ namespace AudioCore::HLE {
 
 class WMFDecoder::Impl {
 public:
-    explicit Impl(Memory::MemorySystem& memory);
+    Impl();
     ~Impl();
-    std::optional<BinaryResponse> ProcessRequest(const BinaryRequest& request);
+    std::optional<BinaryResponse> ProcessRequest(const BinaryRequest& request,
+                                                 DecoderBuffers& buffers);
 
 private:
     std::optional<BinaryResponse> Initalize(const BinaryRequest& request);
 
-    std::optional<BinaryResponse> Decode(const BinaryRequest& request);
+    std::optional<BinaryResponse> Decode(const BinaryRequest& request, DecoderBuffers& buffers);
 
     MFOutputState DecodingLoop(ADTSData adts_header, std::array<std::vector<u8>, 2>& out_streams);
 
     bool transform_initialized = false;
     bool format_selected = false;
 
-    Memory::MemorySystem& memory;
-
     unique_mfptr<IMFTransform> transform;
     DWORD in_stream_id = 0;
     DWORD out_stream_id = 0;
 };
 
-WMFDecoder::Impl::Impl(Memory::MemorySystem& memory) : memory(memory) {
+WMFDecoder::Impl::Impl() {
     HRESULT hr = S_OK;
     hr = CoInitialize(NULL);
     // S_FALSE will be returned when COM has already been initialized
@@ -77,7 +76,8 @@ WMFDecoder::Impl::~Impl() {
     CoUninitialize();
 }
 
-std::optional<BinaryResponse> WMFDecoder::Impl::ProcessRequest(const BinaryRequest& request) {
+std::optional<BinaryResponse> WMFDecoder::Impl::ProcessRequest(const BinaryRequest& request,
+                                                               DecoderBuffers& buffers) {
     if (request.codec != DecoderCodec::AAC) {
         LOG_ERROR(Audio_DSP, "Got unknown codec {}", static_cast<u16>(request.codec));
         return {};
@@ -89,7 +89,7 @@ std::optional<BinaryResponse> WMFDecoder::Impl::ProcessRequest(const BinaryReque
         return Initalize(request);
     }
     case DecoderCommand::Decode: {
-        return Decode(request);
+        return Decode(request, buffers);
     }
     case DecoderCommand::Unknown: {
         BinaryResponse response;
@@ -163,7 +163,8 @@ MFOutputState WMFDecoder::Impl::DecodingLoop(ADTSData adts_header,
     return MFOutputState::FatalError;
 }
 
-std::optional<BinaryResponse> WMFDecoder::Impl::Decode(const BinaryRequest& request) {
+std::optional<BinaryResponse> WMFDecoder::Impl::Decode(const BinaryRequest& request,
+                                                       DecoderBuffers& buffers) {
     BinaryResponse response;
     response.codec = request.codec;
     response.cmd = request.cmd;
@@ -177,12 +178,11 @@ std::optional<BinaryResponse> WMFDecoder::Impl::Decode(const BinaryRequest& requ
         return response;
     }
 
-    if (request.src_addr < Memory::FCRAM_PADDR ||
-        request.src_addr + request.size > Memory::FCRAM_PADDR + Memory::FCRAM_SIZE) {
-        LOG_ERROR(Audio_DSP, "Got out of bounds src_addr {:08x}", request.src_addr);
+    if (buffers.input.size() != request.size) {
+        // The source was out of FCRAM bounds, ReadDecoderInput has logged it
         return {};
     }
-    u8* data = memory.GetFCRAMPointer(request.src_addr - Memory::FCRAM_PADDR);
+    const u8* data = buffers.input.data();
 
     std::array<std::vector<u8>, 2> out_streams;
     unique_mfptr<IMFSample> sample;
@@ -232,43 +232,24 @@ std::optional<BinaryResponse> WMFDecoder::Impl::Decode(const BinaryRequest& requ
             // flush the transform
             MFFlush(transform.get());
             // decode again
-            return this->Decode(request);
+            return this->Decode(request, buffers);
         }
 
         break; // jump out of the loop if at least we don't have obvious issues
     }
 
-    if (out_streams[0].size() != 0) {
-        if (request.dst_addr_ch0 < Memory::FCRAM_PADDR ||
-            request.dst_addr_ch0 + out_streams[0].size() >
-                Memory::FCRAM_PADDR + Memory::FCRAM_SIZE) {
-            LOG_ERROR(Audio_DSP, "Got out of bounds dst_addr_ch0 {:08x}", request.dst_addr_ch0);
-            return {};
-        }
-        std::memcpy(memory.GetFCRAMPointer(request.dst_addr_ch0 - Memory::FCRAM_PADDR),
-                    out_streams[0].data(), out_streams[0].size());
-    }
-
-    if (out_streams[1].size() != 0) {
-        if (request.dst_addr_ch1 < Memory::FCRAM_PADDR ||
-            request.dst_addr_ch1 + out_streams[1].size() >
-                Memory::FCRAM_PADDR + Memory::FCRAM_SIZE) {
-            LOG_ERROR(Audio_DSP, "Got out of bounds dst_addr_ch1 {:08x}", request.dst_addr_ch1);
-            return {};
-        }
-        std::memcpy(memory.GetFCRAMPointer(request.dst_addr_ch1 - Memory::FCRAM_PADDR),
-                    out_streams[1].data(), out_streams[1].size());
-    }
+    buffers.output = std::move(out_streams);
 
     return response;
 }
 
-WMFDecoder::WMFDecoder(Memory::MemorySystem& memory) : impl(std::make_unique<Impl>(memory)) {}
+WMFDecoder::WMFDecoder() : impl(std::make_unique<Impl>()) {}
 
 WMFDecoder::~WMFDecoder() = default;
 
-std::optional<BinaryResponse> WMFDecoder::ProcessRequest(const BinaryRequest& request) {
-    return impl->ProcessRequest(request);
+std::optional<BinaryResponse> WMFDecoder::ProcessRequest(const BinaryRequest& request,
+                                                         DecoderBuffers& buffers) {
+    return impl->ProcessRequest(request, buffers);
 }
 
 } // namespace AudioCore::HLE
@@ -10,9 +10,10 @@ namespace AudioCore::HLE {
 
 class WMFDecoder final : public DecoderBase {
 public:
-    explicit WMFDecoder(Memory::MemorySystem& memory);
+    WMFDecoder();
     ~WMFDecoder() override;
-    std::optional<BinaryResponse> ProcessRequest(const BinaryRequest& request) override;
+    std::optional<BinaryResponse> ProcessRequest(const BinaryRequest& request,
+                                                 DecoderBuffers& buffers) override;
 
 private:
     class Impl;
@@ -3,73 +3,174 @@
 // Refer to the license.txt file included.
 
 #include <algorithm>
+#include <cstring>
+#ifdef ARCHITECTURE_x86_64
+#include <emmintrin.h>
+#endif
 #include "audio_core/interpolate.h"
 #include "common/assert.h"
 
 namespace AudioCore::AudioInterp {
 
+using Sample = StereoBuffer16::Sample;
+
 // Calculations are done in fixed point with 24 fractional bits.
 // (This is not verified. This was chosen for minimal error.)
 constexpr u64 scale_factor = 1 << 24;
 constexpr u64 scale_mask = scale_factor - 1;
 
 /// Here we step over the input in steps of rate, until we consume all of the input.
-/// Three adjacent samples are passed to fn each step.
-template <typename Function>
+/// The number of output samples that can be produced is determined up front, then kernel is
+/// invoked once for the whole run as kernel(samples, fposition, step_size, output, count). The
+/// input passed to kernel is preceded by the two history samples.
+template <typename Kernel>
 static void StepOverSamples(State& state, StereoBuffer16& input, float rate, StereoFrame16& output,
-                            std::size_t& outputi, Function fn) {
+                            std::size_t& outputi, Kernel kernel) {
     ASSERT(rate > 0);
 
-    if (input.empty())
+    if (input.Empty())
         return;
 
-    input.insert(input.begin(), {state.xn2, state.xn1});
+    // The buffer reserves room for the history in front of the unread input.
+    Sample* const samples = input.Data() - 2;
+    samples[0] = state.xn2;
+    samples[1] = state.xn1;
 
     const u64 step_size = static_cast<u64>(rate * scale_factor);
-    u64 fposition = state.fposition;
-    std::size_t inputi = 0;
-
-    while (outputi < output.size()) {
-        inputi = static_cast<std::size_t>(fposition / scale_factor);
-
-        if (inputi + 2 >= input.size()) {
-            inputi = input.size() - 2;
-            break;
-        }
+    const u64 fposition = state.fposition;
+    const u64 input_end = input.Size() * scale_factor;
+    const std::size_t output_remaining = output.size() - outputi;
+
+    // An output sample at fposition needs the input samples up to fposition / scale_factor + 2.
+    std::size_t count = 0;
+    if (fposition < input_end) {
+        count = step_size == 0
+                    ? output_remaining
+                    : static_cast<std::size_t>(std::min<u64>(
+                          output_remaining, (input_end - fposition + step_size - 1) / step_size));
+    }
 
-        u64 fraction = fposition & scale_mask;
-        output[outputi++] = fn(fraction, input[inputi], input[inputi + 1], input[inputi + 2]);
+    kernel(samples, fposition, step_size, &output[outputi], count);
+    outputi += count;
 
-        fposition += step_size;
+    // If we ran out of input everything has been consumed, otherwise we stop at the input sample
+    // used by the last output sample.
+    std::size_t inputi = 0;
+    if (count < output_remaining) {
+        inputi = input.Size();
+    } else if (count != 0) {
+        inputi = static_cast<std::size_t>((fposition + (count - 1) * step_size) / scale_factor);
     }
 
-    state.xn2 = input[inputi];
-    state.xn1 = input[inputi + 1];
-    state.fposition = fposition - inputi * scale_factor;
+    state.xn2 = samples[inputi];
+    state.xn1 = samples[inputi + 1];
+    state.fposition = fposition + count * step_size - inputi * scale_factor;
 
-    input.erase(input.begin(), std::next(input.begin(), inputi + 2));
+    input.Pop(inputi);
 }
 
 void None(State& state, StereoBuffer16& input, float rate, StereoFrame16& output,
           std::size_t& outputi) {
-    StepOverSamples(
-        state, input, rate, output, outputi,
-        [](u64 fraction, const auto& x0, const auto& x1, const auto& x2) { return x0; });
+    StepOverSamples(state, input, rate, output, outputi,
+                    [](const Sample* samples, u64 fposition, u64 step_size, Sample* out,
+                       std::size_t count) {
+                        for (std::size_t i = 0; i < count; i++, fposition += step_size) {
+                            out[i] = samples[fposition / scale_factor];
+                        }
+                    });
+}
+
+static Sample LinearSample(u64 fraction, const Sample& x0, const Sample& x1) {
+    // This is a saturated subtraction. (Verified by black-box fuzzing.)
+    s64 delta0 = std::clamp<s64>(x1[0] - x0[0], -32768, 32767);
+    s64 delta1 = std::clamp<s64>(x1[1] - x0[1], -32768, 32767);
+
+    return Sample{
+        static_cast<s16>(x0[0] + fraction * delta0 / scale_factor),
+        static_cast<s16>(x0[1] + fraction * delta1 / scale_factor),
+    };
+}
+
+#ifdef ARCHITECTURE_x86_64
+static __m128i LoadSamples(const Sample* samples, const std::array<std::size_t, 4>& indices) {
+    std::array<s32, 4> raw;
+    for (std::size_t i = 0; i < 4; i++) {
+        std::memcpy(&raw[i], &samples[indices[i]], sizeof(Sample));
+    }
+    return _mm_setr_epi32(raw[0], raw[1], raw[2], raw[3]);
+}
+
+/// Returns the full 32-bit products of the low four or high four s16 lanes of a and b.
+static __m128i MultiplyLo(__m128i a, __m128i b) {
+    return _mm_unpacklo_epi16(_mm_mullo_epi16(a, b), _mm_mulhi_epi16(a, b));
+}
+static __m128i MultiplyHi(__m128i a, __m128i b) {
+    return _mm_unpackhi_epi16(_mm_mullo_epi16(a, b), _mm_mulhi_epi16(a, b));
+}
+
+/**
+ * Produces four linearly interpolated stereo samples at once.
+ *
+ * The scalar path computes floor(fraction * delta / 2^24) with a 24-bit fraction. Splitting the
+ * fraction into two 12-bit halves keeps every intermediate product within 32 bits:
+ *     floor((fh * 2^12 + fl) * d / 2^24) == (fh * d + ((fl * d) >> 12)) >> 12
+ * so the result is bit-identical to LinearSample.
+ */
+static std::size_t LinearSSE2(const Sample* samples, u64& fposition, u64 step_size, Sample* out,
+                              std::size_t count) {
+    const __m128i low_mask = _mm_set1_epi32(0xFFF);
+
+    std::size_t i = 0;
+    for (; i + 4 <= count; i += 4) {
+        std::array<std::size_t, 4> indices;
+        std::array<std::size_t, 4> next_indices;
+        std::array<s32, 4> fractions;
+        for (std::size_t j = 0; j < 4; j++, fposition += step_size) {
+            indices[j] = static_cast<std::size_t>(fposition / scale_factor);
+            next_indices[j] = indices[j] + 1;
+            fractions[j] = static_cast<s32>(fposition & scale_mask);
+        }
+
+        const __m128i x0 = LoadSamples(samples, indices);
+        const __m128i x1 = LoadSamples(samples, next_indices);
+        const __m128i delta = _mm_subs_epi16(x1, x0);
+
+        // Broadcast each fraction half to both channels of its sample.
+        const __m128i fraction =
+            _mm_setr_epi32(fractions[0], fractions[1], fractions[2], fractions[3]);
+        __m128i fh = _mm_srli_epi32(fraction, 12);
+        __m128i fl = _mm_and_si128(fraction, low_mask);
+        fh = _mm_or_si128(fh, _mm_slli_epi32(fh, 16));
+        fl = _mm_or_si128(fl, _mm_slli_epi32(fl, 16));
+
+        const __m128i lo = _mm_srai_epi32(
+            _mm_add_epi32(MultiplyLo(fh, delta), _mm_srai_epi32(MultiplyLo(fl, delta), 12)), 12);
+        const __m128i hi = _mm_srai_epi32(
+            _mm_add_epi32(MultiplyHi(fh, delta), _mm_srai_epi32(MultiplyHi(fl, delta), 12)), 12);
+
+        const __m128i result = _mm_add_epi16(x0, _mm_packs_epi32(lo, hi));
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(out + i), result);
+    }
+    return i;
 }
+#endif
 
 void Linear(State& state, StereoBuffer16& input, float rate, StereoFrame16& output,
             std::size_t& outputi) {
     // Note on accuracy: Some values that this produces are +/- 1 from the actual firmware.
     StepOverSamples(state, input, rate, output, outputi,
-                    [](u64 fraction, const auto& x0, const auto& x1, const auto& x2) {
-                        // This is a saturated subtraction. (Verified by black-box fuzzing.)
-                        s64 delta0 = std::clamp<s64>(x1[0] - x0[0], -32768, 32767);
-                        s64 delta1 = std::clamp<s64>(x1[1] - x0[1], -32768, 32767);
-
-                        return std::array<s16, 2>{
-                            static_cast<s16>(x0[0] + fraction * delta0 / scale_factor),
-                            static_cast<s16>(x0[1] + fraction * delta1 / scale_factor),
-                        };
+                    [](const Sample* samples, u64 fposition, u64 step_size, Sample* out,
+                       std::size_t count) {
+                        std::size_t i = 0;
+#ifdef ARCHITECTURE_x86_64
+                        i = LinearSSE2(samples, fposition, step_size, out, count);
+#endif
+                        for (; i < count; i++, fposition += step_size) {
+                            const std::size_t inputi =
+                                static_cast<std::size_t>(fposition / scale_factor);
+                            out[i] = LinearSample(fposition & scale_mask, samples[inputi],
+                                                  samples[inputi + 1]);
+                        }
                     });
 }
 
@@ -0,0 +1,100 @@
+// Copyright 2020 Citra Emulator Project
+// Licensed under GPLv2 or any later version
+// Refer to the license.txt file included.
+
+#include <catch2/catch.hpp>
+
+#include <cmath>
+#include <cstring>
+#include "audio_core/hle/hle.h"
+#include "audio_core/hle/shared_memory.h"
+#include "core/core_timing.h"
+#include "core/memory.h"
+
+using Configuration = AudioCore::HLE::SourceConfiguration::Configuration;
+
+/// Starts every source playing a looping embedded PCM16 stereo buffer
+static void SetupSources(AudioCore::HLE::SharedMemory& region, Configuration::Format format,
+                         Configuration::InterpolationMode interpolation) {
+    for (std::size_t i = 0; i < AudioCore::HLE::num_sources; ++i) {
+        Configuration& config = region.source_configurations.config[i];
+        config.enable = 1;
+        config.enable_dirty.Assign(1);
+        config.rate_multiplier = 1.0f + 0.01f * i;
+        config.rate_multiplier_dirty.Assign(1);
+        config.interpolation_mode = interpolation;
+        config.interpolation_dirty.Assign(1);
+        for (std::size_t mix = 0; mix < 3; ++mix) {
+            for (std::size_t channel = 0; channel < 4; ++channel) {
+                config.gain[mix][channel] = mix == 0 ? 0.5f : 0.0f;
+            }
+        }
+        config.gain_0_dirty.Assign(1);
+
+        config.physical_address = Memory::FCRAM_PADDR + static_cast<u32>(i) * 0x10000;
+        config.length = 0x2000;
+        config.mono_or_stereo.Assign(Configuration::MonoOrStereo::Stereo);
+        config.format.Assign(format);
+        config.is_looping.Assign(1);
+        config.buffer_id = 1;
+        config.play_position = 0;
+        config.play_position_dirty.Assign(1);
+        config.embedded_buffer_dirty.Assign(1);
+    }
+
+    region.dsp_configuration.volume[0] = 1.0f;
+    region.dsp_configuration.volume_0_dirty.Assign(1);
+}
+
+TEST_CASE("DspHle", "[benchmark][audio_core]") {
+    constexpr u64 audio_frame_ticks = 1310252ull; // Copied from DspHle internals
+
+    Core::Timing timing;
+    Memory::MemorySystem memory;
+    AudioCore::DspHle dsp(memory, timing);
+
+    // Fill the source buffers with a sine wave so that the mixing work isn't trivially zero
+    u8* fcram = memory.GetPhysicalPointer(Memory::FCRAM_PADDR);
+    for (u32 i = 0; i < AudioCore::HLE::num_sources * 0x10000 / sizeof(s16); ++i) {
+        const s16 sample = static_cast<s16>(std::sin(i * 0.05) * 0x3000);
+        std::memcpy(fcram + i * sizeof(s16), &sample, sizeof(s16));
+    }
+
+    auto& dsp_memory = dsp.GetDspMemory();
+    auto& region_0 = *reinterpret_cast<AudioCore::HLE::SharedMemory*>(
+        dsp_memory.data() + AudioCore::HLE::region0_offset);
+    auto& region_1 = *reinterpret_cast<AudioCore::HLE::SharedMemory*>(
+        dsp_memory.data() + AudioCore::HLE::region1_offset);
+
+    timing.Advance();
+
+    // Runs the emulated timeline forward by one audio frame, which makes the DSP generate it
+    const auto generate_frame = [&] {
+        timing.AddTicks(audio_frame_ticks);
+        timing.Advance();
+    };
+
+    SECTION("PCM16, polyphase") {
+        SetupSources(region_0, Configuration::Format::PCM16,
+                     Configuration::InterpolationMode::Polyphase);
+        SetupSources(region_1, Configuration::Format::PCM16,
+                     Configuration::InterpolationMode::Polyphase);
+        generate_frame();
+
+        BENCHMARK("GenerateCurrentFrame 24 sources PCM16 polyphase") {
+            generate_frame();
+        };
+    }
+
+    SECTION("ADPCM, linear") {
+        SetupSources(region_0, Configuration::Format::ADPCM,
+                     Configuration::InterpolationMode::Linear);
+        SetupSources(region_1, Configuration::Format::ADPCM,
+                     Configuration::InterpolationMode::Linear);
+        generate_frame();
+
+        BENCHMARK("GenerateCurrentFrame 24 sources ADPCM linear") {
+            generate_frame();
+        };
+    }
+}
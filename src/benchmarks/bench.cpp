@@ -0,0 +1,11 @@
+// Copyright 2020 Citra Emulator Project
+// Licensed under GPLv2 or any later version
+// Refer to the license.txt file included.
+
+#define CATCH_CONFIG_MAIN
+#include <catch2/catch.hpp>
+
+// Catch provides the main function since we've given it the
+// CATCH_CONFIG_MAIN preprocessor directive. Benchmarking support is enabled for the whole target
+// through CATCH_CONFIG_ENABLE_BENCHMARKING, and results can be written in a machine-readable form
+// with the usual reporters, e.g. `citra-bench -r xml -o results.xml`.
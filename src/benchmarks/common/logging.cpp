@@ -0,0 +1,27 @@
+// Copyright 2020 Citra Emulator Project
+// Licensed under GPLv2 or any later version
+// Refer to the license.txt file included.
+
+#include <string>
+#include <catch2/catch.hpp>
+#include "common/common_types.h"
+#include "common/logging/log.h"
+
+namespace Log {
+
+TEST_CASE("Logging", "[benchmark][common]") {
+    const std::string name = "gsp::Gpu";
+    const u32 address = 0x1EF00000;
+    const u32 size = 0x100;
+
+    BENCHMARK("Formatted on the calling thread") {
+        FmtLogMessage(Class::Service_GSP, Level::Info, "core/hle/service/gsp/gsp_gpu.cpp", 1,
+                      "WriteHWRegs", "{} write of {} bytes to {:08X}", name, size, address);
+    };
+
+    BENCHMARK("Formatted on the logging thread") {
+        LOG_INFO(Service_GSP, "{} write of {} bytes to {:08X}", name, size, address);
+    };
+}
+
+} // namespace Log
@@ -0,0 +1,54 @@
+// Copyright 2020 Citra Emulator Project
+// Licensed under GPLv2 or any later version
+// Refer to the license.txt file included.
+
+#include <string>
+#include <thread>
+#include <vector>
+#include <catch2/catch.hpp>
+#include "common/common_types.h"
+#include "common/threadsafe_queue.h"
+
+namespace Common {
+
+constexpr std::size_t ELEMENTS_PER_PRODUCER = 10000;
+
+/// Pushes from the given number of producer threads while the calling thread consumes everything
+template <typename Queue>
+static u64 PushFromThreads(Queue& queue, std::size_t producers) {
+    std::vector<std::thread> threads;
+    for (std::size_t i = 0; i < producers; ++i) {
+        threads.emplace_back([&queue] {
+            for (u64 j = 0; j < ELEMENTS_PER_PRODUCER; ++j) {
+                queue.Push(j);
+            }
+        });
+    }
+
+    u64 sum = 0;
+    for (std::size_t i = 0; i < producers * ELEMENTS_PER_PRODUCER; ++i) {
+        sum += queue.PopWait();
+    }
+    for (auto& thread : threads) {
+        thread.join();
+    }
+    return sum;
+}
+
+TEST_CASE("MPSCQueue contention", "[benchmark][common]") {
+    for (const std::size_t producers : {1, 2, 4, 8}) {
+        const std::string suffix = ", " + std::to_string(producers) + " producers";
+
+        BENCHMARK("MPSCQueue" + suffix) {
+            MPSCQueue<u64> queue;
+            return PushFromThreads(queue, producers);
+        };
+
+        BENCHMARK("BoundedMPSCQueue" + suffix) {
+            BoundedMPSCQueue<u64, 1024> queue;
+            return PushFromThreads(queue, producers);
+        };
+    }
+}
+
+} // namespace Common
@@ -0,0 +1,79 @@
+// Copyright 2020 Citra Emulator Project
+// Licensed under GPLv2 or any later version
+// Refer to the license.txt file included.
+
+#include <catch2/catch.hpp>
+
+#include <memory>
+#include <string>
+#include <vector>
+#include <fmt/format.h>
+#include "core/arm/dyncom/arm_dyncom.h"
+#include "core/cheats/gateway_cheat.h"
+#include "core/core.h"
+#include "core/core_timing.h"
+#include "core/hle/kernel/process.h"
+#include "core/memory.h"
+
+namespace {
+/// Builds a code of the shapes found in cheat databases: a guarded write, an unrolled patch, and a
+/// loop filling a table through the offset register.
+std::string MakeCheatCode(u32 index) {
+    const u32 address = Memory::HEAP_VADDR + index * 0x100;
+    std::string code;
+    switch (index % 3) {
+    case 0:
+        code += fmt::format("5{:07X} 00000000\n", address);
+        code += fmt::format("0{:07X} 0000270F\n", address + 0x10);
+        code += fmt::format("1{:07X} 000003E7\n", address + 0x14);
+        code += "D0000000 00000000\n";
+        break;
+    case 1:
+        code += fmt::format("E{:07X} 00000014\n", address);
+        code += "01234567 89ABCDEF\n";
+        code += "01234567 89ABCDEF\n";
+        code += "01234567 00000000\n";
+        break;
+    case 2:
+        code += fmt::format("D3000000 {:08X}\n", address);
+        code += "D5000000 00000063\n";
+        code += "C0000000 0000000F\n";
+        code += "D6000000 00000000\n";
+        code += "D2000000 00000000\n";
+        break;
+    }
+    return code;
+}
+} // Anonymous namespace
+
+TEST_CASE("GatewayCheat", "[benchmark][core][cheats]") {
+    constexpr u32 heap_size = 0x100000;
+    constexpr u32 num_cheats = 300;
+
+    Core::Timing timing;
+    Memory::MemorySystem memory;
+    Kernel::KernelSystem kernel(memory, timing, [] {}, 0);
+    auto process = kernel.CreateProcess(kernel.CreateCodeSet("", 0));
+
+    std::vector<u8> heap(heap_size);
+    REQUIRE(process->vm_manager
+                .MapBackingMemory(Memory::HEAP_VADDR, heap.data(), heap_size,
+                                  Kernel::MemoryState::Private)
+                .Succeeded());
+    memory.SetCurrentPageTable(&process->vm_manager.page_table);
+
+    ARM_DynCom cpu(nullptr, memory, USER32MODE);
+
+    std::vector<std::unique_ptr<Cheats::GatewayCheat>> cheats;
+    for (u32 i = 0; i < num_cheats; ++i) {
+        cheats.push_back(std::make_unique<Cheats::GatewayCheat>(fmt::format("Cheat {}", i),
+                                                                MakeCheatCode(i), ""));
+    }
+
+    BENCHMARK("Execute 300 codes") {
+        for (const auto& cheat : cheats) {
+            cheat->Execute(memory, cpu, 0);
+        }
+        return heap[0x10];
+    };
+}
@@ -0,0 +1,84 @@
+// Copyright 2020 Citra Emulator Project
+// Licensed under GPLv2 or any later version
+// Refer to the license.txt file included.
+
+#include <catch2/catch.hpp>
+
+#include <array>
+#include <string>
+#include "core/core_timing.h"
+
+static u64 callbacks_ran = 0;
+
+static void Callback(u64 userdata, s64 cycles_late) {
+    ++callbacks_ran;
+}
+
+TEST_CASE("CoreTiming", "[benchmark][core]") {
+    Core::Timing timing;
+    std::array<Core::TimingEventType*, 8> event_types;
+    for (std::size_t i = 0; i < event_types.size(); ++i) {
+        event_types[i] = timing.RegisterEvent("event" + std::to_string(i), Callback);
+    }
+    timing.Advance();
+
+    BENCHMARK("ScheduleEvent/UnscheduleEvent x1000") {
+        for (u64 i = 0; i < 1000; ++i) {
+            timing.ScheduleEvent(1000 + (i * 7919) % 50000, event_types[i % event_types.size()],
+                                 i);
+        }
+        for (u64 i = 0; i < 1000; ++i) {
+            timing.UnscheduleEvent(event_types[i % event_types.size()], i);
+        }
+    };
+
+    BENCHMARK("ScheduleEvent/Advance x1000") {
+        callbacks_ran = 0;
+        for (u64 i = 0; i < 1000; ++i) {
+            timing.ScheduleEvent(1 + (i * 7919) % 50000, event_types[i % event_types.size()], i);
+        }
+        while (callbacks_ran < 1000) {
+            timing.AddTicks(timing.GetDowncount());
+            timing.Advance();
+        }
+        return callbacks_ran;
+    };
+
+    BENCHMARK("Advance with one recurring event x1000") {
+        callbacks_ran = 0;
+        for (int i = 0; i < 1000; ++i) {
+            timing.ScheduleEvent(100, event_types[0]);
+            timing.AddTicks(timing.GetDowncount());
+            timing.Advance();
+        }
+        return callbacks_ran;
+    };
+
+    // Keep a backlog of far-off events, like a game with many threads sleeping and timers armed
+    for (u64 i = 0; i < 10000; ++i) {
+        timing.ScheduleEvent((s64{1} << 40) + i, event_types[i % event_types.size()], 1000 + i);
+    }
+
+    BENCHMARK("ScheduleEvent/UnscheduleEvent x1000, 10000 pending") {
+        for (u64 i = 0; i < 1000; ++i) {
+            timing.ScheduleEvent(1000 + (i * 7919) % 50000, event_types[i % event_types.size()],
+                                 i);
+        }
+        for (u64 i = 0; i < 1000; ++i) {
+            timing.UnscheduleEvent(event_types[i % event_types.size()], i);
+        }
+    };
+
+    BENCHMARK("ScheduleEventThreadsafe/Advance x1000, 10000 pending") {
+        callbacks_ran = 0;
+        for (u64 i = 0; i < 1000; ++i) {
+            timing.ScheduleEventThreadsafe(1 + (i * 7919) % 50000,
+                                           event_types[i % event_types.size()], i);
+        }
+        while (callbacks_ran < 1000) {
+            timing.AddTicks(timing.GetDowncount());
+            timing.Advance();
+        }
+        return callbacks_ran;
+    };
+}
@@ -0,0 +1,52 @@
+// Copyright 2020 Citra Emulator Project
+// Licensed under GPLv2 or any later version
+// Refer to the license.txt file included.
+
+#include <catch2/catch.hpp>
+#include "core/core.h"
+#include "core/core_timing.h"
+#include "core/hle/ipc.h"
+#include "core/hle/kernel/event.h"
+#include "core/hle/kernel/handle_table.h"
+#include "core/hle/kernel/hle_ipc.h"
+#include "core/hle/kernel/process.h"
+#include "core/hle/kernel/server_session.h"
+
+namespace Kernel {
+
+TEST_CASE("HLERequestContext", "[benchmark][core][kernel]") {
+    Core::Timing timing;
+    Memory::MemorySystem memory;
+    Kernel::KernelSystem kernel(memory, timing, [] {}, 0);
+    auto [server, client] = kernel.CreateSessionPair();
+    HLERequestContext context(kernel, std::move(server), nullptr);
+
+    auto process = kernel.CreateProcess(kernel.CreateCodeSet("", 0));
+    auto event = kernel.CreateEvent(ResetType::OneShot);
+    const Handle event_handle = process->handle_table.Create(event).Unwrap();
+
+    u32_le output[IPC::COMMAND_BUFFER_LENGTH];
+
+    BENCHMARK("Translate regular params") {
+        const u32_le input[]{
+            IPC::MakeHeader(0x1234, 6, 0), 1, 2, 3, 4, 5, 6,
+        };
+        context.PopulateFromIncomingCommandBuffer(input, *process);
+        context.WriteToOutgoingCommandBuffer(output, *process);
+        return output[0];
+    };
+
+    BENCHMARK("Translate copy handles") {
+        const u32_le input[]{
+            IPC::MakeHeader(0x1234, 2, 4), 1, 2, IPC::CopyHandleDesc(1), event_handle,
+            IPC::CallingPidDesc(), 0,
+        };
+        context.PopulateFromIncomingCommandBuffer(input, *process);
+        context.WriteToOutgoingCommandBuffer(output, *process);
+        // Drop the handle created in the process by the outgoing translation
+        process->handle_table.Close(output[4]);
+        return output[0];
+    };
+}
+
+} // namespace Kernel
@@ -0,0 +1,92 @@
+// Copyright 2020 Citra Emulator Project
+// Licensed under GPLv2 or any later version
+// Refer to the license.txt file included.
+
+#include <array>
+#include <string>
+#include <vector>
+#include <catch2/catch.hpp>
+#include "core/arm/dyncom/arm_dyncom.h"
+#include "core/core.h"
+#include "core/core_timing.h"
+#include "core/hle/ipc.h"
+#include "core/hle/kernel/ipc.h"
+#include "core/hle/kernel/memory.h"
+#include "core/hle/kernel/process.h"
+#include "core/hle/kernel/thread.h"
+#include "core/memory.h"
+
+namespace Kernel {
+
+constexpr u32 HEAP_SIZE = 0x200000;
+
+TEST_CASE("TranslateCommandBuffer MappedBuffer", "[benchmark][core][kernel]") {
+    Core::Timing timing;
+    Memory::MemorySystem memory;
+    Kernel::KernelSystem kernel(memory, timing, [] {}, 0);
+    kernel.SetCPU(std::make_shared<ARM_DynCom>(nullptr, memory, USER32MODE));
+
+    auto client = kernel.CreateProcess(kernel.CreateCodeSet("", 0));
+    auto server = kernel.CreateProcess(kernel.CreateCodeSet("", 0));
+    auto client_thread = kernel
+                             .CreateThread("", Memory::HEAP_VADDR, ThreadPrioLowest, 0,
+                                           ThreadProcessorId0, Memory::HEAP_VADDR, *client)
+                             .Unwrap();
+    auto server_thread = kernel
+                             .CreateThread("", Memory::HEAP_VADDR, ThreadPrioLowest, 0,
+                                           ThreadProcessorId0, Memory::HEAP_VADDR, *server)
+                             .Unwrap();
+
+    // Client buffers in FCRAM are aliased, those in host memory take the copying path
+    const auto offset =
+        kernel.GetMemoryRegion(MemoryRegion::APPLICATION)->LinearAllocate(HEAP_SIZE);
+    client->vm_manager.MapBackingMemory(Memory::HEAP_VADDR, memory.GetFCRAMPointer(*offset),
+                                        HEAP_SIZE, MemoryState::Private);
+    const VAddr host_buffer_address = Memory::HEAP_VADDR + HEAP_SIZE;
+    std::vector<u8> host_buffer(HEAP_SIZE);
+    client->vm_manager.MapBackingMemory(host_buffer_address, host_buffer.data(), HEAP_SIZE,
+                                        MemoryState::Private);
+
+    const VAddr client_cmdbuf = client_thread->GetCommandBufferAddress();
+    const VAddr server_cmdbuf = server_thread->GetCommandBufferAddress();
+    std::vector<MappedBufferContext> mapped_buffer_context;
+
+    const auto round_trip = [&](VAddr source_address, u32 size) {
+        const u32_le request[]{
+            IPC::MakeHeader(1, 0, 2),
+            IPC::MappedBufferDesc(size, IPC::MappedBufferPermissions::RW),
+            source_address,
+        };
+        memory.WriteBlock(*client, client_cmdbuf, request, sizeof(request));
+        TranslateCommandBuffer(kernel, memory, client_thread, server_thread, client_cmdbuf,
+                               server_cmdbuf, mapped_buffer_context, false);
+
+        std::array<u32_le, 3> translated;
+        memory.ReadBlock(*server, server_cmdbuf, translated.data(), sizeof(translated));
+
+        const u32_le reply[]{
+            IPC::MakeHeader(1, 1, 2),
+            RESULT_SUCCESS.raw,
+            IPC::MappedBufferDesc(size, IPC::MappedBufferPermissions::RW),
+            translated[2],
+        };
+        memory.WriteBlock(*server, server_cmdbuf, reply, sizeof(reply));
+        TranslateCommandBuffer(kernel, memory, server_thread, client_thread, server_cmdbuf,
+                               client_cmdbuf, mapped_buffer_context, true);
+        return translated[2];
+    };
+
+    for (const u32 size : {0x1000u, 0x10000u, 0x100000u}) {
+        const std::string suffix = std::to_string(size / 1024) + " KiB";
+
+        BENCHMARK("Round trip, aliased " + suffix) {
+            return round_trip(Memory::HEAP_VADDR, size);
+        };
+
+        BENCHMARK("Round trip, copied " + suffix) {
+            return round_trip(host_buffer_address, size);
+        };
+    }
+}
+
+} // namespace Kernel
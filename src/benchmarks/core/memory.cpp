@@ -0,0 +1,51 @@
+// Copyright 2020 Citra Emulator Project
+// Licensed under GPLv2 or any later version
+// Refer to the license.txt file included.
+
+#include <catch2/catch.hpp>
+
+#include <vector>
+#include "core/core.h"
+#include "core/core_timing.h"
+#include "core/hle/kernel/process.h"
+#include "core/memory.h"
+
+TEST_CASE("MemorySystem", "[benchmark][core][memory]") {
+    constexpr u32 heap_size = 0x100000;
+
+    Core::Timing timing;
+    Memory::MemorySystem memory;
+    Kernel::KernelSystem kernel(memory, timing, [] {}, 0);
+    auto process = kernel.CreateProcess(kernel.CreateCodeSet("", 0));
+
+    std::vector<u8> heap(heap_size);
+    REQUIRE(process->vm_manager
+                .MapBackingMemory(Memory::HEAP_VADDR, heap.data(), heap_size,
+                                  Kernel::MemoryState::Private)
+                .Succeeded());
+    memory.SetCurrentPageTable(&process->vm_manager.page_table);
+
+    std::vector<u8> block(heap_size);
+
+    BENCHMARK("Read32 x4096") {
+        u32 sum = 0;
+        for (u32 offset = 0; offset < 4096 * 4; offset += 4) {
+            sum += memory.Read32(Memory::HEAP_VADDR + offset);
+        }
+        return sum;
+    };
+
+    BENCHMARK("Write32 x4096") {
+        for (u32 offset = 0; offset < 4096 * 4; offset += 4) {
+            memory.Write32(Memory::HEAP_VADDR + offset, offset);
+        }
+    };
+
+    BENCHMARK("ReadBlock 4KiB") {
+        memory.ReadBlock(*process, Memory::HEAP_VADDR + 0x10, block.data(), 0x1000);
+    };
+
+    BENCHMARK("ReadBlock 1MiB") {
+        memory.ReadBlock(*process, Memory::HEAP_VADDR, block.data(), heap_size);
+    };
+}
@@ -0,0 +1,51 @@
+// Copyright 2020 Citra Emulator Project
+// Licensed under GPLv2 or any later version
+// Refer to the license.txt file included.
+
+#include <memory>
+#include <vector>
+#include <catch2/catch.hpp>
+#include "core/hle/kernel/vm_manager.h"
+#include "core/memory.h"
+
+TEST_CASE("VMManager", "[benchmark][core][memory]") {
+    constexpr u32 PAGE_COUNT = 256;
+    Memory::MemorySystem memory;
+    // Because of the PageTable, Kernel::VMManager is too big to be created on the stack.
+    auto manager = std::make_unique<Kernel::VMManager>(memory);
+    std::vector<u8> block(Memory::PAGE_SIZE * PAGE_COUNT);
+
+    BENCHMARK("Map and unmap a single area") {
+        manager->MapBackingMemory(Memory::HEAP_VADDR, block.data(),
+                                  static_cast<u32>(block.size()), Kernel::MemoryState::Private);
+        return manager->UnmapRange(Memory::HEAP_VADDR, static_cast<u32>(block.size()));
+    };
+
+    BENCHMARK("Map page by page and unmap at once") {
+        for (u32 i = 0; i < PAGE_COUNT; ++i) {
+            // Alternate the state so that adjacent pages are not merged
+            manager->MapBackingMemory(Memory::HEAP_VADDR + i * Memory::PAGE_SIZE,
+                                      block.data() + i * Memory::PAGE_SIZE, Memory::PAGE_SIZE,
+                                      i % 2 ? Kernel::MemoryState::Private
+                                            : Kernel::MemoryState::Shared);
+        }
+        return manager->UnmapRange(Memory::HEAP_VADDR, static_cast<u32>(block.size()));
+    };
+
+    manager->MapBackingMemory(Memory::HEAP_VADDR, block.data(), static_cast<u32>(block.size()),
+                              Kernel::MemoryState::Private);
+
+    BENCHMARK("Reprotect every other page") {
+        for (u32 i = 0; i < PAGE_COUNT; i += 2) {
+            manager->ReprotectRange(Memory::HEAP_VADDR + i * Memory::PAGE_SIZE, Memory::PAGE_SIZE,
+                                    Kernel::VMAPermission::Read);
+        }
+        return manager->ReprotectRange(Memory::HEAP_VADDR, static_cast<u32>(block.size()),
+                                       Kernel::VMAPermission::ReadWrite);
+    };
+
+    BENCHMARK("GetBackingBlocksForRange") {
+        return manager->GetBackingBlocksForRange(Memory::HEAP_VADDR,
+                                                 static_cast<u32>(block.size()));
+    };
+}
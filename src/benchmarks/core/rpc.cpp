@@ -0,0 +1,104 @@
+// Copyright 2020 Citra Emulator Project
+// Licensed under GPLv2 or any later version
+// Refer to the license.txt file included.
+
+#include <catch2/catch.hpp>
+
+#include <array>
+#include <cstring>
+#include <vector>
+#include <boost/asio.hpp>
+#include "core/core_timing.h"
+#include "core/hle/kernel/process.h"
+#include "core/memory.h"
+#include "core/rpc/packet.h"
+#include "core/rpc/rpc_server.h"
+
+namespace {
+/// A scripting client on the same machine, talking to the server over the loopback interface
+class LocalClient {
+public:
+    LocalClient()
+        : socket(io_context, boost::asio::ip::udp::endpoint(boost::asio::ip::udp::v4(), 0)),
+          server_endpoint(boost::asio::ip::address_v4::loopback(), 45987) {}
+
+    std::size_t Request(RPC::PacketType type, const std::vector<u8>& data) {
+        const RPC::PacketHeader header{RPC::CURRENT_VERSION, ++id, type,
+                                       static_cast<u32>(data.size())};
+        std::vector<u8> request(sizeof(header) + data.size());
+        std::memcpy(request.data(), &header, sizeof(header));
+        std::memcpy(request.data() + sizeof(header), data.data(), data.size());
+        socket.send_to(boost::asio::buffer(request), server_endpoint);
+        return socket.receive(boost::asio::buffer(reply)) - sizeof(header);
+    }
+
+private:
+    boost::asio::io_context io_context;
+    boost::asio::ip::udp::socket socket;
+    boost::asio::ip::udp::endpoint server_endpoint;
+    std::array<u8, RPC::MAX_PACKET_SIZE> reply;
+    u32 id = 0;
+};
+
+std::vector<u8> MakeRequestData(std::initializer_list<u32> words) {
+    std::vector<u8> data(words.size() * sizeof(u32));
+    std::memcpy(data.data(), words.begin(), data.size());
+    return data;
+}
+} // Anonymous namespace
+
+TEST_CASE("RPCServer", "[benchmark][core][rpc]") {
+    constexpr u32 heap_size = 0x100000;
+    constexpr u32 num_addresses = 256;
+    constexpr u32 address_stride = 0x100;
+
+    Core::Timing timing;
+    Memory::MemorySystem memory;
+    Kernel::KernelSystem kernel(memory, timing, [] {}, 0);
+    auto process = kernel.CreateProcess(kernel.CreateCodeSet("", 0));
+    kernel.SetCurrentProcess(process);
+
+    std::vector<u8> heap(heap_size);
+    REQUIRE(process->vm_manager
+                .MapBackingMemory(Memory::HEAP_VADDR, heap.data(), heap_size,
+                                  Kernel::MemoryState::Private)
+                .Succeeded());
+    memory.SetCurrentPageTable(&process->vm_manager.page_table);
+    const u32 needle = 0xC17A;
+    std::memcpy(heap.data() + heap_size / 2, &needle, sizeof(needle));
+
+    RPC::RPCServer server(memory, kernel, timing);
+    LocalClient client;
+
+    BENCHMARK("ReadMemory 256 addresses") {
+        std::size_t received = 0;
+        for (u32 i = 0; i < num_addresses; ++i) {
+            received += client.Request(RPC::PacketType::ReadMemory,
+                                       MakeRequestData({Memory::HEAP_VADDR + i * address_stride,
+                                                        sizeof(u32)}));
+        }
+        return received;
+    };
+
+    BENCHMARK("ReadMemoryBatch 256 addresses") {
+        constexpr u32 addresses_per_request = RPC::MAX_PACKET_DATA_SIZE / (sizeof(u32) * 2);
+        std::size_t received = 0;
+        for (u32 first = 0; first < num_addresses; first += addresses_per_request) {
+            std::vector<u8> data;
+            for (u32 i = first; i < first + addresses_per_request; ++i) {
+                const auto range =
+                    MakeRequestData({Memory::HEAP_VADDR + i * address_stride, sizeof(u32)});
+                data.insert(data.end(), range.begin(), range.end());
+            }
+            received += client.Request(RPC::PacketType::ReadMemoryBatch, data);
+        }
+        return received;
+    };
+
+    BENCHMARK("ScanMemory 1MiB") {
+        return client.Request(RPC::PacketType::ScanMemory,
+                              MakeRequestData({Memory::HEAP_VADDR, heap_size,
+                                               static_cast<u32>(RPC::ScanCompare::Equal),
+                                               sizeof(u32), needle}));
+    };
+}
@@ -0,0 +1,91 @@
+// Copyright 2020 Citra Emulator Project
+// Licensed under GPLv2 or any later version
+// Refer to the license.txt file included.
+
+#include <catch2/catch.hpp>
+
+#include <cstring>
+#include <memory>
+#include "core/frontend/emu_window.h"
+#include "core/hw/gpu.h"
+#include "core/hw/hw.h"
+#include "core/memory.h"
+#include "video_core/renderer_base.h"
+#include "video_core/video_core.h"
+
+namespace {
+
+class NullWindow final : public Frontend::EmuWindow {
+public:
+    void PollEvents() override {}
+    void MakeCurrent() override {}
+    void DoneCurrent() override {}
+};
+
+/// Renderer backed by the software rasterizer, so that no acceleration path is taken
+class NullRenderer final : public RendererBase {
+public:
+    explicit NullRenderer(Frontend::EmuWindow& window) : RendererBase(window) {}
+
+    Core::System::ResultStatus Init() override {
+        RefreshRasterizerSetting();
+        return Core::System::ResultStatus::Success;
+    }
+
+    void ShutDown() override {}
+    void SwapBuffers() override {}
+    void TryPresent(int timeout_ms) override {}
+    void PrepareVideoDumping() override {}
+    void CleanupVideoDumping() override {}
+};
+
+void TriggerDisplayTransfer() {
+    GPU::Write<u32>(HW::VADDR_GPU + GPU_REG_INDEX(display_transfer_config.trigger) * 4, 1);
+}
+
+} // Anonymous namespace
+
+TEST_CASE("DisplayTransfer", "[benchmark][video_core]") {
+    Memory::MemorySystem memory;
+    GPU::g_memory = &memory;
+
+    NullWindow window;
+    VideoCore::g_hw_renderer_enabled = false;
+    VideoCore::g_renderer = std::make_unique<NullRenderer>(window);
+    VideoCore::g_renderer->Init();
+
+    auto& config = GPU::g_regs.display_transfer_config;
+    std::memset(&config, 0, sizeof(config));
+    config.input_address = Memory::VRAM_PADDR >> 3;
+    config.output_address = Memory::FCRAM_PADDR >> 3;
+
+    SECTION("RGBA8 to RGB8, 240x400") {
+        config.input_width.Assign(240);
+        config.input_height.Assign(400);
+        config.output_width.Assign(240);
+        config.output_height.Assign(400);
+        config.input_format.Assign(GPU::Regs::PixelFormat::RGBA8);
+        config.output_format.Assign(GPU::Regs::PixelFormat::RGB8);
+
+        BENCHMARK("DisplayTransfer RGBA8 to RGB8 240x400") {
+            TriggerDisplayTransfer();
+        };
+    }
+
+    SECTION("RGBA8 to RGBA8, 480x800 downscaled") {
+        config.input_width.Assign(480);
+        config.input_height.Assign(800);
+        config.output_width.Assign(240);
+        config.output_height.Assign(400);
+        config.input_format.Assign(GPU::Regs::PixelFormat::RGBA8);
+        config.output_format.Assign(GPU::Regs::PixelFormat::RGBA8);
+        config.scaling.Assign(GPU::Regs::DisplayTransferConfig::ScaleXY);
+
+        BENCHMARK("DisplayTransfer RGBA8 to RGBA8 480x800 ScaleXY") {
+            TriggerDisplayTransfer();
+        };
+    }
+
+    VideoCore::g_renderer.reset();
+    GPU::g_memory = nullptr;
+}
@@ -0,0 +1,70 @@
+// Copyright 2020 Citra Emulator Project
+// Licensed under GPLv2 or any later version
+// Refer to the license.txt file included.
+
+#include <catch2/catch.hpp>
+
+#include <array>
+#include <memory>
+#include <string>
+#include <utility>
+#include "core/memory.h"
+#include "video_core/renderer_opengl/gl_rasterizer_cache.h"
+#include "video_core/video_core.h"
+
+using PixelFormat = OpenGL::SurfaceParams::PixelFormat;
+using SurfaceType = OpenGL::SurfaceParams::SurfaceType;
+
+static constexpr std::array<std::pair<PixelFormat, const char*>, 17> formats{{
+    {PixelFormat::RGBA8, "RGBA8"},
+    {PixelFormat::RGB8, "RGB8"},
+    {PixelFormat::RGB5A1, "RGB5A1"},
+    {PixelFormat::RGB565, "RGB565"},
+    {PixelFormat::RGBA4, "RGBA4"},
+    {PixelFormat::IA8, "IA8"},
+    {PixelFormat::RG8, "RG8"},
+    {PixelFormat::I8, "I8"},
+    {PixelFormat::A8, "A8"},
+    {PixelFormat::IA4, "IA4"},
+    {PixelFormat::I4, "I4"},
+    {PixelFormat::A4, "A4"},
+    {PixelFormat::ETC1, "ETC1"},
+    {PixelFormat::ETC1A4, "ETC1A4"},
+    {PixelFormat::D16, "D16"},
+    {PixelFormat::D24, "D24"},
+    {PixelFormat::D24S8, "D24S8"},
+}};
+
+// Surfaces are only ever loaded into and flushed from their staging buffer here, which is pure CPU
+// work, so no GL context is required.
+TEST_CASE("RasterizerCache", "[benchmark][video_core]") {
+    Memory::MemorySystem memory;
+    VideoCore::g_memory = &memory;
+
+    for (const auto& [format, name] : formats) {
+        auto surface = std::make_shared<OpenGL::CachedSurface>();
+        surface->addr = Memory::VRAM_PADDR;
+        surface->width = 256;
+        surface->height = 256;
+        surface->is_tiled = true;
+        surface->pixel_format = format;
+        surface->UpdateParams();
+        surface->LoadGLBuffer(surface->addr, surface->end);
+
+        if (surface->type == SurfaceType::Texture) {
+            // Texture-only formats are decoded texel by texel through LookupTexture
+            BENCHMARK("LookupTexture " + std::string(name) + " 256x256") {
+                surface->LoadGLBuffer(surface->addr, surface->end);
+            };
+        } else {
+            BENCHMARK("MortonCopy " + std::string(name) + " 256x256 morton to gl") {
+                surface->LoadGLBuffer(surface->addr, surface->end);
+            };
+            BENCHMARK("MortonCopy " + std::string(name) + " 256x256 gl to morton") {
+                surface->FlushGLBuffer(surface->addr, surface->end);
+            };
+        }
+    }
+
+    VideoCore::g_memory = nullptr;
+}
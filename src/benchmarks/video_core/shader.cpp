@@ -0,0 +1,100 @@
+// Copyright 2020 Citra Emulator Project
+// Licensed under GPLv2 or any later version
+// Refer to the license.txt file included.
+
+#include <catch2/catch.hpp>
+
+#include <algorithm>
+#include <memory>
+#include <nihstro/inline_assembly.h>
+#include "video_core/shader/shader.h"
+#include "video_core/shader/shader_interpreter.h"
+#ifdef ARCHITECTURE_x86_64
+#include "video_core/shader/shader_jit_x64.h"
+#endif
+
+using float24 = Pica::float24;
+
+using DestRegister = nihstro::DestRegister;
+using OpCode = nihstro::OpCode;
+using SourceRegister = nihstro::SourceRegister;
+
+/// Sets up a vertex shader resembling a typical transform: a 4x4 matrix multiplication of the
+/// position plus some per-vertex lighting style arithmetic.
+static void LoadTransformShader(Pica::Shader::ShaderSetup& setup) {
+    const auto v0 = SourceRegister::MakeInput(0);
+    const auto v1 = SourceRegister::MakeInput(1);
+    const auto t0 = SourceRegister::MakeTemporary(0);
+    const auto t1 = SourceRegister::MakeTemporary(1);
+    const auto t0_dest = DestRegister::MakeTemporary(0);
+    const auto t1_dest = DestRegister::MakeTemporary(1);
+    const auto o0 = DestRegister::MakeOutput(0);
+    const auto o1 = DestRegister::MakeOutput(1);
+
+    const auto shbin = nihstro::InlineAsm::CompileToRawBinary({
+        // clang-format off
+        {OpCode::Id::DP4, t0_dest, v0, SourceRegister::MakeFloat(0)},
+        {OpCode::Id::DP4, t1_dest, v0, SourceRegister::MakeFloat(1)},
+        {OpCode::Id::ADD, t0_dest, t0, t1},
+        {OpCode::Id::DP4, t1_dest, v0, SourceRegister::MakeFloat(2)},
+        {OpCode::Id::MUL, t0_dest, t0, t1},
+        {OpCode::Id::DP4, t1_dest, v0, SourceRegister::MakeFloat(3)},
+        {OpCode::Id::RCP, t1_dest, t1},
+        {OpCode::Id::MUL, o0, t0, t1},
+        {OpCode::Id::DP3, t0_dest, v1, SourceRegister::MakeFloat(4)},
+        {OpCode::Id::MAX, t0_dest, t0, SourceRegister::MakeFloat(5)},
+        {OpCode::Id::LG2, t1_dest, t0},
+        {OpCode::Id::MUL, t1_dest, t1, SourceRegister::MakeFloat(6)},
+        {OpCode::Id::EX2, t1_dest, t1},
+        {OpCode::Id::MUL, o1, v1, t1},
+        {OpCode::Id::END},
+        // clang-format on
+    });
+
+    std::transform(shbin.program.begin(), shbin.program.end(), setup.program_code.begin(),
+                   [](const auto& x) { return x.hex; });
+    std::transform(shbin.swizzle_table.begin(), shbin.swizzle_table.end(),
+                   setup.swizzle_data.begin(), [](const auto& x) { return x.hex; });
+    setup.MarkProgramCodeDirty();
+    setup.MarkSwizzleDataDirty();
+
+    for (unsigned i = 0; i < 7; ++i) {
+        for (unsigned comp = 0; comp < 4; ++comp) {
+            setup.uniforms.f[i][comp] = float24::FromFloat32(0.25f * (i + comp + 1));
+        }
+    }
+}
+
+static void RunVertices(Pica::Shader::ShaderEngine& engine, Pica::Shader::ShaderSetup& setup,
+                        unsigned num_vertices) {
+    Pica::Shader::UnitState state;
+    for (unsigned i = 0; i < num_vertices; ++i) {
+        for (unsigned comp = 0; comp < 4; ++comp) {
+            state.registers.input[0][comp] = float24::FromFloat32(static_cast<float>(i + comp));
+            state.registers.input[1][comp] = float24::FromFloat32(1.0f / (i + comp + 1));
+        }
+        engine.Run(setup, state);
+    }
+}
+
+TEST_CASE("Shader", "[benchmark][video_core][shader]") {
+    constexpr unsigned num_vertices = 1024;
+
+    auto setup = std::make_unique<Pica::Shader::ShaderSetup>();
+    LoadTransformShader(*setup);
+
+    Pica::Shader::InterpreterEngine interpreter;
+    BENCHMARK("Interpreter 1024 vertices") {
+        interpreter.SetupBatch(*setup, 0);
+        RunVertices(interpreter, *setup, num_vertices);
+    };
+
+#ifdef ARCHITECTURE_x86_64
+    Pica::Shader::JitX64Engine jit;
+    jit.SetupBatch(*setup, 0); // Compile outside of the measurement
+    BENCHMARK("JIT x64 1024 vertices") {
+        jit.SetupBatch(*setup, 0);
+        RunVertices(jit, *setup, num_vertices);
+    };
+#endif
+}
@@ -112,6 +112,10 @@ shaders_accurate_mul =
 # 0: Interpreter (slow), 1 (default): JIT (fast)
 use_shader_jit =
 
+# Whether to store shaders compiled by the shader JIT on disk and reuse them across sessions
+# 0 (default): Off, 1: On
+use_disk_shader_cache =
+
 # Resolution scale factor
 # 0: Auto (scales resolution to window size), 1: Native 3DS screen resolution, Otherwise a scale
 # factor for the 3DS resolution
@@ -219,6 +223,12 @@ volume =
 # 1 (default): Yes, 0: No
 use_virtual_sd =
 
+# Whether to keep the decompressed and patched code of booted titles in the cache directory and
+# reuse it when the same title is booted again. Also starts reading the disk shader cache while the
+# title boots instead of on the first shader.
+# 0 (default): No, 1: Yes
+use_boot_cache =
+
 [System]
 # The system model that Citra will try to emulate
 # 0: Old 3DS (default), 1: New 3DS
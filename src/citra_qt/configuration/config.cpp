@@ -163,6 +163,7 @@ void Config::ReadValues() {
 #endif
     Settings::values.shaders_accurate_mul = ReadSetting("shaders_accurate_mul", false).toBool();
     Settings::values.use_shader_jit = ReadSetting("use_shader_jit", true).toBool();
+    Settings::values.use_disk_shader_cache = ReadSetting("use_disk_shader_cache", false).toBool();
     Settings::values.resolution_factor =
         static_cast<u16>(ReadSetting("resolution_factor", 1).toInt());
     Settings::values.use_frame_limit = ReadSetting("use_frame_limit", true).toBool();
@@ -244,6 +245,7 @@ void Config::ReadValues() {
 
     qt_config->beginGroup("Data Storage");
     Settings::values.use_virtual_sd = ReadSetting("use_virtual_sd", true).toBool();
+    Settings::values.use_boot_cache = ReadSetting("use_boot_cache", false).toBool();
     qt_config->endGroup();
 
     qt_config->beginGroup("System");
@@ -476,6 +478,7 @@ void Config::SaveValues() {
     WriteSetting("use_hw_shader", Settings::values.use_hw_shader, true);
     WriteSetting("shaders_accurate_mul", Settings::values.shaders_accurate_mul, false);
     WriteSetting("use_shader_jit", Settings::values.use_shader_jit, true);
+    WriteSetting("use_disk_shader_cache", Settings::values.use_disk_shader_cache, false);
     WriteSetting("resolution_factor", Settings::values.resolution_factor, 1);
     WriteSetting("use_frame_limit", Settings::values.use_frame_limit, true);
     WriteSetting("frame_limit", Settings::values.frame_limit, 100);
@@ -546,6 +549,7 @@ void Config::SaveValues() {
 
     qt_config->beginGroup("Data Storage");
     WriteSetting("use_virtual_sd", Settings::values.use_virtual_sd, true);
+    WriteSetting("use_boot_cache", Settings::values.use_boot_cache, false);
     qt_config->endGroup();
 
     qt_config->beginGroup("System");
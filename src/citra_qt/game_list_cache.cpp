@@ -0,0 +1,119 @@
+// Copyright 2020 Citra Emulator Project
+// Licensed under GPLv2 or any later version
+// Refer to the license.txt file included.
+
+#include <iterator>
+#include <QByteArray>
+#include <QDataStream>
+#include <QFile>
+#include <QSaveFile>
+#include <QString>
+#include "citra_qt/game_list_cache.h"
+#include "common/file_util.h"
+#include "common/logging/log.h"
+
+namespace {
+constexpr quint32 CACHE_MAGIC = 0x474C4331;
+constexpr quint32 CACHE_VERSION = 1;
+
+QString GetCachePath() {
+    return QString::fromStdString(FileUtil::GetUserPath(FileUtil::UserPath::CacheDir)) +
+           QStringLiteral("game_list.bin");
+}
+} // Anonymous namespace
+
+GameListCache::GameListCache() {
+    QFile file(GetCachePath());
+    if (!file.open(QIODevice::ReadOnly))
+        return;
+
+    QDataStream stream(&file);
+    quint32 magic, version, count;
+    stream >> magic >> version >> count;
+    if (stream.status() != QDataStream::Ok || magic != CACHE_MAGIC || version != CACHE_VERSION)
+        return;
+
+    entries.reserve(count);
+    for (quint32 i = 0; i < count; i++) {
+        QString path;
+        quint64 size, program_id, extdata_id;
+        qint64 mtime;
+        quint32 file_type;
+        bool executable;
+        QByteArray smdh;
+        stream >> path >> size >> mtime >> executable >> program_id >> extdata_id >> file_type >>
+            smdh;
+        if (stream.status() != QDataStream::Ok) {
+            LOG_WARNING(Frontend, "Game list cache is corrupted, discarding it");
+            entries.clear();
+            return;
+        }
+
+        StoredEntry& stored = entries[path.toStdString()];
+        stored.size = size;
+        stored.mtime = mtime;
+        stored.entry.executable = executable;
+        stored.entry.program_id = program_id;
+        stored.entry.extdata_id = extdata_id;
+        stored.entry.file_type = file_type;
+        stored.entry.smdh.assign(smdh.begin(), smdh.end());
+    }
+}
+
+std::optional<GameListCache::Entry> GameListCache::Lookup(const std::string& path, u64 size,
+                                                          s64 mtime) {
+    std::lock_guard lock{mutex};
+    const auto it = entries.find(path);
+    if (it == entries.end() || it->second.size != size || it->second.mtime != mtime)
+        return std::nullopt;
+
+    used.insert(path);
+    return it->second.entry;
+}
+
+void GameListCache::Insert(const std::string& path, u64 size, s64 mtime, Entry entry) {
+    std::lock_guard lock{mutex};
+    entries[path] = StoredEntry{size, mtime, std::move(entry)};
+    used.insert(path);
+    dirty = true;
+}
+
+void GameListCache::Save(bool prune) {
+    std::lock_guard lock{mutex};
+    if (prune && used.size() != entries.size()) {
+        for (auto it = entries.begin(); it != entries.end();) {
+            it = used.count(it->first) ? std::next(it) : entries.erase(it);
+        }
+        dirty = true;
+    }
+
+    if (!dirty)
+        return;
+
+    FileUtil::CreateFullPath(FileUtil::GetUserPath(FileUtil::UserPath::CacheDir));
+
+    // QSaveFile replaces the cache atomically, so concurrent scans never see a partial file.
+    QSaveFile file(GetCachePath());
+    if (!file.open(QIODevice::WriteOnly)) {
+        LOG_ERROR(Frontend, "Failed to open game list cache for writing");
+        return;
+    }
+
+    QDataStream stream(&file);
+    stream << CACHE_MAGIC << CACHE_VERSION << static_cast<quint32>(entries.size());
+    for (const auto& [path, stored] : entries) {
+        const Entry& entry = stored.entry;
+        stream << QString::fromStdString(path) << static_cast<quint64>(stored.size)
+               << static_cast<qint64>(stored.mtime) << entry.executable
+               << static_cast<quint64>(entry.program_id) << static_cast<quint64>(entry.extdata_id)
+               << static_cast<quint32>(entry.file_type)
+               << QByteArray(reinterpret_cast<const char*>(entry.smdh.data()),
+                             static_cast<int>(entry.smdh.size()));
+    }
+
+    if (!file.commit()) {
+        LOG_ERROR(Frontend, "Failed to write game list cache");
+        return;
+    }
+    dirty = false;
+}
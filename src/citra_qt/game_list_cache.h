@@ -0,0 +1,55 @@
+// Copyright 2020 Citra Emulator Project
+// Licensed under GPLv2 or any later version
+// Refer to the license.txt file included.
+
+#pragma once
+
+#include <mutex>
+#include <optional>
+#include <string>
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
+#include "common/common_types.h"
+
+/**
+ * On-disk cache of the metadata the game list reads from each file, so that refreshing the list
+ * only needs to stat files that have not changed since the last scan. Entries are keyed by path
+ * and validated against the file size and modification time. Thread-safe.
+ */
+class GameListCache {
+public:
+    struct Entry {
+        bool executable = false;
+        u64 program_id = 0;
+        u64 extdata_id = 0;
+        u32 file_type = 0;
+        std::vector<u8> smdh;
+    };
+
+    /// Loads the cache from the user's cache directory. A missing or outdated file is ignored.
+    GameListCache();
+
+    /// Returns the cached metadata of a file if the file has not been modified since.
+    std::optional<Entry> Lookup(const std::string& path, u64 size, s64 mtime);
+
+    void Insert(const std::string& path, u64 size, s64 mtime, Entry entry);
+
+    /**
+     * Writes the cache back to disk.
+     * @param prune whether to drop entries that were not looked up or inserted since loading
+     */
+    void Save(bool prune);
+
+private:
+    struct StoredEntry {
+        u64 size = 0;
+        s64 mtime = 0;
+        Entry entry;
+    };
+
+    std::mutex mutex;
+    std::unordered_map<std::string, StoredEntry> entries;
+    std::unordered_set<std::string> used;
+    bool dirty = false;
+};
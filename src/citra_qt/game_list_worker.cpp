@@ -6,10 +6,13 @@
 #include <string>
 #include <utility>
 #include <vector>
+#include <QDateTime>
 #include <QDir>
 #include <QFileInfo>
+#include <QtConcurrent/QtConcurrentRun>
 #include "citra_qt/compatibility_list.h"
 #include "citra_qt/game_list.h"
+#include "citra_qt/game_list_cache.h"
 #include "citra_qt/game_list_p.h"
 #include "citra_qt/game_list_worker.h"
 #include "citra_qt/uisettings.h"
@@ -24,19 +27,107 @@ bool HasSupportedFileExtension(const std::string& file_name) {
     const QFileInfo file = QFileInfo(QString::fromStdString(file_name));
     return GameList::supported_file_extensions.contains(file.suffix(), Qt::CaseInsensitive);
 }
+
+/// Whether a loader call produced a result that can be cached. Calls the loader does not implement
+/// and sections the file does not have fail the same way every time, other errors (failed reads,
+/// missing keys) may go away by the next scan.
+bool IsFinalResult(Loader::ResultStatus result) {
+    return result == Loader::ResultStatus::Success ||
+           result == Loader::ResultStatus::ErrorNotImplemented ||
+           result == Loader::ResultStatus::ErrorNotUsed;
+}
+
+/**
+ * Reads the game list metadata of a file
+ * @param physical_name Path of the file
+ * @param entry Metadata read from the file
+ * @return bool true if every read succeeded and the entry may be cached, false otherwise
+ */
+bool ReadMetadata(const std::string& physical_name, GameListCache::Entry& entry) {
+    std::unique_ptr<Loader::AppLoader> loader = Loader::GetLoader(physical_name);
+    if (!loader)
+        return false;
+
+    if (loader->IsExecutable(entry.executable) != Loader::ResultStatus::Success) {
+        // Missing keys or a failed read, don't remember the file as not executable
+        entry.executable = false;
+        return false;
+    }
+    if (!entry.executable)
+        return true;
+
+    bool complete = IsFinalResult(loader->ReadProgramId(entry.program_id));
+    complete &= IsFinalResult(loader->ReadExtdataId(entry.extdata_id));
+    complete &= IsFinalResult(loader->ReadIcon(entry.smdh));
+    entry.file_type = static_cast<u32>(loader->GetFileType());
+    return complete;
+}
+
+std::vector<u8> GetIcon(const GameListCache::Entry& entry) {
+    const u64 program_id = entry.program_id;
+    if (program_id < 0x0004000000000000 || program_id > 0x00040000FFFFFFFF)
+        return entry.smdh;
+
+    std::string update_path = Service::AM::GetTitleContentPath(Service::FS::MediaType::SDMC,
+                                                               program_id + 0x0000000E00000000);
+
+    if (!FileUtil::Exists(update_path))
+        return entry.smdh;
+
+    std::unique_ptr<Loader::AppLoader> update_loader = Loader::GetLoader(update_path);
+
+    if (!update_loader)
+        return entry.smdh;
+
+    std::vector<u8> update_smdh;
+    update_loader->ReadIcon(update_smdh);
+    return update_smdh;
+}
 } // Anonymous namespace
 
+struct GameListWorker::GameInfo {
+    std::string physical_name;
+    u64 size;
+    GameListCache::Entry metadata;
+    std::vector<u8> smdh;
+};
+
 GameListWorker::GameListWorker(QVector<UISettings::GameDir>& game_dirs,
                                const CompatibilityList& compatibility_list)
     : game_dirs(game_dirs), compatibility_list(compatibility_list) {}
 
 GameListWorker::~GameListWorker() = default;
 
-void GameListWorker::AddFstEntriesToGameList(const std::string& dir_path, unsigned int recursion,
-                                             GameListDir* parent_dir) {
-    const auto callback = [this, recursion, parent_dir](u64* num_entries_out,
-                                                        const std::string& directory,
-                                                        const std::string& virtual_name) -> bool {
+std::optional<GameListWorker::GameInfo> GameListWorker::ProbeFile(
+    const std::string& physical_name) {
+    if (stop_processing)
+        return std::nullopt;
+
+    // Only files that changed since the last scan are opened, everything else is served by the
+    // metadata cache after a stat.
+    const QFileInfo file_info(QString::fromStdString(physical_name));
+    const u64 size = static_cast<u64>(file_info.size());
+    const s64 mtime = file_info.lastModified().toMSecsSinceEpoch();
+
+    std::optional<GameListCache::Entry> metadata = cache->Lookup(physical_name, size, mtime);
+    if (!metadata) {
+        metadata.emplace();
+        if (ReadMetadata(physical_name, *metadata))
+            cache->Insert(physical_name, size, mtime, *metadata);
+    }
+
+    if (!metadata->executable)
+        return std::nullopt;
+
+    std::vector<u8> smdh = GetIcon(*metadata);
+    return GameInfo{physical_name, size, std::move(*metadata), std::move(smdh)};
+}
+
+void GameListWorker::CollectFiles(const std::string& dir_path, unsigned int recursion,
+                                  std::vector<std::string>& files) {
+    const auto callback = [this, recursion, &files](u64* num_entries_out,
+                                                    const std::string& directory,
+                                                    const std::string& virtual_name) -> bool {
         if (stop_processing) {
             // Breaks the callback loop.
             return false;
@@ -45,71 +136,10 @@ void GameListWorker::AddFstEntriesToGameList(const std::string& dir_path, unsign
         const std::string physical_name = directory + DIR_SEP + virtual_name;
         const bool is_dir = FileUtil::IsDirectory(physical_name);
         if (!is_dir && HasSupportedFileExtension(physical_name)) {
-            std::unique_ptr<Loader::AppLoader> loader = Loader::GetLoader(physical_name);
-            if (!loader)
-                return true;
-
-            bool executable = false;
-            loader->IsExecutable(executable);
-            if (!executable)
-                return true;
-
-            u64 program_id = 0;
-            loader->ReadProgramId(program_id);
-
-            u64 extdata_id = 0;
-            loader->ReadExtdataId(extdata_id);
-
-            std::vector<u8> smdh = [program_id, &loader]() -> std::vector<u8> {
-                std::vector<u8> original_smdh;
-                loader->ReadIcon(original_smdh);
-
-                if (program_id < 0x0004000000000000 || program_id > 0x00040000FFFFFFFF)
-                    return original_smdh;
-
-                std::string update_path = Service::AM::GetTitleContentPath(
-                    Service::FS::MediaType::SDMC, program_id + 0x0000000E00000000);
-
-                if (!FileUtil::Exists(update_path))
-                    return original_smdh;
-
-                std::unique_ptr<Loader::AppLoader> update_loader = Loader::GetLoader(update_path);
-
-                if (!update_loader)
-                    return original_smdh;
-
-                std::vector<u8> update_smdh;
-                update_loader->ReadIcon(update_smdh);
-                return update_smdh;
-            }();
-
-            if (!Loader::IsValidSMDH(smdh) && UISettings::values.game_list_hide_no_icon) {
-                // Skip this invalid entry
-                return true;
-            }
-
-            auto it = FindMatchingCompatibilityEntry(compatibility_list, program_id);
-
-            // The game list uses this as compatibility number for untested games
-            QString compatibility("99");
-            if (it != compatibility_list.end())
-                compatibility = it->second.first;
-
-            emit EntryReady(
-                {
-                    new GameListItemPath(QString::fromStdString(physical_name), smdh, program_id,
-                                         extdata_id),
-                    new GameListItemCompat(compatibility),
-                    new GameListItemRegion(smdh),
-                    new GameListItem(
-                        QString::fromStdString(Loader::GetFileTypeString(loader->GetFileType()))),
-                    new GameListItemSize(FileUtil::GetSize(physical_name)),
-                },
-                parent_dir);
-
+            files.push_back(physical_name);
         } else if (is_dir && recursion > 0) {
             watch_list.append(QString::fromStdString(physical_name));
-            AddFstEntriesToGameList(physical_name, recursion - 1, parent_dir);
+            CollectFiles(physical_name, recursion - 1, files);
         }
 
         return true;
@@ -118,8 +148,55 @@ void GameListWorker::AddFstEntriesToGameList(const std::string& dir_path, unsign
     FileUtil::ForeachDirectoryEntry(nullptr, dir_path, callback);
 }
 
+void GameListWorker::AddFstEntriesToGameList(const std::string& dir_path, unsigned int recursion,
+                                             GameListDir* parent_dir) {
+    std::vector<std::string> files;
+    CollectFiles(dir_path, recursion, files);
+
+    // Probe all files in parallel, but add them to the list in directory order.
+    std::vector<QFuture<std::optional<GameInfo>>> probes;
+    probes.reserve(files.size());
+    for (const std::string& physical_name : files) {
+        probes.push_back(QtConcurrent::run(
+            &probe_pool, [this, physical_name] { return ProbeFile(physical_name); }));
+    }
+
+    for (auto& probe : probes) {
+        const std::optional<GameInfo> info = probe.result();
+        if (!info || stop_processing)
+            continue;
+
+        const std::vector<u8>& smdh = info->smdh;
+        if (!Loader::IsValidSMDH(smdh) && UISettings::values.game_list_hide_no_icon) {
+            // Skip this invalid entry
+            continue;
+        }
+
+        const u64 program_id = info->metadata.program_id;
+        auto it = FindMatchingCompatibilityEntry(compatibility_list, program_id);
+
+        // The game list uses this as compatibility number for untested games
+        QString compatibility("99");
+        if (it != compatibility_list.end())
+            compatibility = it->second.first;
+
+        const auto file_type = static_cast<Loader::FileType>(info->metadata.file_type);
+        emit EntryReady(
+            {
+                new GameListItemPath(QString::fromStdString(info->physical_name), smdh, program_id,
+                                     info->metadata.extdata_id),
+                new GameListItemCompat(compatibility),
+                new GameListItemRegion(smdh),
+                new GameListItem(QString::fromStdString(Loader::GetFileTypeString(file_type))),
+                new GameListItemSize(info->size),
+            },
+            parent_dir);
+    }
+}
+
 void GameListWorker::run() {
     stop_processing = false;
+    cache = std::make_unique<GameListCache>();
     for (UISettings::GameDir& game_dir : game_dirs) {
         if (game_dir.path == "INSTALLED") {
             QString games_path =
@@ -154,6 +231,9 @@ void GameListWorker::run() {
                                     game_list_dir);
         }
     };
+
+    // An interrupted scan has not looked at every file, so keep the entries it did not reach.
+    cache->Save(!stop_processing);
     emit Finished(watch_list);
 }
 
@@ -7,16 +7,20 @@
 #include <atomic>
 #include <map>
 #include <memory>
+#include <optional>
 #include <string>
 #include <unordered_map>
+#include <vector>
 #include <QList>
 #include <QObject>
 #include <QRunnable>
 #include <QString>
+#include <QThreadPool>
 #include <QVector>
 #include "citra_qt/compatibility_list.h"
 #include "common/common_types.h"
 
+class GameListCache;
 class QStandardItem;
 
 /**
@@ -53,9 +57,20 @@ signals:
     void Finished(QStringList watch_list);
 
 private:
+    struct GameInfo;
+
+    /// Reads the metadata of a game file, from the cache if the file has not changed.
+    std::optional<GameInfo> ProbeFile(const std::string& physical_name);
+
+    /// Gathers the files with supported extensions in a directory tree.
+    void CollectFiles(const std::string& dir_path, unsigned int recursion,
+                      std::vector<std::string>& files);
+
     void AddFstEntriesToGameList(const std::string& dir_path, unsigned int recursion,
                                  GameListDir* parent_dir);
 
+    std::unique_ptr<GameListCache> cache;
+    QThreadPool probe_pool;
     QStringList watch_list;
     const CompatibilityList& compatibility_list;
     QVector<UISettings::GameDir>& game_dirs;
@@ -0,0 +1,733 @@
+// Copyright 2020 Citra Emulator Project
+// Licensed under GPLv2 or any later version
+// Refer to the license.txt file included.
+
+#include <algorithm>
+#include <chrono>
+#include <cstring>
+#include <deque>
+#include <fstream>
+#include <iostream>
+#include <memory>
+#include <numeric>
+#include <string>
+#include <utility>
+#include <vector>
+#include <json.hpp>
+
+#ifdef HAVE_SDL2
+#include <SDL.h>
+#include <glad/glad.h>
+#endif
+
+#ifdef _WIN32
+// windows.h needs to be included before shellapi.h
+#include <windows.h>
+
+#include <shellapi.h>
+#endif
+
+#undef _UNICODE
+#include <getopt.h>
+#ifndef _MSC_VER
+#include <unistd.h>
+#endif
+
+#include "common/common_types.h"
+#include "common/file_util.h"
+#include "common/logging/backend.h"
+#include "common/logging/filter.h"
+#include "common/logging/log.h"
+#include "common/microprofile.h"
+#include "common/scm_rev.h"
+#include "common/scope_exit.h"
+#include "common/string_util.h"
+#include "core/frontend/emu_window.h"
+#include "core/hw/gpu.h"
+#include "core/hw/hw.h"
+#include "core/hw/lcd.h"
+#include "core/memory.h"
+#include "core/tracer/citrace.h"
+#include "video_core/pica.h"
+#include "video_core/pica_state.h"
+#include "video_core/rasterizer_interface.h"
+#include "video_core/regs.h"
+#include "video_core/renderer_base.h"
+#include "video_core/video_core.h"
+
+namespace {
+
+enum class Backend {
+    Software,
+    OpenGL,
+};
+
+/// MicroProfile scopes reported by default, as (group, name) pairs
+const std::vector<std::pair<std::string, std::string>> default_scopes = {
+    {"GPU", "Cmdlist Processing"},
+    {"GPU", "DisplayTransfer"},
+    {"GPU", "Drawing"},
+    {"GPU", "Shader"},
+    {"GPU", "Shader Compile"},
+    {"GPU", "Rasterization"},
+    {"OpenGL", "Drawing"},
+    {"OpenGL", "State Sync"},
+    {"OpenGL", "LUT Upload"},
+    {"OpenGL", "Vertex Array Setup"},
+    {"OpenGL", "Vertex Shader Setup"},
+    {"OpenGL", "Cache Mgmt"},
+    {"OpenGL", "Surface Load"},
+    {"OpenGL", "Surface Flush"},
+    {"OpenGL", "Texture Upload"},
+    {"OpenGL", "Texture Download"},
+    {"OpenGL", "Blits"},
+};
+
+/**
+ * Window that is never shown. For the OpenGL backend it owns an offscreen context (a hidden SDL2
+ * window), which is all the hardware rasterizer needs to run.
+ */
+class EmuWindow_Headless : public Frontend::EmuWindow {
+public:
+    explicit EmuWindow_Headless(Backend backend) {
+#ifdef HAVE_SDL2
+        if (backend != Backend::OpenGL) {
+            return;
+        }
+
+        if (SDL_Init(SDL_INIT_VIDEO) < 0) {
+            LOG_CRITICAL(Frontend, "Failed to initialize SDL2: {}", SDL_GetError());
+            return;
+        }
+
+        SDL_GL_SetAttribute(SDL_GL_CONTEXT_MAJOR_VERSION, 3);
+        SDL_GL_SetAttribute(SDL_GL_CONTEXT_MINOR_VERSION, 3);
+        SDL_GL_SetAttribute(SDL_GL_CONTEXT_PROFILE_MASK, SDL_GL_CONTEXT_PROFILE_CORE);
+
+        window = SDL_CreateWindow(nullptr, SDL_WINDOWPOS_UNDEFINED, SDL_WINDOWPOS_UNDEFINED, 1, 1,
+                                  SDL_WINDOW_HIDDEN | SDL_WINDOW_OPENGL);
+        if (window == nullptr) {
+            LOG_CRITICAL(Frontend, "Failed to create hidden SDL2 window: {}", SDL_GetError());
+            return;
+        }
+
+        context = SDL_GL_CreateContext(window);
+        if (context == nullptr) {
+            LOG_CRITICAL(Frontend, "Failed to create SDL2 GL context: {}", SDL_GetError());
+            return;
+        }
+
+        if (!gladLoadGLLoader(static_cast<GLADloadproc>(SDL_GL_GetProcAddress))) {
+            LOG_CRITICAL(Frontend, "Failed to initialize GL functions");
+            return;
+        }
+
+        valid = true;
+#else
+        valid = backend == Backend::Software;
+#endif
+    }
+
+    ~EmuWindow_Headless() override {
+#ifdef HAVE_SDL2
+        if (context != nullptr) {
+            SDL_GL_DeleteContext(context);
+        }
+        if (window != nullptr) {
+            SDL_DestroyWindow(window);
+        }
+        SDL_Quit();
+#endif
+    }
+
+    bool IsValid() const {
+        return valid;
+    }
+
+    void PollEvents() override {}
+
+    void MakeCurrent() override {
+#ifdef HAVE_SDL2
+        SDL_GL_MakeCurrent(window, context);
+#endif
+    }
+
+    void DoneCurrent() override {
+#ifdef HAVE_SDL2
+        SDL_GL_MakeCurrent(window, nullptr);
+#endif
+    }
+
+    /// Blocks until all submitted GPU work has completed
+    void Finish() {
+#ifdef HAVE_SDL2
+        if (context != nullptr) {
+            glFinish();
+        }
+#endif
+    }
+
+private:
+    bool valid = false;
+#ifdef HAVE_SDL2
+    SDL_Window* window = nullptr;
+    SDL_GLContext context = nullptr;
+#endif
+};
+
+/// Forwards to the backend rasterizer while counting the draw calls submitted to it
+class CountingRasterizer final : public VideoCore::RasterizerInterface {
+public:
+    explicit CountingRasterizer(std::unique_ptr<VideoCore::RasterizerInterface> backend)
+        : backend(std::move(backend)) {}
+
+    void AddTriangle(const Pica::Shader::OutputVertex& v0, const Pica::Shader::OutputVertex& v1,
+                     const Pica::Shader::OutputVertex& v2) override {
+        backend->AddTriangle(v0, v1, v2);
+    }
+
+    void DrawTriangles() override {
+        backend->DrawTriangles();
+    }
+
+    void NotifyPicaRegisterChanged(u32 id) override {
+        if (id == PICA_REG_INDEX(pipeline.trigger_draw) ||
+            id == PICA_REG_INDEX(pipeline.trigger_draw_indexed)) {
+            ++draw_calls;
+        }
+        backend->NotifyPicaRegisterChanged(id);
+    }
+
+    void FlushAll() override {
+        backend->FlushAll();
+    }
+
+    void FlushRegion(PAddr addr, u32 size) override {
+        backend->FlushRegion(addr, size);
+    }
+
+    void InvalidateRegion(PAddr addr, u32 size) override {
+        backend->InvalidateRegion(addr, size);
+    }
+
+    void FlushAndInvalidateRegion(PAddr addr, u32 size) override {
+        backend->FlushAndInvalidateRegion(addr, size);
+    }
+
+    bool AccelerateDisplayTransfer(const GPU::Regs::DisplayTransferConfig& config) override {
+        return backend->AccelerateDisplayTransfer(config);
+    }
+
+    bool AccelerateTextureCopy(const GPU::Regs::DisplayTransferConfig& config) override {
+        return backend->AccelerateTextureCopy(config);
+    }
+
+    bool AccelerateFill(const GPU::Regs::MemoryFillConfig& config) override {
+        return backend->AccelerateFill(config);
+    }
+
+    bool AccelerateDisplay(const GPU::Regs::FramebufferConfig& config, PAddr framebuffer_addr,
+                           u32 pixel_stride, OpenGL::ScreenInfo& screen_info) override {
+        return backend->AccelerateDisplay(config, framebuffer_addr, pixel_stride, screen_info);
+    }
+
+    bool AccelerateDrawBatch(bool is_indexed) override {
+        return backend->AccelerateDrawBatch(is_indexed);
+    }
+
+    u64 draw_calls = 0;
+
+private:
+    std::unique_ptr<VideoCore::RasterizerInterface> backend;
+};
+
+/**
+ * Renderer that only drives a rasterizer. Frames are delimited by the trace rather than by
+ * SwapBuffers, so nothing is ever presented and no Core::System is required.
+ */
+class RendererHeadless final : public RendererBase {
+public:
+    explicit RendererHeadless(Frontend::EmuWindow& window) : RendererBase(window) {}
+
+    Core::System::ResultStatus Init() override {
+        RefreshRasterizerSetting();
+        auto counting_rasterizer = std::make_unique<CountingRasterizer>(std::move(rasterizer));
+        counter = counting_rasterizer.get();
+        rasterizer = std::move(counting_rasterizer);
+        return Core::System::ResultStatus::Success;
+    }
+
+    void ShutDown() override {}
+    void SwapBuffers() override {}
+    void TryPresent(int timeout_ms) override {}
+    void PrepareVideoDumping() override {}
+    void CleanupVideoDumping() override {}
+
+    u64 GetDrawCalls() const {
+        return counter->draw_calls;
+    }
+
+private:
+    CountingRasterizer* counter = nullptr;
+};
+
+/// A CiTrace file loaded into memory, with its stream elements already validated
+struct TraceFile {
+    CiTrace::CTHeader header;
+    std::string data;
+    std::vector<CiTrace::CTStreamElement> stream;
+    std::size_t num_frames = 0;
+
+    /// Returns the initial state block at the given offset, or an empty range if out of bounds
+    std::pair<const u32*, u32> InitialState(u32 offset, u32 size) const {
+        if (static_cast<u64>(offset) + static_cast<u64>(size) * sizeof(u32) > data.size()) {
+            return {nullptr, 0};
+        }
+        return {reinterpret_cast<const u32*>(data.data() + offset), size};
+    }
+};
+
+bool LoadTrace(const std::string& path, TraceFile& trace) {
+    if (FileUtil::ReadFileToString(false, path, trace.data) < sizeof(CiTrace::CTHeader)) {
+        LOG_CRITICAL(Frontend, "Could not read CiTrace header from {}", path);
+        return false;
+    }
+
+    std::memcpy(&trace.header, trace.data.data(), sizeof(trace.header));
+    const auto& header = trace.header;
+    if (std::memcmp(header.magic, CiTrace::CTHeader::ExpectedMagicWord(), 4) != 0 ||
+        header.version != CiTrace::CTHeader::ExpectedVersion()) {
+        LOG_CRITICAL(Frontend, "{} is not a supported CiTrace file", path);
+        return false;
+    }
+
+    const u64 stream_end = static_cast<u64>(header.stream_offset) +
+                           static_cast<u64>(header.stream_size) * sizeof(CiTrace::CTStreamElement);
+    if (stream_end > trace.data.size()) {
+        LOG_CRITICAL(Frontend, "CiTrace stream exceeds the file size");
+        return false;
+    }
+
+    trace.stream.resize(header.stream_size);
+    std::memcpy(trace.stream.data(), trace.data.data() + header.stream_offset,
+                trace.stream.size() * sizeof(CiTrace::CTStreamElement));
+
+    for (const auto& element : trace.stream) {
+        switch (element.type) {
+        case CiTrace::FrameMarker:
+            ++trace.num_frames;
+            break;
+        case CiTrace::MemoryLoad: {
+            const auto& load = element.memory_load;
+            if (static_cast<u64>(load.file_offset) + load.size > trace.data.size()) {
+                LOG_CRITICAL(Frontend, "CiTrace memory load exceeds the file size");
+                return false;
+            }
+            break;
+        }
+        case CiTrace::RegisterWrite:
+            break;
+        default:
+            LOG_CRITICAL(Frontend, "Unknown CiTrace stream element {:#x}",
+                         static_cast<u32>(element.type));
+            return false;
+        }
+    }
+
+    return true;
+}
+
+template <typename T>
+void CopyRegisters(T& regs, const std::pair<const u32*, u32>& state) {
+    const std::size_t count = std::min<std::size_t>(state.second, sizeof(T) / sizeof(u32));
+    std::memcpy(&regs, state.first, count * sizeof(u32));
+}
+
+void LoadFloat24Vectors(Common::Vec4<Pica::float24>* vectors, std::size_t num_vectors,
+                        const std::pair<const u32*, u32>& state) {
+    // Only the xyz components are recorded, see GraphicsTracingWidget::StartRecording
+    const std::size_t count = std::min<std::size_t>(state.second / 4, num_vectors);
+    for (std::size_t i = 0; i < count; ++i) {
+        for (std::size_t comp = 0; comp < 3; ++comp) {
+            vectors[i][comp] = Pica::float24::FromRaw(state.first[4 * i + comp]);
+        }
+    }
+}
+
+template <std::size_t N>
+void LoadShaderWords(std::array<u32, N>& words, const std::pair<const u32*, u32>& state) {
+    std::copy_n(state.first, std::min<std::size_t>(state.second, N), words.begin());
+}
+
+/// Restores the GPU, LCD and Pica state captured at the start of the trace
+void ApplyInitialState(const TraceFile& trace, VideoCore::RasterizerInterface& rasterizer) {
+    const auto& initial = trace.header.initial_state_offsets;
+
+    CopyRegisters(GPU::g_regs,
+                  trace.InitialState(initial.gpu_registers, initial.gpu_registers_size));
+    CopyRegisters(LCD::g_regs,
+                  trace.InitialState(initial.lcd_registers, initial.lcd_registers_size));
+
+    auto& state = Pica::g_state;
+    state.Reset();
+    CopyRegisters(state.regs,
+                  trace.InitialState(initial.pica_registers, initial.pica_registers_size));
+
+    LoadFloat24Vectors(state.input_default_attributes.attr, 16,
+                       trace.InitialState(initial.default_attributes,
+                                          initial.default_attributes_size));
+
+    LoadShaderWords(state.vs.program_code, trace.InitialState(initial.vs_program_binary,
+                                                              initial.vs_program_binary_size));
+    LoadShaderWords(state.vs.swizzle_data,
+                    trace.InitialState(initial.vs_swizzle_data, initial.vs_swizzle_data_size));
+    LoadFloat24Vectors(
+        state.vs.uniforms.f, 96,
+        trace.InitialState(initial.vs_float_uniforms, initial.vs_float_uniforms_size));
+    state.vs.MarkProgramCodeDirty();
+    state.vs.MarkSwizzleDataDirty();
+
+    LoadShaderWords(state.gs.program_code, trace.InitialState(initial.gs_program_binary,
+                                                              initial.gs_program_binary_size));
+    LoadShaderWords(state.gs.swizzle_data,
+                    trace.InitialState(initial.gs_swizzle_data, initial.gs_swizzle_data_size));
+    LoadFloat24Vectors(
+        state.gs.uniforms.f, 96,
+        trace.InitialState(initial.gs_float_uniforms, initial.gs_float_uniforms_size));
+    state.gs.MarkProgramCodeDirty();
+    state.gs.MarkSwizzleDataDirty();
+
+    // Let the rasterizer pick up the restored registers, skipping the draw triggers
+    for (u32 id = 0; id < Pica::Regs::NUM_REGS; ++id) {
+        if (id != PICA_REG_INDEX(pipeline.trigger_draw) &&
+            id != PICA_REG_INDEX(pipeline.trigger_draw_indexed)) {
+            rasterizer.NotifyPicaRegisterChanged(id);
+        }
+    }
+}
+
+/// Replays a register write through the emulated MMIO handlers, as the CPU would have issued it
+void ReplayRegisterWrite(const CiTrace::CTRegisterWrite& write) {
+    const VAddr addr = write.physical_address - Memory::IO_AREA_PADDR + Memory::IO_AREA_VADDR;
+    switch (write.size) {
+    case CiTrace::CTRegisterWrite::SIZE_8:
+        HW::Write<u8>(addr, static_cast<u8>(write.value));
+        break;
+    case CiTrace::CTRegisterWrite::SIZE_16:
+        HW::Write<u16>(addr, static_cast<u16>(write.value));
+        break;
+    case CiTrace::CTRegisterWrite::SIZE_32:
+        HW::Write<u32>(addr, static_cast<u32>(write.value));
+        break;
+    case CiTrace::CTRegisterWrite::SIZE_64:
+        HW::Write<u64>(addr, write.value);
+        break;
+    default:
+        LOG_ERROR(Frontend, "Unknown register write size {:#x}", static_cast<u32>(write.size));
+        break;
+    }
+}
+
+struct FrameStats {
+    double time_ms;
+    u64 draw_calls;
+};
+
+double Percentile(std::vector<double> values, double percentile) {
+    if (values.empty()) {
+        return 0.0;
+    }
+    std::sort(values.begin(), values.end());
+    const std::size_t index = std::min(values.size() - 1,
+                                       static_cast<std::size_t>(percentile * values.size()));
+    return values[index];
+}
+
+void PrintHelp(const char* argv0) {
+    std::cout << "Usage: " << argv0
+              << " [options] <trace.ctf>\n"
+                 "-b, --backend=NAME   Rasterizer to replay with: software (default) or opengl\n"
+                 "-l, --loops=N        Replay the trace N times (default 1)\n"
+                 "-o, --output=FILE    Write the JSON report to FILE instead of stdout\n"
+                 "-s, --scope=GRP:NAME Additionally report the given MicroProfile scope\n"
+                 "--no-shader-jit      Use the shader interpreter\n"
+                 "--hw-shader          Use hardware shaders (opengl backend only)\n"
+                 "--log-filter=FILTER  Log filter string (default *:Warning)\n"
+                 "-h, --help           Display this help and exit\n"
+                 "-v, --version        Output version information and exit\n";
+}
+
+void PrintVersion() {
+    std::cout << "citra-trace-bench " << Common::g_scm_branch << " " << Common::g_scm_desc
+              << std::endl;
+}
+
+} // Anonymous namespace
+
+/// Application entry point
+int main(int argc, char** argv) {
+    Backend backend = Backend::Software;
+    int loops = 1;
+    std::string output_path;
+    std::string log_filter_string = "*:Warning";
+    bool shader_jit = true;
+    bool hw_shader = false;
+    auto scopes = default_scopes;
+
+    int option_index = 0;
+    char* endarg;
+
+#ifdef _WIN32
+    int argc_w;
+    auto argv_w = CommandLineToArgvW(GetCommandLineW(), &argc_w);
+
+    if (argv_w == nullptr) {
+        std::cerr << "Failed to get command line arguments" << std::endl;
+        return -1;
+    }
+#endif
+    std::string filepath;
+
+    static struct option long_options[] = {
+        {"backend", required_argument, 0, 'b'},
+        {"loops", required_argument, 0, 'l'},
+        {"output", required_argument, 0, 'o'},
+        {"scope", required_argument, 0, 's'},
+        {"no-shader-jit", no_argument, 0, 'J'},
+        {"hw-shader", no_argument, 0, 'H'},
+        {"log-filter", required_argument, 0, 'f'},
+        {"help", no_argument, 0, 'h'},
+        {"version", no_argument, 0, 'v'},
+        {0, 0, 0, 0},
+    };
+
+    while (optind < argc) {
+        int arg = getopt_long(argc, argv, "b:l:o:s:hv", long_options, &option_index);
+        if (arg != -1) {
+            switch (static_cast<char>(arg)) {
+            case 'b':
+                if (std::string(optarg) == "software") {
+                    backend = Backend::Software;
+                } else if (std::string(optarg) == "opengl") {
+                    backend = Backend::OpenGL;
+                } else {
+                    std::cerr << "Unknown backend " << optarg << std::endl;
+                    return -1;
+                }
+                break;
+            case 'l':
+                loops = std::max(1, static_cast<int>(strtol(optarg, &endarg, 0)));
+                break;
+            case 'o':
+                output_path.assign(optarg);
+                break;
+            case 's': {
+                const std::string scope(optarg);
+                const std::size_t separator = scope.find(':');
+                if (separator == std::string::npos) {
+                    std::cerr << "Scopes are given as GROUP:NAME" << std::endl;
+                    return -1;
+                }
+                scopes.emplace_back(scope.substr(0, separator), scope.substr(separator + 1));
+                break;
+            }
+            case 'J':
+                shader_jit = false;
+                break;
+            case 'H':
+                hw_shader = true;
+                break;
+            case 'f':
+                log_filter_string.assign(optarg);
+                break;
+            case 'h':
+                PrintHelp(argv[0]);
+                return 0;
+            case 'v':
+                PrintVersion();
+                return 0;
+            }
+        } else {
+#ifdef _WIN32
+            filepath = Common::UTF16ToUTF8(argv_w[optind]);
+#else
+            filepath = argv[optind];
+#endif
+            optind++;
+        }
+    }
+
+#ifdef _WIN32
+    LocalFree(argv_w);
+#endif
+
+    if (filepath.empty()) {
+        PrintHelp(argv[0]);
+        return -1;
+    }
+
+    Log::Filter log_filter(Log::Level::Debug);
+    log_filter.ParseFilterString(log_filter_string);
+    Log::SetGlobalFilter(log_filter);
+    Log::AddBackend(std::make_unique<Log::ColorConsoleBackend>());
+
+    MicroProfileOnThreadCreate("TraceBench");
+    SCOPE_EXIT({ MicroProfileShutdown(); });
+    MicroProfileSetForceEnable(true);
+    MicroProfileSetEnableAllGroups(true);
+
+    TraceFile trace;
+    if (!LoadTrace(filepath, trace)) {
+        return -1;
+    }
+
+    EmuWindow_Headless emu_window(backend);
+    if (!emu_window.IsValid()) {
+        LOG_CRITICAL(Frontend, "The requested backend is not available");
+        return -1;
+    }
+    emu_window.MakeCurrent();
+
+    VideoCore::g_hw_renderer_enabled = backend == Backend::OpenGL;
+    VideoCore::g_shader_jit_enabled = shader_jit;
+    VideoCore::g_hw_shader_enabled = hw_shader && backend == Backend::OpenGL;
+    VideoCore::g_hw_shader_accurate_mul = false;
+
+    // The trace only ever touches physical memory, so no process or page table is set up
+    Memory::MemorySystem memory;
+    GPU::g_memory = &memory;
+    VideoCore::g_memory = &memory;
+    Pica::Init();
+    SCOPE_EXIT({ Pica::Shutdown(); });
+
+    auto renderer = std::make_unique<RendererHeadless>(emu_window);
+    renderer->Init();
+    VideoCore::g_renderer = std::move(renderer);
+    SCOPE_EXIT({ VideoCore::g_renderer.reset(); });
+    auto& headless_renderer = static_cast<RendererHeadless&>(*VideoCore::g_renderer);
+    auto& rasterizer = *VideoCore::g_renderer->Rasterizer();
+
+    std::vector<FrameStats> frames;
+    frames.reserve(trace.num_frames * loops);
+    std::vector<double> scope_totals(scopes.size());
+
+    // MicroProfileGetTime reports the interval that ended MICROPROFILE_GPU_FRAME_DELAY flips
+    // earlier, so remember which flips ended a trace frame until their timings come in
+    std::deque<bool> pending_flips;
+    const auto flip = [&](bool ends_frame) {
+        MicroProfileFlip();
+        pending_flips.push_back(ends_frame);
+        if (pending_flips.size() <= MICROPROFILE_GPU_FRAME_DELAY)
+            return;
+        if (pending_flips.front()) {
+            for (std::size_t i = 0; i < scopes.size(); ++i) {
+                scope_totals[i] +=
+                    MicroProfileGetTime(scopes[i].first.c_str(), scopes[i].second.c_str());
+            }
+        }
+        pending_flips.pop_front();
+    };
+
+    using Clock = std::chrono::steady_clock;
+    const auto replay_start = Clock::now();
+
+    for (int loop = 0; loop < loops; ++loop) {
+        ApplyInitialState(trace, rasterizer);
+
+        u64 frame_start_draws = headless_renderer.GetDrawCalls();
+        flip(false);
+        auto frame_start = Clock::now();
+
+        for (const auto& element : trace.stream) {
+            switch (element.type) {
+            case CiTrace::FrameMarker: {
+                if (backend == Backend::OpenGL) {
+                    emu_window.Finish();
+                }
+                const auto frame_end = Clock::now();
+                const u64 draw_calls = headless_renderer.GetDrawCalls();
+                frames.push_back(
+                    {std::chrono::duration<double, std::milli>(frame_end - frame_start).count(),
+                     draw_calls - frame_start_draws});
+
+                flip(true);
+                frame_start_draws = draw_calls;
+                frame_start = Clock::now();
+                break;
+            }
+            case CiTrace::MemoryLoad: {
+                const auto& load = element.memory_load;
+                u8* dest = memory.GetPhysicalPointer(load.physical_address);
+                if (dest == nullptr) {
+                    LOG_ERROR(Frontend, "Memory load to invalid address {:#010X}",
+                              load.physical_address);
+                    break;
+                }
+                Memory::RasterizerFlushAndInvalidateRegion(load.physical_address, load.size);
+                std::memcpy(dest, trace.data.data() + load.file_offset, load.size);
+                break;
+            }
+            case CiTrace::RegisterWrite:
+                ReplayRegisterWrite(element.register_write);
+                break;
+            }
+        }
+    }
+
+    const double total_ms =
+        std::chrono::duration<double, std::milli>(Clock::now() - replay_start).count();
+
+    // Collect the timings of the last frames, which are still in flight
+    while (std::find(pending_flips.begin(), pending_flips.end(), true) != pending_flips.end()) {
+        flip(false);
+    }
+
+    std::vector<double> frame_times(frames.size());
+    std::transform(frames.begin(), frames.end(), frame_times.begin(),
+                   [](const FrameStats& frame) { return frame.time_ms; });
+
+    nlohmann::json report;
+    report["trace"] = filepath;
+    report["version"] = std::string(Common::g_scm_desc);
+    report["backend"] = std::string(backend == Backend::OpenGL ? "opengl" : "software");
+    report["shader_jit"] = shader_jit;
+    report["hw_shader"] = static_cast<bool>(VideoCore::g_hw_shader_enabled);
+    report["loops"] = loops;
+    report["total_ms"] = total_ms;
+
+    auto& summary = report["summary"];
+    summary["frames"] = frames.size();
+    summary["draw_calls"] = headless_renderer.GetDrawCalls();
+    summary["mean_ms"] =
+        frames.empty() ? 0.0 : std::accumulate(frame_times.begin(), frame_times.end(), 0.0) /
+                                   frame_times.size();
+    summary["min_ms"] = Percentile(frame_times, 0.0);
+    summary["median_ms"] = Percentile(frame_times, 0.5);
+    summary["p99_ms"] = Percentile(frame_times, 0.99);
+    summary["max_ms"] = Percentile(frame_times, 1.0);
+
+    auto& scope_report = report["scopes_ms"];
+    for (std::size_t i = 0; i < scopes.size(); ++i) {
+        scope_report[scopes[i].first + "/" + scopes[i].second] = scope_totals[i];
+    }
+
+    auto& frame_report = report["frames"];
+    frame_report = nlohmann::json::array();
+    for (const auto& frame : frames) {
+        frame_report.push_back({{"time_ms", frame.time_ms}, {"draw_calls", frame.draw_calls}});
+    }
+
+    if (output_path.empty()) {
+        std::cout << report.dump(4) << std::endl;
+    } else {
+        std::ofstream output;
+        OpenFStream(output, output_path, std::ios::out | std::ios::trunc);
+        if (!output.is_open()) {
+            LOG_CRITICAL(Frontend, "Could not open {} for writing", output_path);
+            return -1;
+        }
+        output << report.dump(4) << std::endl;
+    }
+
+    return 0;
+}
@@ -3,12 +3,13 @@
 // Refer to the license.txt file included.
 
 #include <algorithm>
+#include <array>
 #include <atomic>
 #include <chrono>
 #include <condition_variable>
+#include <cstring>
 #include <memory>
 #include <mutex>
-#include <regex>
 #include <thread>
 #include <vector>
 #ifdef _WIN32
@@ -41,8 +42,19 @@ public:
 
     void PushEntry(Class log_class, Level log_level, const char* filename, unsigned int line_num,
                    const char* function, std::string message) {
-        message_queue.Push(
-            CreateEntry(log_class, log_level, filename, line_num, function, std::move(message)));
+        Record record = CreateRecord(log_class, log_level, filename, line_num, function);
+        record.message = std::move(message);
+        message_queue.Push(std::move(record));
+    }
+
+    void PushDeferredEntry(Class log_class, Level log_level, const char* filename,
+                           unsigned int line_num, const char* function, const char* format,
+                           Detail::DeferredFormatter formatter, const Detail::DeferredArgs& args) {
+        Record record = CreateRecord(log_class, log_level, filename, line_num, function);
+        record.format = format;
+        record.formatter = formatter;
+        std::memcpy(record.args.data(), args.data.data(), args.size);
+        message_queue.Push(std::move(record));
     }
 
     void AddBackend(std::unique_ptr<Backend> backend) {
@@ -78,63 +90,90 @@ public:
 private:
     Impl() {
         backend_thread = std::thread([&] {
+            Record record;
             Entry entry;
-            auto write_logs = [&](Entry& e) {
+            auto write_logs = [&](Record& r) {
+                // Messages are formatted here rather than by the thread logging them
+                entry.timestamp = r.timestamp;
+                entry.log_class = r.log_class;
+                entry.log_level = r.log_level;
+                entry.filename = r.filename;
+                entry.line_num = r.line_num;
+                entry.function = r.function;
+                if (r.formatter) {
+                    r.formatter(r.format, r.args.data(), entry.message);
+                } else {
+                    entry.message = std::move(r.message);
+                }
+
                 std::lock_guard lock{writing_mutex};
                 for (const auto& backend : backends) {
-                    backend->Write(e);
+                    backend->Write(entry);
                 }
             };
             while (true) {
-                entry = message_queue.PopWait();
-                if (entry.final_entry) {
+                record = message_queue.PopWait();
+                if (record.final_entry) {
                     break;
                 }
-                write_logs(entry);
+                write_logs(record);
             }
 
             // Drain the logging queue. Only writes out up to MAX_LOGS_TO_WRITE to prevent a case
             // where a system is repeatedly spamming logs even on close.
             constexpr int MAX_LOGS_TO_WRITE = 100;
             int logs_written = 0;
-            while (logs_written++ < MAX_LOGS_TO_WRITE && message_queue.Pop(entry)) {
-                write_logs(entry);
+            while (logs_written++ < MAX_LOGS_TO_WRITE && message_queue.Pop(record)) {
+                write_logs(record);
             }
         });
     }
 
     ~Impl() {
-        Entry entry;
-        entry.final_entry = true;
-        message_queue.Push(entry);
+        Record record;
+        record.final_entry = true;
+        message_queue.Push(std::move(record));
         backend_thread.join();
     }
 
-    Entry CreateEntry(Class log_class, Level log_level, const char* filename, unsigned int line_nr,
-                      const char* function, std::string message) const {
+    /**
+     * A log message as it is queued for the logging thread. The strings are literals, and the
+     * message is either formatted already or formatted from the raw arguments by the formatter.
+     */
+    struct Record {
+        std::chrono::microseconds timestamp;
+        Class log_class;
+        Level log_level;
+        const char* filename;
+        unsigned int line_num;
+        const char* function;
+        const char* format = nullptr;
+        Detail::DeferredFormatter formatter = nullptr;
+        std::array<u8, Detail::MAX_DEFERRED_ARGS_SIZE> args;
+        std::string message;
+        bool final_entry = false;
+    };
+
+    Record CreateRecord(Class log_class, Level log_level, const char* filename,
+                        unsigned int line_nr, const char* function) const {
         using std::chrono::duration_cast;
         using std::chrono::steady_clock;
 
-        // matches from the beginning up to the last '../' or 'src/'
-        static const std::regex trim_source_path(R"(.*([\/\\]|^)((\.\.)|(src))[\/\\])");
-
-        Entry entry;
-        entry.timestamp =
+        Record record;
+        record.timestamp =
             duration_cast<std::chrono::microseconds>(steady_clock::now() - time_origin);
-        entry.log_class = log_class;
-        entry.log_level = log_level;
-        entry.filename = std::regex_replace(filename, trim_source_path, "");
-        entry.line_num = line_nr;
-        entry.function = function;
-        entry.message = std::move(message);
-
-        return entry;
+        record.log_class = log_class;
+        record.log_level = log_level;
+        record.filename = filename;
+        record.line_num = line_nr;
+        record.function = function;
+        return record;
     }
 
     std::mutex writing_mutex;
     std::thread backend_thread;
     std::vector<std::unique_ptr<Backend>> backends;
-    Common::MPSCQueue<Log::Entry> message_queue;
+    Common::BoundedMPSCQueue<Record, 1024> message_queue;
     Filter filter;
     std::chrono::steady_clock::time_point time_origin{std::chrono::steady_clock::now()};
 };
@@ -301,4 +340,16 @@ void FmtLogMessageImpl(Class log_class, Level log_level, const char* filename,
     instance.PushEntry(log_class, log_level, filename, line_num, function,
                        fmt::vformat(format, args));
 }
+
+void DeferredLogMessageImpl(Class log_class, Level log_level, const char* filename,
+                            unsigned int line_num, const char* function, const char* format,
+                            Detail::DeferredFormatter formatter, const Detail::DeferredArgs& args) {
+    auto& instance = Impl::Instance();
+    const auto& filter = instance.GetGlobalFilter();
+    if (!filter.CheckMessage(log_class, log_level))
+        return;
+
+    instance.PushDeferredEntry(log_class, log_level, filename, line_num, function, format,
+                               formatter, args);
+}
 } // namespace Log
@@ -4,6 +4,13 @@
 
 #pragma once
 
+#include <array>
+#include <cstddef>
+#include <cstring>
+#include <string>
+#include <string_view>
+#include <tuple>
+#include <type_traits>
 #include <fmt/format.h>
 #include "common/common_types.h"
 
@@ -104,11 +111,119 @@ enum class Class : ClassType {
     Count              ///< Total number of logging classes
 };
 
+/**
+ * Returns the length of the part of a source path up to the last "../" or "src/", which is left
+ * out of the logs. Evaluated at compile time by the logging macros.
+ */
+constexpr std::size_t TrimSourcePath(std::string_view source) {
+    const auto is_separator = [](char c) { return c == '/' || c == '\\'; };
+    std::size_t start = 0;
+    for (std::size_t i = 0; i < source.size(); ++i) {
+        if (i != 0 && !is_separator(source[i - 1]))
+            continue;
+        for (const std::string_view component : {std::string_view("src"), std::string_view("..")}) {
+            const std::size_t end = i + component.size();
+            if (source.substr(i, component.size()) == component && end < source.size() &&
+                is_separator(source[end])) {
+                start = end + 1;
+            }
+        }
+    }
+    return start;
+}
+
+namespace Detail {
+
+/// The space available for the arguments of a message that is formatted on the logging thread.
+constexpr std::size_t MAX_DEFERRED_ARGS_SIZE = 96;
+
+/// Formats a message from the arguments recorded by DeferredArgs.
+using DeferredFormatter = void (*)(const char* format, const u8* args, std::string& message);
+
+template <typename T>
+constexpr bool IsStringArg =
+    std::is_same_v<T, std::string> || std::is_same_v<T, std::string_view> ||
+    std::is_same_v<T, const char*> || std::is_same_v<T, char*>;
+
+/// Arguments that can be copied now and formatted later. Anything else is formatted right away.
+template <typename T>
+constexpr bool IsDeferrableArg = std::is_arithmetic_v<T> || std::is_enum_v<T> ||
+                                 std::is_same_v<T, const void*> || std::is_same_v<T, void*> ||
+                                 IsStringArg<T>;
+
+/// The raw arguments of a log message. Strings are stored as their length followed by the bytes.
+struct DeferredArgs {
+    std::array<u8, MAX_DEFERRED_ARGS_SIZE> data;
+    std::size_t size = 0;
+
+    /// Appends an argument, returns false if it doesn't fit
+    template <typename T>
+    bool Write(const T& value) {
+        if constexpr (IsStringArg<std::decay_t<T>>) {
+            std::string_view string;
+            if constexpr (std::is_pointer_v<std::decay_t<T>>) {
+                if (value)
+                    string = value;
+            } else {
+                string = value;
+            }
+            const u32 length = static_cast<u32>(string.size());
+            if (size + sizeof(length) + length > data.size())
+                return false;
+            std::memcpy(&data[size], &length, sizeof(length));
+            std::memcpy(&data[size + sizeof(length)], string.data(), length);
+            size += sizeof(length) + length;
+        } else {
+            if (size + sizeof(T) > data.size())
+                return false;
+            std::memcpy(&data[size], &value, sizeof(T));
+            size += sizeof(T);
+        }
+        return true;
+    }
+};
+
+template <typename T>
+auto ReadDeferredArg(const u8* data, std::size_t& offset) {
+    if constexpr (IsStringArg<T>) {
+        u32 length;
+        std::memcpy(&length, data + offset, sizeof(length));
+        const char* string = reinterpret_cast<const char*>(data + offset + sizeof(length));
+        offset += sizeof(length) + length;
+        return std::string_view(string, length);
+    } else {
+        T value;
+        std::memcpy(&value, data + offset, sizeof(T));
+        offset += sizeof(T);
+        return value;
+    }
+}
+
+template <typename... Args>
+void FormatDeferred(const char* format, const u8* data, std::string& message) {
+    std::size_t offset = 0;
+    // Braced initialization reads the arguments in order
+    const std::tuple<decltype(ReadDeferredArg<Args>(data, offset))...> values{
+        ReadDeferredArg<Args>(data, offset)...};
+    message = std::apply(
+        [format](const auto&... args) {
+            return fmt::vformat(format, fmt::make_format_args(args...));
+        },
+        values);
+}
+
+} // namespace Detail
+
 /// Logs a message to the global logger, using fmt
 void FmtLogMessageImpl(Class log_class, Level log_level, const char* filename,
                        unsigned int line_num, const char* function, const char* format,
                        const fmt::format_args& args);
 
+/// Logs a message to the global logger, formatting it later on the logging thread
+void DeferredLogMessageImpl(Class log_class, Level log_level, const char* filename,
+                            unsigned int line_num, const char* function, const char* format,
+                            Detail::DeferredFormatter formatter, const Detail::DeferredArgs& args);
+
 template <typename... Args>
 void FmtLogMessage(Class log_class, Level log_level, const char* filename, unsigned int line_num,
                    const char* function, const char* format, const Args&... args) {
@@ -116,32 +231,58 @@ void FmtLogMessage(Class log_class, Level log_level, const char* filename, unsig
                       fmt::make_format_args(args...));
 }
 
+/**
+ * Logs a message to the global logger. Copies the arguments and leaves the formatting to the
+ * logging thread when they are all numbers, enums or strings that fit the space available.
+ * The filename, function and format strings have to live as long as the program, like literals.
+ */
+template <typename... Args>
+void DeferredFmtLogMessage(Class log_class, Level log_level, const char* filename,
+                           unsigned int line_num, const char* function, const char* format,
+                           const Args&... args) {
+    if constexpr ((Detail::IsDeferrableArg<std::decay_t<Args>> && ...)) {
+        Detail::DeferredArgs deferred_args;
+        if ((deferred_args.Write(args) && ...)) {
+            DeferredLogMessageImpl(log_class, log_level, filename, line_num, function, format,
+                                   &Detail::FormatDeferred<std::decay_t<Args>...>, deferred_args);
+            return;
+        }
+    }
+    FmtLogMessageImpl(log_class, log_level, filename, line_num, function, format,
+                      fmt::make_format_args(args...));
+}
+
 } // namespace Log
 
-// Define the fmt lib macros
+/// The path of the current source file relative to the source directory
+#define LOG_SOURCE_FILE                                                                            \
+    (__FILE__ + std::integral_constant<std::size_t, ::Log::TrimSourcePath(__FILE__)>::value)
+
+// Define the fmt lib macros. The format string has to be a literal, as formatting may be deferred.
 #define LOG_GENERIC(log_class, log_level, ...)                                                     \
-    ::Log::FmtLogMessage(log_class, log_level, __FILE__, __LINE__, __func__, __VA_ARGS__)
+    ::Log::DeferredFmtLogMessage(log_class, log_level, LOG_SOURCE_FILE, __LINE__, __func__,        \
+                                 "" __VA_ARGS__)
 
 #ifdef _DEBUG
 #define LOG_TRACE(log_class, ...)                                                                  \
-    ::Log::FmtLogMessage(::Log::Class::log_class, ::Log::Level::Trace, __FILE__, __LINE__,         \
-                         __func__, __VA_ARGS__)
+    ::Log::DeferredFmtLogMessage(::Log::Class::log_class, ::Log::Level::Trace,                     \
+                                 LOG_SOURCE_FILE, __LINE__, __func__, "" __VA_ARGS__)
 #else
 #define LOG_TRACE(log_class, fmt, ...) (void(0))
 #endif
 
 #define LOG_DEBUG(log_class, ...)                                                                  \
-    ::Log::FmtLogMessage(::Log::Class::log_class, ::Log::Level::Debug, __FILE__, __LINE__,         \
-                         __func__, __VA_ARGS__)
+    ::Log::DeferredFmtLogMessage(::Log::Class::log_class, ::Log::Level::Debug,                     \
+                                 LOG_SOURCE_FILE, __LINE__, __func__, "" __VA_ARGS__)
 #define LOG_INFO(log_class, ...)                                                                   \
-    ::Log::FmtLogMessage(::Log::Class::log_class, ::Log::Level::Info, __FILE__, __LINE__,          \
-                         __func__, __VA_ARGS__)
+    ::Log::DeferredFmtLogMessage(::Log::Class::log_class, ::Log::Level::Info,                      \
+                                 LOG_SOURCE_FILE, __LINE__, __func__, "" __VA_ARGS__)
 #define LOG_WARNING(log_class, ...)                                                                \
-    ::Log::FmtLogMessage(::Log::Class::log_class, ::Log::Level::Warning, __FILE__, __LINE__,       \
-                         __func__, __VA_ARGS__)
+    ::Log::DeferredFmtLogMessage(::Log::Class::log_class, ::Log::Level::Warning,                   \
+                                 LOG_SOURCE_FILE, __LINE__, __func__, "" __VA_ARGS__)
 #define LOG_ERROR(log_class, ...)                                                                  \
-    ::Log::FmtLogMessage(::Log::Class::log_class, ::Log::Level::Error, __FILE__, __LINE__,         \
-                         __func__, __VA_ARGS__)
+    ::Log::DeferredFmtLogMessage(::Log::Class::log_class, ::Log::Level::Error,                     \
+                                 LOG_SOURCE_FILE, __LINE__, __func__, "" __VA_ARGS__)
 #define LOG_CRITICAL(log_class, ...)                                                               \
-    ::Log::FmtLogMessage(::Log::Class::log_class, ::Log::Level::Critical, __FILE__, __LINE__,      \
-                         __func__, __VA_ARGS__)
+    ::Log::DeferredFmtLogMessage(::Log::Class::log_class, ::Log::Level::Critical,                  \
+                                 LOG_SOURCE_FILE, __LINE__, __func__, "" __VA_ARGS__)
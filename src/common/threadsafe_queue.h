@@ -10,6 +10,8 @@
 #include <atomic>
 #include <condition_variable>
 #include <cstddef>
+#include <deque>
+#include <memory>
 #include <mutex>
 #include <utility>
 
@@ -162,4 +164,135 @@ private:
     SPSCQueue<T> spsc_queue;
     std::mutex write_lock;
 };
+
+/**
+ * A bounded, lock-free multiple writer, single reader queue.
+ *
+ * Writers claim a slot of the ring with a single compare-and-swap and never take a lock while the
+ * ring has room. Once it is full, writers fall back to a mutex-protected overflow queue, which
+ * they keep using until the reader has drained it so that each writer's elements stay in order.
+ * The reader only sleeps in PopWait, and writers only touch the condition variable while it does.
+ *
+ * @tparam T         Element type
+ * @tparam capacity  Number of slots in the ring, must be a power of two
+ */
+template <typename T, std::size_t capacity>
+class BoundedMPSCQueue {
+    static_assert(capacity >= 2 && (capacity & (capacity - 1)) == 0,
+                  "capacity must be a power of two");
+
+public:
+    BoundedMPSCQueue() : cells(std::make_unique<Cell[]>(capacity)) {
+        for (std::size_t i = 0; i < capacity; ++i) {
+            cells[i].sequence.store(i, std::memory_order_relaxed);
+        }
+    }
+
+    /// Whether Pop would fail. Only meaningful on the reader thread.
+    bool Empty() const {
+        return !IsReadable(cells[read_index % capacity]) &&
+               (!IsRingEmpty() || overflow_size.load(std::memory_order_acquire) == 0);
+    }
+
+    template <typename Arg>
+    void Push(Arg&& t) {
+        if (overflow_size.load(std::memory_order_acquire) != 0 || !TryPush<Arg>(t)) {
+            std::lock_guard lock{overflow_mutex};
+            overflow.emplace_back(std::forward<Arg>(t));
+            overflow_size.fetch_add(1, std::memory_order_release);
+        }
+
+        // Pairs with the fence in PopWait: either the reader sees the new element, or we see that
+        // it is waiting.
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+        if (reader_waiting.load(std::memory_order_relaxed)) {
+            std::lock_guard lock{wait_mutex};
+            cv.notify_one();
+        }
+    }
+
+    bool Pop(T& t) {
+        Cell& cell = cells[read_index % capacity];
+        if (IsReadable(cell)) {
+            t = std::move(cell.value);
+            cell.sequence.store(read_index + capacity, std::memory_order_release);
+            ++read_index;
+            return true;
+        }
+
+        // A writer may have claimed the slot without having filled it yet. Its later elements may
+        // already be in the overflow queue, so that has to wait until the slot has been read.
+        if (!IsRingEmpty() || overflow_size.load(std::memory_order_acquire) == 0)
+            return false;
+
+        std::lock_guard lock{overflow_mutex};
+        t = std::move(overflow.front());
+        overflow.pop_front();
+        overflow_size.fetch_sub(1, std::memory_order_release);
+        return true;
+    }
+
+    T PopWait() {
+        T t;
+        while (!Pop(t)) {
+            std::unique_lock lock{wait_mutex};
+            reader_waiting.store(true, std::memory_order_relaxed);
+            std::atomic_thread_fence(std::memory_order_seq_cst);
+            if (Empty()) {
+                cv.wait(lock);
+            }
+            reader_waiting.store(false, std::memory_order_relaxed);
+        }
+        return t;
+    }
+
+private:
+    struct alignas(64) Cell {
+        std::atomic<std::size_t> sequence;
+        T value;
+    };
+
+    bool IsReadable(const Cell& cell) const {
+        return cell.sequence.load(std::memory_order_acquire) == read_index + 1;
+    }
+
+    /// Whether no slot of the ring has been claimed by a writer and not read yet
+    bool IsRingEmpty() const {
+        return write_index.load(std::memory_order_acquire) == read_index;
+    }
+
+    /// Moves from t only if the element was pushed
+    template <typename Arg>
+    bool TryPush(Arg& t) {
+        std::size_t pos = write_index.load(std::memory_order_relaxed);
+        while (true) {
+            Cell& cell = cells[pos % capacity];
+            const std::size_t sequence = cell.sequence.load(std::memory_order_acquire);
+            if (sequence == pos) {
+                if (write_index.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed)) {
+                    cell.value = std::forward<Arg>(t);
+                    cell.sequence.store(pos + 1, std::memory_order_release);
+                    return true;
+                }
+            } else if (sequence < pos) {
+                // The slot still holds an element from the previous lap, so the ring is full
+                return false;
+            } else {
+                pos = write_index.load(std::memory_order_relaxed);
+            }
+        }
+    }
+
+    std::unique_ptr<Cell[]> cells;
+    alignas(128) std::atomic<std::size_t> write_index{0};
+    alignas(128) std::size_t read_index = 0;
+
+    alignas(128) std::atomic<std::size_t> overflow_size{0};
+    std::mutex overflow_mutex;
+    std::deque<T> overflow;
+
+    std::atomic_bool reader_waiting{false};
+    std::mutex wait_mutex;
+    std::condition_variable cv;
+};
 } // namespace Common
@@ -6,8 +6,17 @@
 
 #include <atomic>
 #include <memory>
+#include <string>
+#include <vector>
+#include "common/common_types.h"
 #include "core/cheats/cheat_base.h"
 
+class ARM_Interface;
+
+namespace Memory {
+class MemorySystem;
+} // namespace Memory
+
 namespace Cheats {
 class GatewayCheat final : public CheatBase {
 public:
@@ -53,11 +62,24 @@ public:
         bool valid = true;
     };
 
+    /// A cheat line decoded for execution. The data lines of a Patch code are folded into the
+    /// code they belong to and invalid lines are dropped, so every instruction is an opcode.
+    struct Instruction {
+        CheatType type;
+        u32 address;
+        u32 value;
+        /// For Patch codes, the index of the first data word in patch_data
+        u32 data_index;
+    };
+
     GatewayCheat(std::string name, std::vector<CheatLine> cheat_lines, std::string comments);
     GatewayCheat(std::string name, std::string code, std::string comments);
     ~GatewayCheat();
 
     void Execute(Core::System& system) const override;
+    /// Runs the compiled cheat against the given memory. Every range written to is invalidated in
+    /// the CPU's cache and Joker codes compare against pad_state.
+    void Execute(Memory::MemorySystem& memory, ARM_Interface& cpu, u32 pad_state) const;
 
     bool IsEnabled() const override;
     void SetEnabled(bool enabled) override;
@@ -78,9 +100,18 @@ public:
     static std::vector<std::unique_ptr<CheatBase>> LoadFile(const std::string& filepath);
 
 private:
+    /// Decodes cheat_lines into the program that is run on every Execute
+    void Compile();
+
     std::atomic<bool> enabled = false;
     const std::string name;
     std::vector<CheatLine> cheat_lines;
     const std::string comments;
+
+    std::vector<Instruction> program;
+    /// The words following every Patch code, in the order they are written
+    std::vector<u32> patch_data;
+    /// Whether the pad state has to be read for Joker codes
+    bool has_joker = false;
 };
 } // namespace Cheats
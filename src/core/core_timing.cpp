@@ -20,6 +20,100 @@ bool Timing::Event::operator<(const Event& right) const {
     return std::tie(time, fifo_order) < std::tie(right.time, right.fifo_order);
 }
 
+Timing::EventNode* Timing::Meld(EventNode* a, EventNode* b) {
+    if (!a)
+        return b;
+    if (!b)
+        return a;
+    if (b->event < a->event)
+        std::swap(a, b);
+
+    // b becomes the leftmost child of a
+    b->prev = a;
+    b->sibling = a->child;
+    if (a->child)
+        a->child->prev = b;
+    a->child = b;
+    return a;
+}
+
+Timing::EventNode* Timing::MergePairs(EventNode* first) {
+    // First pass: meld the subtrees in pairs from left to right, collecting them in reverse
+    EventNode* pairs = nullptr;
+    while (first) {
+        EventNode* a = first;
+        EventNode* b = a->sibling;
+        first = b ? b->sibling : nullptr;
+
+        a->sibling = a->prev = nullptr;
+        if (b)
+            b->sibling = b->prev = nullptr;
+
+        EventNode* pair = Meld(a, b);
+        pair->sibling = pairs;
+        pairs = pair;
+    }
+
+    // Second pass: meld the pairs from right to left
+    EventNode* root = nullptr;
+    while (pairs) {
+        EventNode* next = pairs->sibling;
+        pairs->sibling = nullptr;
+        root = Meld(root, pairs);
+        pairs = next;
+    }
+    return root;
+}
+
+void Timing::InsertEvent(const Event& event) {
+    EventNode* node;
+    if (free_event_nodes) {
+        node = free_event_nodes;
+        free_event_nodes = node->sibling;
+    } else {
+        node = &event_nodes.emplace_back();
+    }
+
+    node->event = event;
+    node->child = node->sibling = node->prev = nullptr;
+
+    EventNode*& type_head = scheduled_events[event.type];
+    node->type_head = &type_head;
+    node->type_prev = nullptr;
+    node->type_next = type_head;
+    if (type_head)
+        type_head->type_prev = node;
+    type_head = node;
+
+    event_queue = Meld(event_queue, node);
+}
+
+void Timing::EraseEvent(EventNode* node) {
+    if (node == event_queue) {
+        event_queue = MergePairs(node->child);
+    } else {
+        // Cut the subtree out of its parent and meld it back into the queue
+        if (node->prev->child == node)
+            node->prev->child = node->sibling;
+        else
+            node->prev->sibling = node->sibling;
+        if (node->sibling)
+            node->sibling->prev = node->prev;
+
+        event_queue = Meld(event_queue, MergePairs(node->child));
+    }
+
+    if (node->type_prev)
+        node->type_prev->type_next = node->type_next;
+    else
+        *node->type_head = node->type_next;
+    if (node->type_next)
+        node->type_next->type_prev = node->type_prev;
+
+    node->sibling = free_event_nodes;
+    free_event_nodes = node;
+}
+
 TimingEventType* Timing::RegisterEvent(const std::string& name, TimedCallback callback) {
     // check for existing type with same name.
     // we want event type names to remain unique so that we can use them for serialization.
@@ -63,8 +157,7 @@ void Timing::ScheduleEvent(s64 cycles_into_future, const TimingEventType* event_
     if (!is_global_timer_sane)
         ForceExceptionCheck(cycles_into_future);
 
-    event_queue.emplace_back(Event{timeout, event_fifo_id++, userdata, event_type});
-    std::push_heap(event_queue.begin(), event_queue.end(), std::greater<>());
+    InsertEvent(Event{timeout, event_fifo_id++, userdata, event_type});
 }
 
 void Timing::ScheduleEventThreadsafe(s64 cycles_into_future, const TimingEventType* event_type,
@@ -73,26 +166,25 @@ void Timing::ScheduleEventThreadsafe(s64 cycles_into_future, const TimingEventTy
 }
 
 void Timing::UnscheduleEvent(const TimingEventType* event_type, u64 userdata) {
-    auto itr = std::remove_if(event_queue.begin(), event_queue.end(), [&](const Event& e) {
-        return e.type == event_type && e.userdata == userdata;
-    });
-
-    // Removing random items breaks the invariant so we have to re-establish it.
-    if (itr != event_queue.end()) {
-        event_queue.erase(itr, event_queue.end());
-        std::make_heap(event_queue.begin(), event_queue.end(), std::greater<>());
+    const auto it = scheduled_events.find(event_type);
+    if (it == scheduled_events.end())
+        return;
+
+    for (EventNode* node = it->second; node;) {
+        EventNode* next = node->type_next;
+        if (node->event.userdata == userdata)
+            EraseEvent(node);
+        node = next;
     }
 }
 
 void Timing::RemoveEvent(const TimingEventType* event_type) {
-    auto itr = std::remove_if(event_queue.begin(), event_queue.end(),
-                              [&](const Event& e) { return e.type == event_type; });
+    const auto it = scheduled_events.find(event_type);
+    if (it == scheduled_events.end())
+        return;
 
-    // Removing random items breaks the invariant so we have to re-establish it.
-    if (itr != event_queue.end()) {
-        event_queue.erase(itr, event_queue.end());
-        std::make_heap(event_queue.begin(), event_queue.end(), std::greater<>());
-    }
+    while (it->second)
+        EraseEvent(it->second);
 }
 
 void Timing::RemoveNormalAndThreadsafeEvent(const TimingEventType* event_type) {
@@ -111,8 +203,7 @@ void Timing::ForceExceptionCheck(s64 cycles) {
 void Timing::MoveEvents() {
     for (Event ev; ts_queue.Pop(ev);) {
         ev.fifo_order = event_fifo_id++;
-        event_queue.emplace_back(std::move(ev));
-        std::push_heap(event_queue.begin(), event_queue.end(), std::greater<>());
+        InsertEvent(ev);
     }
 }
 
@@ -125,19 +216,18 @@ void Timing::Advance() {
 
     is_global_timer_sane = true;
 
-    while (!event_queue.empty() && event_queue.front().time <= global_timer) {
-        Event evt = std::move(event_queue.front());
-        std::pop_heap(event_queue.begin(), event_queue.end(), std::greater<>());
-        event_queue.pop_back();
+    while (event_queue && event_queue->event.time <= global_timer) {
+        const Event evt = event_queue->event;
+        EraseEvent(event_queue);
         evt.type->callback(evt.userdata, global_timer - evt.time);
     }
 
     is_global_timer_sane = false;
 
     // Still events left (scheduled in the future)
-    if (!event_queue.empty()) {
+    if (event_queue) {
         slice_length = static_cast<int>(
-            std::min<s64>(event_queue.front().time - global_timer, MAX_SLICE_LENGTH));
+            std::min<s64>(event_queue->event.time - global_timer, MAX_SLICE_LENGTH));
     }
 
     downcount = slice_length;
@@ -18,6 +18,7 @@
  */
 
 #include <chrono>
+#include <deque>
 #include <functional>
 #include <limits>
 #include <string>
@@ -200,6 +201,25 @@ private:
         bool operator<(const Event& right) const;
     };
 
+    /// Node of the event queue. Nodes are pooled and recycled, so their addresses are stable.
+    struct EventNode {
+        Event event;
+        // Pairing heap links. prev points to the parent for the leftmost child.
+        EventNode* child;
+        EventNode* sibling;
+        EventNode* prev;
+        // Links of the list of scheduled events with the same type
+        EventNode* type_next;
+        EventNode* type_prev;
+        EventNode** type_head;
+    };
+
+    static EventNode* Meld(EventNode* a, EventNode* b);
+    static EventNode* MergePairs(EventNode* first);
+
+    void InsertEvent(const Event& event);
+    void EraseEvent(EventNode* node);
+
     static constexpr int MAX_SLICE_LENGTH = 20000;
 
     s64 global_timer = 0;
@@ -210,15 +230,18 @@ private:
     // elements remain stable regardless of rehashes/resizing.
     std::unordered_map<std::string, TimingEventType> event_types;
 
-    // The queue is a min-heap using std::make_heap/push_heap/pop_heap.
-    // We don't use std::priority_queue because we need to be able to serialize, unserialize and
-    // erase arbitrary events (RemoveEvent()) regardless of the queue order. These aren't
-    // accomodated by the standard adaptor class.
-    std::vector<Event> event_queue;
+    // The queue is a pairing heap ordered by time and then by the order the events were added,
+    // which makes insertion O(1) and removal of arbitrary events O(log n) amortized. Events are
+    // additionally linked per type so that UnscheduleEvent/RemoveEvent don't have to search the
+    // whole queue.
+    EventNode* event_queue = nullptr;
+    std::unordered_map<const TimingEventType*, EventNode*> scheduled_events;
+    std::deque<EventNode> event_nodes;
+    EventNode* free_event_nodes = nullptr;
     u64 event_fifo_id = 0;
     // the queue for storing the events from other threads threadsafe until they will be added
     // to the event_queue by the emu thread
-    Common::MPSCQueue<Event> ts_queue;
+    Common::BoundedMPSCQueue<Event, 256> ts_queue;
     s64 idled_cycles = 0;
 
     // Are we in a function that has been called from Advance()
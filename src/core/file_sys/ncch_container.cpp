@@ -9,6 +9,7 @@
 #include <cryptopp/modes.h>
 #include <cryptopp/sha.h>
 #include "common/common_types.h"
+#include "common/hash.h"
 #include "common/logging/log.h"
 #include "core/core.h"
 #include "core/file_sys/ncch_container.h"
@@ -553,6 +554,49 @@ Loader::ResultStatus NCCHContainer::LoadSectionExeFS(const char* name, std::vect
     return Loader::ResultStatus::ErrorNotUsed;
 }
 
+Loader::ResultStatus NCCHContainer::LoadCodeImage(u32 bss_page_size, std::vector<u8>& code) {
+    Loader::ResultStatus result = LoadSectionExeFS(".code", code);
+    if (result != Loader::ResultStatus::Success)
+        return result;
+
+    code.resize(code.size() + bss_page_size, 0);
+
+    // Apply any IPS patch now that the entire codeset (including .bss) has been allocated
+    ApplyIPSPatch(code);
+    return Loader::ResultStatus::Success;
+}
+
+Loader::ResultStatus NCCHContainer::ReadCodeHash(u64& code_hash) {
+    Loader::ResultStatus result = Load();
+    if (result != Loader::ResultStatus::Success)
+        return result;
+
+    if (!has_exefs)
+        return Loader::ResultStatus::ErrorNotUsed;
+
+    // An extracted code.bin can change without any of the headers changing
+    if (FileUtil::Exists(filepath + ".exefsdir/code.bin"))
+        return Loader::ResultStatus::ErrorNotUsed;
+
+    std::vector<u8> data(sizeof(NCCH_Header) + sizeof(ExHeader_Header) + sizeof(ExeFs_Header));
+    std::memcpy(data.data(), &ncch_header, sizeof(NCCH_Header));
+    std::memcpy(data.data() + sizeof(NCCH_Header), &exheader_header, sizeof(ExHeader_Header));
+    std::memcpy(data.data() + sizeof(NCCH_Header) + sizeof(ExHeader_Header), &exefs_header,
+                sizeof(ExeFs_Header));
+
+    FileUtil::IOFile ips_file{filepath + ".exefsdir/code.ips", "rb"};
+    if (ips_file) {
+        const std::size_t header_size = data.size();
+        data.resize(header_size + ips_file.GetSize());
+        if (ips_file.ReadBytes(data.data() + header_size, data.size() - header_size) !=
+            data.size() - header_size)
+            return Loader::ResultStatus::Error;
+    }
+
+    code_hash = Common::ComputeHash64(data.data(), data.size());
+    return Loader::ResultStatus::Success;
+}
+
 bool NCCHContainer::ApplyIPSPatch(std::vector<u8>& code) const {
     const std::string override_ips = filepath + ".exefsdir/code.ips";
 
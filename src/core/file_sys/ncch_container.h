@@ -271,6 +271,22 @@ public:
      */
     Loader::ResultStatus ReadExtdataId(u64& extdata_id);
 
+    /**
+     * Load the code image for booting: .code followed by the .bss, with the IPS patch applied
+     * @param bss_page_size Size of the .bss, rounded up to whole pages
+     * @param code Buffer the code image is read into
+     * @return ResultStatus result of function
+     */
+    Loader::ResultStatus LoadCodeImage(u32 bss_page_size, std::vector<u8>& code);
+
+    /**
+     * Get a hash identifying the .code section as it is loaded for booting, including its IPS
+     * patch. It covers the NCCH header, the ExHeader and the ExeFS header, which carry the
+     * SHA-256 of every section, so the section itself does not have to be read.
+     * @return ResultStatus result of function, ErrorNotUsed if .code is replaced by an override
+     */
+    Loader::ResultStatus ReadCodeHash(u64& code_hash);
+
     /**
      * Apply an IPS patch for .code (if it exists).
      * This should only be called after allocating .bss.
@@ -1,6 +1,7 @@
 #pragma once
 
 #include <array>
+#include <mutex>
 #include "common/common_types.h"
 #include "common/file_util.h"
 
@@ -22,10 +23,12 @@ public:
         return data_size;
     }
 
+    /// Thread-safe, the same reader is shared by all files opened from a RomFS.
     std::size_t ReadFile(std::size_t offset, std::size_t length, u8* buffer);
 
 private:
     bool is_encrypted;
+    std::mutex file_mutex;
     FileUtil::IOFile file;
     std::array<u8, 16> key;
     std::array<u8, 16> ctr;
@@ -237,6 +237,12 @@ public:
     /// Reports an unimplemented function.
     void ReportUnimplemented() const;
 
+    /**
+     * Prepares the context for a new request while keeping the storage allocated by previous
+     * ones. Passing a null session releases all references held by the context.
+     */
+    void Reset(std::shared_ptr<ServerSession> session, Thread* thread);
+
 private:
     KernelSystem& kernel;
     std::array<u32, IPC::COMMAND_BUFFER_LENGTH> cmd_buf;
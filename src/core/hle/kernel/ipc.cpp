@@ -17,6 +17,53 @@
 
 namespace Kernel {
 
+// Keep enough free guard pages around for a few requests with several mapped buffers each.
+constexpr std::size_t MAX_FREE_GUARD_PAGES = 64;
+
+std::unique_ptr<u8[]> IPCGuardPagePool::Acquire() {
+    if (free_pages.empty())
+        return std::make_unique<u8[]>(Memory::PAGE_SIZE);
+
+    auto page = std::move(free_pages.back());
+    free_pages.pop_back();
+    return page;
+}
+
+void IPCGuardPagePool::Release(std::unique_ptr<u8[]> page) {
+    if (page && free_pages.size() < MAX_FREE_GUARD_PAGES)
+        free_pages.push_back(std::move(page));
+}
+
+/**
+ * Returns the host memory backing a page-aligned range of a process if the range can be mapped
+ * into another process as is, or nullptr if the data has to be copied. This requires the range to
+ * be backed by a single contiguous block of FCRAM, none of which is tracked by the rasterizer
+ * cache.
+ */
+static u8* GetAliasableMemory(Memory::MemorySystem& memory, const Process& process, VAddr address,
+                              u32 size) {
+    if (address + size > VMManager::MAX_ADDRESS)
+        return nullptr;
+
+    const VirtualMemoryArea& vma = process.vm_manager.FindVMA(address)->second;
+    if (vma.type != VMAType::BackingMemory || address + size > vma.base + vma.size)
+        return nullptr;
+
+    u8* const backing_memory = vma.backing_memory + (address - vma.base);
+    const u8* const fcram_begin = memory.GetFCRAMPointer(0);
+    const u8* const fcram_end = fcram_begin + Memory::FCRAM_N3DS_SIZE;
+    if (backing_memory < fcram_begin || backing_memory + size > fcram_end)
+        return nullptr;
+
+    const auto& attributes = process.vm_manager.page_table.attributes;
+    for (VAddr page = address; page < address + size; page += Memory::PAGE_SIZE) {
+        if (attributes[page >> Memory::PAGE_BITS] != Memory::PageType::Memory)
+            return nullptr;
+    }
+
+    return backing_memory;
+}
+
 ResultCode TranslateCommandBuffer(Kernel::KernelSystem& kernel, Memory::MemorySystem& memory,
                                   std::shared_ptr<Thread> src_thread,
                                   std::shared_ptr<Thread> dst_thread, VAddr src_address,
@@ -162,11 +209,17 @@ ResultCode TranslateCommandBuffer(Kernel::KernelSystem& kernel, Memory::MemorySy
                 ASSERT(found != mapped_buffer_context.end());
 
                 if (permissions != IPC::MappedBufferPermissions::R) {
-                    // Copy the modified buffer back into the target process
-                    // NOTE: As this is a reply the "source" is the destination and the
-                    //       "target" is the source.
-                    memory.CopyBlock(*dst_process, *src_process, found->source_address,
-                                     found->target_address, size);
+                    if (found->aliased_address != 0) {
+                        // The data was modified in place, but the writes bypassed the rasterizer
+                        // cache of the target process.
+                        Memory::RasterizerInvalidateRegion(found->aliased_address, size);
+                    } else {
+                        // Copy the modified buffer back into the target process
+                        // NOTE: As this is a reply the "source" is the destination and the
+                        //       "target" is the source.
+                        memory.CopyBlock(*dst_process, *src_process, found->source_address,
+                                         found->target_address, size);
+                    }
                 }
 
                 VAddr prev_reserve = page_start - Memory::PAGE_SIZE;
@@ -182,6 +235,7 @@ ResultCode TranslateCommandBuffer(Kernel::KernelSystem& kernel, Memory::MemorySy
                     page_start - Memory::PAGE_SIZE, (num_pages + 2) * Memory::PAGE_SIZE);
                 ASSERT(result == RESULT_SUCCESS);
 
+                kernel.GetIPCGuardPagePool().Release(std::move(found->reserve_buffer));
                 mapped_buffer_context.erase(found);
 
                 i += 1;
@@ -193,19 +247,36 @@ ResultCode TranslateCommandBuffer(Kernel::KernelSystem& kernel, Memory::MemorySy
             // TODO(Subv): Perform permission checks.
 
             // Reserve a page of memory before the mapped buffer
-            auto reserve_buffer = std::make_unique<u8[]>(Memory::PAGE_SIZE);
+            auto reserve_buffer = kernel.GetIPCGuardPagePool().Acquire();
             dst_process->vm_manager.MapBackingMemoryToBase(
                 Memory::IPC_MAPPING_VADDR, Memory::IPC_MAPPING_SIZE, reserve_buffer.get(),
                 Memory::PAGE_SIZE, Kernel::MemoryState::Reserved);
 
-            auto buffer = std::make_unique<u8[]>(num_pages * Memory::PAGE_SIZE);
-            memory.ReadBlock(*src_process, source_address, buffer.get() + page_offset, size);
+            // When possible, the target maps the source pages themselves, otherwise it gets a copy
+            // of the data which is written back on reply. Read-only buffers are always copied, as
+            // the target's writes to them must not reach the source, and so are buffers which
+            // don't cover whole pages, as the target mustn't access the memory around them.
+            const u32 buffer_size = num_pages * Memory::PAGE_SIZE;
+            const bool can_alias = permissions != IPC::MappedBufferPermissions::R &&
+                                   page_offset == 0 && size == buffer_size;
+            std::unique_ptr<u8[]> buffer;
+            PAddr aliased_address = 0;
+            u8* backing_memory =
+                can_alias ? GetAliasableMemory(memory, *src_process, page_start, buffer_size)
+                          : nullptr;
+            if (backing_memory != nullptr) {
+                aliased_address = Memory::FCRAM_PADDR + memory.GetFCRAMOffset(backing_memory);
+            } else {
+                buffer = std::make_unique<u8[]>(buffer_size);
+                memory.ReadBlock(*src_process, source_address, buffer.get() + page_offset, size);
+                backing_memory = buffer.get();
+            }
 
             // Map the page(s) into the target process' address space.
             target_address =
                 dst_process->vm_manager
                     .MapBackingMemoryToBase(Memory::IPC_MAPPING_VADDR, Memory::IPC_MAPPING_SIZE,
-                                            buffer.get(), num_pages * Memory::PAGE_SIZE,
+                                            backing_memory, buffer_size,
                                             Kernel::MemoryState::Shared)
                     .Unwrap();
 
@@ -217,8 +288,8 @@ ResultCode TranslateCommandBuffer(Kernel::KernelSystem& kernel, Memory::MemorySy
                 Memory::PAGE_SIZE, Kernel::MemoryState::Reserved);
 
             mapped_buffer_context.push_back({permissions, size, source_address,
-                                             target_address + page_offset, std::move(buffer),
-                                             std::move(reserve_buffer)});
+                                             target_address + page_offset, aliased_address,
+                                             std::move(buffer), std::move(reserve_buffer)});
 
             break;
         }
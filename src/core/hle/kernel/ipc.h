@@ -24,10 +24,27 @@ struct MappedBufferContext {
     VAddr source_address;
     VAddr target_address;
 
+    /// Physical address of the source data if the target maps the source pages directly, or 0 if
+    /// the data was copied into `buffer`.
+    PAddr aliased_address;
+
     std::unique_ptr<u8[]> buffer;
     std::unique_ptr<u8[]> reserve_buffer;
 };
 
+/**
+ * Recycles the pages backing the reserved guard pages that surround each IPC mapped buffer, so
+ * that translating a mapped buffer does not need to allocate them every time.
+ */
+class IPCGuardPagePool {
+public:
+    std::unique_ptr<u8[]> Acquire();
+    void Release(std::unique_ptr<u8[]> page);
+
+private:
+    std::vector<std::unique_ptr<u8[]>> free_pages;
+};
+
 /// Performs IPC command buffer translation from one process to another.
 ResultCode TranslateCommandBuffer(KernelSystem& system, Memory::MemorySystem& memory,
                                   std::shared_ptr<Thread> src_thread,
@@ -47,6 +47,7 @@ class Thread;
 class Semaphore;
 class Timer;
 class ClientPort;
+class IPCGuardPagePool;
 class ServerPort;
 class ClientSession;
 class ServerSession;
@@ -229,6 +230,8 @@ public:
     IPCDebugger::Recorder& GetIPCRecorder();
     const IPCDebugger::Recorder& GetIPCRecorder() const;
 
+    IPCGuardPagePool& GetIPCGuardPagePool();
+
     MemoryRegionInfo* GetMemoryRegion(MemoryRegion region);
 
     void HandleSpecialMapping(VMManager& address_space, const AddressMapping& mapping);
@@ -283,6 +286,7 @@ private:
     std::unique_ptr<SharedPage::Handler> shared_page_handler;
 
     std::unique_ptr<IPCDebugger::Recorder> ipc_recorder;
+    std::unique_ptr<IPCGuardPagePool> ipc_guard_page_pool;
 };
 
 } // namespace Kernel
@@ -4,6 +4,7 @@
 
 #include <tuple>
 
+#include "common/microprofile.h"
 #include "core/hle/kernel/client_port.h"
 #include "core/hle/kernel/client_session.h"
 #include "core/hle/kernel/hle_ipc.h"
@@ -60,6 +61,9 @@ void ServerSession::Acquire(Thread* thread) {
     pending_requesting_threads.pop_back();
 }
 
+MICROPROFILE_DEFINE(Kernel_HLEAllocation, "Kernel", "HLE context allocation",
+                    MP_RGB(200, 70, 70));
+
 ResultCode ServerSession::HandleSyncRequest(std::shared_ptr<Thread> thread) {
     // The ServerSession received a sync request, this means that there's new data available
     // from its ClientSession, so wake up any threads that may be waiting on a svcReplyAndReceive or
@@ -72,7 +76,19 @@ ResultCode ServerSession::HandleSyncRequest(std::shared_ptr<Thread> thread) {
         kernel.memory.ReadBlock(*current_process, thread->GetCommandBufferAddress(), cmd_buf.data(),
                                 cmd_buf.size() * sizeof(u32));
 
-        Kernel::HLERequestContext context(kernel, SharedFrom(this), thread.get());
+        // Keeps the session alive until the end of the request, even if the handler closes it.
+        std::shared_ptr<ServerSession> session = SharedFrom(this);
+
+        // Take the pooled context for the duration of the request. It is only missing the first
+        // time, or if the handler somehow made another request on this session.
+        std::unique_ptr<HLERequestContext> context_holder = std::move(hle_context);
+        if (context_holder == nullptr) {
+            MICROPROFILE_SCOPE(Kernel_HLEAllocation);
+            context_holder = std::make_unique<HLERequestContext>(kernel, session, thread.get());
+        } else {
+            context_holder->Reset(session, thread.get());
+        }
+        HLERequestContext& context = *context_holder;
         context.PopulateFromIncomingCommandBuffer(cmd_buf.data(), *current_process);
 
         hle_handler->HandleSyncRequest(context);
@@ -87,6 +103,11 @@ ResultCode ServerSession::HandleSyncRequest(std::shared_ptr<Thread> thread) {
             kernel.memory.WriteBlock(*current_process, thread->GetCommandBufferAddress(),
                                      cmd_buf.data(), cmd_buf.size() * sizeof(u32));
         }
+
+        // Drop the references held by the context before returning it to the pool, otherwise the
+        // session would keep itself alive.
+        context.Reset(nullptr, nullptr);
+        hle_context = std::move(context_holder);
     }
 
     if (thread->status == ThreadStatus::Running) {
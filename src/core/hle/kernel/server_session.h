@@ -18,6 +18,7 @@ namespace Kernel {
 
 class ClientSession;
 class ClientPort;
+class HLERequestContext;
 class ServerSession;
 class Session;
 class SessionRequestHandler;
@@ -103,6 +104,10 @@ private:
 
     friend class KernelSystem;
     KernelSystem& kernel;
+
+    /// Request context reused by the HLE handler across requests, so that its storage does not
+    /// have to be allocated for every request.
+    std::unique_ptr<HLERequestContext> hle_context;
 };
 
 } // namespace Kernel
@@ -12,6 +12,9 @@
 
 namespace Kernel {
 
+// Upper bound on the number of map nodes kept for reuse by each VMManager
+constexpr std::size_t MAX_SPARE_NODES = 64;
+
 static const char* GetMemoryStateName(MemoryState state) {
     static const char* names[] = {
         "Free",   "Reserved",   "IO",      "Static", "Code",      "Private",
@@ -177,15 +180,26 @@ VMManager::VMAIter VMManager::Unmap(VMAIter vma_handle) {
 }
 
 ResultCode VMManager::UnmapRange(VAddr target, u32 size) {
-    CASCADE_RESULT(VMAIter vma, CarveVMARange(target, size));
+    // Fast path for the common case of unmapping exactly what an earlier call mapped.
+    VMAIter vma = StripIterConstness(FindVMA(target));
+    if (vma != vma_map.end() && vma->second.base == target && vma->second.size == size &&
+        vma->second.type != VMAType::Free) {
+        Unmap(vma);
+        return RESULT_SUCCESS;
+    }
+
+    CASCADE_RESULT(vma, CarveVMARange(target, size));
     const VAddr target_end = target + size;
 
-    const VMAIter end = vma_map.end();
-    // The comparison against the end of the range must be done using addresses since VMAs can be
-    // merged during this process, causing invalidation of the iterators.
-    while (vma != end && vma->second.base < target_end) {
-        vma = std::next(Unmap(vma));
+    // The range now consists of whole VMAs. Fold them into the first one, so that the page table
+    // update and the merge with the neighbouring free areas happen once for the whole range.
+    VMAIter next = std::next(vma);
+    while (next != vma_map.end() && next->second.base < target_end) {
+        const VMAIter current = next++;
+        EraseVMA(current);
     }
+    vma->second.size = size;
+    Unmap(vma);
 
     ASSERT(FindVMA(target)->second.size >= size);
     return RESULT_SUCCESS;
@@ -323,21 +337,21 @@ VMManager::VMAIter VMManager::SplitVMA(VMAIter vma_handle, u32 offset_in_vma) {
 
     ASSERT(old_vma.CanBeMergedWith(new_vma));
 
-    return vma_map.emplace_hint(std::next(vma_handle), new_vma.base, new_vma);
+    return InsertVMA(std::next(vma_handle), new_vma);
 }
 
 VMManager::VMAIter VMManager::MergeAdjacent(VMAIter iter) {
     const VMAIter next_vma = std::next(iter);
     if (next_vma != vma_map.end() && iter->second.CanBeMergedWith(next_vma->second)) {
         iter->second.size += next_vma->second.size;
-        vma_map.erase(next_vma);
+        EraseVMA(next_vma);
     }
 
     if (iter != vma_map.begin()) {
         VMAIter prev_vma = std::prev(iter);
         if (prev_vma->second.CanBeMergedWith(iter->second)) {
             prev_vma->second.size += iter->second.size;
-            vma_map.erase(iter);
+            EraseVMA(iter);
             iter = prev_vma;
         }
     }
@@ -345,6 +359,25 @@ VMManager::VMAIter VMManager::MergeAdjacent(VMAIter iter) {
     return iter;
 }
 
+VMManager::VMAIter VMManager::InsertVMA(VMAIter hint, const VirtualMemoryArea& vma) {
+    if (spare_nodes.empty())
+        return vma_map.emplace_hint(hint, vma.base, vma);
+
+    auto node = std::move(spare_nodes.back());
+    spare_nodes.pop_back();
+    node.key() = vma.base;
+    node.mapped() = vma;
+    return vma_map.insert(hint, std::move(node));
+}
+
+void VMManager::EraseVMA(VMAIter vma) {
+    if (spare_nodes.size() < MAX_SPARE_NODES) {
+        spare_nodes.push_back(vma_map.extract(vma));
+    } else {
+        vma_map.erase(vma);
+    }
+}
+
 void VMManager::UpdatePageTableForVMA(const VirtualMemoryArea& vma) {
     switch (vma.type) {
     case VMAType::Free:
@@ -363,9 +396,10 @@ ResultVal<std::vector<std::pair<u8*, u32>>> VMManager::GetBackingBlocksForRange(
                                                                                 u32 size) {
     std::vector<std::pair<u8*, u32>> backing_blocks;
     VAddr interval_target = address;
-    while (interval_target != address + size) {
-        auto vma = FindVMA(interval_target);
-        if (vma->second.type != VMAType::BackingMemory) {
+    // The VMAs covering the range are consecutive, so only the first one needs to be looked up.
+    auto vma = FindVMA(interval_target);
+    for (; interval_target != address + size; ++vma) {
+        if (vma == vma_map.end() || vma->second.type != VMAType::BackingMemory) {
             LOG_ERROR(Kernel, "Trying to use already freed memory");
             return ERR_INVALID_ADDRESS_STATE;
         }
@@ -225,9 +225,19 @@ private:
      */
     VMAIter MergeAdjacent(VMAIter vma);
 
+    /// Inserts a VMA at the position given by `hint`, reusing a spare map node if there is one.
+    VMAIter InsertVMA(VMAIter hint, const VirtualMemoryArea& vma);
+
+    /// Removes a VMA from the map, keeping its node around for a later InsertVMA.
+    void EraseVMA(VMAIter vma);
+
     /// Updates the pages corresponding to this VMA so they match the VMA's attributes.
     void UpdatePageTableForVMA(const VirtualMemoryArea& vma);
 
     Memory::MemorySystem& memory;
+
+    /// Map nodes of erased VMAs. Splits and merges come in pairs most of the time, so recycling
+    /// the nodes avoids an allocation for nearly every split.
+    std::vector<decltype(vma_map)::node_type> spare_nodes;
 };
 } // namespace Kernel
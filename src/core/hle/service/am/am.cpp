@@ -3,15 +3,21 @@
 // Refer to the license.txt file included.
 
 #include <algorithm>
+#include <atomic>
+#include <chrono>
 #include <cinttypes>
 #include <cstddef>
 #include <cstring>
+#include <future>
+#include <thread>
 #include <cryptopp/aes.h>
 #include <cryptopp/modes.h>
+#include <cryptopp/sha.h>
 #include <fmt/format.h>
 #include "common/file_util.h"
 #include "common/logging/log.h"
 #include "common/string_util.h"
+#include "common/threadsafe_queue.h"
 #include "core/core.h"
 #include "core/file_sys/errors.h"
 #include "core/file_sys/ncch_container.h"
@@ -81,8 +87,31 @@ public:
     std::vector<CryptoPP::CBC_Mode<CryptoPP::AES>::Decryption> content;
 };
 
+class CIAFile::ContentState {
+public:
+    std::vector<FileUtil::IOFile> files;
+    std::vector<CryptoPP::SHA256> hashes;
+
+    // Scratch space for decrypted content data, reused across writes
+    std::vector<u8> buffer;
+
+    void CloseAll() {
+        for (auto& file : files) {
+            file.Close();
+        }
+    }
+};
+
+constexpr ResultCode ERROR_CONTENT_HASH_MISMATCH(ErrorDescription::InvalidResultValue,
+                                                 ErrorModule::AM, ErrorSummary::InvalidArgument,
+                                                 ErrorLevel::Permanent);
+
+// Chunks at least this large are hashed on a separate thread while they are written to disk.
+constexpr std::size_t ASYNC_HASH_THRESHOLD = 0x100000;
+
 CIAFile::CIAFile(Service::FS::MediaType media_type)
-    : media_type(media_type), decryption_state(std::make_unique<DecryptionState>()) {}
+    : media_type(media_type), decryption_state(std::make_unique<DecryptionState>()),
+      content_state(std::make_unique<ContentState>()) {}
 
 CIAFile::~CIAFile() {
     Close();
@@ -131,6 +160,8 @@ ResultCode CIAFile::WriteTitleMetadata() {
 
     auto content_count = container.GetTitleMetadata().GetContentCount();
     content_written.resize(content_count);
+    content_state->files.resize(content_count);
+    content_state->hashes.resize(content_count);
 
     if (auto title_key = container.GetTicket().GetTitleKey()) {
         decryption_state->content.resize(content_count);
@@ -150,8 +181,9 @@ ResultVal<std::size_t> CIAFile::WriteContentData(u64 offset, std::size_t length,
     // Data is not being buffered, so we have to keep track of how much of each <ID>.app
     // has been written since we might get a written buffer which contains multiple .app
     // contents or only part of a larger .app's contents.
+    const FileSys::TitleMetadata& tmd = container.GetTitleMetadata();
     u64 offset_max = offset + length;
-    for (int i = 0; i < container.GetTitleMetadata().GetContentCount(); i++) {
+    for (u16 i = 0; i < tmd.GetContentCount(); i++) {
         if (content_written[i] < container.GetContentSize(i)) {
             // The size, minimum unwritten offset, and maximum unwritten offset of this content
             u64 size = container.GetContentSize(i);
@@ -164,32 +196,73 @@ ResultVal<std::size_t> CIAFile::WriteContentData(u64 offset, std::size_t length,
                 continue;
 
             // Figure out how much of this content ID we have just recieved/can write out
-            u64 available_to_write = std::min(offset_max, range_max) - range_min;
+            std::size_t available_to_write =
+                static_cast<std::size_t>(std::min(offset_max, range_max) - range_min);
+            if (available_to_write == 0)
+                continue;
 
             // Since the incoming TMD has already been written, we can use GetTitleContentPath
-            // to get the content paths to write to.
-            FileSys::TitleMetadata tmd = container.GetTitleMetadata();
-            FileUtil::IOFile file(GetTitleContentPath(media_type, tmd.GetTitleID(), i, is_update),
-                                  content_written[i] ? "ab" : "wb");
+            // to get the content paths to write to. The file stays open until the content is
+            // complete.
+            FileUtil::IOFile& file = content_state->files[i];
+            if (!file.IsOpen()) {
+                file.Open(GetTitleContentPath(media_type, tmd.GetTitleID(), i, is_update),
+                          content_written[i] ? "ab" : "wb");
+            }
 
             if (!file.IsOpen())
                 return FileSys::ERROR_INSUFFICIENT_SPACE;
 
-            std::vector<u8> temp(buffer + (range_min - offset),
-                                 buffer + (range_min - offset) + available_to_write);
+            const u8* content_data = buffer + (range_min - offset);
+            if (tmd.GetContentTypeByIndex(i) & FileSys::TMDContentTypeFlag::Encrypted) {
+                auto& decrypted = content_state->buffer;
+                if (decrypted.size() < available_to_write)
+                    decrypted.resize(available_to_write);
+                decryption_state->content[i].ProcessData(decrypted.data(), content_data,
+                                                         available_to_write);
+                content_data = decrypted.data();
+            }
 
-            if (tmd.GetContentTypeByIndex(static_cast<u16>(i)) &
-                FileSys::TMDContentTypeFlag::Encrypted) {
-                decryption_state->content[i].ProcessData(temp.data(), temp.data(), temp.size());
+            // The content hash covers the decrypted data, hash it while it is being written out.
+            CryptoPP::SHA256& hash = content_state->hashes[i];
+            std::future<void> hash_done;
+            if (available_to_write >= ASYNC_HASH_THRESHOLD) {
+                hash_done =
+                    std::async(std::launch::async, [&hash, content_data, available_to_write] {
+                        hash.Update(content_data, available_to_write);
+                    });
+            } else {
+                hash.Update(content_data, available_to_write);
             }
 
-            file.WriteBytes(temp.data(), temp.size());
+            std::size_t bytes_written = file.WriteBytes(content_data, available_to_write);
+            if (hash_done.valid())
+                hash_done.wait();
+
+            if (bytes_written != available_to_write)
+                return FileSys::ERROR_INSUFFICIENT_SPACE;
 
             // Keep tabs on how much of this content ID has been written so new range_min
             // values can be calculated.
             content_written[i] += available_to_write;
             LOG_DEBUG(Service_AM, "Wrote {:x} to content {}, total {:x}", available_to_write, i,
                       content_written[i]);
+
+            if (content_written[i] == size) {
+                file.Close();
+
+                std::array<u8, CryptoPP::SHA256::DIGESTSIZE> digest;
+                hash.Final(digest.data());
+                if (digest != tmd.GetContentHashByIndex(i)) {
+                    LOG_ERROR(Service_AM, "Hash mismatch in content {} ({:08x})", i,
+                              tmd.GetContentIDByIndex(i));
+                    // Discard the content so that the install is treated as incomplete.
+                    FileUtil::Delete(
+                        GetTitleContentPath(media_type, tmd.GetTitleID(), i, is_update));
+                    content_written[i] = 0;
+                    return ERROR_CONTENT_HASH_MISMATCH;
+                }
+            }
         }
     }
 
@@ -282,6 +355,8 @@ bool CIAFile::Close() const {
             complete = false;
     }
 
+    content_state->CloseAll();
+
     // Install aborted
     if (!complete) {
         LOG_ERROR(Service_AM, "CIAFile closed prematurely, aborting install...");
@@ -325,6 +400,10 @@ bool CIAFile::Close() const {
 
 void CIAFile::Flush() const {}
 
+// InstallCIA reads the source file in blocks of this size, keeping up to this many blocks in flight
+constexpr std::size_t INSTALL_BLOCK_SIZE = 0x400000;
+constexpr std::size_t INSTALL_BLOCK_COUNT = 3;
+
 InstallStatus InstallCIA(const std::string& path,
                          std::function<ProgressCallback>&& update_callback) {
     LOG_INFO(Service_AM, "Installing {}...", path);
@@ -354,25 +433,92 @@ InstallStatus InstallCIA(const std::string& path,
         if (!file.IsOpen())
             return InstallStatus::ErrorFailedToOpenFile;
 
-        std::array<u8, 0x10000> buffer;
+        // The source file is read on a separate thread so that reading overlaps decryption,
+        // hashing and writing of the previous block. Blocks cycle between the two queues.
+        struct Block {
+            std::vector<u8> data;
+            std::size_t size = 0;
+        };
+        Common::SPSCQueue<Block> free_blocks;
+        Common::SPSCQueue<Block> filled_blocks;
+        for (std::size_t i = 0; i < INSTALL_BLOCK_COUNT; i++) {
+            free_blocks.Push(Block{std::vector<u8>(INSTALL_BLOCK_SIZE)});
+        }
+
+        const std::size_t total_size = static_cast<std::size_t>(file.GetSize());
+        std::atomic<bool> stop_reading{false};
+        std::thread reader([&] {
+            std::size_t remaining = total_size;
+            while (true) {
+                Block block = free_blocks.PopWait();
+                if (stop_reading)
+                    return;
+
+                block.size = remaining ? file.ReadBytes(block.data.data(),
+                                                        std::min(remaining, block.data.size()))
+                                       : 0;
+                remaining -= block.size;
+
+                // An empty block marks the end of the file, or a read error.
+                const bool done = block.size == 0;
+                filled_blocks.Push(std::move(block));
+                if (done)
+                    return;
+            }
+        });
+
+        const auto stop_reader = [&] {
+            stop_reading = true;
+            free_blocks.Push(Block{});
+            reader.join();
+        };
+
+        using Clock = std::chrono::steady_clock;
+        const auto start_time = Clock::now();
+        auto last_report = start_time;
+        const auto megabytes_per_second = [&start_time](std::size_t bytes, Clock::time_point now) {
+            const std::chrono::duration<double> elapsed = now - start_time;
+            if (elapsed.count() <= 0)
+                return 0.0;
+            return static_cast<double>(bytes) / elapsed.count() / 0x100000;
+        };
+
         std::size_t total_bytes_read = 0;
-        while (total_bytes_read != file.GetSize()) {
-            std::size_t bytes_read = file.ReadBytes(buffer.data(), buffer.size());
-            auto result = installFile.Write(static_cast<u64>(total_bytes_read), bytes_read, true,
-                                            static_cast<u8*>(buffer.data()));
+        while (total_bytes_read != total_size) {
+            Block block = filled_blocks.PopWait();
+            if (block.size == 0) {
+                LOG_ERROR(Service_AM, "Failed to read {} at offset {:x}", path, total_bytes_read);
+                stop_reader();
+                return InstallStatus::ErrorAborted;
+            }
+
+            auto result = installFile.Write(static_cast<u64>(total_bytes_read), block.size, true,
+                                            block.data.data());
 
             if (update_callback)
-                update_callback(total_bytes_read, file.GetSize());
+                update_callback(total_bytes_read, total_size);
             if (result.Failed()) {
                 LOG_ERROR(Service_AM, "CIA file installation aborted with error code {:08x}",
                           result.Code().raw);
+                stop_reader();
                 return InstallStatus::ErrorAborted;
             }
-            total_bytes_read += bytes_read;
+            total_bytes_read += block.size;
+            free_blocks.Push(std::move(block));
+
+            const auto now = Clock::now();
+            if (now - last_report >= std::chrono::seconds(1)) {
+                last_report = now;
+                LOG_INFO(Service_AM, "Installing {}: {} / {} MiB ({:.1f} MiB/s)", path,
+                         total_bytes_read / 0x100000, total_size / 0x100000,
+                         megabytes_per_second(total_bytes_read, now));
+            }
         }
+        stop_reader();
         installFile.Close();
 
-        LOG_INFO(Service_AM, "Installed {} successfully.", path);
+        LOG_INFO(Service_AM, "Installed {} successfully ({:.1f} MiB/s).", path,
+                 megabytes_per_second(total_bytes_read, Clock::now()));
         return InstallStatus::Success;
     }
 
@@ -1157,6 +1303,8 @@ ResultVal<std::unique_ptr<AMFileWrapper>> GetFileFromSession(
             // File::OpenSubFile
             std::size_t offset = file->GetSessionFileOffset(server);
             std::size_t size = file->GetSessionFileSize(server);
+            // The wrapper accesses the backend directly
+            file->WaitForPendingRead();
             return MakeResult(std::make_unique<AMFileWrapper>(file, offset, size));
         }
 
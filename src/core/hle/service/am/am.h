@@ -94,6 +94,11 @@ private:
 
     class DecryptionState;
     std::unique_ptr<DecryptionState> decryption_state;
+
+    // Destination .app handles and running SHA-256 state of each content, kept open for the
+    // duration of the install
+    class ContentState;
+    std::unique_ptr<ContentState> content_state;
 };
 
 /**
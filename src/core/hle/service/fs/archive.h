@@ -14,6 +14,7 @@
 #include "core/hle/result.h"
 #include "core/hle/service/fs/directory.h"
 #include "core/hle/service/fs/file.h"
+#include "core/hle/service/fs/io_worker_pool.h"
 
 /// The unique system identifier hash, also known as ID0
 static constexpr char SYSTEM_ID[]{"00000000000000000000000000000000"};
@@ -233,6 +234,11 @@ public:
     /// Registers a new NCCH file with the SelfNCCH archive factory
     void RegisterSelfNCCH(Loader::AppLoader& app_loader);
 
+    /// Returns the threads that perform host I/O for opened files
+    IOWorkerPool& GetIOWorkerPool() {
+        return io_worker_pool;
+    }
+
 private:
     Core::System& system;
 
@@ -260,6 +266,8 @@ private:
      */
     std::unordered_map<ArchiveHandle, std::unique_ptr<ArchiveBackend>> handle_map;
     ArchiveHandle next_handle = 1;
+
+    IOWorkerPool io_worker_pool{2};
 };
 
 } // namespace Service::FS
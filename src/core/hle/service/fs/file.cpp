@@ -2,7 +2,11 @@
 // Licensed under GPLv2 or any later version
 // Refer to the license.txt file included.
 
+#include <condition_variable>
+#include <mutex>
+#include <vector>
 #include "common/logging/log.h"
+#include "common/microprofile.h"
 #include "core/core.h"
 #include "core/file_sys/errors.h"
 #include "core/file_sys/file_backend.h"
@@ -11,10 +15,33 @@
 #include "core/hle/kernel/client_session.h"
 #include "core/hle/kernel/event.h"
 #include "core/hle/kernel/server_session.h"
+#include "core/hle/service/fs/archive.h"
 #include "core/hle/service/fs/file.h"
 
 namespace Service::FS {
 
+/// A read that is performed on an I/O thread while the client thread sleeps for the read delay
+struct File::PendingRead {
+    std::vector<u8> data;
+    ResultVal<std::size_t> result;
+
+    std::mutex mutex;
+    std::condition_variable cv;
+    bool done = true;
+
+    void Complete(ResultVal<std::size_t> read) {
+        std::lock_guard lock{mutex};
+        result = std::move(read);
+        done = true;
+        cv.notify_all();
+    }
+
+    void Wait() {
+        std::unique_lock lock{mutex};
+        cv.wait(lock, [this] { return done; });
+    }
+};
+
 File::File(Core::System& system, std::unique_ptr<FileSys::FileBackend>&& backend,
            const FileSys::Path& path)
     : ServiceFramework("", 1), path(path), backend(std::move(backend)), system(system) {
@@ -33,6 +60,19 @@ File::File(Core::System& system, std::unique_ptr<FileSys::FileBackend>&& backend
     RegisterHandlers(functions);
 }
 
+File::~File() {
+    WaitForPendingRead();
+}
+
+MICROPROFILE_DEFINE(Service_FS_WaitForRead, "Service", "FS Wait for read", MP_RGB(255, 128, 64));
+
+void File::WaitForPendingRead() {
+    if (pending_read) {
+        MICROPROFILE_SCOPE(Service_FS_WaitForRead);
+        pending_read->Wait();
+    }
+}
+
 void File::Read(Kernel::HLERequestContext& ctx) {
     IPC::RequestParser rp(ctx, 0x0802, 3, 2);
     u64 offset = rp.Pop<u64>();
@@ -42,6 +82,9 @@ void File::Read(Kernel::HLERequestContext& ctx) {
 
     const FileSessionSlot* file = GetSessionData(ctx.Session());
 
+    // Another thread may still be reading from this file
+    WaitForPendingRead();
+
     if (file->subfile && length > file->size) {
         LOG_WARNING(Service_FS, "Trying to read beyond the subfile size, truncating");
         length = static_cast<u32>(file->size);
@@ -56,27 +99,43 @@ void File::Read(Kernel::HLERequestContext& ctx) {
                   offset, length, backend->GetSize());
     }
 
-    IPC::RequestBuilder rb = rp.MakeBuilder(2, 2);
-
-    std::vector<u8> data(length);
-    ResultVal<std::size_t> read = backend->Read(offset, data.size(), data.data());
-    if (read.Failed()) {
-        rb.Push(read.Code());
-        rb.Push<u32>(0);
-    } else {
-        buffer.Write(data.data(), 0, *read);
-        rb.Push(RESULT_SUCCESS);
-        rb.Push<u32>(static_cast<u32>(*read));
+    // The read is performed on an I/O thread while the client thread sleeps for the emulated
+    // delay, and the reply is only written once both are done. Since the reply doesn't depend on
+    // how long the host took, this stays deterministic.
+    if (!pending_read || pending_read.use_count() > 1) {
+        // The previous buffer is still referenced by a client thread that hasn't woken up yet
+        pending_read = std::make_shared<PendingRead>();
     }
-    rb.PushMappedBuffer(buffer);
+    pending_read->data.resize(length);
+    pending_read->done = false;
+
+    system.ArchiveManager().GetIOWorkerPool().Submit(
+        [request = pending_read, backend = backend.get(), offset] {
+            request->Complete(backend->Read(offset, request->data.size(), request->data.data()));
+        });
+
+    auto reply = [request = pending_read, buffer](std::shared_ptr<Kernel::Thread> /*thread*/,
+                                                  Kernel::HLERequestContext& ctx,
+                                                  Kernel::ThreadWakeupReason /*reason*/) mutable {
+        {
+            MICROPROFILE_SCOPE(Service_FS_WaitForRead);
+            request->Wait();
+        }
+
+        IPC::RequestBuilder rb(ctx, 0x0802, 2, 2);
+        if (request->result.Failed()) {
+            rb.Push(request->result.Code());
+            rb.Push<u32>(0);
+        } else {
+            buffer.Write(request->data.data(), 0, *request->result);
+            rb.Push(RESULT_SUCCESS);
+            rb.Push<u32>(static_cast<u32>(*request->result));
+        }
+        rb.PushMappedBuffer(buffer);
+    };
 
     std::chrono::nanoseconds read_timeout_ns{backend->GetReadDelayNs(length)};
-    ctx.SleepClientThread("file::read", read_timeout_ns,
-                          [](std::shared_ptr<Kernel::Thread> /*thread*/,
-                             Kernel::HLERequestContext& /*ctx*/,
-                             Kernel::ThreadWakeupReason /*reason*/) {
-                              // Nothing to do here
-                          });
+    ctx.SleepClientThread("file::read", read_timeout_ns, std::move(reply));
 }
 
 void File::Write(Kernel::HLERequestContext& ctx) {
@@ -102,6 +161,7 @@ void File::Write(Kernel::HLERequestContext& ctx) {
 
     std::vector<u8> data(length);
     buffer.Read(data.data(), 0, data.size());
+    WaitForPendingRead();
     ResultVal<std::size_t> written = backend->Write(offset, data.size(), flush != 0, data.data());
     if (written.Failed()) {
         rb.Push(written.Code());
@@ -138,6 +198,7 @@ void File::SetSize(Kernel::HLERequestContext& ctx) {
     }
 
     file->size = size;
+    WaitForPendingRead();
     backend->SetSize(size);
     rb.Push(RESULT_SUCCESS);
 }
@@ -150,6 +211,7 @@ void File::Close(Kernel::HLERequestContext& ctx) {
         LOG_WARNING(Service_FS, "Closing File backend but {} clients still connected",
                     connected_sessions.size());
 
+    WaitForPendingRead();
     backend->Close();
     IPC::RequestBuilder rb = rp.MakeBuilder(1, 0);
     rb.Push(RESULT_SUCCESS);
@@ -168,6 +230,7 @@ void File::Flush(Kernel::HLERequestContext& ctx) {
         return;
     }
 
+    WaitForPendingRead();
     backend->Flush();
     rb.Push(RESULT_SUCCESS);
 }
@@ -205,6 +268,7 @@ void File::OpenLinkFile(Kernel::HLERequestContext& ctx) {
 
     slot->priority = original_file->priority;
     slot->offset = 0;
+    WaitForPendingRead();
     slot->size = backend->GetSize();
     slot->subfile = false;
 
@@ -263,6 +327,7 @@ std::shared_ptr<Kernel::ClientSession> File::Connect() {
     FileSessionSlot* slot = GetSessionData(server);
     slot->priority = 0;
     slot->offset = 0;
+    WaitForPendingRead();
     slot->size = backend->GetSize();
     slot->subfile = false;
 
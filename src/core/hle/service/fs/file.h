@@ -27,7 +27,7 @@ class File final : public ServiceFramework<File, FileSessionSlot> {
 public:
     File(Core::System& system, std::unique_ptr<FileSys::FileBackend>&& backend,
          const FileSys::Path& path);
-    ~File() = default;
+    ~File();
 
     std::string GetName() const {
         return "Path: " + path.DebugStr();
@@ -47,7 +47,15 @@ public:
     // OpenSubFile.
     std::size_t GetSessionFileSize(std::shared_ptr<Kernel::ServerSession> session);
 
+    /**
+     * Waits for a read that is still being performed on an I/O thread. This must be called before
+     * accessing the backend directly.
+     */
+    void WaitForPendingRead();
+
 private:
+    struct PendingRead;
+
     void Read(Kernel::HLERequestContext& ctx);
     void Write(Kernel::HLERequestContext& ctx);
     void GetSize(Kernel::HLERequestContext& ctx);
@@ -60,6 +68,9 @@ private:
     void OpenSubFile(Kernel::HLERequestContext& ctx);
 
     Core::System& system;
+
+    /// The most recent read of this file, which may still be in progress
+    std::shared_ptr<PendingRead> pending_read;
 };
 
 } // namespace Service::FS
@@ -0,0 +1,58 @@
+// Copyright 2020 Citra Emulator Project
+// Licensed under GPLv2 or any later version
+// Refer to the license.txt file included.
+
+#include "common/microprofile.h"
+#include "core/hle/service/fs/io_worker_pool.h"
+
+namespace Service::FS {
+
+IOWorkerPool::IOWorkerPool(std::size_t num_threads) {
+    for (std::size_t i = 0; i < num_threads; ++i) {
+        threads.emplace_back(&IOWorkerPool::WorkerLoop, this);
+    }
+}
+
+IOWorkerPool::~IOWorkerPool() {
+    {
+        std::lock_guard lock{mutex};
+        stop = true;
+    }
+    cv.notify_all();
+    for (auto& thread : threads) {
+        thread.join();
+    }
+}
+
+void IOWorkerPool::Submit(std::function<void()> job) {
+    {
+        std::lock_guard lock{mutex};
+        jobs.push_back(std::move(job));
+    }
+    cv.notify_one();
+}
+
+MICROPROFILE_DEFINE(FS_IOJob, "Service", "FS I/O", MP_RGB(128, 192, 64));
+
+void IOWorkerPool::WorkerLoop() {
+    MicroProfileOnThreadCreate("FS I/O");
+
+    while (true) {
+        std::function<void()> job;
+        {
+            std::unique_lock lock{mutex};
+            cv.wait(lock, [this] { return stop || !jobs.empty(); });
+            if (jobs.empty())
+                break;
+            job = std::move(jobs.front());
+            jobs.pop_front();
+        }
+
+        MICROPROFILE_SCOPE(FS_IOJob);
+        job();
+    }
+
+    MicroProfileOnThreadExit();
+}
+
+} // namespace Service::FS
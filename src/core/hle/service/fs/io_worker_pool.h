@@ -0,0 +1,42 @@
+// Copyright 2020 Citra Emulator Project
+// Licensed under GPLv2 or any later version
+// Refer to the license.txt file included.
+
+#pragma once
+
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace Service::FS {
+
+/**
+ * A small pool of threads that perform host file I/O on behalf of FS sessions, so that the
+ * emulation thread can keep running while the requesting thread sleeps for the emulated access
+ * time. Jobs must only touch host state; anything visible to the emulated system is done by the
+ * caller once the job has completed.
+ */
+class IOWorkerPool {
+public:
+    explicit IOWorkerPool(std::size_t num_threads);
+
+    /// Finishes all submitted jobs before returning.
+    ~IOWorkerPool();
+
+    void Submit(std::function<void()> job);
+
+private:
+    void WorkerLoop();
+
+    std::mutex mutex;
+    std::condition_variable cv;
+    std::deque<std::function<void()>> jobs;
+    bool stop = false;
+    std::vector<std::thread> threads;
+};
+
+} // namespace Service::FS
@@ -14,7 +14,11 @@ static std::weak_ptr<GSP_GPU> gsp_gpu;
 
 void SignalInterrupt(InterruptId interrupt_id) {
     auto gpu = gsp_gpu.lock();
-    ASSERT(gpu != nullptr);
+    if (gpu == nullptr) {
+        // The GPU is being driven without a running system (e.g. when replaying a CiTrace), so
+        // there is nobody to notify.
+        return;
+    }
     return gpu->SignalInterrupt(interrupt_id);
 }
 
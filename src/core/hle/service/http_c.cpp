@@ -50,27 +50,25 @@ const ResultCode ERROR_WRONG_CERT_HANDLE = // 0xD8A0A0C9
 const ResultCode ERROR_CERT_ALREADY_SET = // 0xD8A0A03D
     ResultCode(61, ErrorModule::HTTP, ErrorSummary::InvalidState, ErrorLevel::Permanent);
 
-void Context::MakeRequest() {
+Context::~Context() {
+    if (request_future.valid()) {
+        request_future.wait();
+    }
+}
+
+void Context::MakeRequest(ConnectionPool& connection_pool) {
     assert(state == RequestState::NotStarted);
 
+    const auto start_time = std::chrono::steady_clock::now();
+    request_stats.queue_time = start_time - request_queued_time;
+
     LUrlParser::clParseURL parsedUrl = LUrlParser::clParseURL::ParseURL(url);
-    int port;
-    std::unique_ptr<httplib::Client> client;
-    if (parsedUrl.m_Scheme == "http") {
-        if (!parsedUrl.GetPort(&port)) {
-            port = 80;
-        }
-        // TODO(B3N30): Support for setting timeout
-        // Figure out what the default timeout on 3DS is
-        client = std::make_unique<httplib::Client>(parsedUrl.m_Host.c_str(), port);
-    } else {
-        if (!parsedUrl.GetPort(&port)) {
-            port = 443;
-        }
-        // TODO(B3N30): Support for setting timeout
-        // Figure out what the default timeout on 3DS is
-        client = std::make_unique<httplib::SSLClient>(parsedUrl.m_Host.c_str(), port);
+    ConnectionPool::Key key{parsedUrl.m_Scheme != "http", parsedUrl.m_Host, 0,
+                            ssl_config.client_cert_ctx.lock()};
+    if (!parsedUrl.GetPort(&key.port)) {
+        key.port = key.https ? 443 : 80;
     }
+    std::unique_ptr<httplib::Client> client = connection_pool.Acquire(key);
 
     state = RequestState::InProgress;
 
@@ -95,24 +93,21 @@ void Context::MakeRequest() {
         request.headers.emplace(header.name, header.value);
     }
 
-    // TODO(B3N30): Check for SSLOptions-Bits and set the verify method accordingly
-    // https://www.3dbrew.org/wiki/SSL_Services#SSLOpt
-    // Hack: Since for now no RootCerts are not implemented we set the VerifyMode to None.
-    if (!client->set_verify(httplib::SSLVerifyMode::None)) {
-        LOG_ERROR(Service_HTTP, "Failed to set SSL verification mode to None");
-    }
-
-    if (auto client_cert = ssl_config.client_cert_ctx.lock()) {
-        if (!client->add_client_cert_ASN1(client_cert->certificate, client_cert->private_key)) {
-            LOG_ERROR(Service_HTTP, "Failed to set client certificate");
-        }
-    }
+    const bool succeeded = client->send(request, response);
+    request_stats.request_time = std::chrono::steady_clock::now() - start_time;
+    request_stats.reused_connection = client->reused_connection();
+    connection_pool.Release(key, std::move(client));
 
-    if (!client->send(request, response)) {
+    if (!succeeded) {
         LOG_ERROR(Service_HTTP, "Request failed");
         state = RequestState::TimedOut;
     } else {
-        LOG_DEBUG(Service_HTTP, "Request successful");
+        LOG_DEBUG(Service_HTTP, "Request successful, queued for {} us, took {} us ({} connection)",
+                  std::chrono::duration_cast<std::chrono::microseconds>(request_stats.queue_time)
+                      .count(),
+                  std::chrono::duration_cast<std::chrono::microseconds>(request_stats.request_time)
+                      .count(),
+                  request_stats.reused_connection ? "reused" : "new");
         // TODO(B3N30): Verify this state on HW
         state = RequestState::ReadyToDownloadContent;
     }
@@ -222,15 +217,7 @@ void HTTP_C::BeginRequest(Kernel::HLERequestContext& ctx) {
     auto itr = contexts.find(context_handle);
     ASSERT(itr != contexts.end());
 
-    // On a 3DS BeginRequest and BeginRequestAsync will push the Request to a worker queue.
-    // You can only enqueue 8 requests at the same time.
-    // trying to enqueue any more will either fail (BeginRequestAsync), or block (BeginRequest)
-    // Note that you only can have 8 Contexts at a time. So this difference shouldn't matter
-    // Then there are 3? worker threads that pop the requests from the queue and send them
-    // For now make every request async in it's own thread.
-
-    itr->second.request_future =
-        std::async(std::launch::async, &Context::MakeRequest, std::ref(itr->second));
+    QueueRequest(itr->second);
 
     IPC::RequestBuilder rb = rp.MakeBuilder(1, 0);
     rb.Push(RESULT_SUCCESS);
@@ -275,18 +262,23 @@ void HTTP_C::BeginRequestAsync(Kernel::HLERequestContext& ctx) {
     auto itr = contexts.find(context_handle);
     ASSERT(itr != contexts.end());
 
+    QueueRequest(itr->second);
+
+    IPC::RequestBuilder rb = rp.MakeBuilder(1, 0);
+    rb.Push(RESULT_SUCCESS);
+}
+
+void HTTP_C::QueueRequest(Context& context) {
     // On a 3DS BeginRequest and BeginRequestAsync will push the Request to a worker queue.
     // You can only enqueue 8 requests at the same time.
     // trying to enqueue any more will either fail (BeginRequestAsync), or block (BeginRequest)
     // Note that you only can have 8 Contexts at a time. So this difference shouldn't matter
     // Then there are 3? worker threads that pop the requests from the queue and send them
-    // For now make every request async in it's own thread.
-
-    itr->second.request_future =
-        std::async(std::launch::async, &Context::MakeRequest, std::ref(itr->second));
-
-    IPC::RequestBuilder rb = rp.MakeBuilder(1, 0);
-    rb.Push(RESULT_SUCCESS);
+    auto request = std::make_shared<std::packaged_task<void()>>(
+        [this, &context] { context.MakeRequest(connection_pool); });
+    context.request_future = request->get_future();
+    context.request_queued_time = std::chrono::steady_clock::now();
+    request_workers.Submit([request] { (*request)(); });
 }
 
 void HTTP_C::CreateContext(Kernel::HLERequestContext& ctx) {
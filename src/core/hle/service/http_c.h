@@ -4,6 +4,7 @@
 
 #pragma once
 
+#include <chrono>
 #include <future>
 #include <memory>
 #include <optional>
@@ -12,6 +13,7 @@
 #include <vector>
 #include <httplib.h>
 #include "core/hle/kernel/shared_memory.h"
+#include "core/hle/service/http_request_pool.h"
 #include "core/hle/service/service.h"
 
 namespace Core {
@@ -83,7 +85,10 @@ public:
     Context(Context&& other) = default;
     Context& operator=(Context&&) = default;
 
-    void MakeRequest();
+    /// Waits for the request to finish if it is still queued or in progress.
+    ~Context();
+
+    void MakeRequest(ConnectionPool& connection_pool);
 
     struct Proxy {
         std::string url;
@@ -110,6 +115,16 @@ public:
         std::string value;
     };
 
+    /// Timings of the last request, for diagnostics
+    struct RequestStats {
+        /// Time spent waiting for a free worker thread
+        std::chrono::nanoseconds queue_time{};
+        /// Time spent sending the request and receiving the response
+        std::chrono::nanoseconds request_time{};
+        /// Whether the request was sent over a connection kept alive from an earlier request
+        bool reused_connection = false;
+    };
+
     struct SSLConfig {
         u32 options;
         std::weak_ptr<ClientCertContext> client_cert_ctx;
@@ -129,6 +144,8 @@ public:
     std::vector<PostData> post_data;
 
     std::future<void> request_future;
+    std::chrono::steady_clock::time_point request_queued_time;
+    RequestStats request_stats;
     std::atomic<u64> current_download_size_bytes;
     std::atomic<u64> total_download_size_bytes;
     httplib::Response response;
@@ -313,6 +330,9 @@ private:
 
     void DecryptClCertA();
 
+    /// Queues the request of a context on the request workers
+    void QueueRequest(Context& context);
+
     std::shared_ptr<Kernel::SharedMemory> shared_memory = nullptr;
 
     /// The next number to use when a new HTTP session is initalized.
@@ -324,7 +344,14 @@ private:
     /// The next handle number to use when a new ClientCert context is created.
     ClientCertContext::Handle client_certs_counter = 0;
 
-    /// Global list of HTTP contexts currently opened.
+    /// Keep-alive connections shared by every context.
+    ConnectionPool connection_pool{8};
+
+    /// On hardware a few worker threads pop requests from a queue of at most 8 entries.
+    RequestWorkerPool request_workers{3, 8};
+
+    /// Global list of HTTP contexts currently opened. Declared after the pools, as closing a
+    /// context waits for its request.
     std::unordered_map<Context::Handle, Context> contexts;
 
     /// Global list of  ClientCert contexts currently opened.
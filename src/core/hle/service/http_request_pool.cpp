@@ -0,0 +1,125 @@
+// Copyright 2020 Citra Emulator Project
+// Licensed under GPLv2 or any later version
+// Refer to the license.txt file included.
+
+#include <algorithm>
+#include <httplib.h>
+#include "common/logging/log.h"
+#include "common/microprofile.h"
+#include "core/hle/service/http_c.h"
+#include "core/hle/service/http_request_pool.h"
+
+namespace Service::HTTP {
+
+bool ConnectionPool::Key::operator==(const Key& other) const {
+    return https == other.https && host == other.host && port == other.port &&
+           client_cert == other.client_cert;
+}
+
+ConnectionPool::ConnectionPool(std::size_t max_idle) : max_idle(max_idle) {}
+
+ConnectionPool::~ConnectionPool() = default;
+
+std::unique_ptr<httplib::Client> ConnectionPool::Acquire(const Key& key) {
+    {
+        std::lock_guard lock{mutex};
+        const auto iter = std::find_if(idle.rbegin(), idle.rend(),
+                                       [&key](const auto& entry) { return entry.first == key; });
+        if (iter != idle.rend()) {
+            auto client = std::move(iter->second);
+            idle.erase(std::next(iter).base());
+            return client;
+        }
+    }
+
+    if (!key.https) {
+        // TODO(B3N30): Support for setting timeout
+        // Figure out what the default timeout on 3DS is
+        auto client = std::make_unique<httplib::Client>(key.host.c_str(), key.port);
+        client->set_keep_alive(true);
+        return client;
+    }
+
+    auto client = std::make_unique<httplib::SSLClient>(key.host.c_str(), key.port);
+    client->set_keep_alive(true);
+
+    // TODO(B3N30): Check for SSLOptions-Bits and set the verify method accordingly
+    // https://www.3dbrew.org/wiki/SSL_Services#SSLOpt
+    // Hack: Since for now no RootCerts are not implemented we set the VerifyMode to None.
+    if (!client->set_verify(httplib::SSLVerifyMode::None)) {
+        LOG_ERROR(Service_HTTP, "Failed to set SSL verification mode to None");
+    }
+
+    if (key.client_cert) {
+        if (!client->add_client_cert_ASN1(key.client_cert->certificate,
+                                          key.client_cert->private_key)) {
+            LOG_ERROR(Service_HTTP, "Failed to set client certificate");
+        }
+    }
+
+    return client;
+}
+
+void ConnectionPool::Release(const Key& key, std::unique_ptr<httplib::Client> client) {
+    std::unique_ptr<httplib::Client> evicted;
+    std::lock_guard lock{mutex};
+    if (idle.size() >= max_idle) {
+        // Closed once the lock has been released
+        evicted = std::move(idle.front().second);
+        idle.erase(idle.begin());
+    }
+    idle.emplace_back(key, std::move(client));
+}
+
+RequestWorkerPool::RequestWorkerPool(std::size_t num_threads, std::size_t max_queued)
+    : max_queued(max_queued) {
+    for (std::size_t i = 0; i < num_threads; ++i) {
+        threads.emplace_back(&RequestWorkerPool::WorkerLoop, this);
+    }
+}
+
+RequestWorkerPool::~RequestWorkerPool() {
+    {
+        std::lock_guard lock{mutex};
+        stop = true;
+    }
+    request_available.notify_all();
+    for (auto& thread : threads) {
+        thread.join();
+    }
+}
+
+void RequestWorkerPool::Submit(std::function<void()> request) {
+    {
+        std::unique_lock lock{mutex};
+        queue_not_full.wait(lock, [this] { return requests.size() < max_queued; });
+        requests.push_back(std::move(request));
+    }
+    request_available.notify_one();
+}
+
+MICROPROFILE_DEFINE(HTTP_Request, "Service", "HTTP request", MP_RGB(64, 128, 192));
+
+void RequestWorkerPool::WorkerLoop() {
+    MicroProfileOnThreadCreate("HTTP");
+
+    while (true) {
+        std::function<void()> request;
+        {
+            std::unique_lock lock{mutex};
+            request_available.wait(lock, [this] { return stop || !requests.empty(); });
+            if (requests.empty())
+                break;
+            request = std::move(requests.front());
+            requests.pop_front();
+        }
+        queue_not_full.notify_one();
+
+        MICROPROFILE_SCOPE(HTTP_Request);
+        request();
+    }
+
+    MicroProfileOnThreadExit();
+}
+
+} // namespace Service::HTTP
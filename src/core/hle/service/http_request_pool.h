@@ -0,0 +1,88 @@
+// Copyright 2020 Citra Emulator Project
+// Licensed under GPLv2 or any later version
+// Refer to the license.txt file included.
+
+#pragma once
+
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <utility>
+#include <vector>
+
+namespace httplib {
+class Client;
+}
+
+namespace Service::HTTP {
+
+struct ClientCertContext;
+
+/**
+ * Host HTTP clients shared by all HTTP contexts. Clients keep their connection alive between
+ * requests, so consecutive requests to the same server skip the TCP and TLS handshakes. A client
+ * is only used by one request at a time.
+ */
+class ConnectionPool {
+public:
+    /// Identifies the connections a request can be sent over.
+    struct Key {
+        bool https;
+        std::string host;
+        int port;
+        /// Client certificates are set up per connection, so connections with different
+        /// certificates are kept apart.
+        std::shared_ptr<ClientCertContext> client_cert;
+
+        bool operator==(const Key& other) const;
+    };
+
+    /// @param max_idle the number of idle clients to keep around, the least recently used
+    ///                 ones are closed first
+    explicit ConnectionPool(std::size_t max_idle);
+    ~ConnectionPool();
+
+    /// Returns an idle client for the key if there is one, otherwise creates a new client.
+    std::unique_ptr<httplib::Client> Acquire(const Key& key);
+
+    /// Returns a client to the pool once its request has finished.
+    void Release(const Key& key, std::unique_ptr<httplib::Client> client);
+
+private:
+    std::mutex mutex;
+    /// Idle clients, the most recently released one last
+    std::vector<std::pair<Key, std::unique_ptr<httplib::Client>>> idle;
+    std::size_t max_idle;
+};
+
+/**
+ * Runs HTTP requests on a fixed number of host threads, like the worker threads of the HTTP
+ * module on hardware. Submitting a request blocks while max_queued requests are already waiting.
+ */
+class RequestWorkerPool {
+public:
+    RequestWorkerPool(std::size_t num_threads, std::size_t max_queued);
+
+    /// Finishes all submitted requests before returning.
+    ~RequestWorkerPool();
+
+    void Submit(std::function<void()> request);
+
+private:
+    void WorkerLoop();
+
+    std::mutex mutex;
+    std::condition_variable request_available;
+    std::condition_variable queue_not_full;
+    std::deque<std::function<void()>> requests;
+    std::size_t max_queued;
+    bool stop = false;
+    std::vector<std::thread> threads;
+};
+
+} // namespace Service::HTTP
@@ -137,12 +137,30 @@ void ServiceFrameworkBase::InstallAsNamedPort(Kernel::KernelSystem& kernel) {
     kernel.AddNamedPort(service_name, std::move(client_port));
 }
 
+// Command ids above this are rare and are only looked up through the map.
+constexpr u32 MAX_DIRECT_COMMAND_ID = 0x1000;
+
 void ServiceFrameworkBase::RegisterHandlersBase(const FunctionInfoBase* functions, std::size_t n) {
     handlers.reserve(handlers.size() + n);
     for (std::size_t i = 0; i < n; ++i) {
         // Usually this array is sorted by id already, so hint to insert at the end
         handlers.emplace_hint(handlers.cend(), functions[i].expected_header, functions[i]);
     }
+
+    // Rebuild the direct table. A header of 0 marks an empty slot, as no command has id 0.
+    handler_table.clear();
+    for (const auto& [header, info] : handlers) {
+        const u32 command_id = header >> 16;
+        if (command_id == 0 || command_id >= MAX_DIRECT_COMMAND_ID)
+            continue;
+
+        if (command_id >= handler_table.size())
+            handler_table.resize(command_id + 1, FunctionInfoBase{0, nullptr, nullptr});
+
+        // Leave out ids that belong to more than one header, so that the map disambiguates them.
+        FunctionInfoBase& slot = handler_table[command_id];
+        slot = slot.expected_header == 0 ? info : FunctionInfoBase{~0u, nullptr, nullptr};
+    }
 }
 
 void ServiceFrameworkBase::ReportUnimplementedFunction(u32* cmd_buf, const FunctionInfoBase* info) {
@@ -168,8 +186,15 @@ void ServiceFrameworkBase::ReportUnimplementedFunction(u32* cmd_buf, const Funct
 
 void ServiceFrameworkBase::HandleSyncRequest(Kernel::HLERequestContext& context) {
     u32 header_code = context.CommandBuffer()[0];
-    auto itr = handlers.find(header_code);
-    const FunctionInfoBase* info = itr == handlers.end() ? nullptr : &itr->second;
+    const u32 command_id = header_code >> 16;
+    const FunctionInfoBase* info = nullptr;
+    if (command_id < handler_table.size() &&
+        handler_table[command_id].expected_header == header_code) {
+        info = &handler_table[command_id];
+    } else {
+        auto itr = handlers.find(header_code);
+        info = itr == handlers.end() ? nullptr : &itr->second;
+    }
     if (info == nullptr || info->handler_callback == nullptr) {
         context.ReportUnimplemented();
         return ReportUnimplementedFunction(context.CommandBuffer(), info);
@@ -9,6 +9,7 @@
 #include <functional>
 #include <memory>
 #include <string>
+#include <vector>
 #include <boost/container/flat_map.hpp>
 #include "common/common_types.h"
 #include "core/hle/kernel/hle_ipc.h"
@@ -99,6 +100,9 @@ private:
     /// Function used to safely up-cast pointers to the derived class before invoking a handler.
     InvokerFn* handler_invoker;
     boost::container::flat_map<u32, FunctionInfoBase> handlers;
+    /// Copy of the handlers indexed by command id, for lookups without a search. Slots that are
+    /// unused, or whose command id is shared by several headers, fall back to `handlers`.
+    std::vector<FunctionInfoBase> handler_table;
 };
 
 /**
@@ -12,7 +12,9 @@
 #include "common/scope_exit.h"
 #include "common/swap.h"
 #include "core/core.h"
+#include "core/core_timing.h"
 #include "core/hle/ipc_helpers.h"
+#include "core/hle/kernel/event.h"
 #include "core/hle/kernel/shared_memory.h"
 #include "core/hle/result.h"
 #include "core/hle/service/soc_u.h"
@@ -155,6 +157,20 @@ static int TranslateError(int error) {
     return error;
 }
 
+/// Returns whether a socket call failed only because the host socket is non-blocking
+static bool WouldBlock(int error) {
+    return error == ERRNO(EAGAIN) || error == ERRNO(EWOULDBLOCK);
+}
+
+/// Returns a handler failing a blocked socket call with EBADF once its socket gets closed
+template <typename State>
+static std::function<void(u32)> FailWithClosedSocket(std::shared_ptr<State> state) {
+    return [state](u32 /*socket*/) {
+        state->ret = static_cast<decltype(state->ret)>(SOCKET_ERROR_VALUE);
+        state->error = ERRNO(EBADF);
+    };
+}
+
 /// Holds the translation from system network socket options to 3DS network socket options
 /// Note: -1 = No effect/unavailable
 static const std::unordered_map<int, int> sockopt_map = {{
@@ -351,11 +367,58 @@ struct CTRAddrInfo {
 static_assert(sizeof(CTRAddrInfo) == 0x130, "Size of CTRAddrInfo is not correct");
 
 void SOC_U::CleanupSockets() {
-    for (auto sock : open_sockets)
+    for (auto sock : open_sockets) {
+        CancelWaits(sock.second.socket_fd);
         closesocket(sock.second.socket_fd);
+    }
     open_sockets.clear();
 }
 
+bool SOC_U::IsBlocking(u32 socket) const {
+    const auto iter = open_sockets.find(socket);
+    return iter != open_sockets.end() && iter->second.blocking;
+}
+
+void SOC_U::WaitForSocket(Kernel::HLERequestContext& ctx, const std::string& reason,
+                          std::vector<SocketReactor::WaitTarget> targets,
+                          std::chrono::nanoseconds timeout, SocketReactor::Operation operation,
+                          std::function<void(u32)> on_closed,
+                          std::function<void(Kernel::HLERequestContext&)> reply) {
+    // Only accessed under the reactor lock, or after the operation has been cancelled
+    auto completed = std::make_shared<bool>(false);
+    const u64 id = reactor->Submit(std::move(targets), [operation, completed] {
+        return *completed = operation();
+    });
+
+    pending_wakeups[id] = ctx.SleepClientThread(
+        reason, timeout,
+        [this, id, operation, completed, on_closed,
+         reply](std::shared_ptr<Kernel::Thread> /*thread*/, Kernel::HLERequestContext& ctx,
+                Kernel::ThreadWakeupReason /*reason*/) {
+            pending_wakeups.erase(id);
+            reactor->Cancel(id);
+            if (const auto closed = closed_waits.find(id); closed != closed_waits.end()) {
+                on_closed(closed->second);
+                closed_waits.erase(closed);
+            } else if (!*completed) {
+                operation();
+            }
+            reply(ctx);
+        });
+}
+
+void SOC_U::CancelWaits(u32 socket) {
+    for (const u64 id : reactor->CancelSocket(socket)) {
+        const auto iter = pending_wakeups.find(id);
+        if (iter == pending_wakeups.end())
+            continue;
+        closed_waits.emplace(id, socket);
+        std::shared_ptr<Kernel::Event> event = std::move(iter->second);
+        pending_wakeups.erase(iter);
+        event->Signal();
+    }
+}
+
 void SOC_U::Socket(Kernel::HLERequestContext& ctx) {
     IPC::RequestParser rp(ctx, 0x02, 3, 2);
     u32 domain = rp.Pop<u32>(); // Address family
@@ -386,8 +449,11 @@ void SOC_U::Socket(Kernel::HLERequestContext& ctx) {
 
     u32 ret = static_cast<u32>(::socket(domain, type, protocol));
 
-    if ((s32)ret != SOCKET_ERROR_VALUE)
+    if ((s32)ret != SOCKET_ERROR_VALUE) {
+        // Blocking calls are emulated by waiting on the socket reactor
+        SetSocketNonBlocking(ret);
         open_sockets[ret] = {ret, true};
+    }
 
     if ((s32)ret == SOCKET_ERROR_VALUE)
         ret = TranslateError(GET_ERRNO);
@@ -432,50 +498,19 @@ void SOC_U::Fcntl(Kernel::HLERequestContext& ctx) {
         rb.Push(posix_ret);
     });
 
+    // The host socket always stays non-blocking, only the mode seen by the application changes
+    auto iter = open_sockets.find(socket_handle);
+    if (iter == open_sockets.end()) {
+        posix_ret = TranslateError(ERRNO(EBADF));
+        return;
+    }
+
     if (ctr_cmd == 3) { // F_GETFL
-#ifdef _WIN32
         posix_ret = 0;
-        auto iter = open_sockets.find(socket_handle);
-        if (iter != open_sockets.end() && iter->second.blocking == false)
+        if (!iter->second.blocking)
             posix_ret |= 4; // O_NONBLOCK
-#else
-        int ret = ::fcntl(socket_handle, F_GETFL, 0);
-        if (ret == SOCKET_ERROR_VALUE) {
-            posix_ret = TranslateError(GET_ERRNO);
-            return;
-        }
-        posix_ret = 0;
-        if (ret & O_NONBLOCK)
-            posix_ret |= 4; // O_NONBLOCK
-#endif
     } else if (ctr_cmd == 4) { // F_SETFL
-#ifdef _WIN32
-        unsigned long tmp = (ctr_arg & 4 /* O_NONBLOCK */) ? 1 : 0;
-        int ret = ioctlsocket(socket_handle, FIONBIO, &tmp);
-        if (ret == SOCKET_ERROR_VALUE) {
-            posix_ret = TranslateError(GET_ERRNO);
-            return;
-        }
-        auto iter = open_sockets.find(socket_handle);
-        if (iter != open_sockets.end())
-            iter->second.blocking = (tmp == 0);
-#else
-        int flags = ::fcntl(socket_handle, F_GETFL, 0);
-        if (flags == SOCKET_ERROR_VALUE) {
-            posix_ret = TranslateError(GET_ERRNO);
-            return;
-        }
-
-        flags &= ~O_NONBLOCK;
-        if (ctr_arg & 4) // O_NONBLOCK
-            flags |= O_NONBLOCK;
-
-        int ret = ::fcntl(socket_handle, F_SETFL, flags);
-        if (ret == SOCKET_ERROR_VALUE) {
-            posix_ret = TranslateError(GET_ERRNO);
-            return;
-        }
-#endif
+        iter->second.blocking = (ctr_arg & 4 /* O_NONBLOCK */) == 0;
     } else {
         LOG_ERROR(Service_SOC, "Unsupported command ({}) in fcntl call", ctr_cmd);
         posix_ret = TranslateError(EINVAL); // TODO: Find the correct error
@@ -499,33 +534,53 @@ void SOC_U::Listen(Kernel::HLERequestContext& ctx) {
 }
 
 void SOC_U::Accept(Kernel::HLERequestContext& ctx) {
-    // TODO(Subv): Calling this function on a blocking socket will block the emu thread,
-    // preventing graceful shutdown when closing the emulator, this can be fixed by always
-    // performing nonblocking operations and spinlock until the data is available
     IPC::RequestParser rp(ctx, 0x04, 2, 2);
     u32 socket_handle = rp.Pop<u32>();
     socklen_t max_addr_len = static_cast<socklen_t>(rp.Pop<u32>());
     rp.PopPID();
-    sockaddr addr;
-    socklen_t addr_len = sizeof(addr);
-    u32 ret = static_cast<u32>(::accept(socket_handle, &addr, &addr_len));
 
-    if ((s32)ret != SOCKET_ERROR_VALUE)
-        open_sockets[ret] = {ret, true};
+    struct AcceptState {
+        u32 ret;
+        int error;
+        sockaddr addr;
+    };
+    auto state = std::make_shared<AcceptState>();
 
-    CTRSockAddr ctr_addr;
-    std::vector<u8> ctr_addr_buf(sizeof(ctr_addr));
-    if ((s32)ret == SOCKET_ERROR_VALUE) {
-        ret = TranslateError(GET_ERRNO);
-    } else {
-        ctr_addr = CTRSockAddr::FromPlatform(addr);
-        std::memcpy(ctr_addr_buf.data(), &ctr_addr, sizeof(ctr_addr));
-    }
+    auto accept = [socket_handle, state] {
+        socklen_t addr_len = sizeof(state->addr);
+        state->ret = static_cast<u32>(::accept(socket_handle, &state->addr, &addr_len));
+        state->error = GET_ERRNO;
+        return (s32)state->ret != SOCKET_ERROR_VALUE || !WouldBlock(state->error);
+    };
 
-    IPC::RequestBuilder rb = rp.MakeBuilder(2, 2);
-    rb.Push(RESULT_SUCCESS);
-    rb.Push(ret);
-    rb.PushStaticBuffer(ctr_addr_buf, 0);
+    auto reply = [this, state](Kernel::HLERequestContext& ctx) {
+        u32 ret = state->ret;
+        if ((s32)ret != SOCKET_ERROR_VALUE) {
+            SetSocketNonBlocking(ret);
+            open_sockets[ret] = {ret, true};
+        }
+
+        CTRSockAddr ctr_addr;
+        std::vector<u8> ctr_addr_buf(sizeof(ctr_addr));
+        if ((s32)ret == SOCKET_ERROR_VALUE) {
+            ret = TranslateError(state->error);
+        } else {
+            ctr_addr = CTRSockAddr::FromPlatform(state->addr);
+            std::memcpy(ctr_addr_buf.data(), &ctr_addr, sizeof(ctr_addr));
+        }
+
+        IPC::RequestBuilder rb(ctx, 0x04, 2, 2);
+        rb.Push(RESULT_SUCCESS);
+        rb.Push(ret);
+        rb.PushStaticBuffer(ctr_addr_buf, 0);
+    };
+
+    if (accept() || !IsBlocking(socket_handle)) {
+        reply(ctx);
+        return;
+    }
+    WaitForSocket(ctx, "soc_u::Accept", {{socket_handle, POLLIN}}, std::chrono::nanoseconds(-1),
+                  std::move(accept), FailWithClosedSocket(state), std::move(reply));
 }
 
 void SOC_U::GetHostId(Kernel::HLERequestContext& ctx) {
@@ -555,6 +610,8 @@ void SOC_U::Close(Kernel::HLERequestContext& ctx) {
     s32 ret = 0;
     open_sockets.erase(socket_handle);
 
+    // Wake up the threads blocked on the socket, they will see that it was closed
+    CancelWaits(socket_handle);
     ret = closesocket(socket_handle);
 
     if (ret != 0)
@@ -572,28 +629,85 @@ void SOC_U::SendTo(Kernel::HLERequestContext& ctx) {
     u32 flags = rp.Pop<u32>();
     u32 addr_len = rp.Pop<u32>();
     rp.PopPID();
-    auto input_buff = rp.PopStaticBuffer();
-    auto dest_addr_buff = rp.PopStaticBuffer();
 
-    s32 ret = -1;
-    if (addr_len > 0) {
-        CTRSockAddr ctr_dest_addr;
-        std::memcpy(&ctr_dest_addr, dest_addr_buff.data(), sizeof(ctr_dest_addr));
-        sockaddr dest_addr = CTRSockAddr::ToPlatform(ctr_dest_addr);
-        ret = ::sendto(socket_handle, reinterpret_cast<const char*>(input_buff.data()), len, flags,
-                       &dest_addr, sizeof(dest_addr));
-    } else {
-        ret = ::sendto(socket_handle, reinterpret_cast<const char*>(input_buff.data()), len, flags,
-                       nullptr, 0);
+    struct SendState {
+        std::vector<u8> input_buff;
+        std::vector<u8> dest_addr_buff;
+        s32 ret;
+        int error;
+    };
+    auto state = std::make_shared<SendState>();
+    state->input_buff = rp.PopStaticBuffer();
+    state->dest_addr_buff = rp.PopStaticBuffer();
+
+    auto send = [socket_handle, len, flags, addr_len, state] {
+        const char* data = reinterpret_cast<const char*>(state->input_buff.data());
+        if (addr_len > 0) {
+            CTRSockAddr ctr_dest_addr;
+            std::memcpy(&ctr_dest_addr, state->dest_addr_buff.data(), sizeof(ctr_dest_addr));
+            sockaddr dest_addr = CTRSockAddr::ToPlatform(ctr_dest_addr);
+            state->ret = ::sendto(socket_handle, data, len, flags, &dest_addr, sizeof(dest_addr));
+        } else {
+            state->ret = ::sendto(socket_handle, data, len, flags, nullptr, 0);
+        }
+        state->error = GET_ERRNO;
+        return state->ret != SOCKET_ERROR_VALUE || !WouldBlock(state->error);
+    };
+
+    auto reply = [state](Kernel::HLERequestContext& ctx) {
+        s32 ret = state->ret;
+        if (ret == SOCKET_ERROR_VALUE)
+            ret = TranslateError(state->error);
+
+        IPC::RequestBuilder rb(ctx, 0x0A, 2, 0);
+        rb.Push(RESULT_SUCCESS);
+        rb.Push(ret);
+    };
+
+    if (send() || !IsBlocking(socket_handle)) {
+        reply(ctx);
+        return;
     }
+    WaitForSocket(ctx, "soc_u::SendTo", {{socket_handle, POLLOUT}}, std::chrono::nanoseconds(-1),
+                  std::move(send), FailWithClosedSocket(state), std::move(reply));
+}
 
-    if (ret == SOCKET_ERROR_VALUE)
-        ret = TranslateError(GET_ERRNO);
+namespace {
+struct RecvState {
+    std::vector<u8> output_buff;
+    std::vector<u8> addr_buff;
+    s32 ret;
+    int error;
+};
 
-    IPC::RequestBuilder rb = rp.MakeBuilder(2, 0);
-    rb.Push(RESULT_SUCCESS);
-    rb.Push(ret);
+/// Returns an operation receiving from the socket into the state
+SocketReactor::Operation MakeRecvOperation(u32 socket_handle, u32 len, u32 flags, u32 addr_len,
+                                           std::shared_ptr<RecvState> state) {
+    state->output_buff.resize(len);
+    return [socket_handle, len, flags, addr_len, state] {
+        char* output = reinterpret_cast<char*>(state->output_buff.data());
+        if (addr_len > 0) {
+            // Only get src adr if input adr available
+            sockaddr src_addr;
+            socklen_t src_addr_len = sizeof(src_addr);
+            state->ret = ::recvfrom(socket_handle, output, len, flags, &src_addr, &src_addr_len);
+            state->error = GET_ERRNO;
+            state->addr_buff.clear();
+            if (state->ret >= 0 && src_addr_len > 0) {
+                CTRSockAddr ctr_src_addr = CTRSockAddr::FromPlatform(src_addr);
+                state->addr_buff.resize(sizeof(ctr_src_addr));
+                std::memcpy(state->addr_buff.data(), &ctr_src_addr, sizeof(ctr_src_addr));
+            } else {
+                state->addr_buff.resize(sizeof(CTRSockAddr));
+            }
+        } else {
+            state->ret = ::recvfrom(socket_handle, output, len, flags, NULL, 0);
+            state->error = GET_ERRNO;
+        }
+        return state->ret != SOCKET_ERROR_VALUE || !WouldBlock(state->error);
+    };
 }
+} // Anonymous namespace
 
 void SOC_U::RecvFromOther(Kernel::HLERequestContext& ctx) {
     IPC::RequestParser rp(ctx, 0x7, 4, 4);
@@ -604,43 +718,34 @@ void SOC_U::RecvFromOther(Kernel::HLERequestContext& ctx) {
     rp.PopPID();
     auto& buffer = rp.PopMappedBuffer();
 
-    CTRSockAddr ctr_src_addr;
-    std::vector<u8> output_buff(len);
-    std::vector<u8> addr_buff(sizeof(ctr_src_addr));
-    sockaddr src_addr;
-    socklen_t src_addr_len = sizeof(src_addr);
+    auto state = std::make_shared<RecvState>();
+    auto recv = MakeRecvOperation(socket_handle, len, flags, addr_len, state);
 
-    s32 ret = -1;
-    if (addr_len > 0) {
-        ret = ::recvfrom(socket_handle, reinterpret_cast<char*>(output_buff.data()), len, flags,
-                         &src_addr, &src_addr_len);
-        if (ret >= 0 && src_addr_len > 0) {
-            ctr_src_addr = CTRSockAddr::FromPlatform(src_addr);
-            std::memcpy(addr_buff.data(), &ctr_src_addr, sizeof(ctr_src_addr));
+    auto reply = [state, buffer](Kernel::HLERequestContext& ctx) mutable {
+        s32 ret = state->ret;
+        if (ret == SOCKET_ERROR_VALUE) {
+            ret = TranslateError(state->error);
+        } else {
+            buffer.Write(state->output_buff.data(), 0, ret);
         }
-    } else {
-        ret = ::recvfrom(socket_handle, reinterpret_cast<char*>(output_buff.data()), len, flags,
-                         NULL, 0);
-        addr_buff.resize(0);
-    }
 
-    if (ret == SOCKET_ERROR_VALUE) {
-        ret = TranslateError(GET_ERRNO);
-    } else {
-        buffer.Write(output_buff.data(), 0, ret);
-    }
+        IPC::RequestBuilder rb(ctx, 0x07, 2, 4);
+        rb.Push(RESULT_SUCCESS);
+        rb.Push(ret);
+        rb.PushStaticBuffer(state->addr_buff, 0);
+        rb.PushMappedBuffer(buffer);
+    };
 
-    IPC::RequestBuilder rb = rp.MakeBuilder(2, 4);
-    rb.Push(RESULT_SUCCESS);
-    rb.Push(ret);
-    rb.PushStaticBuffer(addr_buff, 0);
-    rb.PushMappedBuffer(buffer);
+    if (recv() || !IsBlocking(socket_handle)) {
+        reply(ctx);
+        return;
+    }
+    WaitForSocket(ctx, "soc_u::RecvFromOther", {{socket_handle, POLLIN}},
+                  std::chrono::nanoseconds(-1), std::move(recv), FailWithClosedSocket(state),
+                  std::move(reply));
 }
 
 void SOC_U::RecvFrom(Kernel::HLERequestContext& ctx) {
-    // TODO(Subv): Calling this function on a blocking socket will block the emu thread,
-    // preventing graceful shutdown when closing the emulator, this can be fixed by always
-    // performing nonblocking operations and spinlock until the data is available
     IPC::RequestParser rp(ctx, 0x08, 4, 2);
     u32 socket_handle = rp.Pop<u32>();
     u32 len = rp.Pop<u32>();
@@ -648,42 +753,34 @@ void SOC_U::RecvFrom(Kernel::HLERequestContext& ctx) {
     u32 addr_len = rp.Pop<u32>();
     rp.PopPID();
 
-    CTRSockAddr ctr_src_addr;
-    std::vector<u8> output_buff(len);
-    std::vector<u8> addr_buff(sizeof(ctr_src_addr));
-    sockaddr src_addr;
-    socklen_t src_addr_len = sizeof(src_addr);
+    auto state = std::make_shared<RecvState>();
+    auto recv = MakeRecvOperation(socket_handle, len, flags, addr_len, state);
 
-    s32 ret = -1;
-    if (addr_len > 0) {
-        // Only get src adr if input adr available
-        ret = ::recvfrom(socket_handle, reinterpret_cast<char*>(output_buff.data()), len, flags,
-                         &src_addr, &src_addr_len);
-        if (ret >= 0 && src_addr_len > 0) {
-            ctr_src_addr = CTRSockAddr::FromPlatform(src_addr);
-            std::memcpy(addr_buff.data(), &ctr_src_addr, sizeof(ctr_src_addr));
+    auto reply = [state](Kernel::HLERequestContext& ctx) {
+        s32 ret = state->ret;
+        s32 total_received = ret;
+        if (ret == SOCKET_ERROR_VALUE) {
+            ret = TranslateError(state->error);
+            total_received = 0;
         }
-    } else {
-        ret = ::recvfrom(socket_handle, reinterpret_cast<char*>(output_buff.data()), len, flags,
-                         NULL, 0);
-        addr_buff.resize(0);
-    }
 
-    s32 total_received = ret;
-    if (ret == SOCKET_ERROR_VALUE) {
-        ret = TranslateError(GET_ERRNO);
-        total_received = 0;
-    }
+        // Write only the data we received to avoid overwriting parts of the buffer with zeros
+        state->output_buff.resize(total_received);
 
-    // Write only the data we received to avoid overwriting parts of the buffer with zeros
-    output_buff.resize(total_received);
+        IPC::RequestBuilder rb(ctx, 0x08, 3, 4);
+        rb.Push(RESULT_SUCCESS);
+        rb.Push(ret);
+        rb.Push(total_received);
+        rb.PushStaticBuffer(state->output_buff, 0);
+        rb.PushStaticBuffer(state->addr_buff, 1);
+    };
 
-    IPC::RequestBuilder rb = rp.MakeBuilder(3, 4);
-    rb.Push(RESULT_SUCCESS);
-    rb.Push(ret);
-    rb.Push(total_received);
-    rb.PushStaticBuffer(output_buff, 0);
-    rb.PushStaticBuffer(addr_buff, 1);
+    if (recv() || !IsBlocking(socket_handle)) {
+        reply(ctx);
+        return;
+    }
+    WaitForSocket(ctx, "soc_u::RecvFrom", {{socket_handle, POLLIN}}, std::chrono::nanoseconds(-1),
+                  std::move(recv), FailWithClosedSocket(state), std::move(reply));
 }
 
 void SOC_U::Poll(Kernel::HLERequestContext& ctx) {
@@ -696,28 +793,69 @@ void SOC_U::Poll(Kernel::HLERequestContext& ctx) {
     std::vector<CTRPollFD> ctr_fds(nfds);
     std::memcpy(ctr_fds.data(), input_fds.data(), nfds * sizeof(CTRPollFD));
 
+    struct PollState {
+        std::vector<pollfd> platform_pollfd;
+        s32 ret;
+        int error;
+    };
+    auto state = std::make_shared<PollState>();
+
     // The 3ds_pollfd and the pollfd structures may be different (Windows/Linux have different
     // sizes)
     // so we have to copy the data
-    std::vector<pollfd> platform_pollfd(nfds);
-    std::transform(ctr_fds.begin(), ctr_fds.end(), platform_pollfd.begin(), CTRPollFD::ToPlatform);
+    state->platform_pollfd.resize(nfds);
+    std::transform(ctr_fds.begin(), ctr_fds.end(), state->platform_pollfd.begin(),
+                   CTRPollFD::ToPlatform);
+
+    auto poll = [nfds, state] {
+        state->ret = ::poll(state->platform_pollfd.data(), nfds, 0);
+        state->error = GET_ERRNO;
+        return state->ret != 0;
+    };
 
-    s32 ret = ::poll(platform_pollfd.data(), nfds, timeout);
+    auto reply = [nfds, state](Kernel::HLERequestContext& ctx) {
+        // Now update the output pollfd structure
+        std::vector<CTRPollFD> ctr_fds(nfds);
+        std::transform(state->platform_pollfd.begin(), state->platform_pollfd.end(),
+                       ctr_fds.begin(), CTRPollFD::FromPlatform);
 
-    // Now update the output pollfd structure
-    std::transform(platform_pollfd.begin(), platform_pollfd.end(), ctr_fds.begin(),
-                   CTRPollFD::FromPlatform);
+        std::vector<u8> output_fds(nfds * sizeof(CTRPollFD));
+        std::memcpy(output_fds.data(), ctr_fds.data(), nfds * sizeof(CTRPollFD));
 
-    std::vector<u8> output_fds(nfds * sizeof(CTRPollFD));
-    std::memcpy(output_fds.data(), ctr_fds.data(), nfds * sizeof(CTRPollFD));
+        s32 ret = state->ret;
+        if (ret == SOCKET_ERROR_VALUE)
+            ret = TranslateError(state->error);
 
-    if (ret == SOCKET_ERROR_VALUE)
-        ret = TranslateError(GET_ERRNO);
+        IPC::RequestBuilder rb(ctx, 0x14, 2, 2);
+        rb.Push(RESULT_SUCCESS);
+        rb.Push(ret);
+        rb.PushStaticBuffer(output_fds, 0);
+    };
 
-    IPC::RequestBuilder rb = rp.MakeBuilder(2, 2);
-    rb.Push(RESULT_SUCCESS);
-    rb.Push(ret);
-    rb.PushStaticBuffer(output_fds, 0);
+    if (poll() || timeout == 0) {
+        reply(ctx);
+        return;
+    }
+
+    // A socket closed while waiting is reported as invalid, as it would be if it had been closed
+    // beforehand
+    auto on_closed = [state](u32 socket) {
+        state->ret = 0;
+        for (pollfd& fd : state->platform_pollfd) {
+            fd.revents = static_cast<u32>(fd.fd) == socket ? POLLNVAL : 0;
+            if (fd.revents != 0)
+                state->ret++;
+        }
+    };
+
+    // The timeout is measured in emulated time, a negative one waits forever
+    std::vector<SocketReactor::WaitTarget> targets;
+    for (const pollfd& fd : state->platform_pollfd) {
+        targets.push_back({static_cast<u32>(fd.fd), fd.events});
+    }
+    WaitForSocket(ctx, "soc_u::Poll", std::move(targets),
+                  timeout < 0 ? std::chrono::nanoseconds(-1) : std::chrono::milliseconds(timeout),
+                  std::move(poll), std::move(on_closed), std::move(reply));
 }
 
 void SOC_U::GetSockName(Kernel::HLERequestContext& ctx) {
@@ -782,9 +920,6 @@ void SOC_U::GetPeerName(Kernel::HLERequestContext& ctx) {
 }
 
 void SOC_U::Connect(Kernel::HLERequestContext& ctx) {
-    // TODO(Subv): Calling this function on a blocking socket will block the emu thread,
-    // preventing graceful shutdown when closing the emulator, this can be fixed by always
-    // performing nonblocking operations and spinlock until the data is available
     IPC::RequestParser rp(ctx, 0x06, 2, 4);
     u32 socket_handle = rp.Pop<u32>();
     u32 input_addr_len = rp.Pop<u32>();
@@ -794,14 +929,46 @@ void SOC_U::Connect(Kernel::HLERequestContext& ctx) {
     CTRSockAddr ctr_input_addr;
     std::memcpy(&ctr_input_addr, input_addr_buf.data(), sizeof(ctr_input_addr));
 
+    struct ConnectState {
+        s32 ret;
+        int error;
+    };
+    auto state = std::make_shared<ConnectState>();
+
     sockaddr input_addr = CTRSockAddr::ToPlatform(ctr_input_addr);
-    s32 ret = ::connect(socket_handle, &input_addr, sizeof(input_addr));
-    if (ret != 0)
-        ret = TranslateError(GET_ERRNO);
+    state->ret = ::connect(socket_handle, &input_addr, sizeof(input_addr));
+    state->error = GET_ERRNO;
 
-    IPC::RequestBuilder rb = rp.MakeBuilder(2, 0);
-    rb.Push(RESULT_SUCCESS);
-    rb.Push(ret);
+    auto reply = [state](Kernel::HLERequestContext& ctx) {
+        s32 ret = state->ret;
+        if (ret != 0)
+            ret = TranslateError(state->error);
+
+        IPC::RequestBuilder rb(ctx, 0x06, 2, 0);
+        rb.Push(RESULT_SUCCESS);
+        rb.Push(ret);
+    };
+
+    const bool in_progress = state->error == ERRNO(EINPROGRESS) || WouldBlock(state->error);
+    if (state->ret == 0 || !in_progress || !IsBlocking(socket_handle)) {
+        reply(ctx);
+        return;
+    }
+
+    // The connection has been established, or has failed, once the socket becomes writable
+    auto finish_connect = [socket_handle, state] {
+        int error = 0;
+        socklen_t error_len = sizeof(error);
+        if (::getsockopt(socket_handle, SOL_SOCKET, SO_ERROR, reinterpret_cast<char*>(&error),
+                         &error_len) != 0) {
+            error = GET_ERRNO;
+        }
+        state->ret = error == 0 ? 0 : SOCKET_ERROR_VALUE;
+        state->error = error;
+        return true;
+    };
+    WaitForSocket(ctx, "soc_u::Connect", {{socket_handle, POLLOUT}}, std::chrono::nanoseconds(-1),
+                  std::move(finish_connect), FailWithClosedSocket(state), std::move(reply));
 }
 
 void SOC_U::InitializeSockets(Kernel::HLERequestContext& ctx) {
@@ -977,7 +1144,7 @@ void SOC_U::GetNameInfoImpl(Kernel::HLERequestContext& ctx) {
     rb.PushStaticBuffer(serv, 1);
 }
 
-SOC_U::SOC_U() : ServiceFramework("soc:U") {
+SOC_U::SOC_U(Core::System& system) : ServiceFramework("soc:U"), system(system) {
     static const FunctionInfo functions[] = {
         {0x00010044, &SOC_U::InitializeSockets, "InitializeSockets"},
         {0x000200C2, &SOC_U::Socket, "Socket"},
@@ -1020,10 +1187,28 @@ SOC_U::SOC_U() : ServiceFramework("soc:U") {
     WSADATA data;
     WSAStartup(MAKEWORD(2, 2), &data);
 #endif
+
+    socket_ready_event =
+        system.CoreTiming().RegisterEvent("SOC_U::SocketReady", [this](u64 id, s64 cycles_late) {
+            const auto iter = pending_wakeups.find(id);
+            // The thread might have already woken up because of a timeout
+            if (iter == pending_wakeups.end())
+                return;
+            std::shared_ptr<Kernel::Event> event = std::move(iter->second);
+            pending_wakeups.erase(iter);
+            event->Signal();
+        });
+
+    reactor = std::make_unique<SocketReactor>([this, &system](u64 id) {
+        system.CoreTiming().ScheduleEventThreadsafe(0, socket_ready_event, id);
+    });
 }
 
 SOC_U::~SOC_U() {
     CleanupSockets();
+    reactor.reset();
+    // Wakeups scheduled by the reactor would otherwise run after the service is gone
+    system.CoreTiming().RemoveNormalAndThreadsafeEvent(socket_ready_event);
 #ifdef _WIN32
     WSACleanup();
 #endif
@@ -1031,7 +1216,7 @@ SOC_U::~SOC_U() {
 
 void InstallInterfaces(Core::System& system) {
     auto& service_manager = system.ServiceManager();
-    std::make_shared<SOC_U>()->InstallAsService(service_manager);
+    std::make_shared<SOC_U>(system)->InstallAsService(service_manager);
 }
 
 } // namespace Service::SOC
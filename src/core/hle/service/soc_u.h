@@ -4,11 +4,22 @@
 
 #pragma once
 
+#include <chrono>
+#include <functional>
+#include <memory>
+#include <string>
 #include <unordered_map>
+#include <vector>
 #include "core/hle/service/service.h"
+#include "core/hle/service/socket_reactor.h"
 
 namespace Core {
 class System;
+struct TimingEventType;
+} // namespace Core
+
+namespace Kernel {
+class Event;
 }
 
 namespace Service::SOC {
@@ -16,12 +27,12 @@ namespace Service::SOC {
 /// Holds information about a particular socket
 struct SocketHolder {
     u32 socket_fd; ///< The socket descriptor
-    bool blocking; ///< Whether the socket is blocking or not, it is only read on Windows.
+    bool blocking; ///< Whether the socket is blocking for the application. Host sockets never are.
 };
 
 class SOC_U final : public ServiceFramework<SOC_U> {
 public:
-    SOC_U();
+    explicit SOC_U(Core::System& system);
     ~SOC_U();
 
 private:
@@ -53,8 +64,35 @@ private:
     /// Close all open sockets
     void CleanupSockets();
 
+    /// Returns whether calls on the socket should block the calling thread
+    bool IsBlocking(u32 socket) const;
+
+    /**
+     * Puts the client thread to sleep until the socket reactor completes the operation, then
+     * calls reply on the emulation thread. If the timeout expires first, the operation is
+     * attempted once more before replying. If a socket gets closed first, on_closed is called
+     * with it instead, as its number may already belong to another socket.
+     */
+    void WaitForSocket(Kernel::HLERequestContext& ctx, const std::string& reason,
+                       std::vector<SocketReactor::WaitTarget> targets,
+                       std::chrono::nanoseconds timeout, SocketReactor::Operation operation,
+                       std::function<void(u32)> on_closed,
+                       std::function<void(Kernel::HLERequestContext&)> reply);
+
+    /// Wakes up the threads waiting on the socket, before it gets closed
+    void CancelWaits(u32 socket);
+
+    Core::System& system;
+
     /// Holds info about the currently open sockets
     std::unordered_map<u32, SocketHolder> open_sockets;
+
+    std::unique_ptr<SocketReactor> reactor;
+    Core::TimingEventType* socket_ready_event;
+    /// Events waking up the threads waiting for reactor operations, by operation id
+    std::unordered_map<u64, std::shared_ptr<Kernel::Event>> pending_wakeups;
+    /// Sockets closed while reactor operations were waiting on them, by operation id
+    std::unordered_map<u64, u32> closed_waits;
 };
 
 void InstallInterfaces(Core::System& system);
@@ -0,0 +1,174 @@
+// Copyright 2020 Citra Emulator Project
+// Licensed under GPLv2 or any later version
+// Refer to the license.txt file included.
+
+#include <algorithm>
+#include "common/assert.h"
+#include "common/logging/log.h"
+#include "common/microprofile.h"
+#include "core/hle/service/socket_reactor.h"
+
+#ifdef _WIN32
+#include <winsock2.h>
+#include <ws2tcpip.h>
+#define poll(x, y, z) WSAPoll(x, y, z)
+#else
+#include <fcntl.h>
+#include <netinet/in.h>
+#include <poll.h>
+#include <sys/socket.h>
+#include <unistd.h>
+#define closesocket(x) close(x)
+#endif
+
+namespace Service::SOC {
+
+bool SetSocketNonBlocking(u32 socket) {
+#ifdef _WIN32
+    unsigned long non_blocking = 1;
+    return ioctlsocket(socket, FIONBIO, &non_blocking) == 0;
+#else
+    const int flags = ::fcntl(socket, F_GETFL, 0);
+    return flags != -1 && ::fcntl(socket, F_SETFL, flags | O_NONBLOCK) != -1;
+#endif
+}
+
+SocketReactor::SocketReactor(CompletionCallback on_completion)
+    : on_completion(std::move(on_completion)) {
+    wake_socket = static_cast<u32>(::socket(AF_INET, SOCK_DGRAM, 0));
+
+    sockaddr_in addr{};
+    addr.sin_family = AF_INET;
+    addr.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+    socklen_t addr_len = sizeof(addr);
+    const bool connected =
+        ::bind(wake_socket, reinterpret_cast<sockaddr*>(&addr), sizeof(addr)) == 0 &&
+        ::getsockname(wake_socket, reinterpret_cast<sockaddr*>(&addr), &addr_len) == 0 &&
+        ::connect(wake_socket, reinterpret_cast<sockaddr*>(&addr), sizeof(addr)) == 0 &&
+        SetSocketNonBlocking(wake_socket);
+    ASSERT_MSG(connected, "Failed to create the socket reactor wakeup socket");
+
+    thread = std::thread(&SocketReactor::Loop, this);
+}
+
+SocketReactor::~SocketReactor() {
+    {
+        std::lock_guard lock{mutex};
+        stop = true;
+    }
+    Wake();
+    thread.join();
+    closesocket(wake_socket);
+}
+
+u64 SocketReactor::Submit(std::vector<WaitTarget> targets, Operation operation) {
+    u64 id;
+    {
+        std::lock_guard lock{mutex};
+        id = next_id++;
+        waiters.emplace(id, Waiter{std::move(targets), std::move(operation)});
+    }
+    Wake();
+    return id;
+}
+
+void SocketReactor::Cancel(u64 id) {
+    std::lock_guard lock{mutex};
+    // The reactor rebuilds its poll set whenever something completes, no need to wake it
+    waiters.erase(id);
+}
+
+std::vector<u64> SocketReactor::CancelSocket(u32 socket) {
+    std::vector<u64> cancelled;
+    {
+        std::lock_guard lock{mutex};
+        const auto uses_socket = [socket](const WaitTarget& target) {
+            return target.socket == socket;
+        };
+        for (auto it = waiters.begin(); it != waiters.end();) {
+            const auto& targets = it->second.targets;
+            if (std::any_of(targets.begin(), targets.end(), uses_socket)) {
+                cancelled.push_back(it->first);
+                it = waiters.erase(it);
+            } else {
+                ++it;
+            }
+        }
+    }
+
+    // The reactor may still be polling the socket, but it ignores sockets without waiters. Have
+    // it rebuild its poll set so that it doesn't keep polling the socket once it is closed.
+    if (!cancelled.empty())
+        Wake();
+    return cancelled;
+}
+
+void SocketReactor::Wake() {
+    const char byte = 0;
+    ::send(wake_socket, &byte, 1, 0);
+}
+
+MICROPROFILE_DEFINE(Service_SOC_Reactor, "Service", "Socket reactor", MP_RGB(64, 128, 192));
+
+void SocketReactor::Loop() {
+    MicroProfileOnThreadCreate("SocketReactor");
+
+    std::vector<pollfd> fds;
+    std::vector<u64> owners;
+    std::vector<u64> completed;
+    while (true) {
+        fds.clear();
+        owners.clear();
+        fds.push_back(pollfd{static_cast<decltype(pollfd::fd)>(wake_socket), POLLIN, 0});
+        owners.push_back(0);
+        {
+            std::lock_guard lock{mutex};
+            if (stop)
+                break;
+            for (const auto& [id, waiter] : waiters) {
+                for (const WaitTarget& target : waiter.targets) {
+                    fds.push_back(pollfd{static_cast<decltype(pollfd::fd)>(target.socket),
+                                         target.events, 0});
+                    owners.push_back(id);
+                }
+            }
+        }
+
+        if (::poll(fds.data(), static_cast<unsigned long>(fds.size()), -1) < 0) {
+            LOG_ERROR(Service_SOC, "Socket reactor poll failed");
+            continue;
+        }
+
+        MICROPROFILE_SCOPE(Service_SOC_Reactor);
+        if (fds[0].revents != 0) {
+            char buffer[64];
+            while (::recv(wake_socket, buffer, sizeof(buffer), 0) > 0) {
+            }
+        }
+
+        {
+            std::lock_guard lock{mutex};
+            for (std::size_t i = 1; i < fds.size(); ++i) {
+                if (fds[i].revents == 0)
+                    continue;
+                const auto it = waiters.find(owners[i]);
+                // The waiter might have been cancelled, or completed through another socket
+                if (it == waiters.end())
+                    continue;
+                if (it->second.operation()) {
+                    completed.push_back(it->first);
+                    waiters.erase(it);
+                }
+            }
+        }
+
+        for (const u64 id : completed) {
+            on_completion(id);
+        }
+        completed.clear();
+    }
+
+    MicroProfileOnThreadExit();
+}
+
+} // namespace Service::SOC
@@ -0,0 +1,82 @@
+// Copyright 2020 Citra Emulator Project
+// Licensed under GPLv2 or any later version
+// Refer to the license.txt file included.
+
+#pragma once
+
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+#include "common/common_types.h"
+
+namespace Service::SOC {
+
+/// Switches a host socket to non-blocking mode. Returns false on failure.
+bool SetSocketNonBlocking(u32 socket);
+
+/**
+ * Waits for host sockets to become ready on a dedicated thread, so that blocking socket calls made
+ * by the emulated application don't block the emulation thread. The host sockets are kept in
+ * non-blocking mode, and an operation that would block is handed to the reactor, which retries it
+ * whenever one of its sockets becomes ready and reports when it has completed.
+ */
+class SocketReactor {
+public:
+    /// A host socket to wait on, and the host poll events to wait for
+    struct WaitTarget {
+        u32 socket;
+        s16 events;
+    };
+
+    /**
+     * Attempts an operation without blocking. Returns true if it completed, or false if it would
+     * still block. Operations submitted to the reactor run on the reactor thread.
+     */
+    using Operation = std::function<bool()>;
+
+    /// Called from the reactor thread with the id of each operation that has completed
+    using CompletionCallback = std::function<void(u64 id)>;
+
+    explicit SocketReactor(CompletionCallback on_completion);
+    ~SocketReactor();
+
+    /// Starts waiting for the operation to complete, and returns an id identifying it.
+    u64 Submit(std::vector<WaitTarget> targets, Operation operation);
+
+    /// Stops waiting for the operation. Does nothing if it has already completed.
+    void Cancel(u64 id);
+
+    /**
+     * Stops waiting for every operation on the socket. None of them is attempted or reported as
+     * completed afterwards, so the socket can be closed as soon as this returns. This must be
+     * called before closing the socket.
+     * @return The ids of the operations that were cancelled
+     */
+    std::vector<u64> CancelSocket(u32 socket);
+
+private:
+    struct Waiter {
+        std::vector<WaitTarget> targets;
+        Operation operation;
+    };
+
+    void Loop();
+
+    /// Interrupts the poll, so that the reactor picks up changes to the waiters
+    void Wake();
+
+    CompletionCallback on_completion;
+
+    std::mutex mutex;
+    std::unordered_map<u64, Waiter> waiters;
+    u64 next_id = 1;
+    bool stop = false;
+
+    /// A loopback UDP socket connected to itself, sending to it wakes up the reactor
+    u32 wake_socket;
+    std::thread thread;
+};
+
+} // namespace Service::SOC
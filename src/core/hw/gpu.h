@@ -323,6 +323,9 @@ static_assert(sizeof(Regs) == 0x1000 * sizeof(u32), "Invalid total size of regis
 
 extern Regs g_regs;
 
+/// Memory system the GPU operates on, set by Init
+extern Memory::MemorySystem* g_memory;
+
 template <typename T>
 void Read(T& var, const u32 addr);
 
@@ -0,0 +1,117 @@
+// Copyright 2020 Citra Emulator Project
+// Licensed under GPLv2 or any later version
+// Refer to the license.txt file included.
+
+#include <fmt/format.h>
+#include "common/common_funcs.h"
+#include "common/common_paths.h"
+#include "common/file_util.h"
+#include "common/hash.h"
+#include "common/logging/log.h"
+#include "common/swap.h"
+#include "core/file_sys/ncch_container.h"
+#include "core/loader/boot_cache.h"
+#include "core/loader/loader.h"
+
+namespace Loader {
+
+constexpr u32 BOOT_CACHE_MAGIC = MakeMagic('C', 'B', 'C', 'H');
+/// Bumped whenever the file layout, or the way the code image is built, changes
+constexpr u32 BOOT_CACHE_VERSION = 1;
+
+struct BootCacheHeader {
+    u32_le magic;
+    u32_le version;
+    u64_le code_hash;
+    /// Hash of the stored code image, catches files that were only partially written
+    u64_le code_checksum;
+    u32_le code_size;
+    INSERT_PADDING_WORDS(1);
+};
+static_assert(sizeof(BootCacheHeader) == 0x20, "BootCacheHeader has incorrect size");
+
+BootCache::BootCache(u64 program_id)
+    : BootCache(FileUtil::GetUserPath(FileUtil::UserPath::CacheDir) + "boot" DIR_SEP +
+                fmt::format("{:016X}.bin", program_id)) {}
+
+BootCache::BootCache(std::string path) : path(std::move(path)) {}
+
+bool BootCache::LoadCode(u64 code_hash, std::vector<u8>& code) const {
+    FileUtil::IOFile file(path, "rb");
+    if (!file.IsOpen())
+        return false;
+
+    BootCacheHeader header;
+    if (file.ReadBytes(&header, sizeof(header)) != sizeof(header) ||
+        header.magic != BOOT_CACHE_MAGIC || header.version != BOOT_CACHE_VERSION) {
+        LOG_WARNING(Loader, "Ignoring boot cache {} with an unknown format", path);
+        return false;
+    }
+    if (header.code_hash != code_hash) {
+        LOG_INFO(Loader, "Boot cache {} is out of date", path);
+        return false;
+    }
+    // Checked before allocating, so a damaged size can't ask for gigabytes
+    if (header.code_size != file.GetSize() - sizeof(header)) {
+        LOG_WARNING(Loader, "Ignoring truncated boot cache {}", path);
+        return false;
+    }
+
+    std::vector<u8> cached_code(header.code_size);
+    if (file.ReadBytes(cached_code.data(), cached_code.size()) != cached_code.size() ||
+        Common::ComputeHash64(cached_code.data(), cached_code.size()) != header.code_checksum) {
+        LOG_WARNING(Loader, "Ignoring corrupted boot cache {}", path);
+        return false;
+    }
+
+    LOG_INFO(Loader, "Loaded code image from boot cache {}", path);
+    code = std::move(cached_code);
+    return true;
+}
+
+void BootCache::StoreCode(u64 code_hash, const std::vector<u8>& code) const {
+    if (!FileUtil::CreateFullPath(path)) {
+        LOG_ERROR(Loader, "Failed to create boot cache directory for {}", path);
+        return;
+    }
+
+    BootCacheHeader header{};
+    header.magic = BOOT_CACHE_MAGIC;
+    header.version = BOOT_CACHE_VERSION;
+    header.code_hash = code_hash;
+    header.code_checksum = Common::ComputeHash64(code.data(), code.size());
+    header.code_size = static_cast<u32>(code.size());
+
+    // Write to a temporary file first, so a boot that is cut short never leaves a truncated cache
+    const std::string temp_path = path + ".tmp";
+    {
+        FileUtil::IOFile file(temp_path, "wb");
+        if (file.WriteObject(header) != 1 ||
+            file.WriteBytes(code.data(), code.size()) != code.size()) {
+            LOG_ERROR(Loader, "Failed to write boot cache {}", temp_path);
+            return;
+        }
+    }
+    if (FileUtil::Exists(path))
+        FileUtil::Delete(path);
+    if (!FileUtil::Rename(temp_path, path)) {
+        LOG_ERROR(Loader, "Failed to move boot cache into place at {}", path);
+        return;
+    }
+    LOG_INFO(Loader, "Stored code image in boot cache {}", path);
+}
+
+ResultStatus BootCache::ReadCodeImage(FileSys::NCCHContainer& ncch, u32 bss_page_size,
+                                      std::vector<u8>& code) const {
+    u64 code_hash = 0;
+    const bool cacheable = ncch.ReadCodeHash(code_hash) == ResultStatus::Success;
+    if (cacheable && LoadCode(code_hash, code))
+        return ResultStatus::Success;
+
+    const ResultStatus result = ncch.LoadCodeImage(bss_page_size, code);
+    if (result == ResultStatus::Success && cacheable)
+        StoreCode(code_hash, code);
+    return result;
+}
+
+} // namespace Loader
@@ -0,0 +1,56 @@
+// Copyright 2020 Citra Emulator Project
+// Licensed under GPLv2 or any later version
+// Refer to the license.txt file included.
+
+#pragma once
+
+#include <string>
+#include <vector>
+#include "common/common_types.h"
+
+namespace FileSys {
+class NCCHContainer;
+} // namespace FileSys
+
+namespace Loader {
+
+enum class ResultStatus;
+
+/**
+ * Per-title cache of the work done to boot a title, stored under the cache directory. It holds the
+ * code image after decompression, .bss allocation and IPS patching, tagged with the hash of the
+ * headers it was built from (see FileSys::NCCHContainer::ReadCodeHash).
+ */
+class BootCache {
+public:
+    explicit BootCache(u64 program_id);
+    explicit BootCache(std::string path);
+
+    /**
+     * Reads the cached code image
+     * @param code_hash Hash of the headers the code image has to be built from
+     * @param code Buffer the code image is read into
+     * @return bool true if the cache holds a code image for code_hash, false otherwise
+     */
+    bool LoadCode(u64 code_hash, std::vector<u8>& code) const;
+
+    /// Replaces the cached code image with one built from headers hashing to code_hash
+    void StoreCode(u64 code_hash, const std::vector<u8>& code) const;
+
+    /**
+     * Reads the code image of an NCCH for booting (see FileSys::NCCHContainer::LoadCodeImage).
+     * It is loaded from the cache if the cache holds one built from the same headers, otherwise
+     * it is built from the NCCH and stored.
+     * @param ncch NCCH of the title being booted
+     * @param bss_page_size Size of the .bss, rounded up to whole pages
+     * @param code Buffer the code image is read into
+     * @return ResultStatus result of function
+     */
+    ResultStatus ReadCodeImage(FileSys::NCCHContainer& ncch, u32 bss_page_size,
+                               std::vector<u8>& code) const;
+
+private:
+    std::string path;
+};
+
+} // namespace Loader
@@ -69,6 +69,16 @@ private:
      */
     ResultStatus LoadExec(std::shared_ptr<Kernel::Process>& process);
 
+    /**
+     * Reads the code image for booting (see FileSys::NCCHContainer::LoadCodeImage). Uses the boot
+     * cache when it is enabled.
+     * @param program_id Program ID of the title being booted
+     * @param bss_page_size Size of the .bss, rounded up to whole pages
+     * @param code Buffer the code image is read into
+     * @return ResultStatus result of function
+     */
+    ResultStatus ReadCodeImage(u64 program_id, u32 bss_page_size, std::vector<u8>& code);
+
     /// Reads the region lockout info in the SMDH and send it to CFG service
     void ParseRegionLockoutInfo();
 
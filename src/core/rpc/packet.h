@@ -14,6 +14,40 @@ enum class PacketType {
     Undefined = 0,
     ReadMemory,
     WriteMemory,
+    /// A list of {address, size} pairs, replied to with the contents of each range in order
+    ReadMemoryBatch,
+    /// A list of {address, size, data} records
+    WriteMemoryBatch,
+    /// A ScanRequest, replied to with the address to continue from and the matching addresses
+    ScanMemory,
+    /**
+     * A list of {address, size} pairs replacing the watch list, replied to like ReadMemoryBatch.
+     * Once per frame, the ranges whose contents changed are sent with the id of the request as
+     * {address, size, data} records. An empty list ends the subscription.
+     *
+     * Updates are sent to the address the request came from, interleaved with the replies to
+     * other requests. While waiting for a reply, clients have to set aside WatchMemory packets
+     * carrying the id of their watch request rather than take them for the reply.
+     */
+    WatchMemory,
+};
+
+enum class ScanCompare : u32 {
+    Equal = 0,
+    NotEqual,
+    Less,
+    LessOrEqual,
+    Greater,
+    GreaterOrEqual,
+};
+
+struct ScanRequest {
+    u32 address;
+    u32 size;
+    ScanCompare compare;
+    /// 1, 2 or 4. Values are compared unsigned, at addresses aligned to their size
+    u32 value_size;
+    u32 value;
 };
 
 struct PacketHeader {
@@ -23,9 +57,10 @@ struct PacketHeader {
     u32 packet_size;
 };
 
-constexpr u32 CURRENT_VERSION = 1;
+constexpr u32 CURRENT_VERSION = 2;
 constexpr u32 MIN_PACKET_SIZE = sizeof(PacketHeader);
-constexpr u32 MAX_PACKET_DATA_SIZE = 32;
+// Large enough to batch a hundred accesses, small enough to fit in one Ethernet frame
+constexpr u32 MAX_PACKET_DATA_SIZE = 1024;
 constexpr u32 MAX_PACKET_SIZE = MIN_PACKET_SIZE + MAX_PACKET_DATA_SIZE;
 constexpr u32 MAX_READ_SIZE = MAX_PACKET_DATA_SIZE;
 
@@ -1,6 +1,11 @@
+#include <algorithm>
+#include <array>
+#include <cstring>
 #include "common/logging/log.h"
 #include "core/arm/arm_interface.h"
 #include "core/core.h"
+#include "core/core_timing.h"
+#include "core/hle/kernel/kernel.h"
 #include "core/hle/kernel/process.h"
 #include "core/memory.h"
 #include "core/rpc/packet.h"
@@ -8,9 +13,28 @@
 
 namespace RPC {
 
-RPCServer::RPCServer() : server(*this) {
+constexpr u64 watch_interval_ticks = BASE_CLOCK_RATE_ARM11 / 60;
+
+static u32 ReadU32(const u8* data) {
+    u32 value;
+    std::memcpy(&value, data, sizeof(value));
+    return value;
+}
+
+static void WriteU32(u8* data, u32 value) {
+    std::memcpy(data, &value, sizeof(value));
+}
+
+RPCServer::RPCServer(Memory::MemorySystem& memory, Kernel::KernelSystem& kernel,
+                     Core::Timing& timing)
+    : memory(memory), kernel(kernel), timing(timing), server(*this) {
     LOG_INFO(RPC_Server, "Starting RPC server ...");
 
+    watch_event = timing.RegisterEvent(
+        "RPCServer::WatchCallback",
+        [this](u64 userdata, s64 cycles_late) { WatchCallback(userdata, cycles_late); });
+    timing.ScheduleEvent(watch_interval_ticks, watch_event);
+
     Start();
 
     LOG_INFO(RPC_Server, "RPC started.");
@@ -20,6 +44,7 @@ RPCServer::~RPCServer() {
     LOG_INFO(RPC_Server, "Stopping RPC ...");
 
     Stop();
+    timing.UnscheduleEvent(watch_event, 0);
 
     LOG_INFO(RPC_Server, "RPC stopped.");
 }
@@ -30,26 +55,184 @@ void RPCServer::HandleReadMemory(Packet& packet, u32 address, u32 data_size) {
     }
 
     // Note: Memory read occurs asynchronously from the state of the emulator
-    Core::System::GetInstance().Memory().ReadBlock(
-        *Core::System::GetInstance().Kernel().GetCurrentProcess(), address,
-        packet.GetPacketData().data(), data_size);
+    memory.ReadBlock(*kernel.GetCurrentProcess(), address, packet.GetPacketData().data(),
+                     data_size);
     packet.SetPacketDataSize(data_size);
     packet.SendReply();
 }
 
 void RPCServer::HandleWriteMemory(Packet& packet, u32 address, const u8* data, u32 data_size) {
+    WriteMemory(address, data, data_size);
+    packet.SetPacketDataSize(0);
+    packet.SendReply();
+}
+
+void RPCServer::HandleReadMemoryBatch(Packet& packet, const std::vector<MemoryRange>& ranges) {
+    const auto process = kernel.GetCurrentProcess();
+    u32 data_size = 0;
+    for (const auto& range : ranges) {
+        // Note: Memory read occurs asynchronously from the state of the emulator
+        memory.ReadBlock(*process, range.address, packet.GetPacketData().data() + data_size,
+                         range.size);
+        data_size += range.size;
+    }
+    packet.SetPacketDataSize(data_size);
+    packet.SendReply();
+}
+
+void RPCServer::HandleWriteMemoryBatch(Packet& packet) {
+    const u8* data = packet.GetPacketData().data();
+    const u32 end = packet.GetPacketDataSize();
+
+    // Check every record before writing anything, so a malformed batch has no effect
+    u32 offset = 0;
+    while (offset < end) {
+        if (end - offset < sizeof(u32) * 2 ||
+            ReadU32(data + offset + sizeof(u32)) > end - offset - sizeof(u32) * 2) {
+            packet.SetPacketDataSize(0);
+            packet.SendReply();
+            return;
+        }
+        offset += sizeof(u32) * 2 + ReadU32(data + offset + sizeof(u32));
+    }
+
+    for (offset = 0; offset < end;) {
+        const u32 address = ReadU32(data + offset);
+        const u32 data_size = ReadU32(data + offset + sizeof(u32));
+        WriteMemory(address, data + offset + sizeof(u32) * 2, data_size);
+        offset += sizeof(u32) * 2 + data_size;
+    }
+    packet.SetPacketDataSize(0);
+    packet.SendReply();
+}
+
+static bool CompareScanValue(ScanCompare compare, u32 value, u32 reference) {
+    switch (compare) {
+    case ScanCompare::Equal:
+        return value == reference;
+    case ScanCompare::NotEqual:
+        return value != reference;
+    case ScanCompare::Less:
+        return value < reference;
+    case ScanCompare::LessOrEqual:
+        return value <= reference;
+    case ScanCompare::Greater:
+        return value > reference;
+    case ScanCompare::GreaterOrEqual:
+        return value >= reference;
+    }
+    return false;
+}
+
+void RPCServer::HandleScanMemory(Packet& packet, const ScanRequest& request) {
+    constexpr u32 max_matches = (MAX_PACKET_DATA_SIZE - sizeof(u32)) / sizeof(u32);
+
+    const auto process = kernel.GetCurrentProcess();
+    const auto& page_table = process->vm_manager.page_table;
+    u8* const matches = packet.GetPacketData().data() + sizeof(u32);
+    std::array<u8, Memory::PAGE_SIZE> page_buffer;
+
+    u32 num_matches = 0;
+    u64 address = request.address;
+    const u64 end = address + request.size;
+    while (address < end && num_matches < max_matches) {
+        const u64 page_address = address & ~static_cast<u64>(Memory::PAGE_MASK);
+        const u64 page_end = std::min(page_address + Memory::PAGE_SIZE, end);
+        const std::size_t page_index = page_address >> Memory::PAGE_BITS;
+
+        // Only pages backed by FCRAM or VRAM are scanned, not unmapped or MMIO pages
+        const u8* page = page_table.pointers[page_index];
+        if (!page) {
+            if (page_table.attributes[page_index] != Memory::PageType::RasterizerCachedMemory) {
+                address = page_end;
+                continue;
+            }
+            memory.ReadBlock(*process, static_cast<VAddr>(page_address), page_buffer.data(),
+                             page_buffer.size());
+            page = page_buffer.data();
+        }
+
+        for (; address < page_end && num_matches < max_matches; address += request.value_size) {
+            u32 value = 0;
+            std::memcpy(&value, page + (address - page_address), request.value_size);
+            if (CompareScanValue(request.compare, value, request.value)) {
+                WriteU32(matches + num_matches * sizeof(u32), static_cast<u32>(address));
+                ++num_matches;
+            }
+        }
+    }
+
+    // Lets the client continue a scan that filled the reply
+    WriteU32(packet.GetPacketData().data(), static_cast<u32>(address));
+    packet.SetPacketDataSize(sizeof(u32) * (num_matches + 1));
+    packet.SendReply();
+}
+
+void RPCServer::HandleWatchMemory(std::unique_ptr<Packet> packet,
+                                  std::vector<MemoryRange> ranges) {
+    std::lock_guard lock{watch_mutex};
+
+    const auto process = kernel.GetCurrentProcess();
+    u32 data_size = 0;
+    for (const auto& range : ranges) {
+        memory.ReadBlock(*process, range.address, packet->GetPacketData().data() + data_size,
+                         range.size);
+        data_size += range.size;
+    }
+    packet->SetPacketDataSize(data_size);
+    packet->SendReply();
+
+    if (ranges.empty()) {
+        watch_packet.reset();
+        watch_ranges.clear();
+        watch_values.clear();
+        return;
+    }
+    watch_values.assign(packet->GetPacketData().begin(),
+                        packet->GetPacketData().begin() + data_size);
+    watch_ranges = std::move(ranges);
+    watch_packet = std::move(packet);
+}
+
+void RPCServer::WatchCallback([[maybe_unused]] u64 userdata, s64 cycles_late) {
+    {
+        std::lock_guard lock{watch_mutex};
+        if (watch_packet) {
+            const auto process = kernel.GetCurrentProcess();
+            u8* const data = watch_packet->GetPacketData().data();
+            std::array<u8, MAX_READ_SIZE> value;
+            u32 data_size = 0;
+            u8* last_value = watch_values.data();
+            for (const auto& range : watch_ranges) {
+                memory.ReadBlock(*process, range.address, value.data(), range.size);
+                if (std::memcmp(value.data(), last_value, range.size) != 0) {
+                    std::memcpy(last_value, value.data(), range.size);
+                    WriteU32(data + data_size, range.address);
+                    WriteU32(data + data_size + sizeof(u32), range.size);
+                    std::memcpy(data + data_size + sizeof(u32) * 2, value.data(), range.size);
+                    data_size += sizeof(u32) * 2 + range.size;
+                }
+                last_value += range.size;
+            }
+            if (data_size > 0) {
+                watch_packet->SetPacketDataSize(data_size);
+                watch_packet->SendReply();
+            }
+        }
+    }
+    timing.ScheduleEvent(watch_interval_ticks - cycles_late, watch_event);
+}
+
+void RPCServer::WriteMemory(u32 address, const u8* data, u32 data_size) {
     // Only allow writing to certain memory regions
     if ((address >= Memory::PROCESS_IMAGE_VADDR && address <= Memory::PROCESS_IMAGE_VADDR_END) ||
         (address >= Memory::HEAP_VADDR && address <= Memory::HEAP_VADDR_END) ||
         (address >= Memory::N3DS_EXTRA_RAM_VADDR && address <= Memory::N3DS_EXTRA_RAM_VADDR_END)) {
         // Note: Memory write occurs asynchronously from the state of the emulator
-        Core::System::GetInstance().Memory().WriteBlock(
-            *Core::System::GetInstance().Kernel().GetCurrentProcess(), address, data, data_size);
+        memory.WriteBlock(*kernel.GetCurrentProcess(), address, data, data_size);
         // If the memory happens to be executable code, make sure the changes become visible
         Core::CPU().InvalidateCacheRange(address, data_size);
     }
-    packet.SetPacketDataSize(0);
-    packet.SendReply();
 }
 
 bool RPCServer::ValidatePacket(const PacketHeader& packet_header) {
@@ -57,10 +240,27 @@ bool RPCServer::ValidatePacket(const PacketHeader& packet_header) {
         switch (packet_header.packet_type) {
         case PacketType::ReadMemory:
         case PacketType::WriteMemory:
+        case PacketType::WriteMemoryBatch:
             if (packet_header.packet_size >= (sizeof(u32) * 2)) {
                 return true;
             }
             break;
+        case PacketType::ReadMemoryBatch:
+            if (packet_header.packet_size >= sizeof(MemoryRange) &&
+                packet_header.packet_size % sizeof(MemoryRange) == 0) {
+                return true;
+            }
+            break;
+        case PacketType::WatchMemory:
+            if (packet_header.packet_size % sizeof(MemoryRange) == 0) {
+                return true;
+            }
+            break;
+        case PacketType::ScanMemory:
+            if (packet_header.packet_size == sizeof(ScanRequest)) {
+                return true;
+            }
+            break;
         default:
             break;
         }
@@ -72,27 +272,75 @@ void RPCServer::HandleSingleRequest(std::unique_ptr<Packet> request_packet) {
     bool success = false;
 
     if (ValidatePacket(request_packet->GetHeader())) {
-        // Currently, all request types use the address/data_size wire format
-        u32 address = 0;
-        u32 data_size = 0;
-        std::memcpy(&address, request_packet->GetPacketData().data(), sizeof(address));
-        std::memcpy(&data_size, request_packet->GetPacketData().data() + sizeof(address),
-                    sizeof(data_size));
+        const u8* data = request_packet->GetPacketData().data();
 
         switch (request_packet->GetPacketType()) {
-        case PacketType::ReadMemory:
+        case PacketType::ReadMemory: {
+            const u32 address = ReadU32(data);
+            const u32 data_size = ReadU32(data + sizeof(u32));
             if (data_size > 0 && data_size <= MAX_READ_SIZE) {
                 HandleReadMemory(*request_packet, address, data_size);
                 success = true;
             }
             break;
-        case PacketType::WriteMemory:
-            if (data_size > 0 && data_size <= MAX_PACKET_DATA_SIZE - (sizeof(u32) * 2)) {
-                const u8* data = request_packet->GetPacketData().data() + (sizeof(u32) * 2);
-                HandleWriteMemory(*request_packet, address, data, data_size);
+        }
+        case PacketType::WriteMemory: {
+            const u32 address = ReadU32(data);
+            const u32 data_size = ReadU32(data + sizeof(u32));
+            const u32 max_data_size = request_packet->GetPacketDataSize() - sizeof(u32) * 2;
+            if (data_size > 0 && data_size <= max_data_size) {
+                HandleWriteMemory(*request_packet, address, data + (sizeof(u32) * 2), data_size);
                 success = true;
             }
             break;
+        }
+        case PacketType::ReadMemoryBatch:
+        case PacketType::WatchMemory: {
+            std::vector<MemoryRange> ranges(request_packet->GetPacketDataSize() /
+                                            sizeof(MemoryRange));
+            std::memcpy(ranges.data(), data, ranges.size() * sizeof(MemoryRange));
+            // The contents of all ranges have to fit in one reply, and for watches in one
+            // change notification along with their addresses and sizes
+            const bool watch = request_packet->GetPacketType() == PacketType::WatchMemory;
+            u32 capacity = MAX_READ_SIZE;
+            bool valid = true;
+            for (const auto& range : ranges) {
+                const u64 needed = u64{range.size} + (watch ? sizeof(u32) * 2 : 0);
+                if (range.size == 0 || needed > capacity) {
+                    valid = false;
+                    break;
+                }
+                capacity -= static_cast<u32>(needed);
+            }
+            if (!valid) {
+                break;
+            }
+            if (watch) {
+                HandleWatchMemory(std::move(request_packet), std::move(ranges));
+                return;
+            }
+            HandleReadMemoryBatch(*request_packet, ranges);
+            success = true;
+            break;
+        }
+        case PacketType::WriteMemoryBatch:
+            HandleWriteMemoryBatch(*request_packet);
+            success = true;
+            break;
+        case PacketType::ScanMemory: {
+            ScanRequest request;
+            std::memcpy(&request, data, sizeof(request));
+            const u32 value_size = request.value_size;
+            // The scanned range has to end within the address space
+            if ((value_size == 1 || value_size == 2 || value_size == 4) &&
+                request.address % value_size == 0 && request.size % value_size == 0 &&
+                u64{request.address} + request.size <= (u64{1} << 32) &&
+                request.compare <= ScanCompare::GreaterOrEqual) {
+                HandleScanMemory(*request_packet, request);
+                success = true;
+            }
+            break;
+        }
         default:
             break;
         }
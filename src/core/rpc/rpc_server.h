@@ -8,33 +8,72 @@
 #include <memory>
 #include <mutex>
 #include <thread>
+#include <vector>
 #include "common/threadsafe_queue.h"
 #include "core/rpc/server.h"
 
+namespace Core {
+class Timing;
+struct TimingEventType;
+} // namespace Core
+
+namespace Kernel {
+class KernelSystem;
+} // namespace Kernel
+
+namespace Memory {
+class MemorySystem;
+} // namespace Memory
+
 namespace RPC {
 
 class Packet;
 struct PacketHeader;
+struct ScanRequest;
 
 class RPCServer {
 public:
-    RPCServer();
+    RPCServer(Memory::MemorySystem& memory, Kernel::KernelSystem& kernel, Core::Timing& timing);
     ~RPCServer();
 
     void QueueRequest(std::unique_ptr<RPC::Packet> request);
 
 private:
+    struct MemoryRange {
+        u32 address;
+        u32 size;
+    };
+
     void Start();
     void Stop();
     void HandleReadMemory(Packet& packet, u32 address, u32 data_size);
     void HandleWriteMemory(Packet& packet, u32 address, const u8* data, u32 data_size);
+    void HandleReadMemoryBatch(Packet& packet, const std::vector<MemoryRange>& ranges);
+    void HandleWriteMemoryBatch(Packet& packet);
+    void HandleScanMemory(Packet& packet, const ScanRequest& request);
+    void HandleWatchMemory(std::unique_ptr<Packet> packet, std::vector<MemoryRange> ranges);
+    void WriteMemory(u32 address, const u8* data, u32 data_size);
     bool ValidatePacket(const PacketHeader& packet_header);
     void HandleSingleRequest(std::unique_ptr<Packet> request);
     void HandleRequestsLoop();
+    /// Sends the watched ranges that changed since the last frame
+    void WatchCallback(u64 userdata, s64 cycles_late);
+
+    Memory::MemorySystem& memory;
+    Kernel::KernelSystem& kernel;
+    Core::Timing& timing;
 
     Server server;
     Common::SPSCQueue<std::unique_ptr<Packet>> request_queue;
     std::thread request_handler_thread;
+
+    Core::TimingEventType* watch_event;
+    std::mutex watch_mutex;
+    /// The WatchMemory request the changes are sent as replies to
+    std::unique_ptr<Packet> watch_packet;
+    std::vector<MemoryRange> watch_ranges;
+    /// The contents of every watched range as last sent, back to back
+    std::vector<u8> watch_values;
 };
 
 } // namespace RPC
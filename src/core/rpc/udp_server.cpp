@@ -66,17 +66,21 @@ private:
         std::memcpy(reply_buffer.data() + (4 * sizeof(u32)), reply_packet.GetPacketData().data(),
                     reply_packet.GetPacketDataSize());
 
-        boost::system::error_code error;
-        socket.send_to(boost::asio::buffer(reply_buffer), endpoint, 0, error);
-
-        if (error) {
-            LOG_WARNING(RPC_Server, "Failed to send reply: {}", error.message());
-        } else {
-            LOG_INFO(RPC_Server, "Sent reply version({}) id=({}) type=({}) size=({})",
-                     reply_packet.GetVersion(), reply_packet.GetId(),
-                     static_cast<u32>(reply_packet.GetPacketType()),
-                     reply_packet.GetPacketDataSize());
-        }
+        // Replies come from the request handling thread, and watch updates from the emulation
+        // thread. Sending from the worker thread keeps them from using the socket concurrently.
+        boost::asio::post(io_context, [this, endpoint, reply_header,
+                                       reply_buffer = std::move(reply_buffer)] {
+            boost::system::error_code error;
+            socket.send_to(boost::asio::buffer(reply_buffer), endpoint, 0, error);
+
+            if (error) {
+                LOG_WARNING(RPC_Server, "Failed to send reply: {}", error.message());
+            } else {
+                LOG_TRACE(RPC_Server, "Sent reply version({}) id=({}) type=({}) size=({})",
+                          reply_header.version, reply_header.id,
+                          static_cast<u32>(reply_header.packet_type), reply_header.packet_size);
+            }
+        });
     }
 
     std::thread worker_thread;
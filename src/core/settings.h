@@ -131,6 +131,7 @@ struct Values {
 
     // Data Storage
     bool use_virtual_sd;
+    bool use_boot_cache;
 
     // System
     int region_value;
@@ -143,6 +144,7 @@ struct Values {
     bool use_hw_shader;
     bool shaders_accurate_mul;
     bool use_shader_jit;
+    bool use_disk_shader_cache;
     u16 resolution_factor;
     bool use_frame_limit;
     u16 frame_limit;
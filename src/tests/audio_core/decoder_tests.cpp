@@ -20,32 +20,31 @@
 #include "audio_fixures.h"
 
 TEST_CASE("DSP HLE Audio Decoder", "[audio_core]") {
-    Memory::MemorySystem memory;
     SECTION("decoder should produce correct samples") {
         auto decoder =
 #ifdef HAVE_MF
-            std::make_unique<AudioCore::HLE::WMFDecoder>(memory);
+            std::make_unique<AudioCore::HLE::WMFDecoder>();
 #elif HAVE_FFMPEG
-            std::make_unique<AudioCore::HLE::FFMPEGDecoder>(memory);
+            std::make_unique<AudioCore::HLE::FFMPEGDecoder>();
 #endif
         AudioCore::HLE::BinaryRequest request;
+        AudioCore::HLE::DecoderBuffers buffers;
 
         request.codec = AudioCore::HLE::DecoderCodec::AAC;
         request.cmd = AudioCore::HLE::DecoderCommand::Init;
         // initialize decoder
-        std::optional<AudioCore::HLE::BinaryResponse> response = decoder->ProcessRequest(request);
+        std::optional<AudioCore::HLE::BinaryResponse> response =
+            decoder->ProcessRequest(request, buffers);
 
         request.cmd = AudioCore::HLE::DecoderCommand::Decode;
-        u8* fcram = memory.GetFCRAMPointer(0);
-
-        memcpy(fcram, fixure_buffer, fixure_buffer_size);
+        buffers.input.assign(fixure_buffer->begin(), fixure_buffer->end());
         request.src_addr = Memory::FCRAM_PADDR;
         request.dst_addr_ch0 = Memory::FCRAM_PADDR + 1024;
         request.dst_addr_ch1 = Memory::FCRAM_PADDR + 1048576; // 1 MB
         request.size = fixure_buffer_size;
 
-        response = decoder->ProcessRequest(request);
-        response = decoder->ProcessRequest(request);
+        response = decoder->ProcessRequest(request, buffers);
+        response = decoder->ProcessRequest(request, buffers);
         // remove this line
         request.src_addr = Memory::FCRAM_PADDR;
     }
@@ -0,0 +1,100 @@
+// Copyright 2020 Citra Emulator Project
+// Licensed under GPLv2 or any later version
+// Refer to the license.txt file included.
+
+#include <algorithm>
+#include <catch2/catch.hpp>
+#include "audio_core/hle/decoder.h"
+#include "core/memory.h"
+
+namespace AudioCore::HLE {
+
+namespace {
+/// Decoder which outputs its input on both channels
+class CopyDecoder final : public DecoderBase {
+public:
+    std::optional<BinaryResponse> ProcessRequest(const BinaryRequest& request,
+                                                 DecoderBuffers& buffers) override {
+        buffers.output[0] = buffers.input;
+        buffers.output[1] = buffers.input;
+        BinaryResponse response;
+        response.codec = request.codec;
+        response.cmd = request.cmd;
+        response.size = static_cast<u32>(buffers.input.size());
+        return response;
+    }
+};
+} // Anonymous namespace
+
+TEST_CASE("AsyncDecoder returns responses in submission order", "[audio_core]") {
+    Memory::MemorySystem memory;
+    AsyncDecoder decoder(memory, [] { return std::make_unique<NullDecoder>(); });
+
+    BinaryRequest request;
+    request.codec = DecoderCodec::AAC;
+    request.cmd = DecoderCommand::Decode;
+    request.src_addr = Memory::FCRAM_PADDR;
+    for (u32 i = 0; i < 16; i++) {
+        request.size = i;
+        decoder.Submit(request);
+    }
+
+    std::vector<std::optional<BinaryResponse>> responses;
+    decoder.Collect(responses);
+    REQUIRE(responses.size() == 16);
+    for (u32 i = 0; i < 16; i++) {
+        REQUIRE(responses[i]);
+        REQUIRE(responses[i]->size == i);
+    }
+
+    // Nothing is pending any more, so requests can be processed synchronously.
+    request.size = 1234;
+    const auto response = decoder.ProcessRequest(request);
+    REQUIRE(response);
+    REQUIRE(response->size == 1234);
+
+    responses.clear();
+    decoder.Collect(responses);
+    REQUIRE(responses.empty());
+}
+
+TEST_CASE("AsyncDecoder stages guest memory on the calling thread", "[audio_core]") {
+    Memory::MemorySystem memory;
+    AsyncDecoder decoder(memory, [] { return std::make_unique<CopyDecoder>(); });
+    u8* fcram = memory.GetFCRAMPointer(0);
+
+    constexpr u32 size = 0x100;
+    BinaryRequest request;
+    request.codec = DecoderCodec::AAC;
+    request.cmd = DecoderCommand::Decode;
+    request.src_addr = Memory::FCRAM_PADDR;
+    request.size = size;
+    request.dst_addr_ch0 = Memory::FCRAM_PADDR + 0x1000;
+    request.dst_addr_ch1 = Memory::FCRAM_PADDR + 0x2000;
+
+    std::fill_n(fcram, size, u8{0x11});
+    decoder.Submit(request);
+    // The application may overwrite the source as soon as the request is made
+    std::fill_n(fcram, size, u8{0x22});
+    request.dst_addr_ch0 = Memory::FCRAM_PADDR + 0x3000;
+    request.dst_addr_ch1 = Memory::FCRAM_PADDR + 0x4000;
+    decoder.Submit(request);
+
+    std::vector<std::optional<BinaryResponse>> responses;
+    decoder.Collect(responses);
+    REQUIRE(responses.size() == 2);
+    REQUIRE(responses[0]);
+    REQUIRE(responses[1]);
+    REQUIRE(std::all_of(fcram + 0x1000, fcram + 0x1000 + size, [](u8 b) { return b == 0x11; }));
+    REQUIRE(std::all_of(fcram + 0x2000, fcram + 0x2000 + size, [](u8 b) { return b == 0x11; }));
+    REQUIRE(std::all_of(fcram + 0x3000, fcram + 0x3000 + size, [](u8 b) { return b == 0x22; }));
+    REQUIRE(std::all_of(fcram + 0x4000, fcram + 0x4000 + size, [](u8 b) { return b == 0x22; }));
+
+    SECTION("requests with out of bounds output fail") {
+        request.dst_addr_ch1 = Memory::FCRAM_PADDR + Memory::FCRAM_SIZE - size / 2;
+        const auto response = decoder.ProcessRequest(request);
+        REQUIRE(!response);
+    }
+}
+
+} // namespace AudioCore::HLE
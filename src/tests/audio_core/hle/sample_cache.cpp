@@ -0,0 +1,118 @@
+// Copyright 2020 Citra Emulator Project
+// Licensed under GPLv2 or any later version
+// Refer to the license.txt file included.
+
+#include <array>
+#include <cstring>
+#include <catch2/catch.hpp>
+#include "audio_core/hle/sample_cache.h"
+#include "audio_core/hle/source.h"
+#include "core/memory.h"
+
+namespace AudioCore::HLE {
+
+using Configuration = SourceConfiguration::Configuration;
+
+static void SetupLoopingBuffer(Configuration& config, Configuration::Format format, u32 length) {
+    std::memset(&config, 0, sizeof(config));
+    config.enable = 1;
+    config.enable_dirty.Assign(1);
+    config.rate_multiplier = 1.3f;
+    config.rate_multiplier_dirty.Assign(1);
+    config.interpolation_mode = Configuration::InterpolationMode::Linear;
+    config.interpolation_dirty.Assign(1);
+    config.gain[0][0] = config.gain[0][1] = 1.0f;
+    config.gain_0_dirty.Assign(1);
+    config.adpcm_coefficients_dirty.Assign(1);
+    config.physical_address = Memory::FCRAM_PADDR;
+    config.length = length;
+    config.mono_or_stereo.Assign(Configuration::MonoOrStereo::Mono);
+    config.format.Assign(format);
+    config.adpcm_ps = 0x12;
+    config.adpcm_yn[0] = 100;
+    config.adpcm_yn[1] = -100;
+    config.adpcm_dirty.Assign(1);
+    config.is_looping.Assign(1);
+    config.buffer_id = 1;
+    config.embedded_buffer_dirty.Assign(1);
+}
+
+TEST_CASE("SampleCache doesn't change Source output", "[audio_core]") {
+    Memory::MemorySystem memory;
+    u8* const fcram = memory.GetPhysicalPointer(Memory::FCRAM_PADDR);
+    u32 seed = 1;
+    for (std::size_t i = 0; i < 0x4000; i++) {
+        seed = seed * 1103515245 + 12345;
+        fcram[i] = static_cast<u8>(seed >> 16);
+    }
+
+    s16_le adpcm_coeffs[16];
+    for (std::size_t i = 0; i < 16; i++) {
+        adpcm_coeffs[i] = static_cast<s16>(i % 2 == 0 ? 0x800 - i * 64 : -0x300 + i * 16);
+    }
+
+    // An odd length that isn't a multiple of the ADPCM frame size.
+    constexpr u32 length = 1001;
+
+    for (const auto format : {Configuration::Format::ADPCM, Configuration::Format::PCM8}) {
+        SampleCache cache;
+        Source cached(0);
+        Source uncached(1);
+        cached.SetMemory(memory);
+        uncached.SetMemory(memory);
+        cached.SetSampleCache(&cache);
+
+        Configuration cached_config;
+        Configuration uncached_config;
+        SetupLoopingBuffer(cached_config, format, length);
+        SetupLoopingBuffer(uncached_config, format, length);
+
+        for (int frame = 0; frame < 64; frame++) {
+            cached.Tick(cached_config, adpcm_coeffs);
+            uncached.Tick(uncached_config, adpcm_coeffs);
+
+            QuadFrame32 cached_output{};
+            QuadFrame32 uncached_output{};
+            cached.MixInto(cached_output, 0);
+            uncached.MixInto(uncached_output, 0);
+            REQUIRE(cached_output == uncached_output);
+        }
+
+        // The looping buffer is decoded once and replayed from the cache afterwards.
+        REQUIRE(cache.GetStats().misses == 1);
+        REQUIRE(cache.GetStats().hits > 1);
+        REQUIRE(cache.GetStats().entries == 1);
+    }
+}
+
+TEST_CASE("SampleCache evicts least recently used entries", "[audio_core]") {
+    constexpr std::size_t entry_samples = 256;
+    constexpr std::size_t entry_bytes = entry_samples * sizeof(StereoBuffer16::Sample);
+    SampleCache cache(entry_bytes * 2);
+
+    const std::array<u8, 4> data{};
+    const auto make_key = [&data](PAddr address) {
+        return SampleCache::MakeKey(data.data(), address, static_cast<u32>(data.size()),
+                                    SampleCache::Format::PCM8, 1, {}, {});
+    };
+    const auto make_entry = [] {
+        SampleCache::Entry entry;
+        entry.samples.resize(entry_samples);
+        return entry;
+    };
+
+    cache.Insert(make_key(0x1000), make_entry());
+    cache.Insert(make_key(0x2000), make_entry());
+    REQUIRE(cache.Lookup(make_key(0x1000)) != nullptr);
+
+    cache.Insert(make_key(0x3000), make_entry());
+    REQUIRE(cache.GetStats().evictions == 1);
+    REQUIRE(cache.GetStats().bytes == entry_bytes * 2);
+    REQUIRE(cache.Lookup(make_key(0x1000)) != nullptr);
+    REQUIRE(cache.Lookup(make_key(0x2000)) == nullptr);
+    REQUIRE(cache.Lookup(make_key(0x3000)) != nullptr);
+    REQUIRE(cache.GetStats().hits == 3);
+    REQUIRE(cache.GetStats().misses == 1);
+}
+
+} // namespace AudioCore::HLE
@@ -0,0 +1,102 @@
+// Copyright 2020 Citra Emulator Project
+// Licensed under GPLv2 or any later version
+// Refer to the license.txt file included.
+
+#include <algorithm>
+#include <array>
+#include <vector>
+#include <catch2/catch.hpp>
+#include "audio_core/codec.h"
+#include "audio_core/interpolate.h"
+
+namespace AudioCore::AudioInterp {
+
+static std::vector<StereoBuffer16::Sample> MakeInput(std::size_t length) {
+    std::vector<StereoBuffer16::Sample> input(length);
+    for (std::size_t i = 0; i < length; i++) {
+        // A steep sawtooth exercises the saturated delta in Linear.
+        input[i][0] = static_cast<s16>(i * 4099);
+        input[i][1] = static_cast<s16>(-static_cast<s32>(i) * 7919);
+    }
+    return input;
+}
+
+/// Resamples input into as many frames as it fills, appending chunk_size samples at a time.
+template <typename Function>
+static std::vector<StereoFrame16> Resample(Function fn, float rate,
+                                           const std::vector<StereoBuffer16::Sample>& input,
+                                           std::size_t chunk_size) {
+    std::vector<StereoFrame16> frames;
+    StereoBuffer16 buffer;
+    State state;
+    StereoFrame16 frame{};
+    std::size_t outputi = 0;
+    std::size_t consumed = 0;
+    while (true) {
+        if (buffer.Empty()) {
+            if (consumed == input.size())
+                break;
+            const std::size_t count = std::min(chunk_size, input.size() - consumed);
+            buffer.Clear();
+            std::copy_n(input.begin() + consumed, count, buffer.Append(count));
+            consumed += count;
+        }
+        fn(state, buffer, rate, frame, outputi);
+        if (outputi == frame.size()) {
+            frames.push_back(frame);
+            outputi = 0;
+        }
+    }
+    return frames;
+}
+
+TEST_CASE("AudioInterp is independent of how the input is split", "[audio_core]") {
+    const auto input = MakeInput(3000);
+    for (const float rate : {0.37f, 1.0f, 1.5f, 3.1f}) {
+        const auto reference = Resample(Linear, rate, input, input.size());
+        REQUIRE(!reference.empty());
+        for (const std::size_t chunk_size : {1, 7, 160, 1024}) {
+            REQUIRE(Resample(Linear, rate, input, chunk_size) == reference);
+            REQUIRE(Resample(None, rate, input, chunk_size) ==
+                    Resample(None, rate, input, input.size()));
+        }
+    }
+}
+
+TEST_CASE("AudioInterp::Linear", "[audio_core]") {
+    StereoBuffer16 buffer;
+    StereoBuffer16::Sample* const samples = buffer.Append(4);
+    samples[0] = {0, 0};
+    samples[1] = {100, -100};
+    samples[2] = {-32768, 32767};
+    samples[3] = {0, 0};
+
+    State state;
+    StereoFrame16 frame{};
+    std::size_t outputi = 0;
+    Linear(state, buffer, 0.5f, frame, outputi);
+
+    // Output is delayed by the two history samples.
+    REQUIRE(outputi == 8);
+    REQUIRE((frame[4] == StereoBuffer16::Sample{0, 0}));
+    REQUIRE((frame[5] == StereoBuffer16::Sample{50, -50}));
+    REQUIRE((frame[6] == StereoBuffer16::Sample{100, -100}));
+    // The deltas saturate to -32768 and 32767 before being halved.
+    REQUIRE((frame[7] == StereoBuffer16::Sample{-16284, 16283}));
+    REQUIRE(buffer.Empty());
+}
+
+TEST_CASE("Codec::DecodePCM16 appends to the buffer", "[audio_core]") {
+    const std::array<s16, 4> pcm = {1, -2, 3, -4};
+    StereoBuffer16 buffer;
+    Codec::DecodePCM16(1, reinterpret_cast<const u8*>(pcm.data()), 2, buffer);
+    Codec::DecodePCM16(2, reinterpret_cast<const u8*>(pcm.data()), 2, buffer);
+
+    REQUIRE(buffer.Size() == 4);
+    REQUIRE((buffer[0] == StereoBuffer16::Sample{1, 1}));
+    REQUIRE((buffer[1] == StereoBuffer16::Sample{-2, -2}));
+    REQUIRE((buffer[2] == StereoBuffer16::Sample{1, -2}));
+    REQUIRE((buffer[3] == StereoBuffer16::Sample{3, -4}));
+}
+
+} // namespace AudioCore::AudioInterp
@@ -0,0 +1,111 @@
+// Copyright 2020 Citra Emulator Project
+// Licensed under GPLv2 or any later version
+// Refer to the license.txt file included.
+
+#include <chrono>
+#include <future>
+#include <memory>
+#include <string>
+#include <string_view>
+#include <catch2/catch.hpp>
+#include "common/common_types.h"
+#include "common/logging/backend.h"
+#include "common/logging/log.h"
+
+namespace Log {
+
+static_assert(TrimSourcePath("/home/user/citra/src/core/core.cpp") ==
+              std::string_view("/home/user/citra/src/").size());
+static_assert(TrimSourcePath("src/common/logging/backend.cpp") == std::string_view("src/").size());
+static_assert(TrimSourcePath("..\\..\\src\\video_core\\pica.cpp") ==
+              std::string_view("..\\..\\src\\").size());
+static_assert(TrimSourcePath("../../externals/foo.cpp") == std::string_view("../../").size());
+static_assert(TrimSourcePath("/home/user/mysrc/core.cpp") == 0);
+
+template <typename... Args>
+static std::string FormatDeferred(const char* format, const Args&... args) {
+    Detail::DeferredArgs deferred_args;
+    REQUIRE((deferred_args.Write(args) && ...));
+
+    std::string message;
+    Detail::FormatDeferred<std::decay_t<Args>...>(format, deferred_args.data.data(), message);
+    return message;
+}
+
+enum class TestEnum : u8 { Value = 7 };
+
+TEST_CASE("Logging deferred formatting", "[common]") {
+    SECTION("matches formatting right away") {
+        const std::string name = "gsp::Gpu";
+        const u32 address = 0x1EF00000;
+        const char* method = "WriteHWRegs";
+        REQUIRE(FormatDeferred("{} called {:08X} {} {:.2f} {} {}", name, address, method, 0.5f,
+                               true, static_cast<u8>(TestEnum::Value)) ==
+                fmt::format("{} called {:08X} {} {:.2f} {} {}", name, address, method, 0.5f, true,
+                            static_cast<u8>(TestEnum::Value)));
+    }
+
+    SECTION("keeps strings that go away before formatting") {
+        Detail::DeferredArgs deferred_args;
+        {
+            const std::string temporary = "temporary";
+            REQUIRE(deferred_args.Write(temporary));
+            REQUIRE(deferred_args.Write(s64{-1}));
+        }
+        std::string message;
+        Detail::FormatDeferred<std::string, s64>("{} {}", deferred_args.data.data(), message);
+        REQUIRE(message == "temporary -1");
+    }
+
+    SECTION("rejects arguments that don't fit") {
+        Detail::DeferredArgs deferred_args;
+        REQUIRE_FALSE(deferred_args.Write(std::string(Detail::MAX_DEFERRED_ARGS_SIZE, 'x')));
+    }
+}
+
+namespace {
+class CaptureBackend : public Backend {
+public:
+    static const char* Name() {
+        return "capture";
+    }
+    const char* GetName() const override {
+        return Name();
+    }
+    void Write(const Entry& entry) override {
+        if (entry.log_class == Class::Debug && !written) {
+            written = true;
+            log_level = entry.log_level;
+            filename = entry.filename;
+            message = entry.message;
+            captured.set_value();
+        }
+    }
+
+    std::promise<void> captured;
+    bool written = false;
+    Level log_level;
+    std::string filename;
+    std::string message;
+};
+} // Anonymous namespace
+
+TEST_CASE("Logging through the logging thread", "[common]") {
+    auto backend = std::make_unique<CaptureBackend>();
+    CaptureBackend& capture = *backend;
+    std::future<void> captured = capture.captured.get_future();
+    AddBackend(std::move(backend));
+
+    {
+        const std::string temporary = "formatted";
+        LOG_WARNING(Debug, "{} on the logging thread {:#x}", temporary, 0x3D);
+    }
+
+    REQUIRE(captured.wait_for(std::chrono::seconds(5)) == std::future_status::ready);
+    REQUIRE(capture.log_level == Level::Warning);
+    REQUIRE(capture.message == "formatted on the logging thread 0x3d");
+    REQUIRE(capture.filename == "tests/common/logging.cpp");
+    RemoveBackend(CaptureBackend::Name());
+}
+
+} // namespace Log
@@ -0,0 +1,69 @@
+// Copyright 2020 Citra Emulator Project
+// Licensed under GPLv2 or any later version
+// Refer to the license.txt file included.
+
+#include <thread>
+#include <utility>
+#include <vector>
+#include <catch2/catch.hpp>
+#include "common/common_types.h"
+#include "common/threadsafe_queue.h"
+
+namespace Common {
+
+TEST_CASE("BoundedMPSCQueue overflow", "[common]") {
+    BoundedMPSCQueue<u32, 4> queue;
+    REQUIRE(queue.Empty());
+
+    // The elements past the capacity of the ring go through the overflow queue
+    for (u32 i = 0; i < 10; ++i) {
+        queue.Push(i);
+    }
+    for (u32 i = 0; i < 10; ++i) {
+        REQUIRE(!queue.Empty());
+        REQUIRE(queue.PopWait() == i);
+    }
+    REQUIRE(queue.Empty());
+
+    // Once the overflow queue has been drained, the ring is used again
+    u32 value;
+    queue.Push(10u);
+    REQUIRE(queue.Pop(value));
+    REQUIRE(value == 10);
+    REQUIRE(!queue.Pop(value));
+}
+
+TEST_CASE("BoundedMPSCQueue keeps the order of each writer", "[common]") {
+    constexpr u32 num_writers = 4;
+    constexpr u32 elements_per_writer = 100000;
+
+    // A small ring, so that writers keep switching between it and the overflow queue
+    BoundedMPSCQueue<std::pair<u32, u32>, 8> queue;
+    std::vector<std::thread> writers;
+    for (u32 writer = 0; writer < num_writers; ++writer) {
+        writers.emplace_back([&queue, writer] {
+            for (u32 i = 0; i < elements_per_writer; ++i) {
+                queue.Push(std::make_pair(writer, i));
+            }
+        });
+    }
+
+    std::vector<u32> next(num_writers, 0);
+    bool in_order = true;
+    for (u32 i = 0; i < num_writers * elements_per_writer; ++i) {
+        const auto [writer, value] = queue.PopWait();
+        in_order = in_order && value == next[writer];
+        next[writer] = value + 1;
+    }
+    for (auto& thread : writers) {
+        thread.join();
+    }
+
+    REQUIRE(in_order);
+    REQUIRE(queue.Empty());
+    for (u32 writer = 0; writer < num_writers; ++writer) {
+        REQUIRE(next[writer] == elements_per_writer);
+    }
+}
+
+} // namespace Common
@@ -0,0 +1,125 @@
+// Copyright 2020 Citra Emulator Project
+// Licensed under GPLv2 or any later version
+// Refer to the license.txt file included.
+
+#include <cstring>
+#include <string>
+#include <vector>
+#include <catch2/catch.hpp>
+#include <fmt/format.h>
+#include "core/arm/dyncom/arm_dyncom.h"
+#include "core/cheats/gateway_cheat.h"
+#include "core/core_timing.h"
+#include "core/hle/kernel/process.h"
+#include "core/memory.h"
+
+namespace Cheats {
+
+namespace {
+u32 ReadU32(const std::vector<u8>& heap, std::size_t offset) {
+    u32 value;
+    std::memcpy(&value, heap.data() + offset, sizeof(value));
+    return value;
+}
+} // Anonymous namespace
+
+TEST_CASE("GatewayCheat::Execute", "[core][cheats]") {
+    constexpr u32 heap_size = 0x1000;
+    constexpr u32 base = Memory::HEAP_VADDR;
+
+    Core::Timing timing;
+    Memory::MemorySystem memory;
+    Kernel::KernelSystem kernel(memory, timing, [] {}, 0);
+    auto process = kernel.CreateProcess(kernel.CreateCodeSet("", 0));
+
+    std::vector<u8> heap(heap_size);
+    REQUIRE(process->vm_manager
+                .MapBackingMemory(base, heap.data(), heap_size, Kernel::MemoryState::Private)
+                .Succeeded());
+    memory.SetCurrentPageTable(&process->vm_manager.page_table);
+
+    ARM_DynCom cpu(nullptr, memory, USER32MODE);
+
+    SECTION("a patch inside a false block is skipped along with its data lines") {
+        // The data line reads like a conditional code. Running it as one would leave the block
+        // open and skip the final write.
+        std::string code;
+        code += fmt::format("5{:07X} 12345678\n", base);
+        code += fmt::format("E{:07X} 00000008\n", base + 0x10);
+        code += "50000000 00000000\n";
+        code += "D0000000 00000000\n";
+        code += fmt::format("0{:07X} 0000ABCD\n", base + 0x20);
+        const GatewayCheat cheat("", code, "");
+
+        cheat.Execute(memory, cpu, 0);
+        REQUIRE(ReadU32(heap, 0x10) == 0);
+        REQUIRE(ReadU32(heap, 0x20) == 0xABCD);
+
+        // With the condition met, the data line is written instead of run
+        const u32 condition = 0x12345678;
+        std::memcpy(heap.data(), &condition, sizeof(condition));
+        cheat.Execute(memory, cpu, 0);
+        REQUIRE(ReadU32(heap, 0x10) == 0x50000000);
+        REQUIRE(ReadU32(heap, 0x14) == 0);
+    }
+
+    SECTION("a patch missing data lines writes only the data it has") {
+        std::string code;
+        code += fmt::format("E{:07X} 00000014\n", base + 0x40);
+        code += "11223344 55667788\n";
+        const GatewayCheat cheat("", code, "");
+
+        std::vector<u8> expected = heap;
+        std::memset(expected.data() + 0x40, 0xEE, 0x20);
+        std::memset(heap.data() + 0x40, 0xEE, 0x20);
+        const u32 words[]{0x11223344, 0x55667788};
+        std::memcpy(expected.data() + 0x40, words, sizeof(words));
+
+        cheat.Execute(memory, cpu, 0);
+        REQUIRE(heap == expected);
+    }
+
+    SECTION("a loop jumps back to its own code when invalid lines were dropped before it") {
+        std::string code;
+        code += fmt::format("D3000000 {:08X}\n", base + 0x80);
+        code += "not a code\n";
+        code += "D5000000 00000007\n";
+        code += "G0000000 00000000\n";
+        code += "C0000000 00000002\n";
+        code += "0123\n";
+        code += "D6000000 00000000\n";
+        code += "D4000000 00000001\n";
+        code += "D2000000 00000000\n";
+        const GatewayCheat cheat("", code, "");
+
+        cheat.Execute(memory, cpu, 0);
+        REQUIRE(ReadU32(heap, 0x80) == 7);
+        REQUIRE(ReadU32(heap, 0x84) == 8);
+        REQUIRE(ReadU32(heap, 0x88) == 9);
+        REQUIRE(ReadU32(heap, 0x8C) == 0);
+    }
+
+    SECTION("a joker block only runs while all of its buttons are held") {
+        std::string code;
+        code += "DD000000 00000041\n";
+        code += fmt::format("0{:07X} 00000001\n", base + 0xC0);
+        // A joker inside a skipped block must not end the outer block early
+        code += "DD000000 00000001\n";
+        code += "D0000000 00000000\n";
+        code += fmt::format("0{:07X} 00000002\n", base + 0xC4);
+        code += "D0000000 00000000\n";
+        code += fmt::format("0{:07X} 00000003\n", base + 0xC8);
+        const GatewayCheat cheat("", code, "");
+
+        cheat.Execute(memory, cpu, 0x01);
+        REQUIRE(ReadU32(heap, 0xC0) == 0);
+        REQUIRE(ReadU32(heap, 0xC4) == 0);
+        REQUIRE(ReadU32(heap, 0xC8) == 3);
+
+        cheat.Execute(memory, cpu, 0xFF);
+        REQUIRE(ReadU32(heap, 0xC0) == 1);
+        REQUIRE(ReadU32(heap, 0xC4) == 2);
+    }
+}
+
+} // namespace Cheats
@@ -7,6 +7,7 @@
 #include <array>
 #include <bitset>
 #include <string>
+#include <vector>
 #include "common/file_util.h"
 #include "core/core.h"
 #include "core/core_timing.h"
@@ -226,3 +227,42 @@ TEST_CASE("CoreTiming[ChainScheduling]", "[core]") {
     REQUIRE(0 == reschedules);
     REQUIRE(MAX_SLICE_LENGTH == timing.GetDowncount());
 }
+
+TEST_CASE("CoreTiming[Unschedule]", "[core]") {
+    Core::Timing timing;
+
+    std::vector<u64> order;
+    const auto record = [&order](u64 userdata, s64 cycles_late) { order.push_back(userdata); };
+    Core::TimingEventType* cb_a = timing.RegisterEvent("callbackA", record);
+    Core::TimingEventType* cb_b = timing.RegisterEvent("callbackB", record);
+
+    // Enter slice 0
+    timing.Advance();
+
+    for (u64 i = 0; i < 8; ++i) {
+        timing.ScheduleEvent(1000, i % 2 ? cb_b : cb_a, i);
+    }
+    timing.ScheduleEvent(500, cb_b, 100);
+    timing.ScheduleEvent(1500, cb_a, 101);
+
+    timing.UnscheduleEvent(cb_a, 2);
+    timing.UnscheduleEvent(cb_b, 100);
+    timing.UnscheduleEvent(cb_b, 42); // Not scheduled
+    timing.RemoveEvent(cb_b);
+
+    // Unscheduling doesn't extend the slice, so this one doesn't run anything
+    timing.AddTicks(timing.GetDowncount());
+    timing.Advance();
+    REQUIRE(order.empty());
+    REQUIRE(500 == timing.GetDowncount());
+
+    timing.AddTicks(timing.GetDowncount());
+    timing.Advance();
+    REQUIRE(order == std::vector<u64>{0, 4, 6});
+    REQUIRE(500 == timing.GetDowncount());
+
+    timing.AddTicks(timing.GetDowncount());
+    timing.Advance();
+    REQUIRE(order == std::vector<u64>{0, 4, 6, 101});
+    REQUIRE(MAX_SLICE_LENGTH == timing.GetDowncount());
+}
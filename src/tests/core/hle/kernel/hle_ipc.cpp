@@ -230,6 +230,45 @@ TEST_CASE("HLERequestContext::PopulateFromIncomingCommandBuffer", "[core][kernel
         REQUIRE(process->vm_manager.UnmapRange(target_address_mapped, buffer_mapped->size()) ==
                 RESULT_SUCCESS);
     }
+
+    SECTION("can be reused after Reset") {
+        auto buffer = std::make_shared<std::vector<u8>>(Memory::PAGE_SIZE);
+        std::fill(buffer->begin(), buffer->end(), 0xAB);
+
+        VAddr target_address = 0x10000000;
+        auto result = process->vm_manager.MapBackingMemory(target_address, buffer->data(),
+                                                           buffer->size(), MemoryState::Private);
+        REQUIRE(result.Code() == RESULT_SUCCESS);
+
+        auto a = MakeObject(kernel);
+        const u32_le first[]{
+            IPC::MakeHeader(0, 0, 4),
+            IPC::StaticBufferDesc(buffer->size(), 0),
+            target_address,
+            IPC::CopyHandleDesc(1),
+            process->handle_table.Create(a).Unwrap(),
+        };
+        context.PopulateFromIncomingCommandBuffer(first, *process);
+        REQUIRE(context.GetStaticBuffer(0).size() == buffer->size());
+
+        context.Reset(nullptr, nullptr);
+        REQUIRE(context.Session() == nullptr);
+        REQUIRE(context.GetStaticBuffer(0).empty());
+
+        std::fill(buffer->begin(), buffer->end(), 0xCD);
+        const u32_le second[]{
+            IPC::MakeHeader(0, 0, 2),
+            IPC::StaticBufferDesc(0x10, 0),
+            target_address,
+        };
+        context.PopulateFromIncomingCommandBuffer(second, *process);
+
+        CHECK(context.GetStaticBuffer(0) == std::vector<u8>(0x10, 0xCD));
+        // The handle from the first request is no longer referenced by the context
+        CHECK(a.use_count() == 2);
+
+        REQUIRE(process->vm_manager.UnmapRange(target_address, buffer->size()) == RESULT_SUCCESS);
+    }
 }
 
 TEST_CASE("HLERequestContext::WriteToOutgoingCommandBuffer", "[core][kernel]") {
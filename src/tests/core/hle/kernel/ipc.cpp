@@ -0,0 +1,146 @@
+// Copyright 2020 Citra Emulator Project
+// Licensed under GPLv2 or any later version
+// Refer to the license.txt file included.
+
+#include <algorithm>
+#include <array>
+#include <vector>
+#include <catch2/catch.hpp>
+#include "core/arm/dyncom/arm_dyncom.h"
+#include "core/core.h"
+#include "core/core_timing.h"
+#include "core/hle/ipc.h"
+#include "core/hle/kernel/ipc.h"
+#include "core/hle/kernel/memory.h"
+#include "core/hle/kernel/process.h"
+#include "core/hle/kernel/thread.h"
+#include "core/memory.h"
+
+namespace Kernel {
+
+constexpr u32 HEAP_SIZE = 0x10000;
+
+static std::shared_ptr<Process> MakeProcess(KernelSystem& kernel, Memory::MemorySystem& memory) {
+    auto process = kernel.CreateProcess(kernel.CreateCodeSet("", 0));
+    const auto offset =
+        kernel.GetMemoryRegion(MemoryRegion::APPLICATION)->LinearAllocate(HEAP_SIZE);
+    REQUIRE(offset.has_value());
+    REQUIRE(process->vm_manager
+                .MapBackingMemory(Memory::HEAP_VADDR, memory.GetFCRAMPointer(*offset), HEAP_SIZE,
+                                  MemoryState::Private)
+                .Succeeded());
+    return process;
+}
+
+static std::shared_ptr<Thread> MakeThread(KernelSystem& kernel, Process& process) {
+    return kernel
+        .CreateThread("", Memory::HEAP_VADDR, ThreadPrioLowest, 0, ThreadProcessorId0,
+                      Memory::HEAP_VADDR + HEAP_SIZE, process)
+        .Unwrap();
+}
+
+TEST_CASE("TranslateCommandBuffer MappedBuffer", "[core][kernel]") {
+    Core::Timing timing;
+    Memory::MemorySystem memory;
+    Kernel::KernelSystem kernel(memory, timing, [] {}, 0);
+    kernel.SetCPU(std::make_shared<ARM_DynCom>(nullptr, memory, USER32MODE));
+
+    auto client = MakeProcess(kernel, memory);
+    auto server = MakeProcess(kernel, memory);
+    auto client_thread = MakeThread(kernel, *client);
+    auto server_thread = MakeThread(kernel, *server);
+
+    // Buffers outside of FCRAM can not be aliased and are copied instead.
+    std::vector<u8> host_buffer(HEAP_SIZE);
+    REQUIRE(client->vm_manager
+                .MapBackingMemory(Memory::HEAP_VADDR + HEAP_SIZE, host_buffer.data(),
+                                  static_cast<u32>(host_buffer.size()), MemoryState::Private)
+                .Succeeded());
+
+    std::vector<MappedBufferContext> mapped_buffer_context;
+
+    const auto round_trip = [&](VAddr source_address, u32 size,
+                                IPC::MappedBufferPermissions permissions, bool expect_aliased) {
+        std::vector<u8> data(size);
+        std::generate(data.begin(), data.end(), [n = 0]() mutable { return static_cast<u8>(n++); });
+        memory.WriteBlock(*client, source_address, data.data(), data.size());
+        const u8 byte_before = 0x5A;
+        memory.WriteBlock(*client, source_address - 1, &byte_before, sizeof(byte_before));
+
+        const u32_le request[]{
+            IPC::MakeHeader(1, 0, 2),
+            IPC::MappedBufferDesc(size, permissions),
+            source_address,
+        };
+        memory.WriteBlock(*client, client_thread->GetCommandBufferAddress(), request,
+                          sizeof(request));
+        REQUIRE(TranslateCommandBuffer(kernel, memory, client_thread, server_thread,
+                                       client_thread->GetCommandBufferAddress(),
+                                       server_thread->GetCommandBufferAddress(),
+                                       mapped_buffer_context, false) == RESULT_SUCCESS);
+
+        REQUIRE(mapped_buffer_context.size() == 1);
+        REQUIRE((mapped_buffer_context[0].aliased_address != 0) == expect_aliased);
+
+        std::array<u32_le, 3> translated;
+        memory.ReadBlock(*server, server_thread->GetCommandBufferAddress(), translated.data(),
+                         sizeof(translated));
+        const VAddr target_address = translated[2];
+        std::vector<u8> received(size);
+        memory.ReadBlock(*server, target_address, received.data(), received.size());
+        REQUIRE(received == data);
+
+        // The server modifies the buffer, as well as the memory right before it, and replies
+        std::reverse(received.begin(), received.end());
+        memory.WriteBlock(*server, target_address, received.data(), received.size());
+        const u8 server_byte = 0xA5;
+        memory.WriteBlock(*server, target_address - 1, &server_byte, sizeof(server_byte));
+
+        const u32_le reply[]{
+            IPC::MakeHeader(1, 1, 2),
+            RESULT_SUCCESS.raw,
+            IPC::MappedBufferDesc(size, permissions),
+            target_address,
+        };
+        memory.WriteBlock(*server, server_thread->GetCommandBufferAddress(), reply, sizeof(reply));
+        REQUIRE(TranslateCommandBuffer(kernel, memory, server_thread, client_thread,
+                                       server_thread->GetCommandBufferAddress(),
+                                       client_thread->GetCommandBufferAddress(),
+                                       mapped_buffer_context, true) == RESULT_SUCCESS);
+
+        REQUIRE(mapped_buffer_context.empty());
+        REQUIRE(server->vm_manager.FindVMA(target_address)->second.type == VMAType::Free);
+
+        std::vector<u8> result(size);
+        memory.ReadBlock(*client, source_address, result.data(), result.size());
+        if (permissions == IPC::MappedBufferPermissions::R) {
+            REQUIRE(result == data);
+        } else {
+            REQUIRE(result == received);
+        }
+        u8 result_before;
+        memory.ReadBlock(*client, source_address - 1, &result_before, sizeof(result_before));
+        REQUIRE(result_before == byte_before);
+    };
+
+    SECTION("aliases FCRAM-backed writable buffers covering whole pages") {
+        round_trip(Memory::HEAP_VADDR + 0x1000, 0x2000, IPC::MappedBufferPermissions::RW, true);
+        round_trip(Memory::HEAP_VADDR + 0x1000, 0x2000, IPC::MappedBufferPermissions::W, true);
+    }
+
+    SECTION("copies read-only buffers") {
+        round_trip(Memory::HEAP_VADDR + 0x1000, 0x2000, IPC::MappedBufferPermissions::R, false);
+    }
+
+    SECTION("copies buffers not covering whole pages") {
+        round_trip(Memory::HEAP_VADDR + 0x123, 0x2345, IPC::MappedBufferPermissions::RW, false);
+        round_trip(Memory::HEAP_VADDR + 0x1000, 0x1234, IPC::MappedBufferPermissions::RW, false);
+    }
+
+    SECTION("copies other buffers") {
+        round_trip(Memory::HEAP_VADDR + HEAP_SIZE + 0x1000, 0x2000,
+                   IPC::MappedBufferPermissions::RW, false);
+    }
+}
+
+} // namespace Kernel
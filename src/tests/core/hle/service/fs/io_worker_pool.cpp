@@ -0,0 +1,32 @@
+// Copyright 2020 Citra Emulator Project
+// Licensed under GPLv2 or any later version
+// Refer to the license.txt file included.
+
+#include <atomic>
+#include <catch2/catch.hpp>
+#include "core/hle/service/fs/io_worker_pool.h"
+
+namespace Service::FS {
+
+TEST_CASE("IOWorkerPool", "[core][fs]") {
+    std::atomic<int> jobs_run{0};
+
+    SECTION("runs every submitted job before being destroyed") {
+        {
+            IOWorkerPool pool(2);
+            for (int i = 0; i < 100; ++i) {
+                pool.Submit([&jobs_run] { ++jobs_run; });
+            }
+        }
+        REQUIRE(jobs_run == 100);
+    }
+
+    SECTION("can be destroyed without jobs") {
+        {
+            IOWorkerPool pool(4);
+        }
+        REQUIRE(jobs_run == 0);
+    }
+}
+
+} // namespace Service::FS
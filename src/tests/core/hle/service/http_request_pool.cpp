@@ -0,0 +1,179 @@
+// Copyright 2020 Citra Emulator Project
+// Licensed under GPLv2 or any later version
+// Refer to the license.txt file included.
+
+#include <atomic>
+#include <future>
+#include <string>
+#include <thread>
+#include <catch2/catch.hpp>
+#include <httplib.h>
+#include "core/hle/service/http_request_pool.h"
+
+#ifndef _WIN32
+#include <csignal>
+#include <netinet/in.h>
+#include <sys/socket.h>
+#include <unistd.h>
+#endif
+
+namespace Service::HTTP {
+
+TEST_CASE("HTTP request pools", "[core][hle][http]") {
+    // A local stand-in for the servers the application talks to
+    httplib::Server server;
+    server.Get("/hello", [](const httplib::Request&, httplib::Response& res) {
+        res.set_content("Hello from the stand-in server", "text/plain");
+    });
+    const int port = server.bind_to_any_port("127.0.0.1");
+    REQUIRE(port > 0);
+    std::thread server_thread([&server] { server.listen_after_bind(); });
+    while (!server.is_running()) {
+        std::this_thread::yield();
+    }
+
+    const ConnectionPool::Key key{false, "127.0.0.1", port, nullptr};
+    const auto get = [&key](ConnectionPool& pool, bool* reused_connection = nullptr) {
+        auto client = pool.Acquire(key);
+        httplib::Request request;
+        request.method = "GET";
+        request.path = "/hello";
+        httplib::Response response;
+        const bool succeeded = client->send(request, response);
+        if (reused_connection)
+            *reused_connection = client->reused_connection();
+        pool.Release(key, std::move(client));
+        return succeeded && response.status == 200 &&
+               response.body == "Hello from the stand-in server";
+    };
+
+    SECTION("keeps connections alive between requests") {
+        ConnectionPool pool(8);
+        bool reused_connection = true;
+        REQUIRE(get(pool, &reused_connection));
+        REQUIRE(!reused_connection);
+        REQUIRE(get(pool, &reused_connection));
+        REQUIRE(reused_connection);
+
+        // The stand-in server closes connections after 5 requests, and the pool reconnects
+        for (int i = 0; i < 8; ++i) {
+            REQUIRE(get(pool));
+        }
+    }
+
+    SECTION("finishes every queued request") {
+        ConnectionPool pool(8);
+        std::atomic<int> succeeded{0};
+        {
+            RequestWorkerPool workers(3, 2);
+            for (int i = 0; i < 16; ++i) {
+                workers.Submit([&] {
+                    if (get(pool))
+                        ++succeeded;
+                });
+            }
+        }
+        REQUIRE(succeeded == 16);
+    }
+
+    server.stop();
+    server_thread.join();
+}
+
+#ifndef _WIN32
+namespace {
+/// Reads a request up to the end of its headers
+bool ReadRequestHeaders(int socket) {
+    std::string received;
+    char buffer[256];
+    while (received.find("\r\n\r\n") == std::string::npos) {
+        const auto size = ::recv(socket, buffer, sizeof(buffer), 0);
+        if (size <= 0)
+            return false;
+        received.append(buffer, size);
+    }
+    return true;
+}
+
+/// Closes the connection with a reset, so that writing to it fails on the other end
+void ResetConnection(int socket) {
+    const linger reset{1, 0};
+    ::setsockopt(socket, SOL_SOCKET, SO_LINGER, &reset, sizeof(reset));
+    ::close(socket);
+}
+} // Anonymous namespace
+
+// httplib::Server ignores SIGPIPE for the whole process, so this runs without one, using a raw
+// socket as the server
+TEST_CASE("HTTP clients survive connections reset by the server", "[core][hle][http]") {
+    const auto old_handler = std::signal(SIGPIPE, SIG_DFL);
+
+    const int listener = ::socket(AF_INET, SOCK_STREAM, 0);
+    sockaddr_in addr{};
+    addr.sin_family = AF_INET;
+    addr.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+    socklen_t addr_len = sizeof(addr);
+    REQUIRE(::bind(listener, reinterpret_cast<sockaddr*>(&addr), sizeof(addr)) == 0);
+    REQUIRE(::getsockname(listener, reinterpret_cast<sockaddr*>(&addr), &addr_len) == 0);
+    REQUIRE(::listen(listener, 4) == 0);
+    const int port = ntohs(addr.sin_port);
+
+    SECTION("writing to a reset connection fails") {
+        const int client = ::socket(AF_INET, SOCK_STREAM, 0);
+        REQUIRE(::connect(client, reinterpret_cast<sockaddr*>(&addr), sizeof(addr)) == 0);
+        ResetConnection(::accept(listener, nullptr, nullptr));
+
+        // Wait for the reset to arrive, writes after it would raise SIGPIPE
+        char byte;
+        REQUIRE(::recv(client, &byte, 1, 0) < 0);
+        httplib::SocketStream stream(client);
+        REQUIRE(stream.write("GET / HTTP/1.1\r\n\r\n") < 0);
+        REQUIRE(stream.write("GET / HTTP/1.1\r\n\r\n") < 0);
+        ::close(client);
+    }
+
+    SECTION("a kept alive connection reset by the server is replaced") {
+        std::promise<void> first_request_done;
+        std::promise<void> first_connection_reset;
+
+        // Answers one request per connection, and resets the first one once the client is idle
+        std::thread server_thread([&, listener] {
+            const std::string response = "HTTP/1.1 200 OK\r\nContent-Length: 5\r\n\r\nHello";
+            for (int i = 0; i < 2; ++i) {
+                const int connection = ::accept(listener, nullptr, nullptr);
+                if (ReadRequestHeaders(connection))
+                    ::send(connection, response.data(), response.size(), 0);
+                if (i == 0) {
+                    first_request_done.get_future().wait();
+                    ResetConnection(connection);
+                    first_connection_reset.set_value();
+                } else {
+                    ::close(connection);
+                }
+            }
+        });
+
+        httplib::Client client("127.0.0.1", port, 5);
+        client.set_keep_alive(true);
+        const auto get = [&client] {
+            httplib::Request request;
+            request.method = "GET";
+            request.path = "/";
+            httplib::Response response;
+            return client.send(request, response) && response.body == "Hello";
+        };
+
+        REQUIRE(get());
+        first_request_done.set_value();
+        first_connection_reset.get_future().wait();
+        REQUIRE(get());
+        REQUIRE(!client.reused_connection());
+        server_thread.join();
+    }
+
+    ::close(listener);
+    std::signal(SIGPIPE, old_handler);
+}
+#endif
+
+} // namespace Service::HTTP
@@ -0,0 +1,148 @@
+// Copyright 2020 Citra Emulator Project
+// Licensed under GPLv2 or any later version
+// Refer to the license.txt file included.
+
+#include <array>
+#include <chrono>
+#include <future>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <vector>
+#include <catch2/catch.hpp>
+#include "core/hle/service/socket_reactor.h"
+
+#ifdef _WIN32
+#include <winsock2.h>
+#include <ws2tcpip.h>
+#else
+#include <netinet/in.h>
+#include <poll.h>
+#include <sys/socket.h>
+#include <unistd.h>
+#define closesocket(x) close(x)
+#endif
+
+namespace Service::SOC {
+
+namespace {
+/// Collects the ids reported by a reactor, and lets the test wait for them
+class Completions {
+public:
+    void Complete(u64 id) {
+        std::lock_guard lock{mutex};
+        promises[id].set_value();
+    }
+
+    bool WaitFor(u64 id) {
+        std::future<void> future;
+        {
+            std::lock_guard lock{mutex};
+            future = promises[id].get_future();
+        }
+        return future.wait_for(std::chrono::seconds(5)) == std::future_status::ready;
+    }
+
+private:
+    std::mutex mutex;
+    std::unordered_map<u64, std::promise<void>> promises;
+};
+
+u32 ListenOnLoopback(sockaddr_in& addr) {
+    const u32 listener = static_cast<u32>(::socket(AF_INET, SOCK_STREAM, 0));
+    addr = {};
+    addr.sin_family = AF_INET;
+    addr.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+    socklen_t addr_len = sizeof(addr);
+    REQUIRE(::bind(listener, reinterpret_cast<sockaddr*>(&addr), sizeof(addr)) == 0);
+    REQUIRE(::getsockname(listener, reinterpret_cast<sockaddr*>(&addr), &addr_len) == 0);
+    REQUIRE(::listen(listener, 1) == 0);
+    REQUIRE(SetSocketNonBlocking(listener));
+    return listener;
+}
+} // Anonymous namespace
+
+TEST_CASE("SocketReactor", "[core][hle][soc]") {
+#ifdef _WIN32
+    WSADATA data;
+    WSAStartup(MAKEWORD(2, 2), &data);
+#endif
+
+    Completions completions;
+    SocketReactor reactor([&completions](u64 id) { completions.Complete(id); });
+
+    sockaddr_in addr;
+    const u32 listener = ListenOnLoopback(addr);
+
+    // Nobody has connected yet, so accepting has to wait for the client
+    u32 server = static_cast<u32>(-1);
+    auto accept = [listener, &server] {
+        const auto ret = ::accept(listener, nullptr, nullptr);
+        if (static_cast<s32>(ret) < 0)
+            return false;
+        server = static_cast<u32>(ret);
+        return true;
+    };
+    REQUIRE_FALSE(accept());
+    const u64 accept_id = reactor.Submit({{listener, POLLIN}}, accept);
+
+    const u32 client = static_cast<u32>(::socket(AF_INET, SOCK_STREAM, 0));
+    REQUIRE(::connect(client, reinterpret_cast<sockaddr*>(&addr), sizeof(addr)) == 0);
+    REQUIRE(completions.WaitFor(accept_id));
+    REQUIRE(SetSocketNonBlocking(server));
+
+    SECTION("completes operations once their socket is ready") {
+        const std::string message = "Hello from the emulated application";
+        std::array<char, 64> received{};
+        int received_size = 0;
+        auto recv = [server, &received, &received_size] {
+            received_size = ::recv(server, received.data(), static_cast<int>(received.size()), 0);
+            return received_size >= 0;
+        };
+        REQUIRE_FALSE(recv());
+        const u64 recv_id = reactor.Submit({{server, POLLIN}}, recv);
+
+        REQUIRE(::send(client, message.data(), static_cast<int>(message.size()), 0) ==
+                static_cast<int>(message.size()));
+        REQUIRE(completions.WaitFor(recv_id));
+        REQUIRE(std::string(received.data(), received_size) == message);
+
+        // Echo the message back through the reactor
+        auto send = [server, &message] {
+            return ::send(server, message.data(), static_cast<int>(message.size()), 0) >= 0;
+        };
+        const u64 send_id = reactor.Submit({{server, POLLOUT}}, send);
+        REQUIRE(completions.WaitFor(send_id));
+
+        std::array<char, 64> echoed{};
+        const int echoed_size = ::recv(client, echoed.data(), static_cast<int>(echoed.size()), 0);
+        REQUIRE(std::string(echoed.data(), echoed_size) == message);
+    }
+
+    SECTION("drops operations on a cancelled socket") {
+        bool attempted_after_cancel = false;
+        const u64 id = reactor.Submit({{server, POLLIN}}, [&attempted_after_cancel] {
+            attempted_after_cancel = true;
+            return false;
+        });
+        REQUIRE(reactor.CancelSocket(server) == std::vector<u64>{id});
+
+        // Data arriving on the socket no longer runs the operation
+        const char byte = 0;
+        REQUIRE(::send(client, &byte, 1, 0) == 1);
+        const u64 other_id = reactor.Submit({{server, POLLIN}}, [] { return true; });
+        REQUIRE(completions.WaitFor(other_id));
+        REQUIRE_FALSE(attempted_after_cancel);
+        REQUIRE(reactor.CancelSocket(server).empty());
+    }
+
+    closesocket(client);
+    closesocket(server);
+    closesocket(listener);
+
+#ifdef _WIN32
+    WSACleanup();
+#endif
+}
+
+} // namespace Service::SOC
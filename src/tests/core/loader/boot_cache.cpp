@@ -0,0 +1,203 @@
+// Copyright 2020 Citra Emulator Project
+// Licensed under GPLv2 or any later version
+// Refer to the license.txt file included.
+
+#include <chrono>
+#include <cstdlib>
+#include <cstring>
+#include <string>
+#include <vector>
+#include <catch2/catch.hpp>
+#include <fmt/format.h>
+#include "common/common_paths.h"
+#include "common/file_util.h"
+#include "common/scope_exit.h"
+#include "core/file_sys/ncch_container.h"
+#include "core/loader/boot_cache.h"
+#include "core/loader/loader.h"
+
+namespace Loader {
+
+namespace {
+/// Returns a new directory under the system's temporary directory
+std::string MakeTestDirectory() {
+#ifdef _WIN32
+    const char* temp_dir = std::getenv("TEMP");
+#else
+    const char* temp_dir = std::getenv("TMPDIR");
+#endif
+    const std::string dir =
+        fmt::format("{}" DIR_SEP "citra_boot_cache_test_{}", temp_dir ? temp_dir : "/tmp",
+                    std::chrono::steady_clock::now().time_since_epoch().count());
+    REQUIRE(FileUtil::CreateFullPath(dir + DIR_SEP));
+    return dir;
+}
+
+constexpr u32 BSS_PAGE_SIZE = 0x1000;
+
+/// Writes an unencrypted NCCH holding an uncompressed .code section
+void WriteNCCH(const std::string& path, const std::vector<u8>& code) {
+    constexpr u32 media_unit = 0x200;
+
+    NCCH_Header ncch_header{};
+    ncch_header.magic = MakeMagic('N', 'C', 'C', 'H');
+    ncch_header.program_id = 0x0004000000123400;
+    ncch_header.no_crypto.Assign(1);
+    ncch_header.is_executable.Assign(1);
+    ncch_header.extended_header_size = 0x400;
+    ncch_header.exefs_offset =
+        static_cast<u32>((sizeof(ncch_header) + sizeof(ExHeader_Header)) / media_unit);
+    ncch_header.exefs_size = static_cast<u32>((sizeof(ExeFs_Header) + code.size()) / media_unit);
+
+    ExHeader_Header exheader{};
+    exheader.codeset_info.bss_size = BSS_PAGE_SIZE;
+    exheader.codeset_info.text.code_size = static_cast<u32>(code.size());
+
+    ExeFs_Header exefs_header{};
+    std::strcpy(exefs_header.section[0].name, ".code");
+    exefs_header.section[0].offset = 0;
+    exefs_header.section[0].size = static_cast<u32>(code.size());
+
+    FileUtil::IOFile file(path, "wb");
+    REQUIRE(file.WriteObject(ncch_header) == 1);
+    REQUIRE(file.WriteObject(exheader) == 1);
+    REQUIRE(file.WriteObject(exefs_header) == 1);
+    REQUIRE(file.WriteBytes(code.data(), code.size()) == code.size());
+}
+} // Anonymous namespace
+
+TEST_CASE("BootCache", "[core][loader]") {
+    const std::string test_dir = MakeTestDirectory();
+    SCOPE_EXIT({ FileUtil::DeleteDirRecursively(test_dir); });
+    const std::string path = test_dir + DIR_SEP "0004000000000000.bin";
+    const BootCache cache(path);
+
+    std::vector<u8> code(0x3000);
+    for (std::size_t i = 0; i < code.size(); ++i) {
+        code[i] = static_cast<u8>(i * 7);
+    }
+
+    std::vector<u8> loaded;
+    REQUIRE(!cache.LoadCode(0x1234, loaded));
+
+    cache.StoreCode(0x1234, code);
+    REQUIRE(cache.LoadCode(0x1234, loaded));
+    REQUIRE(loaded == code);
+
+    SECTION("a different code hash is a miss") {
+        loaded.clear();
+        REQUIRE(!cache.LoadCode(0x4321, loaded));
+        REQUIRE(loaded.empty());
+    }
+
+    SECTION("a corrupted file is a miss") {
+        {
+            FileUtil::IOFile file(path, "r+b");
+            file.Seek(0x100, SEEK_SET);
+            const u8 byte = 0xFF;
+            file.WriteObject(byte);
+        }
+        REQUIRE(!cache.LoadCode(0x1234, loaded));
+    }
+
+    SECTION("a damaged code size is a miss") {
+        {
+            // The size follows the magic, the version and the two hashes
+            FileUtil::IOFile file(path, "r+b");
+            file.Seek(0x18, SEEK_SET);
+            const u32 code_size = 0xFFFFFFF0;
+            file.WriteObject(code_size);
+        }
+        REQUIRE(!cache.LoadCode(0x1234, loaded));
+    }
+
+    SECTION("storing again replaces the code image") {
+        code.resize(0x1000);
+        cache.StoreCode(0x5678, code);
+        REQUIRE(!cache.LoadCode(0x1234, loaded));
+        REQUIRE(cache.LoadCode(0x5678, loaded));
+        REQUIRE(loaded == code);
+    }
+}
+
+TEST_CASE("BootCache::ReadCodeImage", "[core][loader]") {
+    const std::string test_dir = MakeTestDirectory();
+    SCOPE_EXIT({ FileUtil::DeleteDirRecursively(test_dir); });
+    const std::string rom_path = test_dir + DIR_SEP "title.cxi";
+    const BootCache cache(test_dir + DIR_SEP "cache" DIR_SEP "0004000000123400.bin");
+
+    std::vector<u8> code(0x2000);
+    for (std::size_t i = 0; i < code.size(); ++i) {
+        code[i] = static_cast<u8>(i * 13);
+    }
+    WriteNCCH(rom_path, code);
+
+    std::vector<u8> expected = code;
+    expected.resize(code.size() + BSS_PAGE_SIZE);
+
+    // A cold boot builds the image from the NCCH and stores it
+    std::vector<u8> image;
+    {
+        FileSys::NCCHContainer ncch(rom_path);
+        REQUIRE(cache.ReadCodeImage(ncch, BSS_PAGE_SIZE, image) == ResultStatus::Success);
+    }
+    REQUIRE(image == expected);
+
+    // A warm boot never reads .code, as the headers it was built from did not change. Change it
+    // behind their back to tell the two apart.
+    std::vector<u8> changed_code = code;
+    changed_code[0x10] ^= 0xFF;
+    WriteNCCH(rom_path, changed_code);
+    image.clear();
+    {
+        FileSys::NCCHContainer ncch(rom_path);
+        REQUIRE(cache.ReadCodeImage(ncch, BSS_PAGE_SIZE, image) == ResultStatus::Success);
+    }
+    REQUIRE(image == expected);
+
+    SECTION("adding an IPS patch builds the image again") {
+        const std::string exefs_dir = rom_path + ".exefsdir" DIR_SEP;
+        REQUIRE(FileUtil::CreateFullPath(exefs_dir));
+        const std::string ips = std::string("PATCH") + std::string("\x00\x00\x20\x00\x01\xAB", 6) +
+                                std::string("EOF");
+        REQUIRE(FileUtil::WriteStringToFile(true, exefs_dir + "code.ips", ips) == ips.size());
+
+        expected = changed_code;
+        expected.resize(code.size() + BSS_PAGE_SIZE);
+        expected[0x20] = 0xAB;
+        image.clear();
+        FileSys::NCCHContainer ncch(rom_path);
+        REQUIRE(cache.ReadCodeImage(ncch, BSS_PAGE_SIZE, image) == ResultStatus::Success);
+        REQUIRE(image == expected);
+    }
+
+    SECTION("a code.bin override is never cached") {
+        const std::string exefs_dir = rom_path + ".exefsdir" DIR_SEP;
+        REQUIRE(FileUtil::CreateFullPath(exefs_dir));
+        const std::vector<u8> override_code(0x1000, 0x42);
+        {
+            FileUtil::IOFile file(exefs_dir + "code.bin", "wb");
+            REQUIRE(file.WriteBytes(override_code.data(), override_code.size()) ==
+                    override_code.size());
+        }
+
+        expected = override_code;
+        expected.resize(override_code.size() + BSS_PAGE_SIZE);
+        image.clear();
+        {
+            FileSys::NCCHContainer ncch(rom_path);
+            REQUIRE(cache.ReadCodeImage(ncch, BSS_PAGE_SIZE, image) == ResultStatus::Success);
+        }
+        REQUIRE(image == expected);
+
+        // The image built without the override is still the cached one
+        FileUtil::Delete(exefs_dir + "code.bin");
+        image.clear();
+        FileSys::NCCHContainer ncch(rom_path);
+        REQUIRE(cache.ReadCodeImage(ncch, BSS_PAGE_SIZE, image) == ResultStatus::Success);
+        code.resize(code.size() + BSS_PAGE_SIZE);
+        REQUIRE(image == code);
+    }
+}
+
+} // namespace Loader
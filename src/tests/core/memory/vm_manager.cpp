@@ -136,4 +136,39 @@ TEST_CASE("Memory Basics", "[kernel][memory]") {
         code = manager->UnmapRange(Memory::HEAP_VADDR, block->size());
         REQUIRE(code == RESULT_SUCCESS);
     }
+
+    SECTION("unmapping a range spanning several areas") {
+        // Because of the PageTable, Kernel::VMManager is too big to be created on the stack.
+        auto manager = std::make_unique<Kernel::VMManager>(memory);
+        auto blocks = std::make_shared<std::vector<u8>>(Memory::PAGE_SIZE * 4);
+        for (u32 i = 0; i < 4; ++i) {
+            auto result = manager->MapBackingMemory(
+                Memory::HEAP_VADDR + i * Memory::PAGE_SIZE,
+                blocks->data() + (3 - i) * Memory::PAGE_SIZE, Memory::PAGE_SIZE,
+                i % 2 ? Kernel::MemoryState::Private : Kernel::MemoryState::Shared);
+            REQUIRE(result.Code() == RESULT_SUCCESS);
+        }
+
+        // Leave the first and last page mapped
+        ResultCode code =
+            manager->UnmapRange(Memory::HEAP_VADDR + Memory::PAGE_SIZE, Memory::PAGE_SIZE * 2);
+        REQUIRE(code == RESULT_SUCCESS);
+
+        auto vma = manager->FindVMA(Memory::HEAP_VADDR + Memory::PAGE_SIZE);
+        CHECK(vma->second.type == Kernel::VMAType::Free);
+        CHECK(vma->second.base == Memory::HEAP_VADDR + Memory::PAGE_SIZE);
+        CHECK(vma->second.size == Memory::PAGE_SIZE * 2);
+        CHECK(manager->page_table.attributes[(Memory::HEAP_VADDR >> Memory::PAGE_BITS) + 2] ==
+              Memory::PageType::Unmapped);
+
+        vma = manager->FindVMA(Memory::HEAP_VADDR + Memory::PAGE_SIZE * 3);
+        CHECK(vma->second.type == Kernel::VMAType::BackingMemory);
+        CHECK(vma->second.backing_memory == blocks->data());
+
+        // Unmapping the rest merges everything back into the surrounding free area
+        REQUIRE(manager->UnmapRange(Memory::HEAP_VADDR, Memory::PAGE_SIZE) == RESULT_SUCCESS);
+        REQUIRE(manager->UnmapRange(Memory::HEAP_VADDR + Memory::PAGE_SIZE * 3,
+                                    Memory::PAGE_SIZE) == RESULT_SUCCESS);
+        CHECK(manager->vma_map.size() == 1);
+    }
 }
@@ -0,0 +1,175 @@
+// Copyright 2020 Citra Emulator Project
+// Licensed under GPLv2 or any later version
+// Refer to the license.txt file included.
+
+#include <array>
+#include <cstring>
+#include <vector>
+#include <boost/asio.hpp>
+#include <catch2/catch.hpp>
+#include "core/core_timing.h"
+#include "core/hle/kernel/process.h"
+#include "core/memory.h"
+#include "core/rpc/packet.h"
+#include "core/rpc/rpc_server.h"
+
+namespace RPC {
+
+namespace {
+class TestClient {
+public:
+    TestClient()
+        : socket(io_context, boost::asio::ip::udp::endpoint(boost::asio::ip::udp::v4(), 0)),
+          server_endpoint(boost::asio::ip::address_v4::loopback(), 45987) {}
+
+    /// Sends a request and returns the data of the reply
+    std::vector<u8> Request(PacketType type, const std::vector<u8>& data) {
+        const PacketHeader header{CURRENT_VERSION, ++id, type, static_cast<u32>(data.size())};
+        std::vector<u8> request(sizeof(header) + data.size());
+        std::memcpy(request.data(), &header, sizeof(header));
+        std::memcpy(request.data() + sizeof(header), data.data(), data.size());
+        socket.send_to(boost::asio::buffer(request), server_endpoint);
+
+        std::array<u8, MAX_PACKET_SIZE> reply;
+        const std::size_t size = socket.receive(boost::asio::buffer(reply));
+        REQUIRE(size >= sizeof(header));
+        return {reply.begin() + sizeof(header), reply.begin() + size};
+    }
+
+private:
+    boost::asio::io_context io_context;
+    boost::asio::ip::udp::socket socket;
+    boost::asio::ip::udp::endpoint server_endpoint;
+    u32 id = 0;
+};
+
+std::vector<u8> MakeRequestData(std::initializer_list<u32> words) {
+    std::vector<u8> data(words.size() * sizeof(u32));
+    std::memcpy(data.data(), words.begin(), data.size());
+    return data;
+}
+
+u32 ReadU32(const std::vector<u8>& data, std::size_t offset) {
+    u32 value;
+    std::memcpy(&value, data.data() + offset, sizeof(value));
+    return value;
+}
+} // Anonymous namespace
+
+TEST_CASE("RPCServer rejects malformed requests", "[core][rpc]") {
+    constexpr u32 heap_size = 0x10000;
+
+    Core::Timing timing;
+    Memory::MemorySystem memory;
+    Kernel::KernelSystem kernel(memory, timing, [] {}, 0);
+    auto process = kernel.CreateProcess(kernel.CreateCodeSet("", 0));
+    kernel.SetCurrentProcess(process);
+
+    std::vector<u8> heap(heap_size);
+    REQUIRE(process->vm_manager
+                .MapBackingMemory(Memory::HEAP_VADDR, heap.data(), heap_size,
+                                  Kernel::MemoryState::Private)
+                .Succeeded());
+    memory.SetCurrentPageTable(&process->vm_manager.page_table);
+    const u32 needle = 0xC17A;
+    std::memcpy(heap.data() + 0x100, &needle, sizeof(needle));
+
+    RPCServer server(memory, kernel, timing);
+    TestClient client;
+
+    SECTION("batched reads") {
+        const auto reply = client.Request(
+            PacketType::ReadMemoryBatch,
+            MakeRequestData({Memory::HEAP_VADDR + 0x100, 4, Memory::HEAP_VADDR + 0x100, 2}));
+        REQUIRE(reply.size() == 6);
+        REQUIRE(ReadU32(reply, 0) == needle);
+
+        REQUIRE(client.Request(PacketType::ReadMemoryBatch,
+                               MakeRequestData({Memory::HEAP_VADDR, MAX_READ_SIZE + 1}))
+                    .empty());
+        REQUIRE(client.Request(PacketType::ReadMemoryBatch,
+                               MakeRequestData({Memory::HEAP_VADDR, MAX_READ_SIZE - 4,
+                                                Memory::HEAP_VADDR, 8}))
+                    .empty());
+        REQUIRE(client.Request(PacketType::ReadMemoryBatch,
+                               MakeRequestData({Memory::HEAP_VADDR, 0}))
+                    .empty());
+    }
+
+    SECTION("watch ranges whose size overflows with the record header") {
+        REQUIRE(client.Request(PacketType::WatchMemory,
+                               MakeRequestData({Memory::HEAP_VADDR, 0xFFFFFFF8}))
+                    .empty());
+        REQUIRE(client.Request(PacketType::WatchMemory,
+                               MakeRequestData({Memory::HEAP_VADDR, 0xFFFFFFFC}))
+                    .empty());
+        REQUIRE(client.Request(PacketType::WatchMemory,
+                               MakeRequestData({Memory::HEAP_VADDR, MAX_READ_SIZE}))
+                    .empty());
+
+        const auto reply = client.Request(PacketType::WatchMemory,
+                                          MakeRequestData({Memory::HEAP_VADDR + 0x100, 4}));
+        REQUIRE(reply.size() == 4);
+        REQUIRE(ReadU32(reply, 0) == needle);
+        client.Request(PacketType::WatchMemory, {});
+    }
+
+    SECTION("malformed write batches write nothing") {
+        const std::vector<u8> before = heap;
+
+        // The second record claims more data than the packet holds
+        auto data = MakeRequestData({Memory::HEAP_VADDR, 4, 0xFFFFFFFF, Memory::HEAP_VADDR, 8,
+                                     0xFFFFFFFF});
+        REQUIRE(client.Request(PacketType::WriteMemoryBatch, data).empty());
+        REQUIRE(heap == before);
+
+        // A record cut off in its header
+        data = MakeRequestData({Memory::HEAP_VADDR, 4, 0xFFFFFFFF, Memory::HEAP_VADDR});
+        REQUIRE(client.Request(PacketType::WriteMemoryBatch, data).empty());
+        REQUIRE(heap == before);
+
+        // A size that wraps around when the header size is added
+        data = MakeRequestData({Memory::HEAP_VADDR, 0xFFFFFFFC, 0xFFFFFFFF});
+        REQUIRE(client.Request(PacketType::WriteMemoryBatch, data).empty());
+        REQUIRE(heap == before);
+    }
+
+    SECTION("scans") {
+        const auto compare = static_cast<u32>(ScanCompare::Equal);
+        auto reply = client.Request(
+            PacketType::ScanMemory,
+            MakeRequestData({Memory::HEAP_VADDR, heap_size, compare, sizeof(u32), needle}));
+        REQUIRE(reply.size() == 8);
+        REQUIRE(ReadU32(reply, 0) == Memory::HEAP_VADDR + heap_size);
+        REQUIRE(ReadU32(reply, 4) == Memory::HEAP_VADDR + 0x100);
+
+        // The last page of the address space is scanned up to the end
+        reply = client.Request(PacketType::ScanMemory,
+                               MakeRequestData({0xFFFFF000, 0x1000, compare, sizeof(u32), 0}));
+        REQUIRE(reply.size() == 4);
+        REQUIRE(ReadU32(reply, 0) == 0);
+
+        // Ranges running past the end of the address space are rejected
+        REQUIRE(client.Request(PacketType::ScanMemory,
+                               MakeRequestData({0xFFFFF000, 0x2000, compare, sizeof(u32), 0}))
+                    .empty());
+        REQUIRE(client.Request(PacketType::ScanMemory,
+                               MakeRequestData({0xFFFFFFFC, 0xFFFFFFFC, compare, sizeof(u32), 0}))
+                    .empty());
+
+        // Misaligned and unknown scans
+        REQUIRE(client.Request(PacketType::ScanMemory,
+                               MakeRequestData({Memory::HEAP_VADDR + 2, 0x100, compare,
+                                                sizeof(u32), needle}))
+                    .empty());
+        REQUIRE(client.Request(PacketType::ScanMemory,
+                               MakeRequestData({Memory::HEAP_VADDR, 0x100, compare, 3, needle}))
+                    .empty());
+        REQUIRE(client.Request(PacketType::ScanMemory,
+                               MakeRequestData({Memory::HEAP_VADDR, 0x100, 6, sizeof(u32),
+                                                needle}))
+                    .empty());
+    }
+}
+
+} // namespace RPC
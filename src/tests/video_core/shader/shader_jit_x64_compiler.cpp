@@ -89,3 +89,27 @@ TEST_CASE("EX2", "[video_core][shader][shader_jit]") {
     REQUIRE(shader.Run(79.7262742773f) == Approx(1.e24f));
     REQUIRE(std::isinf(shader.Run(800.f)));
 }
+
+TEST_CASE("Serialize", "[video_core][shader][shader_jit]") {
+    const auto sh_input = SourceRegister::MakeInput(0);
+    const auto sh_output = DestRegister::MakeOutput(0);
+
+    auto shader = ShaderTest({
+        // clang-format off
+        {OpCode::Id::EX2, sh_output, sh_input},
+        {OpCode::Id::END},
+        // clang-format on
+    });
+
+    const std::vector<u8> blob = shader.shader->Serialize();
+
+    // Load into a shader that was never compiled, as happens when reading the disk cache
+    shader.shader = std::make_unique<JitShader>();
+    REQUIRE(shader.shader->Deserialize(blob.data(), blob.size()));
+    REQUIRE(shader.Run(2.f) == Approx(4.f));
+    REQUIRE(shader.Run(6.f) == Approx(64.f));
+
+    // Truncated data must be rejected
+    auto truncated = std::make_unique<JitShader>();
+    REQUIRE_FALSE(truncated->Deserialize(blob.data(), blob.size() - 1));
+}
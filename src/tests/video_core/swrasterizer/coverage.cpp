@@ -0,0 +1,154 @@
+// Copyright 2020 Citra Emulator Project
+// Licensed under GPLv2 or any later version
+// Refer to the license.txt file included.
+
+#include <algorithm>
+#include <array>
+#include <random>
+#include <catch2/catch.hpp>
+#include "video_core/swrasterizer/coverage.h"
+
+namespace Pica::Rasterizer {
+
+namespace {
+using Triangle = std::array<Common::Vec2<Fix12P4>, 3>;
+
+struct Scissor {
+    bool exclude;
+    u16 x1;
+    u16 y1;
+    u16 x2;
+    u16 y2;
+};
+
+constexpr Scissor NO_SCISSOR{false, 0, 0, 0, 0};
+
+/// Returns whether the per-pixel edge test covers a pixel center
+bool CoversPixel(const TriangleCoverage& coverage, u16 x, u16 y) {
+    if (coverage.IsScissored(x, y))
+        return false;
+    const auto weights = coverage.GetWeights(x, y);
+    return std::all_of(weights.begin(), weights.end(), [](int w) { return w >= 0; });
+}
+
+/**
+ * Traverses the bounding box of a counter-clockwise wound triangle in blocks the way the
+ * rasterizer does, requires the block coverage to match the per-pixel edge test for each pixel and
+ * returns the number of pixels covered.
+ */
+int CheckBlockCoverage(const Triangle& vtxpos, const Scissor& scissor = NO_SCISSOR) {
+    const TriangleCoverage coverage(vtxpos, scissor.exclude, scissor.x1, scissor.y1, scissor.x2,
+                                    scissor.y2);
+
+    u16 min_x = std::min({vtxpos[0].x, vtxpos[1].x, vtxpos[2].x});
+    u16 min_y = std::min({vtxpos[0].y, vtxpos[1].y, vtxpos[2].y});
+    u16 max_x = std::max({vtxpos[0].x, vtxpos[1].x, vtxpos[2].x});
+    u16 max_y = std::max({vtxpos[0].y, vtxpos[1].y, vtxpos[2].y});
+    min_x &= Fix12P4::IntMask();
+    min_y &= Fix12P4::IntMask();
+    max_x = ((max_x + Fix12P4::FracMask()) & Fix12P4::IntMask());
+    max_y = ((max_y + Fix12P4::FracMask()) & Fix12P4::IntMask());
+
+    int covered = 0;
+    int mismatches = 0;
+    const int blocks_x = std::max(0, max_x - min_x + BLOCK_SIZE * 0x10 - 1) / (BLOCK_SIZE * 0x10);
+    const int blocks_y = std::max(0, max_y - min_y + BLOCK_SIZE * 0x10 - 1) / (BLOCK_SIZE * 0x10);
+    for (int block = 0; block < blocks_x * blocks_y; ++block) {
+        const int block_x = min_x + 8 + (block % blocks_x) * BLOCK_SIZE * 0x10;
+        const int block_y = min_y + 8 + (block / blocks_x) * BLOCK_SIZE * 0x10;
+        const int block_width = std::min(BLOCK_SIZE, (max_x - block_x + 0xF) >> 4);
+        const int block_height = std::min(BLOCK_SIZE, (max_y - block_y + 0xF) >> 4);
+        const BitSet64 block_coverage = coverage.GetBlockCoverage(
+            static_cast<u16>(block_x), static_cast<u16>(block_y), block_width, block_height);
+
+        for (int pixel = 0; pixel < BLOCK_SIZE * BLOCK_SIZE; ++pixel) {
+            const int i = pixel % BLOCK_SIZE;
+            const int j = pixel / BLOCK_SIZE;
+            const bool expected =
+                i < block_width && j < block_height &&
+                CoversPixel(coverage, static_cast<u16>(block_x + i * 0x10),
+                            static_cast<u16>(block_y + j * 0x10));
+            if (block_coverage[pixel] != expected)
+                ++mismatches;
+            if (expected)
+                ++covered;
+        }
+    }
+    REQUIRE(mismatches == 0);
+    return covered;
+}
+
+/// Returns a triangle from 12.4 fixed point coordinates, wound counter-clockwise
+Triangle MakeTriangle(u16 x0, u16 y0, u16 x1, u16 y1, u16 x2, u16 y2) {
+    Triangle triangle{{{x0, y0}, {x1, y1}, {x2, y2}}};
+    if (SignedArea(triangle[0], triangle[1], triangle[2]) < 0)
+        std::swap(triangle[1], triangle[2]);
+    return triangle;
+}
+} // Anonymous namespace
+
+TEST_CASE("TriangleCoverage matches the per-pixel edge test", "[video_core][swrasterizer]") {
+    SECTION("slivers") {
+        // Nearly horizontal and vertical, and thinner than a pixel
+        REQUIRE(CheckBlockCoverage(MakeTriangle(0x10, 0x100, 0x800, 0x108, 0x10, 0x110)) > 0);
+        REQUIRE(CheckBlockCoverage(MakeTriangle(0x100, 0x10, 0x10C, 0x7F0, 0x103, 0x20)) >= 0);
+        // Diagonal, crossing many blocks without covering any of them fully
+        REQUIRE(CheckBlockCoverage(MakeTriangle(0x08, 0x08, 0x7F8, 0x7E8, 0x7F8, 0x7F8)) > 0);
+        // Degenerate
+        REQUIRE(CheckBlockCoverage(MakeTriangle(0x18, 0x18, 0x418, 0x418, 0x218, 0x218)) >= 0);
+    }
+
+    SECTION("partial blocks") {
+        // Bounding boxes that are not a multiple of the block size in either direction, with
+        // edges running through pixel centers where the fill rules decide
+        REQUIRE(CheckBlockCoverage(MakeTriangle(0x08, 0x08, 0x98, 0x08, 0x08, 0xD8)) > 0);
+        REQUIRE(CheckBlockCoverage(MakeTriangle(0x13, 0x2D, 0x1A7, 0x61, 0xC1, 0x1F9)) > 0);
+        REQUIRE(CheckBlockCoverage(MakeTriangle(0x48, 0x08, 0x88, 0x88, 0x08, 0x88)) > 0);
+        REQUIRE(CheckBlockCoverage(MakeTriangle(0x08, 0x08, 0x28, 0x08, 0x08, 0x28)) > 0);
+    }
+
+    SECTION("scissor exclude") {
+        const Triangle triangle = MakeTriangle(0x00, 0x00, 0x800, 0x40, 0x80, 0x700);
+        const int unscissored = CheckBlockCoverage(triangle);
+        // A box covering whole blocks, one cutting through blocks and one of a single pixel
+        REQUIRE(CheckBlockCoverage(triangle, {true, 0x80, 0x80, 0x180, 0x180}) < unscissored);
+        REQUIRE(CheckBlockCoverage(triangle, {true, 0x30, 0x50, 0x2A0, 0x1B0}) < unscissored);
+        REQUIRE(CheckBlockCoverage(triangle, {true, 0x110, 0x110, 0x120, 0x120}) ==
+                unscissored - 1);
+        // A box covering the whole triangle
+        REQUIRE(CheckBlockCoverage(triangle, {true, 0x00, 0x00, 0x1000, 0x1000}) == 0);
+    }
+
+    SECTION("random triangles") {
+        std::mt19937 random(0xC17A);
+        std::uniform_int_distribution<int> position(0, 0x600);
+        std::uniform_int_distribution<int> offset(-0x18, 0x18);
+        for (int n = 0; n < 5000; ++n) {
+            const u16 x0 = static_cast<u16>(position(random));
+            const u16 y0 = static_cast<u16>(position(random));
+            const u16 x1 = static_cast<u16>(position(random));
+            const u16 y1 = static_cast<u16>(position(random));
+            u16 x2, y2;
+            if (n % 2) {
+                // A sliver along the first edge
+                x2 = static_cast<u16>(std::max(0, x1 + offset(random)));
+                y2 = static_cast<u16>(std::max(0, y1 + offset(random)));
+            } else {
+                x2 = static_cast<u16>(position(random));
+                y2 = static_cast<u16>(position(random));
+            }
+
+            Scissor scissor = NO_SCISSOR;
+            if (n % 3 == 0) {
+                const u16 sx1 = static_cast<u16>(position(random) & Fix12P4::IntMask());
+                const u16 sy1 = static_cast<u16>(position(random) & Fix12P4::IntMask());
+                scissor = {true, sx1, sy1,
+                           static_cast<u16>(sx1 + (position(random) & Fix12P4::IntMask()) / 2),
+                           static_cast<u16>(sy1 + (position(random) & Fix12P4::IntMask()) / 2)};
+            }
+            CheckBlockCoverage(MakeTriangle(x0, y0, x1, y1, x2, y2), scissor);
+        }
+    }
+}
+
+} // namespace Pica::Rasterizer
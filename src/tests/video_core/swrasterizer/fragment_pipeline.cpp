@@ -0,0 +1,106 @@
+// Copyright 2020 Citra Emulator Project
+// Licensed under GPLv2 or any later version
+// Refer to the license.txt file included.
+
+#include <memory>
+#include <catch2/catch.hpp>
+#include "video_core/regs.h"
+#include "video_core/swrasterizer/fragment_pipeline.h"
+#include "video_core/swrasterizer/framebuffer.h"
+#include "video_core/swrasterizer/texturing.h"
+
+namespace Pica::Rasterizer {
+
+using TevStageConfig = TexturingRegs::TevStageConfig;
+
+TEST_CASE("Specialized fragment functions match the generic ones", "[video_core][swrasterizer]") {
+    const Common::Vec4<u8> src{200, 100, 50, 25};
+    const Common::Vec4<u8> dest{30, 60, 90, 120};
+    const Common::Vec4<u8> blend_const{255, 128, 1, 77};
+    const Common::Vec3<u8> color_input[3] = {{200, 100, 50}, {30, 60, 90}, {128, 255, 0}};
+    const std::array<u8, 3> alpha_input = {25, 120, 77};
+
+    for (u32 op = 0; op <= static_cast<u32>(TevStageConfig::Operation::AddThenMultiply); ++op) {
+        const auto operation = static_cast<TevStageConfig::Operation>(op);
+        const auto specialized = GetColorCombineFunc(operation)(color_input);
+        const auto generic = ColorCombine(operation, color_input);
+        REQUIRE(specialized.r() == generic.r());
+        REQUIRE(specialized.g() == generic.g());
+        REQUIRE(specialized.b() == generic.b());
+        // The alpha combiner has no dot product
+        if (operation != TevStageConfig::Operation::Dot3_RGB &&
+            operation != TevStageConfig::Operation::Dot3_RGBA) {
+            REQUIRE(GetAlphaCombineFunc(operation)(alpha_input) ==
+                    AlphaCombine(operation, alpha_input));
+        }
+    }
+
+    constexpr auto last_factor = FramebufferRegs::BlendFactor::SourceAlphaSaturate;
+    for (u32 factor = 0; factor <= static_cast<u32>(last_factor); ++factor) {
+        const auto blend_factor = static_cast<FramebufferRegs::BlendFactor>(factor);
+        for (unsigned channel = 0; channel < 4; ++channel) {
+            REQUIRE(GetBlendFactorFunc(blend_factor)(channel, src, dest, blend_const) ==
+                    LookupBlendFactor(channel, blend_factor, src, dest, blend_const));
+        }
+    }
+
+    for (u32 op = 0; op <= static_cast<u32>(FramebufferRegs::LogicOp::OrInverted); ++op) {
+        const auto logic_op = static_cast<FramebufferRegs::LogicOp>(op);
+        REQUIRE(GetLogicOpFunc(logic_op)(src.r(), dest.r()) ==
+                LogicOp(src.r(), dest.r(), logic_op));
+    }
+
+    REQUIRE_FALSE(GetCompareTestFunc(FramebufferRegs::CompareFunc::Never)(1, 1));
+    REQUIRE(GetCompareTestFunc(FramebufferRegs::CompareFunc::Always)(0, 1));
+    REQUIRE(GetCompareTestFunc(FramebufferRegs::CompareFunc::LessThan)(0x7FFFFF, 0x800000));
+    REQUIRE_FALSE(GetCompareTestFunc(FramebufferRegs::CompareFunc::GreaterThanOrEqual)(2, 3));
+}
+
+TEST_CASE("FragmentPipeline", "[video_core][swrasterizer]") {
+    auto regs = std::make_unique<Regs>();
+    regs->reg_array.fill(0);
+
+    // Stage 0 modulates the primary color with texture 0, the other stages pass it through
+    auto& tev_stage0 = regs->texturing.tev_stage0;
+    tev_stage0.color_source1.Assign(TevStageConfig::Source::PrimaryColor);
+    tev_stage0.color_source2.Assign(TevStageConfig::Source::Texture0);
+    tev_stage0.alpha_source1.Assign(TevStageConfig::Source::Constant);
+    tev_stage0.color_op.Assign(TevStageConfig::Operation::Modulate);
+    tev_stage0.alpha_op.Assign(TevStageConfig::Operation::Replace);
+    tev_stage0.const_a.Assign(0x40);
+    for (auto* stage : {&regs->texturing.tev_stage1, &regs->texturing.tev_stage2,
+                        &regs->texturing.tev_stage3, &regs->texturing.tev_stage4,
+                        &regs->texturing.tev_stage5}) {
+        stage->color_source1.Assign(TevStageConfig::Source::Previous);
+        stage->alpha_source1.Assign(TevStageConfig::Source::Previous);
+    }
+
+    FragmentPipelineCache cache;
+    const FragmentPipeline& pipeline = cache.Get(*regs);
+    const auto uniforms = FragmentUniforms::FromRegs(*regs);
+
+    SECTION("runs the texture environment") {
+        FragmentPipeline::TevInputs inputs;
+        inputs[FragmentPipeline::PrimaryColor] = {255, 128, 0, 255};
+        inputs[FragmentPipeline::Texture0] = {128, 255, 77, 0};
+        const auto output = pipeline.CombineTev(inputs, uniforms);
+        REQUIRE(output.r() == 128);
+        REQUIRE(output.g() == 128);
+        REQUIRE(output.b() == 0);
+        REQUIRE(output.a() == 0x40);
+    }
+
+    SECTION("reuses the pipeline while only uniforms change") {
+        regs->texturing.tev_stage0.const_a.Assign(0x80);
+        REQUIRE(&cache.Get(*regs) == &pipeline);
+
+        regs->texturing.tev_stage3.scales_raw = 1;
+        const FragmentPipeline& scaled = cache.Get(*regs);
+        REQUIRE(&scaled != &pipeline);
+
+        regs->texturing.tev_stage3.scales_raw = 0;
+        REQUIRE(&cache.Get(*regs) == &pipeline);
+    }
+}
+
+} // namespace Pica::Rasterizer
@@ -0,0 +1,86 @@
+// Copyright 2020 Citra Emulator Project
+// Licensed under GPLv2 or any later version
+// Refer to the license.txt file included.
+
+#include <memory>
+#include <catch2/catch.hpp>
+#include "video_core/pica_state.h"
+#include "video_core/swrasterizer/proctex.h"
+
+namespace Pica::Rasterizer {
+
+TEST_CASE("ProcTexCache reuses decoded tables", "[video_core][swrasterizer]") {
+    auto regs = std::make_unique<TexturingRegs>();
+    auto proctex = std::make_unique<State::ProcTex>();
+    regs->proctex.color_combiner.Assign(TexturingRegs::ProcTexCombiner::U);
+    regs->proctex_lut.filter.Assign(TexturingRegs::ProcTexFilter::Nearest);
+    regs->proctex_lut.width.Assign(2);
+    for (std::size_t i = 0; i < proctex->color_map_table.size(); ++i) {
+        proctex->color_map_table[i].value.Assign(static_cast<u32>(i * 32));
+        proctex->color_map_table[i].difference.Assign(32);
+    }
+    proctex->color_table[0].raw = 0x11223344;
+    proctex->color_table[1].raw = 0x55667788;
+
+    ProcTexCache cache;
+    const ProcTexTables& tables = cache.Get(*regs, *proctex);
+    REQUIRE(cache.GetStats().misses == 1);
+    REQUIRE(&cache.Get(*regs, *proctex) == &tables);
+    REQUIRE(cache.GetStats().hits == 1);
+
+    const auto low = ProcTex(0.25f, 0.0f, tables);
+    REQUIRE(low.r() == 0x44);
+    REQUIRE(low.a() == 0x11);
+    const auto high = ProcTex(0.75f, 0.0f, tables);
+    REQUIRE(high.r() == 0x88);
+    REQUIRE(high.a() == 0x55);
+
+    SECTION("decodes the tables again when a LUT changes") {
+        proctex->color_table[1].raw = 0x99AABBCC;
+        const ProcTexTables& changed = cache.Get(*regs, *proctex);
+        REQUIRE(cache.GetStats().misses == 2);
+        REQUIRE(ProcTex(0.75f, 0.0f, changed).r() == 0xCC);
+
+        // Switching back finds the first tables again
+        proctex->color_table[1].raw = 0x55667788;
+        REQUIRE(&cache.Get(*regs, *proctex) == &tables);
+        REQUIRE(cache.GetStats().misses == 2);
+    }
+}
+
+TEST_CASE("ProcTexCache evicts the least recently used tables", "[video_core][swrasterizer]") {
+    auto regs = std::make_unique<TexturingRegs>();
+    auto proctex = std::make_unique<State::ProcTex>();
+    const auto get = [&](ProcTexCache& cache, u32 color) -> const ProcTexTables& {
+        proctex->color_table[0].raw = color;
+        return cache.Get(*regs, *proctex);
+    };
+
+    ProcTexCache cache(2);
+    get(cache, 1);
+    get(cache, 2);
+    // Using the first tables again makes the second the least recently used
+    get(cache, 1);
+    REQUIRE(cache.GetStats().misses == 2);
+
+    get(cache, 3);
+    REQUIRE(cache.Size() == 2);
+    REQUIRE(cache.GetStats().evictions == 1);
+
+    get(cache, 1);
+    REQUIRE(cache.GetStats().misses == 3);
+    get(cache, 2);
+    REQUIRE(cache.GetStats().misses == 4);
+    REQUIRE(cache.GetStats().evictions == 2);
+
+    SECTION("a title rewriting its LUTs every frame stays within the capacity") {
+        ProcTexCache bounded;
+        for (u32 frame = 0; frame < ProcTexCache::default_capacity * 4; ++frame) {
+            REQUIRE(get(bounded, frame).color_table[0].r() == static_cast<u8>(frame));
+        }
+        REQUIRE(bounded.Size() == ProcTexCache::default_capacity);
+        REQUIRE(bounded.GetStats().evictions == ProcTexCache::default_capacity * 3);
+    }
+}
+
+} // namespace Pica::Rasterizer
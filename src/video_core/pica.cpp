@@ -15,6 +15,7 @@ State g_state;
 
 void Init() {
     g_state.Reset();
+    Shader::PreloadDiskCache();
 }
 
 void Shutdown() {
@@ -48,8 +48,7 @@ RasterizerOpenGL::RasterizerOpenGL(Frontend::EmuWindow& window)
     : is_amd(IsVendorAmd()), shader_dirty(true),
       vertex_buffer(GL_ARRAY_BUFFER, VERTEX_BUFFER_SIZE, is_amd),
       uniform_buffer(GL_UNIFORM_BUFFER, UNIFORM_BUFFER_SIZE, false),
-      index_buffer(GL_ELEMENT_ARRAY_BUFFER, INDEX_BUFFER_SIZE, false),
-      texture_buffer(GL_TEXTURE_BUFFER, TEXTURE_BUFFER_SIZE, false), emu_window{window} {
+      index_buffer(GL_ELEMENT_ARRAY_BUFFER, INDEX_BUFFER_SIZE, false), emu_window{window} {
 
     allow_shadow = GLAD_GL_ARB_shader_image_load_store && GLAD_GL_ARB_shader_image_size &&
                    GLAD_GL_ARB_framebuffer_no_attachments;
@@ -90,16 +89,30 @@ RasterizerOpenGL::RasterizerOpenGL(Frontend::EmuWindow& window)
 
     uniform_block_data.dirty = true;
 
-    uniform_block_data.lighting_lut_dirty.fill(true);
+    for (auto& dirty : uniform_block_data.lighting_lut_dirty) {
+        dirty.MarkAll(256);
+    }
     uniform_block_data.lighting_lut_dirty_any = true;
 
-    uniform_block_data.fog_lut_dirty = true;
+    uniform_block_data.fog_lut_dirty.MarkAll(128);
+
+    uniform_block_data.proctex_noise_lut_dirty.MarkAll(128);
+    uniform_block_data.proctex_color_map_dirty.MarkAll(128);
+    uniform_block_data.proctex_alpha_map_dirty.MarkAll(128);
+    uniform_block_data.proctex_lut_dirty.MarkAll(256);
+    uniform_block_data.proctex_diff_lut_dirty.MarkAll(256);
 
-    uniform_block_data.proctex_noise_lut_dirty = true;
-    uniform_block_data.proctex_color_map_dirty = true;
-    uniform_block_data.proctex_alpha_map_dirty = true;
-    uniform_block_data.proctex_lut_dirty = true;
-    uniform_block_data.proctex_diff_lut_dirty = true;
+    // The LUT slots never move, so their offsets only need to be set once
+    for (std::size_t index = 0; index < Pica::LightingRegs::NumLightingSampler; ++index) {
+        uniform_block_data.data.lighting_lut_offset[index / 4][index % 4] = static_cast<GLint>(
+            (LIGHTING_LUT_SLOT + index * 256 * sizeof(GLvec2)) / sizeof(GLvec2));
+    }
+    uniform_block_data.data.fog_lut_offset = FOG_LUT_SLOT / sizeof(GLvec2);
+    uniform_block_data.data.proctex_noise_lut_offset = PROCTEX_NOISE_LUT_SLOT / sizeof(GLvec2);
+    uniform_block_data.data.proctex_color_map_offset = PROCTEX_COLOR_MAP_SLOT / sizeof(GLvec2);
+    uniform_block_data.data.proctex_alpha_map_offset = PROCTEX_ALPHA_MAP_SLOT / sizeof(GLvec2);
+    uniform_block_data.data.proctex_lut_offset = PROCTEX_LUT_SLOT / sizeof(GLvec4);
+    uniform_block_data.data.proctex_diff_lut_offset = PROCTEX_DIFF_LUT_SLOT / sizeof(GLvec4);
 
     glGetIntegerv(GL_UNIFORM_BUFFER_OFFSET_ALIGNMENT, &uniform_buffer_alignment);
     uniform_size_aligned_vs =
@@ -145,6 +158,13 @@ RasterizerOpenGL::RasterizerOpenGL(Frontend::EmuWindow& window)
     // Create render framebuffer
     framebuffer.Create();
 
+    // Allocate the LUT texture buffer. It is zero-filled to match the initial contents of the
+    // CPU-side copies of the LUTs, which are used to skip uploading unchanged entries.
+    texture_buffer.Create();
+    glBindBuffer(GL_TEXTURE_BUFFER, texture_buffer.handle);
+    const std::vector<u8> zero_lut_data(TEXTURE_BUFFER_SIZE);
+    glBufferData(GL_TEXTURE_BUFFER, TEXTURE_BUFFER_SIZE, zero_lut_data.data(), GL_DYNAMIC_DRAW);
+
     // Allocate and bind texture buffer lut textures
     texture_buffer_lut_rg.Create();
     texture_buffer_lut_rgba.Create();
@@ -152,9 +172,9 @@ RasterizerOpenGL::RasterizerOpenGL(Frontend::EmuWindow& window)
     state.texture_buffer_lut_rgba.texture_buffer = texture_buffer_lut_rgba.handle;
     state.Apply();
     glActiveTexture(TextureUnits::TextureBufferLUT_RG.Enum());
-    glTexBuffer(GL_TEXTURE_BUFFER, GL_RG32F, texture_buffer.GetHandle());
+    glTexBuffer(GL_TEXTURE_BUFFER, GL_RG32F, texture_buffer.handle);
     glActiveTexture(TextureUnits::TextureBufferLUT_RGBA.Enum());
-    glTexBuffer(GL_TEXTURE_BUFFER, GL_RGBA32F, texture_buffer.GetHandle());
+    glTexBuffer(GL_TEXTURE_BUFFER, GL_RGBA32F, texture_buffer.handle);
 
     // Bind index buffer for hardware shader path
     state.draw.vertex_array = hw_vao.handle;
@@ -171,6 +191,104 @@ RasterizerOpenGL::RasterizerOpenGL(Frontend::EmuWindow& window)
 
 RasterizerOpenGL::~RasterizerOpenGL() {}
 
+void RasterizerOpenGL::MarkDirty(DirtyState dirty) {
+    const std::size_t index = static_cast<std::size_t>(dirty);
+    if (dirty_state.test(index)) {
+        ++redundant_register_writes;
+    } else {
+        dirty_state.set(index);
+    }
+}
+
+void RasterizerOpenGL::MarkLightDirty(unsigned light_index) {
+    MarkDirty(static_cast<DirtyState>(static_cast<std::size_t>(DirtyState::Light0) + light_index));
+}
+
+MICROPROFILE_DEFINE(OpenGL_StateSync, "OpenGL", "State Sync", MP_RGB(100, 255, 100));
+void RasterizerOpenGL::SyncDirtyState() {
+    if (dirty_state.none()) {
+        return;
+    }
+
+    MICROPROFILE_SCOPE(OpenGL_StateSync);
+
+    const auto IsDirty = [this](DirtyState dirty) {
+        return dirty_state.test(static_cast<std::size_t>(dirty));
+    };
+
+    // Sync fixed function OpenGL state
+    if (IsDirty(DirtyState::ClipEnabled))
+        SyncClipEnabled();
+    if (IsDirty(DirtyState::CullMode))
+        SyncCullMode();
+    if (IsDirty(DirtyState::BlendEnabled))
+        SyncBlendEnabled();
+    if (IsDirty(DirtyState::BlendFuncs))
+        SyncBlendFuncs();
+    if (IsDirty(DirtyState::BlendColor))
+        SyncBlendColor();
+    if (IsDirty(DirtyState::LogicOp))
+        SyncLogicOp();
+    if (IsDirty(DirtyState::StencilTest))
+        SyncStencilTest();
+    if (IsDirty(DirtyState::DepthTest))
+        SyncDepthTest();
+    if (IsDirty(DirtyState::ColorWriteMask))
+        SyncColorWriteMask();
+    if (IsDirty(DirtyState::StencilWriteMask))
+        SyncStencilWriteMask();
+    if (IsDirty(DirtyState::DepthWriteMask))
+        SyncDepthWriteMask();
+
+    // Sync uniforms
+    if (IsDirty(DirtyState::ClipCoef))
+        SyncClipCoef();
+    if (IsDirty(DirtyState::DepthScale))
+        SyncDepthScale();
+    if (IsDirty(DirtyState::DepthOffset))
+        SyncDepthOffset();
+    if (IsDirty(DirtyState::AlphaTest))
+        SyncAlphaTest();
+    if (IsDirty(DirtyState::CombinerColor))
+        SyncCombinerColor();
+    if (IsDirty(DirtyState::TevConstColor)) {
+        auto& tev_stages = Pica::g_state.regs.texturing.GetTevStages();
+        for (std::size_t index = 0; index < tev_stages.size(); ++index)
+            SyncTevConstColor(index, tev_stages[index]);
+    }
+
+    if (IsDirty(DirtyState::GlobalAmbient))
+        SyncGlobalAmbient();
+    for (unsigned light_index = 0; light_index < 8; light_index++) {
+        const auto light = static_cast<std::size_t>(DirtyState::Light0) + light_index;
+        if (!IsDirty(static_cast<DirtyState>(light)))
+            continue;
+        SyncLightSpecular0(light_index);
+        SyncLightSpecular1(light_index);
+        SyncLightDiffuse(light_index);
+        SyncLightAmbient(light_index);
+        SyncLightPosition(light_index);
+        SyncLightSpotDirection(light_index);
+        SyncLightDistanceAttenuationBias(light_index);
+        SyncLightDistanceAttenuationScale(light_index);
+    }
+
+    if (IsDirty(DirtyState::FogColor))
+        SyncFogColor();
+    if (IsDirty(DirtyState::ProcTexNoise))
+        SyncProcTexNoise();
+    if (IsDirty(DirtyState::ProcTexBias))
+        SyncProcTexBias();
+    if (IsDirty(DirtyState::ShadowBias))
+        SyncShadowBias();
+    if (IsDirty(DirtyState::ShadowTextureBias))
+        SyncShadowTextureBias();
+
+    MICROPROFILE_META_CPU("Redundant register writes", redundant_register_writes);
+    redundant_register_writes = 0;
+    dirty_state.reset();
+}
+
 void RasterizerOpenGL::SyncEntireState() {
     // Sync fixed function OpenGL state
     SyncClipEnabled();
@@ -488,6 +606,9 @@ bool RasterizerOpenGL::Draw(bool accelerate, bool is_indexed) {
     MICROPROFILE_SCOPE(OpenGL_Drawing);
     const auto& regs = Pica::g_state.regs;
 
+    // Resolve the register writes since the last draw
+    SyncDirtyState();
+
     bool shadow_rendering = regs.framebuffer.output_merger.fragment_operation_mode ==
                             Pica::FramebufferRegs::FragmentOperationMode::Shadow;
 
@@ -858,27 +979,27 @@ void RasterizerOpenGL::NotifyPicaRegisterChanged(u32 id) {
     switch (id) {
     // Culling
     case PICA_REG_INDEX(rasterizer.cull_mode):
-        SyncCullMode();
+        MarkDirty(DirtyState::CullMode);
         break;
 
     // Clipping plane
     case PICA_REG_INDEX(rasterizer.clip_enable):
-        SyncClipEnabled();
+        MarkDirty(DirtyState::ClipEnabled);
         break;
 
     case PICA_REG_INDEX(rasterizer.clip_coef[0]):
     case PICA_REG_INDEX(rasterizer.clip_coef[1]):
     case PICA_REG_INDEX(rasterizer.clip_coef[2]):
     case PICA_REG_INDEX(rasterizer.clip_coef[3]):
-        SyncClipCoef();
+        MarkDirty(DirtyState::ClipCoef);
         break;
 
     // Depth modifiers
     case PICA_REG_INDEX(rasterizer.viewport_depth_range):
-        SyncDepthScale();
+        MarkDirty(DirtyState::DepthScale);
         break;
     case PICA_REG_INDEX(rasterizer.viewport_depth_near_plane):
-        SyncDepthOffset();
+        MarkDirty(DirtyState::DepthOffset);
         break;
 
     // Depth buffering
@@ -888,23 +1009,23 @@ void RasterizerOpenGL::NotifyPicaRegisterChanged(u32 id) {
 
     // Blending
     case PICA_REG_INDEX(framebuffer.output_merger.alphablend_enable):
-        SyncBlendEnabled();
+        MarkDirty(DirtyState::BlendEnabled);
         break;
     case PICA_REG_INDEX(framebuffer.output_merger.alpha_blending):
-        SyncBlendFuncs();
+        MarkDirty(DirtyState::BlendFuncs);
         break;
     case PICA_REG_INDEX(framebuffer.output_merger.blend_const):
-        SyncBlendColor();
+        MarkDirty(DirtyState::BlendColor);
         break;
 
     // Shadow texture
     case PICA_REG_INDEX(texturing.shadow):
-        SyncShadowTextureBias();
+        MarkDirty(DirtyState::ShadowTextureBias);
         break;
 
     // Fog state
     case PICA_REG_INDEX(texturing.fog_color):
-        SyncFogColor();
+        MarkDirty(DirtyState::FogColor);
         break;
     case PICA_REG_INDEX(texturing.fog_lut_data[0]):
     case PICA_REG_INDEX(texturing.fog_lut_data[1]):
@@ -914,21 +1035,22 @@ void RasterizerOpenGL::NotifyPicaRegisterChanged(u32 id) {
     case PICA_REG_INDEX(texturing.fog_lut_data[5]):
     case PICA_REG_INDEX(texturing.fog_lut_data[6]):
     case PICA_REG_INDEX(texturing.fog_lut_data[7]):
-        uniform_block_data.fog_lut_dirty = true;
+        // The offset has already been advanced past the written entry
+        uniform_block_data.fog_lut_dirty.Mark((regs.texturing.fog_lut_offset - 1) % 128);
         break;
 
     // ProcTex state
     case PICA_REG_INDEX(texturing.proctex):
     case PICA_REG_INDEX(texturing.proctex_lut):
     case PICA_REG_INDEX(texturing.proctex_lut_offset):
-        SyncProcTexBias();
+        MarkDirty(DirtyState::ProcTexBias);
         shader_dirty = true;
         break;
 
     case PICA_REG_INDEX(texturing.proctex_noise_u):
     case PICA_REG_INDEX(texturing.proctex_noise_v):
     case PICA_REG_INDEX(texturing.proctex_noise_frequency):
-        SyncProcTexNoise();
+        MarkDirty(DirtyState::ProcTexNoise);
         break;
 
     case PICA_REG_INDEX(texturing.proctex_lut_data[0]):
@@ -938,67 +1060,70 @@ void RasterizerOpenGL::NotifyPicaRegisterChanged(u32 id) {
     case PICA_REG_INDEX(texturing.proctex_lut_data[4]):
     case PICA_REG_INDEX(texturing.proctex_lut_data[5]):
     case PICA_REG_INDEX(texturing.proctex_lut_data[6]):
-    case PICA_REG_INDEX(texturing.proctex_lut_data[7]):
+    case PICA_REG_INDEX(texturing.proctex_lut_data[7]): {
         using Pica::TexturingRegs;
+        // The index has already been advanced past the written entry
+        const u32 index = regs.texturing.proctex_lut_config.index - 1;
         switch (regs.texturing.proctex_lut_config.ref_table.Value()) {
         case TexturingRegs::ProcTexLutTable::Noise:
-            uniform_block_data.proctex_noise_lut_dirty = true;
+            uniform_block_data.proctex_noise_lut_dirty.Mark(index % 128);
             break;
         case TexturingRegs::ProcTexLutTable::ColorMap:
-            uniform_block_data.proctex_color_map_dirty = true;
+            uniform_block_data.proctex_color_map_dirty.Mark(index % 128);
             break;
         case TexturingRegs::ProcTexLutTable::AlphaMap:
-            uniform_block_data.proctex_alpha_map_dirty = true;
+            uniform_block_data.proctex_alpha_map_dirty.Mark(index % 128);
             break;
         case TexturingRegs::ProcTexLutTable::Color:
-            uniform_block_data.proctex_lut_dirty = true;
+            uniform_block_data.proctex_lut_dirty.Mark(index % 256);
             break;
         case TexturingRegs::ProcTexLutTable::ColorDiff:
-            uniform_block_data.proctex_diff_lut_dirty = true;
+            uniform_block_data.proctex_diff_lut_dirty.Mark(index % 256);
             break;
         }
         break;
+    }
 
     // Alpha test
     case PICA_REG_INDEX(framebuffer.output_merger.alpha_test):
-        SyncAlphaTest();
+        MarkDirty(DirtyState::AlphaTest);
         shader_dirty = true;
         break;
 
     // Sync GL stencil test + stencil write mask
     // (Pica stencil test function register also contains a stencil write mask)
     case PICA_REG_INDEX(framebuffer.output_merger.stencil_test.raw_func):
-        SyncStencilTest();
-        SyncStencilWriteMask();
+        MarkDirty(DirtyState::StencilTest);
+        MarkDirty(DirtyState::StencilWriteMask);
         break;
     case PICA_REG_INDEX(framebuffer.output_merger.stencil_test.raw_op):
     case PICA_REG_INDEX(framebuffer.framebuffer.depth_format):
-        SyncStencilTest();
+        MarkDirty(DirtyState::StencilTest);
         break;
 
     // Sync GL depth test + depth and color write mask
     // (Pica depth test function register also contains a depth and color write mask)
     case PICA_REG_INDEX(framebuffer.output_merger.depth_test_enable):
-        SyncDepthTest();
-        SyncDepthWriteMask();
-        SyncColorWriteMask();
+        MarkDirty(DirtyState::DepthTest);
+        MarkDirty(DirtyState::DepthWriteMask);
+        MarkDirty(DirtyState::ColorWriteMask);
         break;
 
     // Sync GL depth and stencil write mask
     // (This is a dedicated combined depth / stencil write-enable register)
     case PICA_REG_INDEX(framebuffer.framebuffer.allow_depth_stencil_write):
-        SyncDepthWriteMask();
-        SyncStencilWriteMask();
+        MarkDirty(DirtyState::DepthWriteMask);
+        MarkDirty(DirtyState::StencilWriteMask);
         break;
 
     // Sync GL color write mask
     // (This is a dedicated color write-enable register)
     case PICA_REG_INDEX(framebuffer.framebuffer.allow_color_write):
-        SyncColorWriteMask();
+        MarkDirty(DirtyState::ColorWriteMask);
         break;
 
     case PICA_REG_INDEX(framebuffer.shadow):
-        SyncShadowBias();
+        MarkDirty(DirtyState::ShadowBias);
         break;
 
     // Scissor test
@@ -1008,7 +1133,7 @@ void RasterizerOpenGL::NotifyPicaRegisterChanged(u32 id) {
 
     // Logic op
     case PICA_REG_INDEX(framebuffer.output_merger.logic_op):
-        SyncLogicOp();
+        MarkDirty(DirtyState::LogicOp);
         break;
 
     case PICA_REG_INDEX(texturing.main_config):
@@ -1050,27 +1175,27 @@ void RasterizerOpenGL::NotifyPicaRegisterChanged(u32 id) {
         shader_dirty = true;
         break;
     case PICA_REG_INDEX(texturing.tev_stage0.const_r):
-        SyncTevConstColor(0, regs.texturing.tev_stage0);
+        MarkDirty(DirtyState::TevConstColor);
         break;
     case PICA_REG_INDEX(texturing.tev_stage1.const_r):
-        SyncTevConstColor(1, regs.texturing.tev_stage1);
+        MarkDirty(DirtyState::TevConstColor);
         break;
     case PICA_REG_INDEX(texturing.tev_stage2.const_r):
-        SyncTevConstColor(2, regs.texturing.tev_stage2);
+        MarkDirty(DirtyState::TevConstColor);
         break;
     case PICA_REG_INDEX(texturing.tev_stage3.const_r):
-        SyncTevConstColor(3, regs.texturing.tev_stage3);
+        MarkDirty(DirtyState::TevConstColor);
         break;
     case PICA_REG_INDEX(texturing.tev_stage4.const_r):
-        SyncTevConstColor(4, regs.texturing.tev_stage4);
+        MarkDirty(DirtyState::TevConstColor);
         break;
     case PICA_REG_INDEX(texturing.tev_stage5.const_r):
-        SyncTevConstColor(5, regs.texturing.tev_stage5);
+        MarkDirty(DirtyState::TevConstColor);
         break;
 
     // TEV combiner buffer color
     case PICA_REG_INDEX(texturing.tev_combiner_buffer_color):
-        SyncCombinerColor();
+        MarkDirty(DirtyState::CombinerColor);
         break;
 
     // Fragment lighting switches
@@ -1086,174 +1211,174 @@ void RasterizerOpenGL::NotifyPicaRegisterChanged(u32 id) {
 
     // Fragment lighting specular 0 color
     case PICA_REG_INDEX(lighting.light[0].specular_0):
-        SyncLightSpecular0(0);
+        MarkLightDirty(0);
         break;
     case PICA_REG_INDEX(lighting.light[1].specular_0):
-        SyncLightSpecular0(1);
+        MarkLightDirty(1);
         break;
     case PICA_REG_INDEX(lighting.light[2].specular_0):
-        SyncLightSpecular0(2);
+        MarkLightDirty(2);
         break;
     case PICA_REG_INDEX(lighting.light[3].specular_0):
-        SyncLightSpecular0(3);
+        MarkLightDirty(3);
         break;
     case PICA_REG_INDEX(lighting.light[4].specular_0):
-        SyncLightSpecular0(4);
+        MarkLightDirty(4);
         break;
     case PICA_REG_INDEX(lighting.light[5].specular_0):
-        SyncLightSpecular0(5);
+        MarkLightDirty(5);
         break;
     case PICA_REG_INDEX(lighting.light[6].specular_0):
-        SyncLightSpecular0(6);
+        MarkLightDirty(6);
         break;
     case PICA_REG_INDEX(lighting.light[7].specular_0):
-        SyncLightSpecular0(7);
+        MarkLightDirty(7);
         break;
 
     // Fragment lighting specular 1 color
     case PICA_REG_INDEX(lighting.light[0].specular_1):
-        SyncLightSpecular1(0);
+        MarkLightDirty(0);
         break;
     case PICA_REG_INDEX(lighting.light[1].specular_1):
-        SyncLightSpecular1(1);
+        MarkLightDirty(1);
         break;
     case PICA_REG_INDEX(lighting.light[2].specular_1):
-        SyncLightSpecular1(2);
+        MarkLightDirty(2);
         break;
     case PICA_REG_INDEX(lighting.light[3].specular_1):
-        SyncLightSpecular1(3);
+        MarkLightDirty(3);
         break;
     case PICA_REG_INDEX(lighting.light[4].specular_1):
-        SyncLightSpecular1(4);
+        MarkLightDirty(4);
         break;
     case PICA_REG_INDEX(lighting.light[5].specular_1):
-        SyncLightSpecular1(5);
+        MarkLightDirty(5);
         break;
     case PICA_REG_INDEX(lighting.light[6].specular_1):
-        SyncLightSpecular1(6);
+        MarkLightDirty(6);
         break;
     case PICA_REG_INDEX(lighting.light[7].specular_1):
-        SyncLightSpecular1(7);
+        MarkLightDirty(7);
         break;
 
     // Fragment lighting diffuse color
     case PICA_REG_INDEX(lighting.light[0].diffuse):
-        SyncLightDiffuse(0);
+        MarkLightDirty(0);
         break;
     case PICA_REG_INDEX(lighting.light[1].diffuse):
-        SyncLightDiffuse(1);
+        MarkLightDirty(1);
         break;
     case PICA_REG_INDEX(lighting.light[2].diffuse):
-        SyncLightDiffuse(2);
+        MarkLightDirty(2);
         break;
     case PICA_REG_INDEX(lighting.light[3].diffuse):
-        SyncLightDiffuse(3);
+        MarkLightDirty(3);
         break;
     case PICA_REG_INDEX(lighting.light[4].diffuse):
-        SyncLightDiffuse(4);
+        MarkLightDirty(4);
         break;
     case PICA_REG_INDEX(lighting.light[5].diffuse):
-        SyncLightDiffuse(5);
+        MarkLightDirty(5);
         break;
     case PICA_REG_INDEX(lighting.light[6].diffuse):
-        SyncLightDiffuse(6);
+        MarkLightDirty(6);
         break;
     case PICA_REG_INDEX(lighting.light[7].diffuse):
-        SyncLightDiffuse(7);
+        MarkLightDirty(7);
         break;
 
     // Fragment lighting ambient color
     case PICA_REG_INDEX(lighting.light[0].ambient):
-        SyncLightAmbient(0);
+        MarkLightDirty(0);
         break;
     case PICA_REG_INDEX(lighting.light[1].ambient):
-        SyncLightAmbient(1);
+        MarkLightDirty(1);
         break;
     case PICA_REG_INDEX(lighting.light[2].ambient):
-        SyncLightAmbient(2);
+        MarkLightDirty(2);
         break;
     case PICA_REG_INDEX(lighting.light[3].ambient):
-        SyncLightAmbient(3);
+        MarkLightDirty(3);
         break;
     case PICA_REG_INDEX(lighting.light[4].ambient):
-        SyncLightAmbient(4);
+        MarkLightDirty(4);
         break;
     case PICA_REG_INDEX(lighting.light[5].ambient):
-        SyncLightAmbient(5);
+        MarkLightDirty(5);
         break;
     case PICA_REG_INDEX(lighting.light[6].ambient):
-        SyncLightAmbient(6);
+        MarkLightDirty(6);
         break;
     case PICA_REG_INDEX(lighting.light[7].ambient):
-        SyncLightAmbient(7);
+        MarkLightDirty(7);
         break;
 
     // Fragment lighting position
     case PICA_REG_INDEX(lighting.light[0].x):
     case PICA_REG_INDEX(lighting.light[0].z):
-        SyncLightPosition(0);
+        MarkLightDirty(0);
         break;
     case PICA_REG_INDEX(lighting.light[1].x):
     case PICA_REG_INDEX(lighting.light[1].z):
-        SyncLightPosition(1);
+        MarkLightDirty(1);
         break;
     case PICA_REG_INDEX(lighting.light[2].x):
     case PICA_REG_INDEX(lighting.light[2].z):
-        SyncLightPosition(2);
+        MarkLightDirty(2);
         break;
     case PICA_REG_INDEX(lighting.light[3].x):
     case PICA_REG_INDEX(lighting.light[3].z):
-        SyncLightPosition(3);
+        MarkLightDirty(3);
         break;
     case PICA_REG_INDEX(lighting.light[4].x):
     case PICA_REG_INDEX(lighting.light[4].z):
-        SyncLightPosition(4);
+        MarkLightDirty(4);
         break;
     case PICA_REG_INDEX(lighting.light[5].x):
     case PICA_REG_INDEX(lighting.light[5].z):
-        SyncLightPosition(5);
+        MarkLightDirty(5);
         break;
     case PICA_REG_INDEX(lighting.light[6].x):
     case PICA_REG_INDEX(lighting.light[6].z):
-        SyncLightPosition(6);
+        MarkLightDirty(6);
         break;
     case PICA_REG_INDEX(lighting.light[7].x):
     case PICA_REG_INDEX(lighting.light[7].z):
-        SyncLightPosition(7);
+        MarkLightDirty(7);
         break;
 
     // Fragment spot lighting direction
     case PICA_REG_INDEX(lighting.light[0].spot_x):
     case PICA_REG_INDEX(lighting.light[0].spot_z):
-        SyncLightSpotDirection(0);
+        MarkLightDirty(0);
         break;
     case PICA_REG_INDEX(lighting.light[1].spot_x):
     case PICA_REG_INDEX(lighting.light[1].spot_z):
-        SyncLightSpotDirection(1);
+        MarkLightDirty(1);
         break;
     case PICA_REG_INDEX(lighting.light[2].spot_x):
     case PICA_REG_INDEX(lighting.light[2].spot_z):
-        SyncLightSpotDirection(2);
+        MarkLightDirty(2);
         break;
     case PICA_REG_INDEX(lighting.light[3].spot_x):
     case PICA_REG_INDEX(lighting.light[3].spot_z):
-        SyncLightSpotDirection(3);
+        MarkLightDirty(3);
         break;
     case PICA_REG_INDEX(lighting.light[4].spot_x):
     case PICA_REG_INDEX(lighting.light[4].spot_z):
-        SyncLightSpotDirection(4);
+        MarkLightDirty(4);
         break;
     case PICA_REG_INDEX(lighting.light[5].spot_x):
     case PICA_REG_INDEX(lighting.light[5].spot_z):
-        SyncLightSpotDirection(5);
+        MarkLightDirty(5);
         break;
     case PICA_REG_INDEX(lighting.light[6].spot_x):
     case PICA_REG_INDEX(lighting.light[6].spot_z):
-        SyncLightSpotDirection(6);
+        MarkLightDirty(6);
         break;
     case PICA_REG_INDEX(lighting.light[7].spot_x):
     case PICA_REG_INDEX(lighting.light[7].spot_z):
-        SyncLightSpotDirection(7);
+        MarkLightDirty(7);
         break;
 
     // Fragment lighting light source config
@@ -1270,59 +1395,59 @@ void RasterizerOpenGL::NotifyPicaRegisterChanged(u32 id) {
 
     // Fragment lighting distance attenuation bias
     case PICA_REG_INDEX(lighting.light[0].dist_atten_bias):
-        SyncLightDistanceAttenuationBias(0);
+        MarkLightDirty(0);
         break;
     case PICA_REG_INDEX(lighting.light[1].dist_atten_bias):
-        SyncLightDistanceAttenuationBias(1);
+        MarkLightDirty(1);
         break;
     case PICA_REG_INDEX(lighting.light[2].dist_atten_bias):
-        SyncLightDistanceAttenuationBias(2);
+        MarkLightDirty(2);
         break;
     case PICA_REG_INDEX(lighting.light[3].dist_atten_bias):
-        SyncLightDistanceAttenuationBias(3);
+        MarkLightDirty(3);
         break;
     case PICA_REG_INDEX(lighting.light[4].dist_atten_bias):
-        SyncLightDistanceAttenuationBias(4);
+        MarkLightDirty(4);
         break;
     case PICA_REG_INDEX(lighting.light[5].dist_atten_bias):
-        SyncLightDistanceAttenuationBias(5);
+        MarkLightDirty(5);
         break;
     case PICA_REG_INDEX(lighting.light[6].dist_atten_bias):
-        SyncLightDistanceAttenuationBias(6);
+        MarkLightDirty(6);
         break;
     case PICA_REG_INDEX(lighting.light[7].dist_atten_bias):
-        SyncLightDistanceAttenuationBias(7);
+        MarkLightDirty(7);
         break;
 
     // Fragment lighting distance attenuation scale
     case PICA_REG_INDEX(lighting.light[0].dist_atten_scale):
-        SyncLightDistanceAttenuationScale(0);
+        MarkLightDirty(0);
         break;
     case PICA_REG_INDEX(lighting.light[1].dist_atten_scale):
-        SyncLightDistanceAttenuationScale(1);
+        MarkLightDirty(1);
         break;
     case PICA_REG_INDEX(lighting.light[2].dist_atten_scale):
-        SyncLightDistanceAttenuationScale(2);
+        MarkLightDirty(2);
         break;
     case PICA_REG_INDEX(lighting.light[3].dist_atten_scale):
-        SyncLightDistanceAttenuationScale(3);
+        MarkLightDirty(3);
         break;
     case PICA_REG_INDEX(lighting.light[4].dist_atten_scale):
-        SyncLightDistanceAttenuationScale(4);
+        MarkLightDirty(4);
         break;
     case PICA_REG_INDEX(lighting.light[5].dist_atten_scale):
-        SyncLightDistanceAttenuationScale(5);
+        MarkLightDirty(5);
         break;
     case PICA_REG_INDEX(lighting.light[6].dist_atten_scale):
-        SyncLightDistanceAttenuationScale(6);
+        MarkLightDirty(6);
         break;
     case PICA_REG_INDEX(lighting.light[7].dist_atten_scale):
-        SyncLightDistanceAttenuationScale(7);
+        MarkLightDirty(7);
         break;
 
     // Fragment lighting global ambient color (emission + ambient * ambient)
     case PICA_REG_INDEX(lighting.global_ambient):
-        SyncGlobalAmbient();
+        MarkDirty(DirtyState::GlobalAmbient);
         break;
 
     // Fragment lighting lookup tables
@@ -1335,7 +1460,8 @@ void RasterizerOpenGL::NotifyPicaRegisterChanged(u32 id) {
     case PICA_REG_INDEX(lighting.lut_data[6]):
     case PICA_REG_INDEX(lighting.lut_data[7]): {
         auto& lut_config = regs.lighting.lut_config;
-        uniform_block_data.lighting_lut_dirty[lut_config.type] = true;
+        // The index has already been advanced past the written entry
+        uniform_block_data.lighting_lut_dirty[lut_config.type].Mark((lut_config.index - 1) % 256);
         uniform_block_data.lighting_lut_dirty_any = true;
         break;
     }
@@ -1945,156 +2071,101 @@ void RasterizerOpenGL::SyncShadowTextureBias() {
     }
 }
 
-void RasterizerOpenGL::SyncAndUploadLUTs() {
-    constexpr std::size_t max_size = sizeof(GLvec2) * 256 * Pica::LightingRegs::NumLightingSampler +
-                                     sizeof(GLvec2) * 128 +     // fog
-                                     sizeof(GLvec2) * 128 * 3 + // proctex: noise + color + alpha
-                                     sizeof(GLvec4) * 256 +     // proctex
-                                     sizeof(GLvec4) * 256;      // proctex diff
-
-    if (!uniform_block_data.lighting_lut_dirty_any && !uniform_block_data.fog_lut_dirty &&
-        !uniform_block_data.proctex_noise_lut_dirty &&
-        !uniform_block_data.proctex_color_map_dirty &&
-        !uniform_block_data.proctex_alpha_map_dirty && !uniform_block_data.proctex_lut_dirty &&
-        !uniform_block_data.proctex_diff_lut_dirty) {
-        return;
-    }
-
-    u8* buffer;
-    GLintptr offset;
-    bool invalidate;
-    std::size_t bytes_used = 0;
-    glBindBuffer(GL_TEXTURE_BUFFER, texture_buffer.GetHandle());
-    std::tie(buffer, offset, invalidate) = texture_buffer.Map(max_size, sizeof(GLvec4));
-
-    // Sync the lighting luts
-    if (uniform_block_data.lighting_lut_dirty_any || invalidate) {
-        for (unsigned index = 0; index < uniform_block_data.lighting_lut_dirty.size(); index++) {
-            if (uniform_block_data.lighting_lut_dirty[index] || invalidate) {
-                std::array<GLvec2, 256> new_data;
-                const auto& source_lut = Pica::g_state.lighting.luts[index];
-                std::transform(source_lut.begin(), source_lut.end(), new_data.begin(),
-                               [](const auto& entry) {
-                                   return GLvec2{entry.ToFloat(), entry.DiffToFloat()};
-                               });
-
-                if (new_data != lighting_lut_data[index] || invalidate) {
-                    lighting_lut_data[index] = new_data;
-                    std::memcpy(buffer + bytes_used, new_data.data(),
-                                new_data.size() * sizeof(GLvec2));
-                    uniform_block_data.data.lighting_lut_offset[index / 4][index % 4] =
-                        (offset + bytes_used) / sizeof(GLvec2);
-                    uniform_block_data.dirty = true;
-                    bytes_used += new_data.size() * sizeof(GLvec2);
-                }
-                uniform_block_data.lighting_lut_dirty[index] = false;
-            }
+/**
+ * Converts the dirty range of a LUT and uploads the entries that actually changed to the LUT's slot
+ * in the bound texture buffer.
+ * @param source LUT as written by the guest
+ * @param lut_data Converted copy of the LUT, matching what is currently in the texture buffer
+ * @param dirty Range of `source` written since the last upload, reset by this function
+ * @param slot Byte offset of the LUT within the texture buffer
+ * @param convert Function converting a `source` entry to a `lut_data` entry
+ * @returns the number of bytes uploaded
+ */
+template <typename Entry, typename GLEntry, std::size_t N, typename Converter>
+static std::size_t UploadLUTRange(const std::array<Entry, N>& source,
+                                  std::array<GLEntry, N>& lut_data, LUTDirtyRange& dirty,
+                                  std::size_t slot, Converter convert) {
+    u32 changed_begin = dirty.end;
+    u32 changed_end = dirty.begin;
+    for (u32 index = dirty.begin; index < dirty.end; ++index) {
+        const GLEntry new_entry = convert(source[index]);
+        if (new_entry != lut_data[index]) {
+            lut_data[index] = new_entry;
+            changed_begin = std::min(changed_begin, index);
+            changed_end = index + 1;
         }
     }
-    uniform_block_data.lighting_lut_dirty_any = false;
-
-    // Sync the fog lut
-    if (uniform_block_data.fog_lut_dirty || invalidate) {
-        std::array<GLvec2, 128> new_data;
-
-        std::transform(Pica::g_state.fog.lut.begin(), Pica::g_state.fog.lut.end(), new_data.begin(),
-                       [](const auto& entry) {
-                           return GLvec2{entry.ToFloat(), entry.DiffToFloat()};
-                       });
-
-        if (new_data != fog_lut_data || invalidate) {
-            fog_lut_data = new_data;
-            std::memcpy(buffer + bytes_used, new_data.data(), new_data.size() * sizeof(GLvec2));
-            uniform_block_data.data.fog_lut_offset = (offset + bytes_used) / sizeof(GLvec2);
-            uniform_block_data.dirty = true;
-            bytes_used += new_data.size() * sizeof(GLvec2);
-        }
-        uniform_block_data.fog_lut_dirty = false;
-    }
-
-    // helper function for SyncProcTexNoiseLUT/ColorMap/AlphaMap
-    auto SyncProcTexValueLUT = [this, buffer, offset, invalidate, &bytes_used](
-                                   const std::array<Pica::State::ProcTex::ValueEntry, 128>& lut,
-                                   std::array<GLvec2, 128>& lut_data, GLint& lut_offset) {
-        std::array<GLvec2, 128> new_data;
-        std::transform(lut.begin(), lut.end(), new_data.begin(), [](const auto& entry) {
-            return GLvec2{entry.ToFloat(), entry.DiffToFloat()};
-        });
-
-        if (new_data != lut_data || invalidate) {
-            lut_data = new_data;
-            std::memcpy(buffer + bytes_used, new_data.data(), new_data.size() * sizeof(GLvec2));
-            lut_offset = (offset + bytes_used) / sizeof(GLvec2);
-            uniform_block_data.dirty = true;
-            bytes_used += new_data.size() * sizeof(GLvec2);
-        }
-    };
+    dirty.Reset();
 
-    // Sync the proctex noise lut
-    if (uniform_block_data.proctex_noise_lut_dirty || invalidate) {
-        SyncProcTexValueLUT(Pica::g_state.proctex.noise_table, proctex_noise_lut_data,
-                            uniform_block_data.data.proctex_noise_lut_offset);
-        uniform_block_data.proctex_noise_lut_dirty = false;
+    if (changed_begin >= changed_end) {
+        return 0;
     }
 
-    // Sync the proctex color map
-    if (uniform_block_data.proctex_color_map_dirty || invalidate) {
-        SyncProcTexValueLUT(Pica::g_state.proctex.color_map_table, proctex_color_map_data,
-                            uniform_block_data.data.proctex_color_map_offset);
-        uniform_block_data.proctex_color_map_dirty = false;
-    }
+    const std::size_t size = (changed_end - changed_begin) * sizeof(GLEntry);
+    glBufferSubData(GL_TEXTURE_BUFFER, slot + changed_begin * sizeof(GLEntry), size,
+                    &lut_data[changed_begin]);
+    return size;
+}
 
-    // Sync the proctex alpha map
-    if (uniform_block_data.proctex_alpha_map_dirty || invalidate) {
-        SyncProcTexValueLUT(Pica::g_state.proctex.alpha_map_table, proctex_alpha_map_data,
-                            uniform_block_data.data.proctex_alpha_map_offset);
-        uniform_block_data.proctex_alpha_map_dirty = false;
+MICROPROFILE_DEFINE(OpenGL_LUTUpload, "OpenGL", "LUT Upload", MP_RGB(100, 100, 255));
+void RasterizerOpenGL::SyncAndUploadLUTs() {
+    if (!uniform_block_data.lighting_lut_dirty_any && !uniform_block_data.fog_lut_dirty.IsDirty() &&
+        !uniform_block_data.proctex_noise_lut_dirty.IsDirty() &&
+        !uniform_block_data.proctex_color_map_dirty.IsDirty() &&
+        !uniform_block_data.proctex_alpha_map_dirty.IsDirty() &&
+        !uniform_block_data.proctex_lut_dirty.IsDirty() &&
+        !uniform_block_data.proctex_diff_lut_dirty.IsDirty()) {
+        return;
     }
 
-    // Sync the proctex lut
-    if (uniform_block_data.proctex_lut_dirty || invalidate) {
-        std::array<GLvec4, 256> new_data;
+    MICROPROFILE_SCOPE(OpenGL_LUTUpload);
 
-        std::transform(Pica::g_state.proctex.color_table.begin(),
-                       Pica::g_state.proctex.color_table.end(), new_data.begin(),
-                       [](const auto& entry) {
-                           auto rgba = entry.ToVector() / 255.0f;
-                           return GLvec4{rgba.r(), rgba.g(), rgba.b(), rgba.a()};
-                       });
+    const auto ValueEntryToGL = [](const auto& entry) {
+        return GLvec2{entry.ToFloat(), entry.DiffToFloat()};
+    };
+    const auto ColorEntryToGL = [](const auto& entry) {
+        auto rgba = entry.ToVector() / 255.0f;
+        return GLvec4{rgba.r(), rgba.g(), rgba.b(), rgba.a()};
+    };
 
-        if (new_data != proctex_lut_data || invalidate) {
-            proctex_lut_data = new_data;
-            std::memcpy(buffer + bytes_used, new_data.data(), new_data.size() * sizeof(GLvec4));
-            uniform_block_data.data.proctex_lut_offset = (offset + bytes_used) / sizeof(GLvec4);
-            uniform_block_data.dirty = true;
-            bytes_used += new_data.size() * sizeof(GLvec4);
-        }
-        uniform_block_data.proctex_lut_dirty = false;
-    }
-
-    // Sync the proctex difference lut
-    if (uniform_block_data.proctex_diff_lut_dirty || invalidate) {
-        std::array<GLvec4, 256> new_data;
-
-        std::transform(Pica::g_state.proctex.color_diff_table.begin(),
-                       Pica::g_state.proctex.color_diff_table.end(), new_data.begin(),
-                       [](const auto& entry) {
-                           auto rgba = entry.ToVector() / 255.0f;
-                           return GLvec4{rgba.r(), rgba.g(), rgba.b(), rgba.a()};
-                       });
-
-        if (new_data != proctex_diff_lut_data || invalidate) {
-            proctex_diff_lut_data = new_data;
-            std::memcpy(buffer + bytes_used, new_data.data(), new_data.size() * sizeof(GLvec4));
-            uniform_block_data.data.proctex_diff_lut_offset =
-                (offset + bytes_used) / sizeof(GLvec4);
-            uniform_block_data.dirty = true;
-            bytes_used += new_data.size() * sizeof(GLvec4);
+    std::size_t bytes_uploaded = 0;
+    glBindBuffer(GL_TEXTURE_BUFFER, texture_buffer.handle);
+
+    // Sync the lighting luts
+    if (uniform_block_data.lighting_lut_dirty_any) {
+        for (unsigned index = 0; index < uniform_block_data.lighting_lut_dirty.size(); index++) {
+            bytes_uploaded += UploadLUTRange(
+                Pica::g_state.lighting.luts[index], lighting_lut_data[index],
+                uniform_block_data.lighting_lut_dirty[index],
+                LIGHTING_LUT_SLOT + index * 256 * sizeof(GLvec2), ValueEntryToGL);
         }
-        uniform_block_data.proctex_diff_lut_dirty = false;
+        uniform_block_data.lighting_lut_dirty_any = false;
     }
 
-    texture_buffer.Unmap(bytes_used);
+    // Sync the fog lut
+    bytes_uploaded += UploadLUTRange(Pica::g_state.fog.lut, fog_lut_data,
+                                     uniform_block_data.fog_lut_dirty, FOG_LUT_SLOT, ValueEntryToGL);
+
+    // Sync the proctex noise lut, color map and alpha map
+    bytes_uploaded += UploadLUTRange(Pica::g_state.proctex.noise_table, proctex_noise_lut_data,
+                                     uniform_block_data.proctex_noise_lut_dirty,
+                                     PROCTEX_NOISE_LUT_SLOT, ValueEntryToGL);
+    bytes_uploaded += UploadLUTRange(Pica::g_state.proctex.color_map_table, proctex_color_map_data,
+                                     uniform_block_data.proctex_color_map_dirty,
+                                     PROCTEX_COLOR_MAP_SLOT, ValueEntryToGL);
+    bytes_uploaded += UploadLUTRange(Pica::g_state.proctex.alpha_map_table, proctex_alpha_map_data,
+                                     uniform_block_data.proctex_alpha_map_dirty,
+                                     PROCTEX_ALPHA_MAP_SLOT, ValueEntryToGL);
+
+    // Sync the proctex lut and difference lut
+    bytes_uploaded += UploadLUTRange(Pica::g_state.proctex.color_table, proctex_lut_data,
+                                     uniform_block_data.proctex_lut_dirty, PROCTEX_LUT_SLOT,
+                                     ColorEntryToGL);
+    bytes_uploaded += UploadLUTRange(Pica::g_state.proctex.color_diff_table, proctex_diff_lut_data,
+                                     uniform_block_data.proctex_diff_lut_dirty,
+                                     PROCTEX_DIFF_LUT_SLOT, ColorEntryToGL);
+
+    MICROPROFILE_META_CPU("Bytes uploaded", static_cast<int>(bytes_uploaded));
 }
 
 void RasterizerOpenGL::UploadUniforms(bool accelerate_draw) {
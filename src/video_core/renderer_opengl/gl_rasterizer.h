@@ -4,7 +4,9 @@
 
 #pragma once
 
+#include <algorithm>
 #include <array>
+#include <bitset>
 #include <cstddef>
 #include <cstring>
 #include <memory>
@@ -37,6 +39,35 @@ class ShaderProgramManager;
 
 namespace OpenGL {
 
+/// Range of entries of a LUT that have been written since it was last uploaded
+struct LUTDirtyRange {
+    u32 begin = 0;
+    u32 end = 0;
+
+    bool IsDirty() const {
+        return begin < end;
+    }
+
+    void Mark(u32 index) {
+        if (IsDirty()) {
+            begin = std::min(begin, index);
+            end = std::max(end, index + 1);
+        } else {
+            begin = index;
+            end = index + 1;
+        }
+    }
+
+    void MarkAll(u32 size) {
+        begin = 0;
+        end = size;
+    }
+
+    void Reset() {
+        begin = end = 0;
+    }
+};
+
 class RasterizerOpenGL : public VideoCore::RasterizerInterface {
 public:
     explicit RasterizerOpenGL(Frontend::EmuWindow& renderer);
@@ -128,6 +159,44 @@ private:
         GLvec3 view;
     };
 
+    /// Groups of GL state and uniforms that are synced from the PICA registers at draw time
+    enum class DirtyState : std::size_t {
+        CullMode,
+        ClipEnabled,
+        ClipCoef,
+        DepthScale,
+        DepthOffset,
+        BlendEnabled,
+        BlendFuncs,
+        BlendColor,
+        ShadowTextureBias,
+        FogColor,
+        ProcTexBias,
+        ProcTexNoise,
+        AlphaTest,
+        StencilTest,
+        StencilWriteMask,
+        DepthTest,
+        DepthWriteMask,
+        ColorWriteMask,
+        ShadowBias,
+        LogicOp,
+        CombinerColor,
+        TevConstColor,
+        GlobalAmbient,
+        Light0, ///< All properties of light 0, followed by lights 1 to 7
+        NumStates = Light0 + 8,
+    };
+
+    /// Flags a state group to be synced at the next draw, counting the write if it was redundant
+    void MarkDirty(DirtyState dirty);
+
+    /// Flags all properties of the specified light to be synced at the next draw
+    void MarkLightDirty(unsigned light_index);
+
+    /// Syncs the state groups modified since the last draw
+    void SyncDirtyState();
+
     /// Syncs entire status to match PICA registers
     void SyncEntireState();
 
@@ -271,16 +340,20 @@ private:
 
     bool shader_dirty;
 
+    std::bitset<static_cast<std::size_t>(DirtyState::NumStates)> dirty_state;
+    /// Register writes to state groups that were already waiting to be synced
+    u32 redundant_register_writes = 0;
+
     struct {
         UniformData data;
-        std::array<bool, Pica::LightingRegs::NumLightingSampler> lighting_lut_dirty;
+        std::array<LUTDirtyRange, Pica::LightingRegs::NumLightingSampler> lighting_lut_dirty;
         bool lighting_lut_dirty_any;
-        bool fog_lut_dirty;
-        bool proctex_noise_lut_dirty;
-        bool proctex_color_map_dirty;
-        bool proctex_alpha_map_dirty;
-        bool proctex_lut_dirty;
-        bool proctex_diff_lut_dirty;
+        LUTDirtyRange fog_lut_dirty;
+        LUTDirtyRange proctex_noise_lut_dirty;
+        LUTDirtyRange proctex_color_map_dirty;
+        LUTDirtyRange proctex_alpha_map_dirty;
+        LUTDirtyRange proctex_lut_dirty;
+        LUTDirtyRange proctex_diff_lut_dirty;
         bool dirty;
     } uniform_block_data = {};
 
@@ -290,7 +363,20 @@ private:
     static constexpr std::size_t VERTEX_BUFFER_SIZE = 16 * 1024 * 1024;
     static constexpr std::size_t INDEX_BUFFER_SIZE = 1 * 1024 * 1024;
     static constexpr std::size_t UNIFORM_BUFFER_SIZE = 2 * 1024 * 1024;
-    static constexpr std::size_t TEXTURE_BUFFER_SIZE = 1 * 1024 * 1024;
+
+    // Every LUT has a fixed slot in the texture buffer, so that only the entries the guest
+    // rewrites need to be uploaded. Each slot starts at a multiple of sizeof(GLvec4).
+    static constexpr std::size_t LIGHTING_LUT_SLOT = 0;
+    static constexpr std::size_t FOG_LUT_SLOT =
+        LIGHTING_LUT_SLOT + sizeof(GLvec2) * 256 * Pica::LightingRegs::NumLightingSampler;
+    static constexpr std::size_t PROCTEX_NOISE_LUT_SLOT = FOG_LUT_SLOT + sizeof(GLvec2) * 128;
+    static constexpr std::size_t PROCTEX_COLOR_MAP_SLOT =
+        PROCTEX_NOISE_LUT_SLOT + sizeof(GLvec2) * 128;
+    static constexpr std::size_t PROCTEX_ALPHA_MAP_SLOT =
+        PROCTEX_COLOR_MAP_SLOT + sizeof(GLvec2) * 128;
+    static constexpr std::size_t PROCTEX_LUT_SLOT = PROCTEX_ALPHA_MAP_SLOT + sizeof(GLvec2) * 128;
+    static constexpr std::size_t PROCTEX_DIFF_LUT_SLOT = PROCTEX_LUT_SLOT + sizeof(GLvec4) * 256;
+    static constexpr std::size_t TEXTURE_BUFFER_SIZE = PROCTEX_DIFF_LUT_SLOT + sizeof(GLvec4) * 256;
 
     OGLVertexArray sw_vao; // VAO for software shader draw
     OGLVertexArray hw_vao; // VAO for hardware shader / accelerate draw
@@ -300,7 +386,7 @@ private:
     OGLStreamBuffer vertex_buffer;
     OGLStreamBuffer uniform_buffer;
     OGLStreamBuffer index_buffer;
-    OGLStreamBuffer texture_buffer;
+    OGLBuffer texture_buffer;
     OGLFramebuffer framebuffer;
     GLint uniform_buffer_alignment;
     std::size_t uniform_size_aligned_vs;
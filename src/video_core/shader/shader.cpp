@@ -7,6 +7,7 @@
 #include "common/bit_set.h"
 #include "common/logging/log.h"
 #include "common/microprofile.h"
+#include "core/settings.h"
 #include "video_core/pica_state.h"
 #include "video_core/regs_rasterizer.h"
 #include "video_core/regs_shader.h"
@@ -142,7 +143,7 @@ static InterpreterEngine interpreter_engine;
 ShaderEngine* GetEngine() {
 #ifdef ARCHITECTURE_x86_64
     // TODO(yuriks): Re-initialize on each change rather than being persistent
-    if (VideoCore::g_shader_jit_enabled) {
+    if (VideoCore::g_shader_jit_enabled && Settings::values.use_boot_cache) {
         if (jit_engine == nullptr) {
             jit_engine = std::make_unique<JitX64Engine>();
         }
@@ -153,6 +154,17 @@ ShaderEngine* GetEngine() {
     return &interpreter_engine;
 }
 
+void PreloadDiskCache() {
+#ifdef ARCHITECTURE_x86_64
+    if (VideoCore::g_shader_jit_enabled) {
+        if (jit_engine == nullptr) {
+            jit_engine = std::make_unique<JitX64Engine>();
+        }
+        jit_engine->PreloadDiskCache();
+    }
+#endif // ARCHITECTURE_x86_64
+}
+
 void Shutdown() {
 #ifdef ARCHITECTURE_x86_64
     jit_engine = nullptr;
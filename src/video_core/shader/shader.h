@@ -258,6 +258,8 @@ public:
 
 // TODO(yuriks): Remove and make it non-global state somewhere
 ShaderEngine* GetEngine();
+/// Starts reading the shader disk cache in the background, if it and the boot cache are enabled
+void PreloadDiskCache();
 void Shutdown();
 
 } // namespace Pica::Shader
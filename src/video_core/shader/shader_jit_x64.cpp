@@ -2,15 +2,109 @@
 // Licensed under GPLv2 or any later version
 // Refer to the license.txt file included.
 
+#include "common/file_util.h"
+#include "common/logging/log.h"
 #include "common/microprofile.h"
+#include "common/x64/cpu_detect.h"
+#include "core/settings.h"
 #include "video_core/shader/shader.h"
 #include "video_core/shader/shader_jit_x64.h"
 #include "video_core/shader/shader_jit_x64_compiler.h"
 
 namespace Pica::Shader {
 
+/// Version of the serialized JitShader layout, see JitShader::Serialize
+constexpr u32 DISK_CACHE_FORMAT_VERSION = 1;
+
+static u32 GetCPUFeatureMask() {
+    const auto& caps = Common::GetCPUCaps();
+    return (caps.sse4_1 ? 1 << 0 : 0) | (caps.sse4_2 ? 1 << 1 : 0) | (caps.avx ? 1 << 2 : 0) |
+           (caps.avx2 ? 1 << 3 : 0) | (caps.fma ? 1 << 4 : 0) | (caps.bmi1 ? 1 << 5 : 0) |
+           (caps.bmi2 ? 1 << 6 : 0) | (caps.lzcnt ? 1 << 7 : 0);
+}
+
+static std::string GetDiskCachePath() {
+    return FileUtil::GetUserPath(FileUtil::UserPath::CacheDir) + "shader" DIR_SEP "jit_x64.bin";
+}
+
+namespace {
+class DiskCacheReader final : public LinearDiskCacheReader<JitShaderDiskCacheKey, u8> {
+public:
+    explicit DiskCacheReader(std::unordered_map<u64, std::vector<u8>>& blobs) : blobs(blobs) {}
+
+    void Read(const JitShaderDiskCacheKey& key, const u8* value, u32 value_size) override {
+        if (key.format_version != DISK_CACHE_FORMAT_VERSION ||
+            key.cpu_features != GetCPUFeatureMask()) {
+            return;
+        }
+        blobs[key.program_code_hash ^ key.swizzle_data_hash].assign(value, value + value_size);
+    }
+
+private:
+    std::unordered_map<u64, std::vector<u8>>& blobs;
+};
+} // Anonymous namespace
+
 JitX64Engine::JitX64Engine() = default;
-JitX64Engine::~JitX64Engine() = default;
+
+JitX64Engine::~JitX64Engine() {
+    if (disk_cache_read.valid()) {
+        disk_cache_read.wait();
+    }
+    if (disk_cache_loaded) {
+        disk_cache.Close();
+        LOG_INFO(HW_GPU, "Shader JIT: compiled {} shaders, loaded {} from the disk cache",
+                 num_compiled, num_loaded_from_disk);
+    }
+}
+
+void JitX64Engine::PreloadDiskCache() {
+    if (!Settings::values.use_disk_shader_cache || disk_cache_loaded) {
+        return;
+    }
+    disk_cache_loaded = true;
+    disk_cache_read = std::async(std::launch::async, [this] { LoadDiskCache(); });
+}
+
+void JitX64Engine::LoadDiskCache() {
+    const std::string path = GetDiskCachePath();
+    if (!FileUtil::CreateFullPath(path)) {
+        LOG_ERROR(HW_GPU, "Failed to create shader disk cache directory for {}", path);
+        return;
+    }
+
+    DiskCacheReader reader(disk_blobs);
+    const u32 num_entries = disk_cache.OpenAndRead(path.c_str(), reader);
+    LOG_INFO(HW_GPU, "Loaded {} of {} shaders from disk cache {}", disk_blobs.size(), num_entries,
+             path);
+}
+
+std::unique_ptr<JitShader> JitX64Engine::LoadFromDiskCache(u64 cache_key) {
+    auto iter = disk_blobs.find(cache_key);
+    if (iter == disk_blobs.end()) {
+        return nullptr;
+    }
+
+    auto shader = std::make_unique<JitShader>();
+    const bool valid = shader->Deserialize(iter->second.data(), iter->second.size());
+    disk_blobs.erase(iter);
+    if (!valid) {
+        LOG_WARNING(HW_GPU, "Discarding malformed shader {:016X} from the disk cache", cache_key);
+        return nullptr;
+    }
+    return shader;
+}
+
+void JitX64Engine::SaveToDiskCache(const JitShader& shader, u64 code_hash, u64 swizzle_hash) {
+    const JitShaderDiskCacheKey key{code_hash, swizzle_hash, GetCPUFeatureMask(),
+                                    DISK_CACHE_FORMAT_VERSION};
+    const std::vector<u8> blob = shader.Serialize();
+    disk_cache.Append(key, blob.data(), static_cast<u32>(blob.size()));
+    disk_cache.Sync();
+}
+
+MICROPROFILE_DECLARE(GPU_Shader);
+MICROPROFILE_DEFINE(GPU_ShaderCompile, "GPU", "Shader Compile", MP_RGB(100, 100, 240));
 
 void JitX64Engine::SetupBatch(ShaderSetup& setup, unsigned int entry_point) {
     ASSERT(entry_point < MAX_PROGRAM_CODE_LENGTH);
@@ -23,15 +117,42 @@ void JitX64Engine::SetupBatch(ShaderSetup& setup, unsigned int entry_point) {
     auto iter = cache.find(cache_key);
     if (iter != cache.end()) {
         setup.engine_data.cached_shader = iter->second.get();
+        return;
+    }
+
+    MICROPROFILE_SCOPE(GPU_Shader);
+    MICROPROFILE_SCOPE(GPU_ShaderCompile);
+
+    const bool use_disk_cache = Settings::values.use_disk_shader_cache;
+    if (use_disk_cache && !disk_cache_loaded) {
+        disk_cache_loaded = true;
+        LoadDiskCache();
+    }
+    if (disk_cache_read.valid()) {
+        disk_cache_read.get();
+    }
+
+    std::unique_ptr<JitShader> shader;
+    if (use_disk_cache) {
+        shader = LoadFromDiskCache(cache_key);
+    }
+
+    if (shader) {
+        ++num_loaded_from_disk;
+        MICROPROFILE_META_CPU("Loaded from disk", 1);
     } else {
-        auto shader = std::make_unique<JitShader>();
+        shader = std::make_unique<JitShader>();
         shader->Compile(&setup.program_code, &setup.swizzle_data);
-        setup.engine_data.cached_shader = shader.get();
-        cache.emplace_hint(iter, cache_key, std::move(shader));
+        ++num_compiled;
+        MICROPROFILE_META_CPU("Compiled", 1);
+        if (use_disk_cache) {
+            SaveToDiskCache(*shader, code_hash, swizzle_hash);
+        }
     }
-}
 
-MICROPROFILE_DECLARE(GPU_Shader);
+    setup.engine_data.cached_shader = shader.get();
+    cache.emplace_hint(iter, cache_key, std::move(shader));
+}
 
 void JitX64Engine::Run(const ShaderSetup& setup, UnitState& state) const {
     ASSERT(setup.engine_data.cached_shader != nullptr);
@@ -4,15 +4,28 @@
 
 #pragma once
 
+#include <future>
 #include <memory>
 #include <unordered_map>
+#include <vector>
 #include "common/common_types.h"
+#include "common/linear_disk_cache.h"
 #include "video_core/shader/shader.h"
 
 namespace Pica::Shader {
 
 class JitShader;
 
+/// Key of a compiled shader stored in the on-disk shader cache
+struct JitShaderDiskCacheKey {
+    u64 program_code_hash;
+    u64 swizzle_data_hash;
+    /// Host CPU features the compiler selected code paths for
+    u32 cpu_features;
+    /// Version of the serialized format, bumped whenever the blob layout changes
+    u32 format_version;
+};
+
 class JitX64Engine final : public ShaderEngine {
 public:
     JitX64Engine();
@@ -21,8 +34,30 @@ public:
     void SetupBatch(ShaderSetup& setup, unsigned int entry_point) override;
     void Run(const ShaderSetup& setup, UnitState& state) const override;
 
+    /// Starts reading the disk cache on a worker thread, so the first shader miss finds it loaded
+    void PreloadDiskCache();
+
 private:
+    /// Reads all compiled shaders matching this host from the disk cache into `disk_blobs`
+    void LoadDiskCache();
+
+    /// Returns a shader from the disk cache, or nullptr if it is not present or unusable
+    std::unique_ptr<JitShader> LoadFromDiskCache(u64 cache_key);
+
+    /// Appends a freshly compiled shader to the disk cache
+    void SaveToDiskCache(const JitShader& shader, u64 code_hash, u64 swizzle_hash);
+
     std::unordered_map<u64, std::unique_ptr<JitShader>> cache;
+
+    bool disk_cache_loaded = false;
+    /// Pending read of the disk cache started by PreloadDiskCache
+    std::future<void> disk_cache_read;
+    LinearDiskCache<JitShaderDiskCacheKey, u8> disk_cache;
+    /// Serialized shaders read from the disk cache that have not been requested yet
+    std::unordered_map<u64, std::vector<u8>> disk_blobs;
+
+    u32 num_compiled = 0;
+    u32 num_loaded_from_disk = 0;
 };
 
 } // namespace Pica::Shader
@@ -5,6 +5,7 @@
 #include <algorithm>
 #include <cmath>
 #include <cstdint>
+#include <cstring>
 #include <nihstro/shader_bytecode.h>
 #include <smmintrin.h>
 #include <xmmintrin.h>
@@ -162,10 +163,36 @@ static void LogCritical(const char* msg) {
     LOG_CRITICAL(HW_GPU, "{}", msg);
 }
 
+static void Emit(GSEmitter* emitter, Common::Vec4<float24> (*output)[16]) {
+    emitter->Emit(*output);
+}
+
+/// Host functions called by the emitted code, indexed by JitShader::HostFunction
+static const std::array<const void*, JitShader::NumHostFunctions> host_functions = {{
+    reinterpret_cast<const void*>(&LogCritical),
+    reinterpret_cast<const void*>(&Emit),
+}};
+
+void JitShader::Compile_CallHostFunction(HostFunction function) {
+    call(qword[rip + host_function_slots[static_cast<std::size_t>(function)]]);
+}
+
+void JitShader::Compile_EmbedString(Reg64 dest, const char* str) {
+    Label string_data, skip;
+    jmp(skip, T_NEAR);
+    L(string_data);
+    for (const char* c = str; *c != '\0'; ++c) {
+        db(*c);
+    }
+    db(0);
+    L(skip);
+    lea(dest, ptr[rip + string_data]);
+}
+
 void JitShader::Compile_Assert(bool condition, const char* msg) {
     if (!condition) {
-        mov(ABI_PARAM1, reinterpret_cast<std::size_t>(msg));
-        CallFarFunction(*this, LogCritical);
+        Compile_EmbedString(ABI_PARAM1, msg);
+        Compile_CallHostFunction(HostFunction::LogCritical);
     }
 }
 
@@ -777,10 +804,6 @@ void JitShader::Compile_JMP(Instruction instr) {
     }
 }
 
-static void Emit(GSEmitter* emitter, Common::Vec4<float24> (*output)[16]) {
-    emitter->Emit(*output);
-}
-
 void JitShader::Compile_EMIT(Instruction instr) {
     Label have_emitter, end;
     mov(rax, qword[STATE + offsetof(UnitState, emitter_ptr)]);
@@ -788,8 +811,8 @@ void JitShader::Compile_EMIT(Instruction instr) {
     jnz(have_emitter);
 
     ABI_PushRegistersAndAdjustStack(*this, PersistentCallerSavedRegs(), 0);
-    mov(ABI_PARAM1, reinterpret_cast<std::size_t>("Execute EMIT on VS"));
-    CallFarFunction(*this, LogCritical);
+    Compile_EmbedString(ABI_PARAM1, "Execute EMIT on VS");
+    Compile_CallHostFunction(HostFunction::LogCritical);
     ABI_PopRegistersAndAdjustStack(*this, PersistentCallerSavedRegs(), 0);
     jmp(end);
 
@@ -798,7 +821,7 @@ void JitShader::Compile_EMIT(Instruction instr) {
     mov(ABI_PARAM1, rax);
     mov(ABI_PARAM2, STATE);
     add(ABI_PARAM2, static_cast<Xbyak::uint32>(offsetof(UnitState, registers.output)));
-    CallFarFunction(*this, Emit);
+    Compile_CallHostFunction(HostFunction::Emit);
     ABI_PopRegistersAndAdjustStack(*this, PersistentCallerSavedRegs(), 0);
     L(end);
 }
@@ -810,8 +833,8 @@ void JitShader::Compile_SETE(Instruction instr) {
     jnz(have_emitter);
 
     ABI_PushRegistersAndAdjustStack(*this, PersistentCallerSavedRegs(), 0);
-    mov(ABI_PARAM1, reinterpret_cast<std::size_t>("Execute SETEMIT on VS"));
-    CallFarFunction(*this, LogCritical);
+    Compile_EmbedString(ABI_PARAM1, "Execute SETEMIT on VS");
+    Compile_CallHostFunction(HostFunction::LogCritical);
     ABI_PopRegistersAndAdjustStack(*this, PersistentCallerSavedRegs(), 0);
     jmp(end);
 
@@ -890,7 +913,7 @@ void JitShader::Compile(const std::array<u32, MAX_PROGRAM_CODE_LENGTH>* program_
     swizzle_data = swizzle_data_;
 
     // Reset flow control state
-    program = (CompiledShader*)getCurr();
+    program_offset = static_cast<u32>(getSize());
     program_counter = 0;
     looping = false;
     instruction_labels.fill(Xbyak::Label());
@@ -920,14 +943,10 @@ void JitShader::Compile(const std::array<u32, MAX_PROGRAM_CODE_LENGTH>* program_
     mov(COND1, byte[STATE + offsetof(UnitState, conditional_code[1])]);
 
     // Used to set a register to one
-    static const __m128 one = {1.f, 1.f, 1.f, 1.f};
-    mov(rax, reinterpret_cast<std::size_t>(&one));
-    movaps(ONE, xword[rax]);
+    movaps(ONE, xword[rip + one_vector]);
 
     // Used to negate registers
-    static const __m128 neg = {-0.f, -0.f, -0.f, -0.f};
-    mov(rax, reinterpret_cast<std::size_t>(&neg));
-    movaps(NEGBIT, xword[rax]);
+    movaps(NEGBIT, xword[rip + negbit_vector]);
 
     // Jump to start of the shader program
     jmp(ABI_PARAM3);
@@ -943,15 +962,109 @@ void JitShader::Compile(const std::array<u32, MAX_PROGRAM_CODE_LENGTH>* program_
 
     ready();
 
+    for (std::size_t i = 0; i < instruction_labels.size(); ++i) {
+        instruction_offsets[i] = static_cast<u32>(instruction_labels[i].getAddress() - getCode());
+    }
+    program = reinterpret_cast<CompiledShader*>(getCode() + program_offset);
+
     ASSERT_MSG(getSize() <= MAX_SHADER_SIZE, "Compiled a shader that exceeds the allocated size!");
     LOG_DEBUG(HW_GPU, "Compiled shader size={}", getSize());
 }
 
+/// Layout of a serialized shader, followed by the instruction offsets and then the code itself
+struct SerializedShaderHeader {
+    u32 code_size;
+    u32 program_offset;
+    u32 host_function_table_offset;
+    u32 num_host_functions;
+};
+
+std::vector<u8> JitShader::Serialize() const {
+    const SerializedShaderHeader header{static_cast<u32>(getSize()), program_offset,
+                                        host_function_table_offset,
+                                        static_cast<u32>(NumHostFunctions)};
+
+    std::vector<u8> blob(sizeof(header) + sizeof(instruction_offsets) + getSize());
+    u8* out = blob.data();
+    std::memcpy(out, &header, sizeof(header));
+    out += sizeof(header);
+    std::memcpy(out, instruction_offsets.data(), sizeof(instruction_offsets));
+    out += sizeof(instruction_offsets);
+    std::memcpy(out, getCode(), getSize());
+
+    // Host function pointers are only meaningful in this process, they are patched back in by
+    // Deserialize.
+    std::memset(out + host_function_table_offset, 0, NumHostFunctions * sizeof(u64));
+    return blob;
+}
+
+bool JitShader::Deserialize(const u8* data, std::size_t size) {
+    SerializedShaderHeader header;
+    if (size < sizeof(header)) {
+        return false;
+    }
+    std::memcpy(&header, data, sizeof(header));
+
+    const std::size_t table_size = NumHostFunctions * sizeof(u64);
+    if (header.num_host_functions != NumHostFunctions || header.code_size > MAX_SHADER_SIZE ||
+        size != sizeof(header) + sizeof(instruction_offsets) + header.code_size ||
+        header.program_offset >= header.code_size ||
+        header.host_function_table_offset + table_size > header.code_size) {
+        return false;
+    }
+
+    std::memcpy(instruction_offsets.data(), data + sizeof(header), sizeof(instruction_offsets));
+    if (std::any_of(instruction_offsets.begin(), instruction_offsets.end(),
+                    [&header](u32 offset) { return offset >= header.code_size; })) {
+        return false;
+    }
+
+    // Re-emit the code into a fresh buffer, relocating the host function table on the way
+    const u8* code = data + sizeof(header) + sizeof(instruction_offsets);
+    reset();
+    std::size_t offset = 0;
+    while (offset < header.code_size) {
+        if (offset == header.host_function_table_offset) {
+            for (const void* function : host_functions) {
+                dq(reinterpret_cast<std::uintptr_t>(function));
+            }
+            offset += table_size;
+        } else {
+            db(code[offset++]);
+        }
+    }
+    ready();
+
+    program_offset = header.program_offset;
+    host_function_table_offset = header.host_function_table_offset;
+    program = reinterpret_cast<CompiledShader*>(getCode() + program_offset);
+    return true;
+}
+
 JitShader::JitShader() : Xbyak::CodeGenerator(MAX_SHADER_SIZE) {
     CompilePrelude();
 }
 
 void JitShader::CompilePrelude() {
+    // Table of host function pointers, called indirectly so that no host address is ever encoded
+    // in the instruction stream and the code can be relocated when loaded from the disk cache
+    align(8);
+    host_function_table_offset = static_cast<u32>(getSize());
+    for (std::size_t i = 0; i < NumHostFunctions; ++i) {
+        L(host_function_slots[i]);
+        dq(reinterpret_cast<std::uintptr_t>(host_functions[i]));
+    }
+
+    align(16);
+    L(one_vector);
+    for (int i = 0; i < 4; ++i) {
+        dd(0x3f800000); // 1.0f
+    }
+    L(negbit_vector);
+    for (int i = 0; i < 4; ++i) {
+        dd(0x80000000); // -0.0f
+    }
+
     log2_subroutine = CompilePrelude_Log2();
     exp2_subroutine = CompilePrelude_Exp2();
 }
@@ -32,13 +32,32 @@ class JitShader : public Xbyak::CodeGenerator {
 public:
     JitShader();
 
+    /// Host functions the emitted code may call into
+    enum class HostFunction {
+        LogCritical,
+        Emit,
+    };
+    static constexpr std::size_t NumHostFunctions = 2;
+
     void Run(const ShaderSetup& setup, UnitState& state, unsigned offset) const {
-        program(&setup.uniforms, &state, instruction_labels[offset].getAddress());
+        program(&setup.uniforms, &state, getCode() + instruction_offsets[offset]);
     }
 
     void Compile(const std::array<u32, MAX_PROGRAM_CODE_LENGTH>* program_code,
                  const std::array<u32, MAX_SWIZZLE_DATA_LENGTH>* swizzle_data);
 
+    /**
+     * Serializes the compiled code together with the metadata needed to relocate it, for storage
+     * in the shader disk cache.
+     */
+    std::vector<u8> Serialize() const;
+
+    /**
+     * Replaces the contents of this shader with code previously produced by Serialize.
+     * @returns false if the data is malformed, in which case the shader must be discarded
+     */
+    bool Deserialize(const u8* data, std::size_t size);
+
     void Compile_ADD(Instruction instr);
     void Compile_DP3(Instruction instr);
     void Compile_DP4(Instruction instr);
@@ -93,6 +112,15 @@ private:
 
     BitSet32 PersistentCallerSavedRegs();
 
+    /// Emits an indirect call through the host function table built by the prelude.
+    void Compile_CallHostFunction(HostFunction function);
+
+    /**
+     * Emits a null-terminated copy of `str` into the code buffer and loads its address into
+     * `dest`, so that the code does not reference host memory outside of its own buffer.
+     */
+    void Compile_EmbedString(Xbyak::Reg64 dest, const char* str);
+
     /**
      * Assertion evaluated at compile-time, but only triggered if executed at runtime.
      * @param condition Condition to be evaluated.
@@ -119,6 +147,9 @@ private:
     /// Mapping of Pica VS instructions to pointers in the emitted code
     std::array<Xbyak::Label, MAX_PROGRAM_CODE_LENGTH> instruction_labels;
 
+    /// Offsets of each Pica VS instruction from the start of the code buffer
+    std::array<u32, MAX_PROGRAM_CODE_LENGTH> instruction_offsets{};
+
     /// Label pointing to the end of the current LOOP block. Used by the BREAKC instruction to break
     /// out of the loop.
     std::optional<Xbyak::Label> loop_break_label;
@@ -131,7 +162,14 @@ private:
 
     using CompiledShader = void(const void* setup, void* state, const u8* start_addr);
     CompiledShader* program = nullptr;
+    u32 program_offset = 0; ///< Offset of `program` from the start of the code buffer
+
+    /// Offset of the host function table from the start of the code buffer
+    u32 host_function_table_offset = 0;
+    std::array<Xbyak::Label, NumHostFunctions> host_function_slots;
 
+    Xbyak::Label one_vector;
+    Xbyak::Label negbit_vector;
     Xbyak::Label log2_subroutine;
     Xbyak::Label exp2_subroutine;
 };
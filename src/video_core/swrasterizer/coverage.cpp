@@ -0,0 +1,144 @@
+// Copyright 2020 Citra Emulator Project
+// Licensed under GPLv2 or any later version
+// Refer to the license.txt file included.
+
+#include <algorithm>
+#include "video_core/swrasterizer/coverage.h"
+
+namespace Pica::Rasterizer {
+
+int SignedArea(const Common::Vec2<Fix12P4>& vtx1, const Common::Vec2<Fix12P4>& vtx2,
+               const Common::Vec2<Fix12P4>& vtx3) {
+    const auto vec1 = Common::MakeVec(vtx2 - vtx1, 0);
+    const auto vec2 = Common::MakeVec(vtx3 - vtx1, 0);
+    // TODO: There is a very small chance this will overflow for sizeof(int) == 4
+    return Common::Cross(vec1, vec2).z;
+}
+
+/// Returns the coverage bits of a width * height rectangle of pixels at (x, y) within a block
+static u64 BlockCoverageMask(int x, int y, int width, int height) {
+    const u64 row = ((u64{1} << width) - 1) << x;
+    u64 mask = 0;
+    for (int j = y; j < y + height; ++j) {
+        mask |= row << (j * BLOCK_SIZE);
+    }
+    return mask;
+}
+
+// Triangle filling rules: Pixels on the right-sided edge or on flat bottom edges are not
+// drawn. Pixels on any other triangle border are drawn. This is implemented with three bias
+// values which are added to the barycentric coordinates w0, w1 and w2, respectively.
+// NOTE: These are the PSP filling rules. Not sure if the 3DS uses the same ones...
+static bool IsRightSideOrFlatBottomEdge(const Common::Vec2<Fix12P4>& vtx,
+                                        const Common::Vec2<Fix12P4>& line1,
+                                        const Common::Vec2<Fix12P4>& line2) {
+    if (line1.y == line2.y) {
+        // just check if vertex is above us => bottom line parallel to x-axis
+        return vtx.y < line1.y;
+    } else {
+        // check if vertex is on our left => right side
+        // TODO: Not sure how likely this is to overflow
+        return (int)vtx.x < (int)line1.x + ((int)line2.x - (int)line1.x) *
+                                               ((int)vtx.y - (int)line1.y) /
+                                               ((int)line2.y - (int)line1.y);
+    }
+}
+
+TriangleCoverage::TriangleCoverage(const std::array<Common::Vec2<Fix12P4>, 3>& vtxpos,
+                                   bool scissor_exclude, u16 scissor_x1, u16 scissor_y1,
+                                   u16 scissor_x2, u16 scissor_y2)
+    : scissor_exclude(scissor_exclude), scissor_x1(scissor_x1), scissor_y1(scissor_y1),
+      scissor_x2(scissor_x2), scissor_y2(scissor_y2) {
+    for (std::size_t i = 0; i < edges.size(); ++i) {
+        const auto& vtx = vtxpos[i];
+        const auto& line1 = vtxpos[(i + 1) % 3];
+        const auto& line2 = vtxpos[(i + 2) % 3];
+        edges[i] = {line1, line2, IsRightSideOrFlatBottomEdge(vtx, line1, line2) ? -1 : 0};
+    }
+}
+
+std::array<int, 3> TriangleCoverage::GetWeights(u16 x, u16 y) const {
+    std::array<int, 3> weights;
+    for (std::size_t i = 0; i < edges.size(); ++i) {
+        weights[i] = edges[i].bias + SignedArea(edges[i].line1, edges[i].line2, {x, y});
+    }
+    return weights;
+}
+
+bool TriangleCoverage::IsScissored(u16 x, u16 y) const {
+    // Pixels inside the scissor box are not processed if the scissor mode is set to Exclude
+    return scissor_exclude && x >= scissor_x1 && x < scissor_x2 && y >= scissor_y1 &&
+           y < scissor_y2;
+}
+
+// Coverage of the rectangle of pixel centers from (x1, y1) to (x2, y2) inclusive. The edge
+// functions are linear, so their extremes over the rectangle are found at its corners.
+TriangleCoverage::Coverage TriangleCoverage::GetCoverage(u16 x1, u16 y1, u16 x2, u16 y2) const {
+    const std::array<Common::Vec2<Fix12P4>, 4> corners{{{x1, y1}, {x2, y1}, {x1, y2}, {x2, y2}}};
+    Coverage coverage = Coverage::Full;
+    for (const auto& [line1, line2, bias] : edges) {
+        int min_w = bias + SignedArea(line1, line2, corners[0]);
+        int max_w = min_w;
+        for (std::size_t i = 1; i < corners.size(); ++i) {
+            const int w = bias + SignedArea(line1, line2, corners[i]);
+            min_w = std::min(min_w, w);
+            max_w = std::max(max_w, w);
+        }
+        if (max_w < 0)
+            return Coverage::None;
+        if (min_w < 0)
+            coverage = Coverage::Partial;
+    }
+
+    if (scissor_exclude) {
+        if (x1 >= scissor_x1 && x2 < scissor_x2 && y1 >= scissor_y1 && y2 < scissor_y2)
+            return Coverage::None;
+        if (x2 >= scissor_x1 && x1 < scissor_x2 && y2 >= scissor_y1 && y1 < scissor_y2)
+            coverage = Coverage::Partial;
+    }
+    return coverage;
+}
+
+// Blocks that are only partially covered are narrowed down in 2x2 quads before single pixels
+// are tested.
+BitSet64 TriangleCoverage::GetBlockCoverage(u16 block_x, u16 block_y, int width,
+                                            int height) const {
+    const u16 last_x = block_x + (width - 1) * 0x10;
+    const u16 last_y = block_y + (height - 1) * 0x10;
+    switch (GetCoverage(block_x, block_y, last_x, last_y)) {
+    case Coverage::None:
+        return BitSet64();
+    case Coverage::Full:
+        return BitSet64(BlockCoverageMask(0, 0, width, height));
+    case Coverage::Partial:
+        break;
+    }
+
+    u64 mask = 0;
+    for (int quad_y = 0; quad_y < height; quad_y += 2) {
+        for (int quad_x = 0; quad_x < width; quad_x += 2) {
+            const int quad_width = std::min(2, width - quad_x);
+            const int quad_height = std::min(2, height - quad_y);
+            const u16 x1 = block_x + quad_x * 0x10;
+            const u16 y1 = block_y + quad_y * 0x10;
+            const u16 x2 = x1 + (quad_width - 1) * 0x10;
+            const u16 y2 = y1 + (quad_height - 1) * 0x10;
+            const Coverage quad_coverage = GetCoverage(x1, y1, x2, y2);
+            if (quad_coverage == Coverage::Full) {
+                mask |= BlockCoverageMask(quad_x, quad_y, quad_width, quad_height);
+            } else if (quad_coverage == Coverage::Partial) {
+                for (int j = 0; j < quad_height; ++j) {
+                    for (int i = 0; i < quad_width; ++i) {
+                        const u16 x = x1 + i * 0x10;
+                        const u16 y = y1 + j * 0x10;
+                        if (GetCoverage(x, y, x, y) == Coverage::Full)
+                            mask |= BlockCoverageMask(quad_x + i, quad_y + j, 1, 1);
+                    }
+                }
+            }
+        }
+    }
+    return BitSet64(mask);
+}
+
+} // namespace Pica::Rasterizer
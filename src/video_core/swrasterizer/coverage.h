@@ -0,0 +1,99 @@
+// Copyright 2020 Citra Emulator Project
+// Licensed under GPLv2 or any later version
+// Refer to the license.txt file included.
+
+#pragma once
+
+#include <array>
+#include "common/bit_set.h"
+#include "common/common_types.h"
+#include "common/vector_math.h"
+
+namespace Pica::Rasterizer {
+
+// NOTE: Assuming that rasterizer coordinates are 12.4 fixed-point values
+struct Fix12P4 {
+    Fix12P4() {}
+    Fix12P4(u16 val) : val(val) {}
+
+    static u16 FracMask() {
+        return 0xF;
+    }
+    static u16 IntMask() {
+        return (u16)~0xF;
+    }
+
+    operator u16() const {
+        return val;
+    }
+
+    bool operator<(const Fix12P4& oth) const {
+        return (u16) * this < (u16)oth;
+    }
+
+private:
+    u16 val;
+};
+
+/**
+ * Calculate signed area of the triangle spanned by the three argument vertices.
+ * The sign denotes an orientation.
+ *
+ * @todo define orientation concretely.
+ */
+int SignedArea(const Common::Vec2<Fix12P4>& vtx1, const Common::Vec2<Fix12P4>& vtx2,
+               const Common::Vec2<Fix12P4>& vtx3);
+
+/// Width and height in pixels of the blocks the rasterization loop traverses
+constexpr int BLOCK_SIZE = 8;
+static_assert(BLOCK_SIZE * BLOCK_SIZE <= 64, "Block coverage must fit into a BitSet64");
+
+/// Decides which pixel centers of the render target a counter-clockwise wound triangle covers
+class TriangleCoverage {
+public:
+    /**
+     * @param vtxpos Triangle vertices in rasterizer coordinates
+     * @param scissor_exclude Whether the pixels inside the scissor box are dropped
+     * @param scissor_x1, scissor_y1 Top left corner of the scissor box, inclusive
+     * @param scissor_x2, scissor_y2 Bottom right corner of the scissor box, exclusive
+     */
+    TriangleCoverage(const std::array<Common::Vec2<Fix12P4>, 3>& vtxpos, bool scissor_exclude,
+                     u16 scissor_x1, u16 scissor_y1, u16 scissor_x2, u16 scissor_y2);
+
+    /**
+     * Returns the barycentric coordinates w0, w1 and w2 of a pixel center, biased by the triangle
+     * filling rules. The pixel lies inside the triangle if none of them is negative.
+     */
+    std::array<int, 3> GetWeights(u16 x, u16 y) const;
+
+    /// Returns whether the scissor test drops a pixel center
+    bool IsScissored(u16 x, u16 y) const;
+
+    /**
+     * Returns the pixels of the width * height block at (block_x, block_y) the triangle covers.
+     * Bit (i + j * BLOCK_SIZE) is set if the pixel center i pixels right and j pixels below the
+     * block origin is both inside the triangle and not dropped by the scissor test.
+     */
+    BitSet64 GetBlockCoverage(u16 block_x, u16 block_y, int width, int height) const;
+
+private:
+    /// How much of a rectangle of pixel centers a triangle covers
+    enum class Coverage { None, Partial, Full };
+
+    Coverage GetCoverage(u16 x1, u16 y1, u16 x2, u16 y2) const;
+
+    struct Edge {
+        Common::Vec2<Fix12P4> line1;
+        Common::Vec2<Fix12P4> line2;
+        int bias;
+    };
+    std::array<Edge, 3> edges;
+
+    bool scissor_exclude;
+    u16 scissor_x1;
+    u16 scissor_y1;
+    u16 scissor_x2;
+    u16 scissor_y2;
+};
+
+} // namespace Pica::Rasterizer
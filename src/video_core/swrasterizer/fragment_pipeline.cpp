@@ -0,0 +1,298 @@
+// Copyright 2020 Citra Emulator Project
+// Licensed under GPLv2 or any later version
+// Refer to the license.txt file included.
+
+#include <algorithm>
+#include "common/assert.h"
+#include "common/logging/log.h"
+#include "common/microprofile.h"
+#include "video_core/swrasterizer/fragment_pipeline.h"
+
+namespace Pica::Rasterizer {
+
+using TevStageConfig = TexturingRegs::TevStageConfig;
+
+FragmentConfig FragmentConfig::BuildFromRegs(const Regs& regs) {
+    FragmentConfig res;
+    auto& state = res.state;
+
+    const auto& tev_stages = regs.texturing.GetTevStages();
+    for (std::size_t i = 0; i < tev_stages.size(); i++) {
+        const auto& tev_stage = tev_stages[i];
+        state.tev_stages[i].sources_raw = tev_stage.sources_raw;
+        state.tev_stages[i].modifiers_raw = tev_stage.modifiers_raw;
+        state.tev_stages[i].ops_raw = tev_stage.ops_raw;
+        state.tev_stages[i].scales_raw = tev_stage.scales_raw;
+    }
+    state.combiner_buffer_input = regs.texturing.tev_combiner_buffer_input.update_mask_rgb.Value() |
+                                  regs.texturing.tev_combiner_buffer_input.update_mask_a.Value()
+                                      << 4;
+
+    state.fog_mode = regs.texturing.fog_mode;
+    state.fog_flip = regs.texturing.fog_flip != 0;
+
+    const auto& output_merger = regs.framebuffer.output_merger;
+    state.fragment_operation_mode = output_merger.fragment_operation_mode;
+    state.alpha_test_enable = output_merger.alpha_test.enable != 0;
+    state.alpha_test_func = output_merger.alpha_test.func;
+    state.stencil_action_enable =
+        output_merger.stencil_test.enable &&
+        regs.framebuffer.framebuffer.depth_format == FramebufferRegs::DepthFormat::D24S8;
+    state.stencil_test_func = output_merger.stencil_test.func;
+    state.depth_test_enable = output_merger.depth_test_enable != 0;
+    state.depth_test_func = output_merger.depth_test_func;
+
+    state.alphablend_enable = output_merger.alphablend_enable != 0;
+    state.blend_equation_rgb = output_merger.alpha_blending.blend_equation_rgb;
+    state.blend_equation_a = output_merger.alpha_blending.blend_equation_a;
+    state.factor_source_rgb = output_merger.alpha_blending.factor_source_rgb;
+    state.factor_dest_rgb = output_merger.alpha_blending.factor_dest_rgb;
+    state.factor_source_a = output_merger.alpha_blending.factor_source_a;
+    state.factor_dest_a = output_merger.alpha_blending.factor_dest_a;
+    state.logic_op = output_merger.logic_op;
+
+    return res;
+}
+
+FragmentUniforms FragmentUniforms::FromRegs(const Regs& regs) {
+    FragmentUniforms uniforms;
+
+    const auto& tev_stages = regs.texturing.GetTevStages();
+    for (std::size_t i = 0; i < tev_stages.size(); i++) {
+        const auto& tev_stage = tev_stages[i];
+        uniforms.tev_constants[i] =
+            Common::MakeVec(tev_stage.const_r.Value(), tev_stage.const_g.Value(),
+                            tev_stage.const_b.Value(), tev_stage.const_a.Value())
+                .Cast<u8>();
+    }
+
+    const auto& buffer_color = regs.texturing.tev_combiner_buffer_color;
+    uniforms.tev_combiner_buffer_color =
+        Common::MakeVec(buffer_color.r.Value(), buffer_color.g.Value(), buffer_color.b.Value(),
+                        buffer_color.a.Value())
+            .Cast<u8>();
+
+    const auto& fog_color = regs.texturing.fog_color;
+    uniforms.fog_color =
+        Common::MakeVec(fog_color.r.Value(), fog_color.g.Value(), fog_color.b.Value()).Cast<u8>();
+
+    const auto& output_merger = regs.framebuffer.output_merger;
+    uniforms.alpha_test_ref = static_cast<u8>(output_merger.alpha_test.ref);
+    uniforms.blend_const =
+        Common::MakeVec(output_merger.blend_const.r.Value(), output_merger.blend_const.g.Value(),
+                        output_merger.blend_const.b.Value(), output_merger.blend_const.a.Value())
+            .Cast<u8>();
+
+    return uniforms;
+}
+
+static FragmentPipeline::Input GetTevInput(TevStageConfig::Source source) {
+    using Source = TevStageConfig::Source;
+    using Input = FragmentPipeline::Input;
+
+    switch (source) {
+    case Source::PrimaryColor:
+        return Input::PrimaryColor;
+    case Source::PrimaryFragmentColor:
+        return Input::PrimaryFragmentColor;
+    case Source::SecondaryFragmentColor:
+        return Input::SecondaryFragmentColor;
+    case Source::Texture0:
+        return Input::Texture0;
+    case Source::Texture1:
+        return Input::Texture1;
+    case Source::Texture2:
+        return Input::Texture2;
+    case Source::Texture3:
+        return Input::Texture3;
+    case Source::PreviousBuffer:
+        return Input::PreviousBuffer;
+    case Source::Constant:
+        return Input::Constant;
+    case Source::Previous:
+        return Input::Previous;
+    default:
+        LOG_ERROR(HW_GPU, "Unknown color combiner source {}", static_cast<u32>(source));
+        UNIMPLEMENTED();
+        return Input::Zero;
+    }
+}
+
+static bool IsPassThroughTevStage(const TevStageConfig& stage) {
+    return (stage.color_op == TevStageConfig::Operation::Replace &&
+            stage.alpha_op == TevStageConfig::Operation::Replace &&
+            stage.color_source1 == TevStageConfig::Source::Previous &&
+            stage.alpha_source1 == TevStageConfig::Source::Previous &&
+            stage.color_modifier1 == TevStageConfig::ColorModifier::SourceColor &&
+            stage.alpha_modifier1 == TevStageConfig::AlphaModifier::SourceAlpha &&
+            stage.GetColorMultiplier() == 1 && stage.GetAlphaMultiplier() == 1);
+}
+
+FragmentPipeline::FragmentPipeline(const FragmentConfig& config) : config(config) {
+    const auto& state = config.state;
+
+    for (unsigned i = 0; i < tev_stages.size(); ++i) {
+        TevStageConfig stage_config;
+        stage_config.sources_raw = state.tev_stages[i].sources_raw;
+        stage_config.modifiers_raw = state.tev_stages[i].modifiers_raw;
+        stage_config.ops_raw = state.tev_stages[i].ops_raw;
+        stage_config.const_color = 0;
+        stage_config.scales_raw = state.tev_stages[i].scales_raw;
+
+        auto& stage = tev_stages[i];
+        stage.pass_through = IsPassThroughTevStage(stage_config);
+        stage.color_inputs = {GetTevInput(stage_config.color_source1),
+                              GetTevInput(stage_config.color_source2),
+                              GetTevInput(stage_config.color_source3)};
+        stage.alpha_inputs = {GetTevInput(stage_config.alpha_source1),
+                              GetTevInput(stage_config.alpha_source2),
+                              GetTevInput(stage_config.alpha_source3)};
+        stage.color_modifiers = {GetColorModifierFunc(stage_config.color_modifier1),
+                                 GetColorModifierFunc(stage_config.color_modifier2),
+                                 GetColorModifierFunc(stage_config.color_modifier3)};
+        stage.alpha_modifiers = {GetAlphaModifierFunc(stage_config.alpha_modifier1),
+                                 GetAlphaModifierFunc(stage_config.alpha_modifier2),
+                                 GetAlphaModifierFunc(stage_config.alpha_modifier3)};
+        stage.color_combine = GetColorCombineFunc(stage_config.color_op);
+        stage.alpha_combine =
+            stage_config.color_op == TevStageConfig::Operation::Dot3_RGBA
+                ? nullptr
+                : GetAlphaCombineFunc(stage_config.alpha_op);
+        stage.color_multiplier = stage_config.GetColorMultiplier();
+        stage.alpha_multiplier = stage_config.GetAlphaMultiplier();
+        stage.updates_buffer_color = config.TevStageUpdatesCombinerBufferColor(i);
+        stage.updates_buffer_alpha = config.TevStageUpdatesCombinerBufferAlpha(i);
+    }
+
+    alpha_test = GetCompareTestFunc(state.alpha_test_func);
+    stencil_test = GetCompareTestFunc(state.stencil_test_func);
+    depth_test = GetCompareTestFunc(state.depth_test_func);
+
+    source_rgb_factor = GetBlendFactorFunc(state.factor_source_rgb);
+    dest_rgb_factor = GetBlendFactorFunc(state.factor_dest_rgb);
+    source_a_factor = GetBlendFactorFunc(state.factor_source_a);
+    dest_a_factor = GetBlendFactorFunc(state.factor_dest_a);
+    blend_equation_rgb = GetBlendEquationFunc(state.blend_equation_rgb);
+    blend_equation_a = GetBlendEquationFunc(state.blend_equation_a);
+    logic_op = GetLogicOpFunc(state.logic_op);
+}
+
+Common::Vec4<u8> FragmentPipeline::CombineTev(TevInputs& inputs,
+                                              const FragmentUniforms& uniforms) const {
+    // Texture environment - consists of 6 stages of color and alpha combining.
+    //
+    // Color combiners take three input color values from some source (e.g. interpolated
+    // vertex color, texture color, previous stage, etc), perform some very simple
+    // operations on each of them (e.g. inversion) and then calculate the output color
+    // with some basic arithmetic. Alpha combiners can be configured separately but work
+    // analogously.
+    auto& combiner_output = inputs[Previous];
+    auto& combiner_buffer = inputs[PreviousBuffer];
+    combiner_output = {0, 0, 0, 0};
+    combiner_buffer = {0, 0, 0, 0};
+    inputs[Zero] = {0, 0, 0, 0};
+    Common::Vec4<u8> next_combiner_buffer = uniforms.tev_combiner_buffer_color;
+
+    for (unsigned tev_stage_index = 0; tev_stage_index < tev_stages.size(); ++tev_stage_index) {
+        const auto& stage = tev_stages[tev_stage_index];
+
+        if (!stage.pass_through) {
+            inputs[Constant] = uniforms.tev_constants[tev_stage_index];
+
+            // color combiner
+            // NOTE: Not sure if the alpha combiner might use the color output of the previous
+            //       stage as input. Hence, we currently don't directly write the result to
+            //       combiner_output.rgb(), but instead store it in a temporary variable until
+            //       alpha combining has been done.
+            const Common::Vec3<u8> color_result[3] = {
+                stage.color_modifiers[0](inputs[stage.color_inputs[0]]),
+                stage.color_modifiers[1](inputs[stage.color_inputs[1]]),
+                stage.color_modifiers[2](inputs[stage.color_inputs[2]]),
+            };
+            const auto color_output = stage.color_combine(color_result);
+
+            u8 alpha_output;
+            if (!stage.alpha_combine) {
+                // result of Dot3_RGBA operation is also placed to the alpha component
+                alpha_output = color_output.x;
+            } else {
+                // alpha combiner
+                const std::array<u8, 3> alpha_result = {{
+                    stage.alpha_modifiers[0](inputs[stage.alpha_inputs[0]]),
+                    stage.alpha_modifiers[1](inputs[stage.alpha_inputs[1]]),
+                    stage.alpha_modifiers[2](inputs[stage.alpha_inputs[2]]),
+                }};
+                alpha_output = stage.alpha_combine(alpha_result);
+            }
+
+            combiner_output[0] =
+                std::min((unsigned)255, color_output.r() * stage.color_multiplier);
+            combiner_output[1] =
+                std::min((unsigned)255, color_output.g() * stage.color_multiplier);
+            combiner_output[2] =
+                std::min((unsigned)255, color_output.b() * stage.color_multiplier);
+            combiner_output[3] = std::min((unsigned)255, alpha_output * stage.alpha_multiplier);
+        }
+
+        combiner_buffer = next_combiner_buffer;
+
+        if (stage.updates_buffer_color) {
+            next_combiner_buffer.r() = combiner_output.r();
+            next_combiner_buffer.g() = combiner_output.g();
+            next_combiner_buffer.b() = combiner_output.b();
+        }
+
+        if (stage.updates_buffer_alpha) {
+            next_combiner_buffer.a() = combiner_output.a();
+        }
+    }
+
+    return combiner_output;
+}
+
+Common::Vec4<u8> FragmentPipeline::Blend(const Common::Vec4<u8>& src,
+                                         const Common::Vec4<u8>& dest,
+                                         const FragmentUniforms& uniforms) const {
+    if (!config.state.alphablend_enable) {
+        return Common::MakeVec(logic_op(src.r(), dest.r()), logic_op(src.g(), dest.g()),
+                               logic_op(src.b(), dest.b()), logic_op(src.a(), dest.a()));
+    }
+
+    const auto& blend_const = uniforms.blend_const;
+    const auto srcfactor = Common::MakeVec(source_rgb_factor(0, src, dest, blend_const),
+                                           source_rgb_factor(1, src, dest, blend_const),
+                                           source_rgb_factor(2, src, dest, blend_const),
+                                           source_a_factor(3, src, dest, blend_const));
+    const auto dstfactor = Common::MakeVec(dest_rgb_factor(0, src, dest, blend_const),
+                                           dest_rgb_factor(1, src, dest, blend_const),
+                                           dest_rgb_factor(2, src, dest, blend_const),
+                                           dest_a_factor(3, src, dest, blend_const));
+
+    auto blend_output = blend_equation_rgb(src, srcfactor, dest, dstfactor);
+    blend_output.a() = blend_equation_a(src, srcfactor, dest, dstfactor).a();
+    return blend_output;
+}
+
+FragmentPipelineCache::FragmentPipelineCache() = default;
+
+FragmentPipelineCache::~FragmentPipelineCache() = default;
+
+MICROPROFILE_DEFINE(GPU_FragmentPipeline, "GPU", "Build Fragment Pipeline", MP_RGB(100, 100, 255));
+
+const FragmentPipeline& FragmentPipelineCache::Get(const Regs& regs) {
+    const auto config = FragmentConfig::BuildFromRegs(regs);
+    // Consecutive triangles almost always share their configuration
+    if (last_used && last_used->GetConfig() == config) {
+        return *last_used;
+    }
+
+    auto& pipeline = pipelines[config];
+    if (!pipeline) {
+        MICROPROFILE_SCOPE(GPU_FragmentPipeline);
+        pipeline = std::make_unique<FragmentPipeline>(config);
+    }
+    last_used = pipeline.get();
+    return *pipeline;
+}
+
+} // namespace Pica::Rasterizer
@@ -0,0 +1,207 @@
+// Copyright 2020 Citra Emulator Project
+// Licensed under GPLv2 or any later version
+// Refer to the license.txt file included.
+
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <memory>
+#include <unordered_map>
+#include <utility>
+#include "common/common_types.h"
+#include "common/hash.h"
+#include "common/vector_math.h"
+#include "video_core/regs.h"
+#include "video_core/swrasterizer/framebuffer.h"
+#include "video_core/swrasterizer/texturing.h"
+
+namespace Pica::Rasterizer {
+
+template <typename Specialization, u32... raw>
+constexpr auto MakeSpecializationTable(std::integer_sequence<u32, raw...>) {
+    return std::array{&Specialization::template Func<raw>...};
+}
+
+/**
+ * Builds a table holding Specialization::Func<raw> for every value of a register field that is
+ * num_values wide, so the function specialized for a field value is found with one lookup.
+ */
+template <typename Specialization, u32 num_values>
+constexpr auto MakeSpecializationTable() {
+    return MakeSpecializationTable<Specialization>(std::make_integer_sequence<u32, num_values>{});
+}
+
+struct FragmentConfigState {
+    struct TevStageConfigRaw {
+        u32 sources_raw;
+        u32 modifiers_raw;
+        u32 ops_raw;
+        u32 scales_raw;
+    };
+    std::array<TevStageConfigRaw, 6> tev_stages;
+    u8 combiner_buffer_input;
+
+    TexturingRegs::FogMode fog_mode;
+    bool fog_flip;
+
+    FramebufferRegs::FragmentOperationMode fragment_operation_mode;
+    bool alpha_test_enable;
+    FramebufferRegs::CompareFunc alpha_test_func;
+    bool stencil_action_enable;
+    FramebufferRegs::CompareFunc stencil_test_func;
+    bool depth_test_enable;
+    FramebufferRegs::CompareFunc depth_test_func;
+
+    bool alphablend_enable;
+    FramebufferRegs::BlendEquation blend_equation_rgb;
+    FramebufferRegs::BlendEquation blend_equation_a;
+    FramebufferRegs::BlendFactor factor_source_rgb;
+    FramebufferRegs::BlendFactor factor_dest_rgb;
+    FramebufferRegs::BlendFactor factor_source_a;
+    FramebufferRegs::BlendFactor factor_dest_a;
+    FramebufferRegs::LogicOp logic_op;
+};
+
+/**
+ * The Pica register state that decides which operations the software rasterizer runs for each
+ * fragment. Values that change often without changing the operations, like the TEV constant
+ * colors or the alpha test reference, are left out and read once per triangle instead, the same
+ * way PicaFSConfig leaves them to shader uniforms.
+ */
+struct FragmentConfig : Common::HashableStruct<FragmentConfigState> {
+    static FragmentConfig BuildFromRegs(const Regs& regs);
+
+    bool TevStageUpdatesCombinerBufferColor(unsigned stage_index) const {
+        return (stage_index < 4) && (state.combiner_buffer_input & (1 << stage_index));
+    }
+
+    bool TevStageUpdatesCombinerBufferAlpha(unsigned stage_index) const {
+        return (stage_index < 4) && ((state.combiner_buffer_input >> 4) & (1 << stage_index));
+    }
+};
+
+} // namespace Pica::Rasterizer
+
+namespace std {
+template <>
+struct hash<Pica::Rasterizer::FragmentConfig> {
+    std::size_t operator()(const Pica::Rasterizer::FragmentConfig& k) const {
+        return k.Hash();
+    }
+};
+} // namespace std
+
+namespace Pica::Rasterizer {
+
+/// The register values used by a FragmentPipeline that are not part of its FragmentConfig
+struct FragmentUniforms {
+    static FragmentUniforms FromRegs(const Regs& regs);
+
+    std::array<Common::Vec4<u8>, 6> tev_constants;
+    Common::Vec4<u8> tev_combiner_buffer_color;
+    Common::Vec3<u8> fog_color;
+    u8 alpha_test_ref;
+    Common::Vec4<u8> blend_const;
+};
+
+/**
+ * The fragment operations for one FragmentConfig, put together from functions specialized for
+ * each TEV source, modifier and operation, compare function and blend mode, so no per-fragment
+ * work goes through a switch on register values.
+ */
+class FragmentPipeline {
+public:
+    /// The values TEV stages can read their inputs from
+    enum Input : std::size_t {
+        PrimaryColor,
+        PrimaryFragmentColor,
+        SecondaryFragmentColor,
+        Texture0,
+        Texture1,
+        Texture2,
+        Texture3,
+        PreviousBuffer,
+        Constant,
+        Previous,
+        /// Read by sources that aren't known, which are always zero
+        Zero,
+        NumInputs,
+    };
+    using TevInputs = std::array<Common::Vec4<u8>, NumInputs>;
+
+    explicit FragmentPipeline(const FragmentConfig& config);
+
+    const FragmentConfig& GetConfig() const {
+        return config;
+    }
+
+    /**
+     * Runs the texture environment.
+     * @param inputs the inputs up to and including Texture3 have to be filled in, the others are
+     *               used as scratch space
+     */
+    Common::Vec4<u8> CombineTev(TevInputs& inputs, const FragmentUniforms& uniforms) const;
+
+    bool AlphaTest(u8 alpha, const FragmentUniforms& uniforms) const {
+        return alpha_test(alpha, uniforms.alpha_test_ref);
+    }
+
+    bool StencilTest(u8 ref, u8 dest) const {
+        return stencil_test(ref, dest);
+    }
+
+    bool DepthTest(u32 z, u32 ref_z) const {
+        return depth_test(z, ref_z);
+    }
+
+    /// Blends or applies the logic op to a fragment, depending on alphablend_enable
+    Common::Vec4<u8> Blend(const Common::Vec4<u8>& src, const Common::Vec4<u8>& dest,
+                           const FragmentUniforms& uniforms) const;
+
+private:
+    struct TevStage {
+        /// Whether the stage passes the previous stage's output through unchanged
+        bool pass_through;
+        std::array<Input, 3> color_inputs;
+        std::array<Input, 3> alpha_inputs;
+        std::array<ColorModifierFunc, 3> color_modifiers;
+        std::array<AlphaModifierFunc, 3> alpha_modifiers;
+        ColorCombineFunc color_combine;
+        /// Null for Dot3_RGBA, which writes the color result to alpha as well
+        AlphaCombineFunc alpha_combine;
+        unsigned color_multiplier;
+        unsigned alpha_multiplier;
+        bool updates_buffer_color;
+        bool updates_buffer_alpha;
+    };
+
+    FragmentConfig config;
+    std::array<TevStage, 6> tev_stages;
+    CompareTestFunc alpha_test;
+    CompareTestFunc stencil_test;
+    CompareTestFunc depth_test;
+    BlendFactorFunc source_rgb_factor;
+    BlendFactorFunc dest_rgb_factor;
+    BlendFactorFunc source_a_factor;
+    BlendFactorFunc dest_a_factor;
+    BlendEquationFunc blend_equation_rgb;
+    BlendEquationFunc blend_equation_a;
+    LogicOpFunc logic_op;
+};
+
+/// Keeps the FragmentPipeline of every FragmentConfig that has been drawn with
+class FragmentPipelineCache {
+public:
+    FragmentPipelineCache();
+    ~FragmentPipelineCache();
+
+    /// Returns the pipeline for the current register state, building it on first use
+    const FragmentPipeline& Get(const Regs& regs);
+
+private:
+    std::unordered_map<FragmentConfig, std::unique_ptr<FragmentPipeline>> pipelines;
+    const FragmentPipeline* last_used = nullptr;
+};
+
+} // namespace Pica::Rasterizer
@@ -5,6 +5,7 @@
 #include <algorithm>
 #include "common/assert.h"
 #include "common/color.h"
+#include "common/common_funcs.h"
 #include "common/common_types.h"
 #include "common/logging/log.h"
 #include "common/vector_math.h"
@@ -12,6 +13,7 @@
 #include "core/memory.h"
 #include "video_core/pica_state.h"
 #include "video_core/regs_framebuffer.h"
+#include "video_core/swrasterizer/fragment_pipeline.h"
 #include "video_core/swrasterizer/framebuffer.h"
 #include "video_core/utils.h"
 #include "video_core/video_core.h"
@@ -257,11 +259,9 @@ u8 PerformStencilAction(FramebufferRegs::StencilAction action, u8 old_stencil, u
     }
 }
 
-Common::Vec4<u8> EvaluateBlendEquation(const Common::Vec4<u8>& src,
-                                       const Common::Vec4<u8>& srcfactor,
-                                       const Common::Vec4<u8>& dest,
-                                       const Common::Vec4<u8>& destfactor,
-                                       FramebufferRegs::BlendEquation equation) {
+static FORCE_INLINE Common::Vec4<u8> EvaluateBlendEquationImpl(
+    const Common::Vec4<u8>& src, const Common::Vec4<u8>& srcfactor, const Common::Vec4<u8>& dest,
+    const Common::Vec4<u8>& destfactor, FramebufferRegs::BlendEquation equation) {
     Common::Vec4<int> result;
 
     auto src_result = (src * srcfactor).Cast<int>();
@@ -305,7 +305,15 @@ Common::Vec4<u8> EvaluateBlendEquation(const Common::Vec4<u8>& src,
                             std::clamp(result.b(), 0, 255), std::clamp(result.a(), 0, 255));
 };
 
-u8 LogicOp(u8 src, u8 dest, FramebufferRegs::LogicOp op) {
+Common::Vec4<u8> EvaluateBlendEquation(const Common::Vec4<u8>& src,
+                                       const Common::Vec4<u8>& srcfactor,
+                                       const Common::Vec4<u8>& dest,
+                                       const Common::Vec4<u8>& destfactor,
+                                       FramebufferRegs::BlendEquation equation) {
+    return EvaluateBlendEquationImpl(src, srcfactor, dest, destfactor, equation);
+}
+
+static FORCE_INLINE u8 LogicOpImpl(u8 src, u8 dest, FramebufferRegs::LogicOp op) {
     switch (op) {
     case FramebufferRegs::LogicOp::Clear:
         return 0;
@@ -359,6 +367,161 @@ u8 LogicOp(u8 src, u8 dest, FramebufferRegs::LogicOp op) {
     UNREACHABLE();
 };
 
+u8 LogicOp(u8 src, u8 dest, FramebufferRegs::LogicOp op) {
+    return LogicOpImpl(src, dest, op);
+}
+
+static FORCE_INLINE u8 LookupBlendFactorImpl(unsigned channel, FramebufferRegs::BlendFactor factor,
+                                             const Common::Vec4<u8>& src,
+                                             const Common::Vec4<u8>& dest,
+                                             const Common::Vec4<u8>& blend_const) {
+    DEBUG_ASSERT(channel < 4);
+
+    switch (factor) {
+    case FramebufferRegs::BlendFactor::Zero:
+        return 0;
+
+    case FramebufferRegs::BlendFactor::One:
+        return 255;
+
+    case FramebufferRegs::BlendFactor::SourceColor:
+        return src[channel];
+
+    case FramebufferRegs::BlendFactor::OneMinusSourceColor:
+        return 255 - src[channel];
+
+    case FramebufferRegs::BlendFactor::DestColor:
+        return dest[channel];
+
+    case FramebufferRegs::BlendFactor::OneMinusDestColor:
+        return 255 - dest[channel];
+
+    case FramebufferRegs::BlendFactor::SourceAlpha:
+        return src.a();
+
+    case FramebufferRegs::BlendFactor::OneMinusSourceAlpha:
+        return 255 - src.a();
+
+    case FramebufferRegs::BlendFactor::DestAlpha:
+        return dest.a();
+
+    case FramebufferRegs::BlendFactor::OneMinusDestAlpha:
+        return 255 - dest.a();
+
+    case FramebufferRegs::BlendFactor::ConstantColor:
+        return blend_const[channel];
+
+    case FramebufferRegs::BlendFactor::OneMinusConstantColor:
+        return 255 - blend_const[channel];
+
+    case FramebufferRegs::BlendFactor::ConstantAlpha:
+        return blend_const.a();
+
+    case FramebufferRegs::BlendFactor::OneMinusConstantAlpha:
+        return 255 - blend_const.a();
+
+    case FramebufferRegs::BlendFactor::SourceAlphaSaturate:
+        // Returns 1.0 for the alpha channel
+        if (channel == 3)
+            return 255;
+        return std::min(src.a(), static_cast<u8>(255 - dest.a()));
+
+    default:
+        LOG_CRITICAL(HW_GPU, "Unknown blend factor {:x}", static_cast<u32>(factor));
+        UNIMPLEMENTED();
+        break;
+    }
+
+    return src[channel];
+}
+
+u8 LookupBlendFactor(unsigned channel, FramebufferRegs::BlendFactor factor,
+                     const Common::Vec4<u8>& src, const Common::Vec4<u8>& dest,
+                     const Common::Vec4<u8>& blend_const) {
+    return LookupBlendFactorImpl(channel, factor, src, dest, blend_const);
+}
+
+namespace {
+struct CompareTestSpecialization {
+    template <u32 raw>
+    static bool Func(u32 lhs, u32 rhs) {
+        switch (static_cast<FramebufferRegs::CompareFunc>(raw)) {
+        case FramebufferRegs::CompareFunc::Never:
+            return false;
+
+        case FramebufferRegs::CompareFunc::Always:
+            return true;
+
+        case FramebufferRegs::CompareFunc::Equal:
+            return lhs == rhs;
+
+        case FramebufferRegs::CompareFunc::NotEqual:
+            return lhs != rhs;
+
+        case FramebufferRegs::CompareFunc::LessThan:
+            return lhs < rhs;
+
+        case FramebufferRegs::CompareFunc::LessThanOrEqual:
+            return lhs <= rhs;
+
+        case FramebufferRegs::CompareFunc::GreaterThan:
+            return lhs > rhs;
+
+        case FramebufferRegs::CompareFunc::GreaterThanOrEqual:
+            return lhs >= rhs;
+        }
+
+        return false;
+    }
+};
+
+struct BlendFactorSpecialization {
+    template <u32 raw>
+    static u8 Func(unsigned channel, const Common::Vec4<u8>& src, const Common::Vec4<u8>& dest,
+                   const Common::Vec4<u8>& blend_const) {
+        return LookupBlendFactorImpl(channel, static_cast<FramebufferRegs::BlendFactor>(raw), src,
+                                 dest, blend_const);
+    }
+};
+
+struct BlendEquationSpecialization {
+    template <u32 raw>
+    static Common::Vec4<u8> Func(const Common::Vec4<u8>& src, const Common::Vec4<u8>& srcfactor,
+                                 const Common::Vec4<u8>& dest,
+                                 const Common::Vec4<u8>& destfactor) {
+        return EvaluateBlendEquationImpl(src, srcfactor, dest, destfactor,
+                                     static_cast<FramebufferRegs::BlendEquation>(raw));
+    }
+};
+
+struct LogicOpSpecialization {
+    template <u32 raw>
+    static u8 Func(u8 src, u8 dest) {
+        return LogicOpImpl(src, dest, static_cast<FramebufferRegs::LogicOp>(raw));
+    }
+};
+} // Anonymous namespace
+
+CompareTestFunc GetCompareTestFunc(FramebufferRegs::CompareFunc func) {
+    static constexpr auto table = MakeSpecializationTable<CompareTestSpecialization, 8>();
+    return table[static_cast<u32>(func)];
+}
+
+BlendFactorFunc GetBlendFactorFunc(FramebufferRegs::BlendFactor factor) {
+    static constexpr auto table = MakeSpecializationTable<BlendFactorSpecialization, 16>();
+    return table[static_cast<u32>(factor)];
+}
+
+BlendEquationFunc GetBlendEquationFunc(FramebufferRegs::BlendEquation equation) {
+    static constexpr auto table = MakeSpecializationTable<BlendEquationSpecialization, 8>();
+    return table[static_cast<u32>(equation)];
+}
+
+LogicOpFunc GetLogicOpFunc(FramebufferRegs::LogicOp op) {
+    static constexpr auto table = MakeSpecializationTable<LogicOpSpecialization, 16>();
+    return table[static_cast<u32>(op)];
+}
+
 // Decode/Encode for shadow map format. It is similar to D24S8 format, but the depth field is in
 // big-endian
 static const Common::Vec2<u32> DecodeD24S8Shadow(const u8* bytes) {
@@ -26,6 +26,31 @@ Common::Vec4<u8> EvaluateBlendEquation(const Common::Vec4<u8>& src,
 
 u8 LogicOp(u8 src, u8 dest, FramebufferRegs::LogicOp op);
 
+u8 LookupBlendFactor(unsigned channel, FramebufferRegs::BlendFactor factor,
+                     const Common::Vec4<u8>& src, const Common::Vec4<u8>& dest,
+                     const Common::Vec4<u8>& blend_const);
+
+using CompareTestFunc = bool (*)(u32 lhs, u32 rhs);
+using BlendFactorFunc = u8 (*)(unsigned channel, const Common::Vec4<u8>& src,
+                               const Common::Vec4<u8>& dest, const Common::Vec4<u8>& blend_const);
+using BlendEquationFunc = Common::Vec4<u8> (*)(const Common::Vec4<u8>& src,
+                                               const Common::Vec4<u8>& srcfactor,
+                                               const Common::Vec4<u8>& dest,
+                                               const Common::Vec4<u8>& destfactor);
+using LogicOpFunc = u8 (*)(u8 src, u8 dest);
+
+/// Returns a function evaluating "lhs func rhs"
+CompareTestFunc GetCompareTestFunc(FramebufferRegs::CompareFunc func);
+
+/// Returns a function looking up the given blend factor for one channel
+BlendFactorFunc GetBlendFactorFunc(FramebufferRegs::BlendFactor factor);
+
+/// Returns EvaluateBlendEquation specialized for the given equation
+BlendEquationFunc GetBlendEquationFunc(FramebufferRegs::BlendEquation equation);
+
+/// Returns LogicOp specialized for the given operation
+LogicOpFunc GetLogicOpFunc(FramebufferRegs::LogicOp op);
+
 void DrawShadowMapPixel(int x, int y, u32 depth, u8 stencil);
 
 } // namespace Pica::Rasterizer
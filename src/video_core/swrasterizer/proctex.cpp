@@ -4,7 +4,11 @@
 
 #include <array>
 #include <cmath>
+#include <cstddef>
+#include <cstring>
+#include "common/logging/log.h"
 #include "common/math_util.h"
+#include "common/microprofile.h"
 #include "video_core/swrasterizer/proctex.h"
 
 namespace Pica::Rasterizer {
@@ -14,14 +18,14 @@ using ProcTexShift = TexturingRegs::ProcTexShift;
 using ProcTexCombiner = TexturingRegs::ProcTexCombiner;
 using ProcTexFilter = TexturingRegs::ProcTexFilter;
 
-static float LookupLUT(const std::array<State::ProcTex::ValueEntry, 128>& lut, float coord) {
+static float LookupLUT(const std::array<ProcTexTables::ValueEntry, 128>& lut, float coord) {
     // For NoiseLUT/ColorMap/AlphaMap, coord=0.0 is lut[0], coord=127.0/128.0 is lut[127] and
     // coord=1.0 is lut[127]+lut_diff[127]. For other indices, the result is interpolated using
     // value entries and difference entries.
     coord *= 128;
     const int index_int = std::min(static_cast<int>(coord), 127);
     const float frac = coord - index_int;
-    return lut[index_int].ToFloat() + frac * lut[index_int].DiffToFloat();
+    return lut[index_int].value + frac * lut[index_int].difference;
 }
 
 // These function are used to generate random noise for procedural texture. Their results are
@@ -45,13 +49,9 @@ static float NoiseRand2D(unsigned int x, unsigned int y) {
     return -1.0f + v2 * 2.0f / 15.0f;
 }
 
-static float NoiseCoef(float u, float v, TexturingRegs regs, State::ProcTex state) {
-    const float freq_u = float16::FromRaw(regs.proctex_noise_frequency.u).ToFloat32();
-    const float freq_v = float16::FromRaw(regs.proctex_noise_frequency.v).ToFloat32();
-    const float phase_u = float16::FromRaw(regs.proctex_noise_u.phase).ToFloat32();
-    const float phase_v = float16::FromRaw(regs.proctex_noise_v.phase).ToFloat32();
-    const float x = 9 * freq_u * std::abs(u + phase_u);
-    const float y = 9 * freq_v * std::abs(v + phase_v);
+static float NoiseCoef(float u, float v, const ProcTexTables& tables) {
+    const float x = 9 * tables.noise_frequency_u * std::abs(u + tables.noise_phase_u);
+    const float y = 9 * tables.noise_frequency_v * std::abs(v + tables.noise_phase_v);
     const int x_int = static_cast<int>(x);
     const int y_int = static_cast<int>(y);
     const float x_frac = x - x_int;
@@ -61,8 +61,8 @@ static float NoiseCoef(float u, float v, TexturingRegs regs, State::ProcTex stat
     const float g1 = NoiseRand2D(x_int + 1, y_int) * (x_frac + y_frac - 1);
     const float g2 = NoiseRand2D(x_int, y_int + 1) * (x_frac + y_frac - 1);
     const float g3 = NoiseRand2D(x_int + 1, y_int + 1) * (x_frac + y_frac - 2);
-    const float x_noise = LookupLUT(state.noise_table, x_frac);
-    const float y_noise = LookupLUT(state.noise_table, y_frac);
+    const float x_noise = LookupLUT(tables.noise_table, x_frac);
+    const float y_noise = LookupLUT(tables.noise_table, y_frac);
     return Common::BilinearInterp(g0, g1, g2, g3, x_noise, y_noise);
 }
 
@@ -112,8 +112,8 @@ static void ClampCoord(float& coord, ProcTexClamp mode) {
     }
 }
 
-float CombineAndMap(float u, float v, ProcTexCombiner combiner,
-                    const std::array<State::ProcTex::ValueEntry, 128>& map_table) {
+static float CombineAndMap(float u, float v, ProcTexCombiner combiner,
+                           const std::array<ProcTexTables::ValueEntry, 128>& map_table) {
     float f;
     switch (combiner) {
     case ProcTexCombiner::U:
@@ -154,19 +154,19 @@ float CombineAndMap(float u, float v, ProcTexCombiner combiner,
     return LookupLUT(map_table, f);
 }
 
-Common::Vec4<u8> ProcTex(float u, float v, TexturingRegs regs, State::ProcTex state) {
+Common::Vec4<u8> ProcTex(float u, float v, const ProcTexTables& tables) {
     u = std::abs(u);
     v = std::abs(v);
 
     // Get shift offset before noise generation
-    const float u_shift = GetShiftOffset(v, regs.proctex.u_shift, regs.proctex.u_clamp);
-    const float v_shift = GetShiftOffset(u, regs.proctex.v_shift, regs.proctex.v_clamp);
+    const float u_shift = GetShiftOffset(v, tables.u_shift, tables.u_clamp);
+    const float v_shift = GetShiftOffset(u, tables.v_shift, tables.v_clamp);
 
     // Generate noise
-    if (regs.proctex.noise_enable) {
-        float noise = NoiseCoef(u, v, regs, state);
-        u += noise * regs.proctex_noise_u.amplitude / 4095.0f;
-        v += noise * regs.proctex_noise_v.amplitude / 4095.0f;
+    if (tables.noise_enable) {
+        float noise = NoiseCoef(u, v, tables);
+        u += noise * tables.noise_amplitude_u / 4095.0f;
+        v += noise * tables.noise_amplitude_v / 4095.0f;
         u = std::abs(u);
         v = std::abs(v);
     }
@@ -176,46 +176,137 @@ Common::Vec4<u8> ProcTex(float u, float v, TexturingRegs regs, State::ProcTex st
     v += v_shift;
 
     // Clamp
-    ClampCoord(u, regs.proctex.u_clamp);
-    ClampCoord(v, regs.proctex.v_clamp);
+    ClampCoord(u, tables.u_clamp);
+    ClampCoord(v, tables.v_clamp);
 
     // Combine and map
-    const float lut_coord = CombineAndMap(u, v, regs.proctex.color_combiner, state.color_map_table);
+    const float lut_coord = CombineAndMap(u, v, tables.color_combiner, tables.color_map_table);
 
     // Look up the color
     // For the color lut, coord=0.0 is lut[offset] and coord=1.0 is lut[offset+width-1]
-    const u32 offset = regs.proctex_lut_offset.level0;
-    const u32 width = regs.proctex_lut.width;
+    const u32 offset = tables.lut_offset;
+    const u32 width = tables.lut_width;
     const float index = offset + (lut_coord * (width - 1));
     Common::Vec4<u8> final_color;
     // TODO(wwylele): implement mipmap
-    switch (regs.proctex_lut.filter) {
+    switch (tables.lut_filter) {
     case ProcTexFilter::Linear:
     case ProcTexFilter::LinearMipmapLinear:
     case ProcTexFilter::LinearMipmapNearest: {
         const int index_int = static_cast<int>(index);
         const float frac = index - index_int;
-        const auto color_value = state.color_table[index_int].ToVector().Cast<float>();
-        const auto color_diff = state.color_diff_table[index_int].ToVector().Cast<float>();
+        const auto& color_value = tables.color_float_table[index_int];
+        const auto& color_diff = tables.color_diff_table[index_int];
         final_color = (color_value + frac * color_diff).Cast<u8>();
         break;
     }
     case ProcTexFilter::Nearest:
     case ProcTexFilter::NearestMipmapLinear:
     case ProcTexFilter::NearestMipmapNearest:
-        final_color = state.color_table[static_cast<int>(std::round(index))].ToVector();
+        final_color = tables.color_table[static_cast<int>(std::round(index))];
         break;
     }
 
-    if (regs.proctex.separate_alpha) {
+    if (tables.separate_alpha) {
         // Note: in separate alpha mode, the alpha channel skips the color LUT look up stage. It
         // uses the output of CombineAndMap directly instead.
         const float final_alpha =
-            CombineAndMap(u, v, regs.proctex.alpha_combiner, state.alpha_map_table);
+            CombineAndMap(u, v, tables.alpha_combiner, tables.alpha_map_table);
         return Common::MakeVec<u8>(final_color.rgb(), static_cast<u8>(final_alpha * 255));
     } else {
         return final_color;
     }
 }
 
+ProcTexConfig ProcTexConfig::BuildFromRegs(const TexturingRegs& regs,
+                                           const State::ProcTex& proctex) {
+    static_assert(offsetof(TexturingRegs, proctex_lut_offset) - offsetof(TexturingRegs, proctex) ==
+                      sizeof(ProcTexConfigState::regs) - sizeof(u32),
+                  "ProcTex config registers are not contiguous");
+    static_assert(sizeof(State::ProcTex) == sizeof(ProcTexConfigState::luts));
+
+    ProcTexConfig res;
+    std::memcpy(res.state.regs.data(), &regs.proctex, sizeof(res.state.regs));
+    std::memcpy(res.state.luts.data(), &proctex, sizeof(res.state.luts));
+    return res;
+}
+
+ProcTexTables::ProcTexTables(const ProcTexConfig& config) {
+    TexturingRegs regs{};
+    std::memcpy(&regs.proctex, config.state.regs.data(), sizeof(config.state.regs));
+    State::ProcTex proctex;
+    std::memcpy(&proctex, config.state.luts.data(), sizeof(config.state.luts));
+
+    u_clamp = regs.proctex.u_clamp;
+    v_clamp = regs.proctex.v_clamp;
+    color_combiner = regs.proctex.color_combiner;
+    alpha_combiner = regs.proctex.alpha_combiner;
+    separate_alpha = regs.proctex.separate_alpha != 0;
+    noise_enable = regs.proctex.noise_enable != 0;
+    u_shift = regs.proctex.u_shift;
+    v_shift = regs.proctex.v_shift;
+    noise_amplitude_u = static_cast<float>(regs.proctex_noise_u.amplitude);
+    noise_amplitude_v = static_cast<float>(regs.proctex_noise_v.amplitude);
+    noise_phase_u = float16::FromRaw(regs.proctex_noise_u.phase).ToFloat32();
+    noise_phase_v = float16::FromRaw(regs.proctex_noise_v.phase).ToFloat32();
+    noise_frequency_u = float16::FromRaw(regs.proctex_noise_frequency.u).ToFloat32();
+    noise_frequency_v = float16::FromRaw(regs.proctex_noise_frequency.v).ToFloat32();
+    lut_filter = regs.proctex_lut.filter;
+    lut_width = regs.proctex_lut.width;
+    lut_offset = regs.proctex_lut_offset.level0;
+
+    const auto decode_value_table = [](std::array<ValueEntry, 128>& table,
+                                       const std::array<State::ProcTex::ValueEntry, 128>& lut) {
+        for (std::size_t i = 0; i < table.size(); ++i) {
+            table[i] = {lut[i].ToFloat(), lut[i].DiffToFloat()};
+        }
+    };
+    decode_value_table(noise_table, proctex.noise_table);
+    decode_value_table(color_map_table, proctex.color_map_table);
+    decode_value_table(alpha_map_table, proctex.alpha_map_table);
+    for (std::size_t i = 0; i < color_table.size(); ++i) {
+        color_table[i] = proctex.color_table[i].ToVector();
+        color_float_table[i] = color_table[i].Cast<float>();
+        color_diff_table[i] = proctex.color_diff_table[i].ToVector().Cast<float>();
+    }
+}
+
+ProcTexCache::ProcTexCache(std::size_t capacity) : capacity(capacity) {}
+
+ProcTexCache::~ProcTexCache() = default;
+
+MICROPROFILE_DEFINE(GPU_ProcTexTables, "GPU", "Decode ProcTex Tables", MP_RGB(100, 200, 255));
+
+const ProcTexTables& ProcTexCache::Get(const TexturingRegs& regs, const State::ProcTex& proctex) {
+    const auto config = ProcTexConfig::BuildFromRegs(regs, proctex);
+    // The LUTs are usually uploaded once and drawn with over many triangles and frames
+    if (!lru.empty() && lru.front().first == config) {
+        ++stats.hits;
+        return *lru.front().second;
+    }
+
+    const auto iter = tables.find(config);
+    if (iter != tables.end()) {
+        ++stats.hits;
+        lru.splice(lru.begin(), lru, iter->second);
+        return *lru.front().second;
+    }
+
+    while (!lru.empty() && tables.size() >= capacity) {
+        tables.erase(lru.back().first);
+        lru.pop_back();
+        ++stats.evictions;
+    }
+
+    MICROPROFILE_SCOPE(GPU_ProcTexTables);
+    auto decoded = std::make_unique<ProcTexTables>(config);
+    lru.emplace_front(config, std::move(decoded));
+    tables.emplace(config, lru.begin());
+    ++stats.misses;
+    LOG_DEBUG(HW_GPU,
+              "Decoded procedural texture configuration, {} hits, {} misses and {} evictions",
+              stats.hits, stats.misses, stats.evictions);
+    return *lru.front().second;
+}
+
 } // namespace Pica::Rasterizer
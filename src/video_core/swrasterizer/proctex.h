@@ -2,13 +2,119 @@
 // Licensed under GPLv2 or any later version
 // Refer to the license.txt file included.
 
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <list>
+#include <memory>
+#include <unordered_map>
+#include <utility>
 #include "common/common_types.h"
+#include "common/hash.h"
 #include "common/vector_math.h"
 #include "video_core/pica_state.h"
 
 namespace Pica::Rasterizer {
 
+struct ProcTexConfigState {
+    /// The raw ProcTex config registers, 0xa8-0xad
+    std::array<u32, 6> regs;
+    /// The raw contents of every ProcTex LUT
+    std::array<u32, sizeof(State::ProcTex) / sizeof(u32)> luts;
+};
+
+/// The Pica register and LUT state a procedural texture is generated from
+struct ProcTexConfig : Common::HashableStruct<ProcTexConfigState> {
+    static ProcTexConfig BuildFromRegs(const TexturingRegs& regs, const State::ProcTex& proctex);
+};
+
+} // namespace Pica::Rasterizer
+
+namespace std {
+template <>
+struct hash<Pica::Rasterizer::ProcTexConfig> {
+    std::size_t operator()(const Pica::Rasterizer::ProcTexConfig& k) const {
+        return k.Hash();
+    }
+};
+} // namespace std
+
+namespace Pica::Rasterizer {
+
+/// A ProcTexConfig decoded into the values ProcTex reads for each fragment
+struct ProcTexTables {
+    explicit ProcTexTables(const ProcTexConfig& config);
+
+    struct ValueEntry {
+        float value;
+        float difference;
+    };
+
+    TexturingRegs::ProcTexClamp u_clamp;
+    TexturingRegs::ProcTexClamp v_clamp;
+    TexturingRegs::ProcTexCombiner color_combiner;
+    TexturingRegs::ProcTexCombiner alpha_combiner;
+    bool separate_alpha;
+    bool noise_enable;
+    TexturingRegs::ProcTexShift u_shift;
+    TexturingRegs::ProcTexShift v_shift;
+    float noise_amplitude_u;
+    float noise_amplitude_v;
+    float noise_phase_u;
+    float noise_phase_v;
+    float noise_frequency_u;
+    float noise_frequency_v;
+    TexturingRegs::ProcTexFilter lut_filter;
+    u32 lut_width;
+    u32 lut_offset;
+
+    std::array<ValueEntry, 128> noise_table;
+    std::array<ValueEntry, 128> color_map_table;
+    std::array<ValueEntry, 128> alpha_map_table;
+    std::array<Common::Vec4<u8>, 256> color_table;
+    std::array<Common::Vec4<float>, 256> color_float_table;
+    std::array<Common::Vec4<float>, 256> color_diff_table;
+};
+
+/// Keeps the decoded tables of the procedural texture configurations drawn with most recently
+class ProcTexCache {
+public:
+    struct Stats {
+        u64 hits = 0;
+        u64 misses = 0;
+        u64 evictions = 0;
+    };
+
+    /// Enough for the handful of configurations a frame draws with. Each entry takes about 17 KB
+    /// (two copies of the config and the decoded tables) and titles that rewrite their LUTs every
+    /// frame would otherwise keep adding entries.
+    static constexpr std::size_t default_capacity = 64;
+
+    explicit ProcTexCache(std::size_t capacity = default_capacity);
+    ~ProcTexCache();
+
+    /// Returns the tables for the current procedural texture state, decoding them on first use
+    const ProcTexTables& Get(const TexturingRegs& regs, const State::ProcTex& proctex);
+
+    std::size_t Size() const {
+        return tables.size();
+    }
+
+    const Stats& GetStats() const {
+        return stats;
+    }
+
+private:
+    using LruList = std::list<std::pair<ProcTexConfig, std::unique_ptr<ProcTexTables>>>;
+
+    std::size_t capacity;
+    LruList lru; ///< Most recently used first
+    std::unordered_map<ProcTexConfig, LruList::iterator> tables;
+    Stats stats;
+};
+
 /// Generates procedural texture color for the given coordinates
-Common::Vec4<u8> ProcTex(float u, float v, TexturingRegs regs, State::ProcTex state);
+Common::Vec4<u8> ProcTex(float u, float v, const ProcTexTables& tables);
 
 } // namespace Pica::Rasterizer
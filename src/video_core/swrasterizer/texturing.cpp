@@ -4,9 +4,11 @@
 
 #include <algorithm>
 #include "common/assert.h"
+#include "common/common_funcs.h"
 #include "common/common_types.h"
 #include "common/vector_math.h"
 #include "video_core/regs_texturing.h"
+#include "video_core/swrasterizer/fragment_pipeline.h"
 #include "video_core/swrasterizer/texturing.h"
 
 namespace Pica::Rasterizer {
@@ -51,8 +53,8 @@ int GetWrappedTexCoord(TexturingRegs::TextureConfig::WrapMode mode, int val, uns
     }
 };
 
-Common::Vec3<u8> GetColorModifier(TevStageConfig::ColorModifier factor,
-                                  const Common::Vec4<u8>& values) {
+static FORCE_INLINE Common::Vec3<u8> GetColorModifierImpl(TevStageConfig::ColorModifier factor,
+                                                          const Common::Vec4<u8>& values) {
     using ColorModifier = TevStageConfig::ColorModifier;
 
     switch (factor) {
@@ -90,7 +92,13 @@ Common::Vec3<u8> GetColorModifier(TevStageConfig::ColorModifier factor,
     UNREACHABLE();
 };
 
-u8 GetAlphaModifier(TevStageConfig::AlphaModifier factor, const Common::Vec4<u8>& values) {
+Common::Vec3<u8> GetColorModifier(TevStageConfig::ColorModifier factor,
+                                  const Common::Vec4<u8>& values) {
+    return GetColorModifierImpl(factor, values);
+}
+
+static FORCE_INLINE u8 GetAlphaModifierImpl(TevStageConfig::AlphaModifier factor,
+                                            const Common::Vec4<u8>& values) {
     using AlphaModifier = TevStageConfig::AlphaModifier;
 
     switch (factor) {
@@ -122,7 +130,12 @@ u8 GetAlphaModifier(TevStageConfig::AlphaModifier factor, const Common::Vec4<u8>
     UNREACHABLE();
 };
 
-Common::Vec3<u8> ColorCombine(TevStageConfig::Operation op, const Common::Vec3<u8> input[3]) {
+u8 GetAlphaModifier(TevStageConfig::AlphaModifier factor, const Common::Vec4<u8>& values) {
+    return GetAlphaModifierImpl(factor, values);
+}
+
+static FORCE_INLINE Common::Vec3<u8> ColorCombineImpl(TevStageConfig::Operation op,
+                                                      const Common::Vec3<u8> input[3]) {
     using Operation = TevStageConfig::Operation;
 
     switch (op) {
@@ -200,7 +213,12 @@ Common::Vec3<u8> ColorCombine(TevStageConfig::Operation op, const Common::Vec3<u
     }
 };
 
-u8 AlphaCombine(TevStageConfig::Operation op, const std::array<u8, 3>& input) {
+Common::Vec3<u8> ColorCombine(TevStageConfig::Operation op, const Common::Vec3<u8> input[3]) {
+    return ColorCombineImpl(op, input);
+}
+
+static FORCE_INLINE u8 AlphaCombineImpl(TevStageConfig::Operation op,
+                                        const std::array<u8, 3>& input) {
     switch (op) {
         using Operation = TevStageConfig::Operation;
     case Operation::Replace:
@@ -237,4 +255,58 @@ u8 AlphaCombine(TevStageConfig::Operation op, const std::array<u8, 3>& input) {
     }
 };
 
+u8 AlphaCombine(TevStageConfig::Operation op, const std::array<u8, 3>& input) {
+    return AlphaCombineImpl(op, input);
+}
+
+namespace {
+struct ColorModifierSpecialization {
+    template <u32 raw>
+    static Common::Vec3<u8> Func(const Common::Vec4<u8>& values) {
+        return GetColorModifierImpl(static_cast<TevStageConfig::ColorModifier>(raw), values);
+    }
+};
+
+struct AlphaModifierSpecialization {
+    template <u32 raw>
+    static u8 Func(const Common::Vec4<u8>& values) {
+        return GetAlphaModifierImpl(static_cast<TevStageConfig::AlphaModifier>(raw), values);
+    }
+};
+
+struct ColorCombineSpecialization {
+    template <u32 raw>
+    static Common::Vec3<u8> Func(const Common::Vec3<u8> input[3]) {
+        return ColorCombineImpl(static_cast<TevStageConfig::Operation>(raw), input);
+    }
+};
+
+struct AlphaCombineSpecialization {
+    template <u32 raw>
+    static u8 Func(const std::array<u8, 3>& input) {
+        return AlphaCombineImpl(static_cast<TevStageConfig::Operation>(raw), input);
+    }
+};
+} // Anonymous namespace
+
+ColorModifierFunc GetColorModifierFunc(TevStageConfig::ColorModifier factor) {
+    static constexpr auto table = MakeSpecializationTable<ColorModifierSpecialization, 16>();
+    return table[static_cast<u32>(factor)];
+}
+
+AlphaModifierFunc GetAlphaModifierFunc(TevStageConfig::AlphaModifier factor) {
+    static constexpr auto table = MakeSpecializationTable<AlphaModifierSpecialization, 8>();
+    return table[static_cast<u32>(factor)];
+}
+
+ColorCombineFunc GetColorCombineFunc(TevStageConfig::Operation op) {
+    static constexpr auto table = MakeSpecializationTable<ColorCombineSpecialization, 16>();
+    return table[static_cast<u32>(op)];
+}
+
+AlphaCombineFunc GetAlphaCombineFunc(TevStageConfig::Operation op) {
+    static constexpr auto table = MakeSpecializationTable<AlphaCombineSpecialization, 16>();
+    return table[static_cast<u32>(op)];
+}
+
 } // namespace Pica::Rasterizer
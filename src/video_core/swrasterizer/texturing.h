@@ -4,6 +4,7 @@
 
 #pragma once
 
+#include <array>
 #include "common/common_types.h"
 #include "common/vector_math.h"
 #include "video_core/regs_texturing.h"
@@ -23,4 +24,21 @@ Common::Vec3<u8> ColorCombine(TexturingRegs::TevStageConfig::Operation op,
 
 u8 AlphaCombine(TexturingRegs::TevStageConfig::Operation op, const std::array<u8, 3>& input);
 
+using ColorModifierFunc = Common::Vec3<u8> (*)(const Common::Vec4<u8>& values);
+using AlphaModifierFunc = u8 (*)(const Common::Vec4<u8>& values);
+using ColorCombineFunc = Common::Vec3<u8> (*)(const Common::Vec3<u8> input[3]);
+using AlphaCombineFunc = u8 (*)(const std::array<u8, 3>& input);
+
+/// Returns GetColorModifier specialized for the given modifier
+ColorModifierFunc GetColorModifierFunc(TexturingRegs::TevStageConfig::ColorModifier factor);
+
+/// Returns GetAlphaModifier specialized for the given modifier
+AlphaModifierFunc GetAlphaModifierFunc(TexturingRegs::TevStageConfig::AlphaModifier factor);
+
+/// Returns ColorCombine specialized for the given operation
+ColorCombineFunc GetColorCombineFunc(TexturingRegs::TevStageConfig::Operation op);
+
+/// Returns AlphaCombine specialized for the given operation
+AlphaCombineFunc GetAlphaCombineFunc(TexturingRegs::TevStageConfig::Operation op);
+
 } // namespace Pica::Rasterizer